@@ -0,0 +1,91 @@
+#include "ColumnDictionary.h"
+#include "TableData.h"
+#include "ResultCache.h"
+
+namespace Core {
+
+qint64 ColumnDictionary::memoryCost() const
+{
+    qint64 cost = codes.size() * static_cast<qint64>(sizeof(int));
+    cost += counts.size() * static_cast<qint64>(sizeof(qint64));
+
+    // 文本同时存放在 labels 与 index 中，另计哈希节点开销
+    for (const QString& label : labels) {
+        cost += 2 * (label.size() * static_cast<qint64>(sizeof(QChar)) + 32);
+    }
+    return cost;
+}
+
+ColumnDictionary ColumnDictionary::build(const TableData& table, int column)
+{
+    ColumnDictionary dictionary;
+    if (column < 0 || column >= table.columnCount()) {
+        return dictionary;
+    }
+
+    int rows = table.rowCount();
+    dictionary.codes.resize(rows);
+
+    for (int row = 0; row < rows; ++row) {
+        QVariant value = table.at(row, column);
+        QString text = value.isNull() ? QString() : value.toString();
+
+        if (text.isEmpty()) {
+            dictionary.codes[row] = NULL_CODE;
+            ++dictionary.nullCount;
+            continue;
+        }
+
+        auto it = dictionary.index.constFind(text);
+        int code;
+        if (it != dictionary.index.constEnd()) {
+            code = it.value();
+        } else {
+            code = dictionary.labels.size();
+            dictionary.index.insert(text, code);
+            dictionary.labels.append(text);
+            dictionary.counts.append(0);
+        }
+
+        dictionary.codes[row] = code;
+        ++dictionary.counts[code];
+    }
+
+    return dictionary;
+}
+
+QSharedPointer<const ColumnDictionary> ColumnDictionary::cached(const TableData& table, int column)
+{
+    return ResultCache::instance().getOrCompute<ColumnDictionary>(
+        ResultCache::makeKey(table, column, "dictionary"),
+        [&]() { return build(table, column); },
+        [](const ColumnDictionary& dictionary) { return dictionary.memoryCost(); });
+}
+
+ColumnDictionary ColumnDictionary::fromCodes(const QVector<int>& codes, const QStringList& labels)
+{
+    ColumnDictionary dictionary;
+    dictionary.codes = codes;
+    dictionary.labels = labels;
+    dictionary.counts.fill(0, labels.size());
+    for (int code = 0; code < labels.size(); ++code) {
+        dictionary.index.insert(labels[code], code);
+    }
+
+    for (int code : codes) {
+        if (code >= 0 && code < labels.size()) {
+            ++dictionary.counts[code];
+        } else {
+            ++dictionary.nullCount;
+        }
+    }
+    return dictionary;
+}
+
+void ColumnDictionary::store(const TableData& table, int column, const ColumnDictionary& dictionary)
+{
+    QSharedPointer<const ColumnDictionary> value(new ColumnDictionary(dictionary));
+    ResultCache::instance().insert(ResultCache::makeKey(table, column, "dictionary"), value, value->memoryCost());
+}
+
+} // namespace Core
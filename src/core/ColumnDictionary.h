@@ -0,0 +1,69 @@
+#ifndef COLUMNDICTIONARY_H
+#define COLUMNDICTIONARY_H
+
+#include <QVector>
+#include <QStringList>
+#include <QHash>
+#include <QSharedPointer>
+
+namespace Core {
+
+class TableData;
+
+/**
+ * @brief 列的字典编码
+ *
+ * 把一列的取值映射为整数编码（按首次出现顺序），用于分组、计数和
+ * 独热编码等需要反复比较类别的场景，避免逐行比较字符串。
+ */
+struct ColumnDictionary
+{
+    // 空单元格的编码
+    static const int NULL_CODE = -1;
+
+    QVector<int> codes;             // 每行的编码
+    QStringList labels;             // 编码对应的取值文本
+    QVector<qint64> counts;         // 每个编码的出现次数
+    QHash<QString, int> index;      // 取值文本 -> 编码
+    qint64 nullCount = 0;           // 空单元格个数
+
+    int categoryCount() const { return labels.size(); }
+
+    /**
+     * @brief 查找取值的编码
+     * @return 不存在时返回 NULL_CODE
+     */
+    int codeOf(const QString& label) const { return index.value(label, NULL_CODE); }
+
+    /**
+     * @brief 估算占用的内存（字节）
+     */
+    qint64 memoryCost() const;
+
+    /**
+     * @brief 对表格的一列做字典编码
+     */
+    static ColumnDictionary build(const TableData& table, int column);
+
+    /**
+     * @brief 获取列的字典编码（结果按列版本缓存）
+     */
+    static QSharedPointer<const ColumnDictionary> cached(const TableData& table, int column);
+
+    /**
+     * @brief 由现成的编码构造（counts、index 与 nullCount 随之统计）
+     * @param codes 每行的编码，取值为 NULL_CODE 或 labels 的下标
+     */
+    static ColumnDictionary fromCodes(const QVector<int>& codes, const QStringList& labels);
+
+    /**
+     * @brief 把已知的编码放入缓存（如刚追加的分类列），之后 cached() 不必再逐行编码
+     *
+     * 编码须与 build() 的结果一致，即类别按首次出现的顺序编号。
+     */
+    static void store(const TableData& table, int column, const ColumnDictionary& dictionary);
+};
+
+} // namespace Core
+
+#endif // COLUMNDICTIONARY_H
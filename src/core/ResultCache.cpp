@@ -0,0 +1,85 @@
+#include "ResultCache.h"
+#include "TableData.h"
+
+namespace Core {
+
+ResultCache& ResultCache::instance()
+{
+    static ResultCache cache;
+    return cache;
+}
+
+ResultCache::ResultCache()
+{
+    m_cache.setMaxCost(DEFAULT_MAX_COST);
+}
+
+QString ResultCache::makeKey(const TableData& table, int column,
+                             const QString& kind, const QString& params)
+{
+    quint64 version = column >= 0 ? table.columnVersion(column) : table.version();
+
+    // 表格标识放在最前面，便于按前缀移除
+    return QString("%1/%2/%3/%4/%5")
+        .arg(table.id())
+        .arg(column)
+        .arg(version)
+        .arg(kind, params);
+}
+
+void ResultCache::remove(const QString& key)
+{
+    QMutexLocker locker(&m_mutex);
+    m_cache.remove(key);
+}
+
+void ResultCache::removeTable(quint64 tableId)
+{
+    QString prefix = QString("%1/").arg(tableId);
+
+    QMutexLocker locker(&m_mutex);
+    const auto keys = m_cache.keys();
+    for (const QString& key : keys) {
+        if (key.startsWith(prefix)) {
+            m_cache.remove(key);
+        }
+    }
+}
+
+void ResultCache::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_cache.clear();
+}
+
+void ResultCache::setMaxCost(qint64 bytes)
+{
+    QMutexLocker locker(&m_mutex);
+    m_cache.setMaxCost(bytes);
+}
+
+qint64 ResultCache::maxCost() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_cache.maxCost();
+}
+
+qint64 ResultCache::totalCost() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_cache.totalCost();
+}
+
+qint64 ResultCache::hits() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_hits;
+}
+
+qint64 ResultCache::misses() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_misses;
+}
+
+} // namespace Core
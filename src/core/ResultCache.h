@@ -0,0 +1,129 @@
+#ifndef RESULTCACHE_H
+#define RESULTCACHE_H
+
+#include <QCache>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QString>
+#include <algorithm>
+#include <any>
+
+namespace Core {
+
+class TableData;
+
+/**
+ * @brief 派生结果缓存
+ *
+ * 以"表格标识 + 列 + 列版本号 + 结果类型 + 参数"为键缓存统计摘要、
+ * 排序副本、直方图、字典编码等派生结果。列被修改后版本号变化，
+ * 旧结果不会再被命中，并按最近最少使用原则在超出内存上限时淘汰。
+ * 所有接口均可在多线程中调用。
+ */
+class ResultCache
+{
+public:
+    static ResultCache& instance();
+
+    /**
+     * @brief 生成缓存键
+     * @param column 列索引（整表结果传 -1，版本号取整表版本）
+     * @param kind 结果类型（如 "summary"、"sorted"）
+     * @param params 影响结果的参数（序列化为字符串）
+     */
+    static QString makeKey(const TableData& table, int column,
+                           const QString& kind, const QString& params = QString());
+
+    /**
+     * @brief 查找缓存结果
+     * @return 未命中或类型不符时返回空指针
+     */
+    template<typename T>
+    QSharedPointer<const T> find(const QString& key)
+    {
+        QMutexLocker locker(&m_mutex);
+        Entry* entry = m_cache.object(key);
+        if (!entry) {
+            ++m_misses;
+            return QSharedPointer<const T>();
+        }
+
+        const auto* value = std::any_cast<QSharedPointer<const T>>(&entry->value);
+        if (!value) {
+            ++m_misses;
+            return QSharedPointer<const T>();
+        }
+
+        ++m_hits;
+        return *value;
+    }
+
+    /**
+     * @brief 插入结果
+     * @param costBytes 结果占用的内存（字节），超过上限时不缓存
+     */
+    template<typename T>
+    void insert(const QString& key, const QSharedPointer<const T>& value, qint64 costBytes)
+    {
+        QMutexLocker locker(&m_mutex);
+        m_cache.insert(key, new Entry{value}, std::max<qint64>(1, costBytes));
+    }
+
+    /**
+     * @brief 查找结果，未命中时计算并缓存
+     * @param compute 形如 T() 的函数对象（在锁外执行）
+     * @param cost 形如 qint64(const T&) 的函数对象，返回结果占用的字节数
+     */
+    template<typename T, typename Compute, typename Cost>
+    QSharedPointer<const T> getOrCompute(const QString& key, Compute compute, Cost cost)
+    {
+        QSharedPointer<const T> cached = find<T>(key);
+        if (cached) {
+            return cached;
+        }
+
+        QSharedPointer<const T> value(new T(compute()));
+        insert(key, value, cost(*value));
+        return value;
+    }
+
+    /**
+     * @brief 移除一个结果（如不会再命中的旧版本键，以释放其对数据的引用）
+     */
+    void remove(const QString& key);
+
+    /**
+     * @brief 移除某个表格的所有结果
+     */
+    void removeTable(quint64 tableId);
+
+    void clear();
+
+    // 内存上限（字节）
+    void setMaxCost(qint64 bytes);
+    qint64 maxCost() const;
+    qint64 totalCost() const;
+
+    qint64 hits() const;
+    qint64 misses() const;
+
+    // 默认内存上限
+    static const qint64 DEFAULT_MAX_COST = 256LL * 1024 * 1024;
+
+private:
+    ResultCache();
+
+    struct Entry
+    {
+        std::any value;
+    };
+
+    mutable QMutex m_mutex;
+    QCache<QString, Entry> m_cache;
+    qint64 m_hits = 0;
+    qint64 m_misses = 0;
+};
+
+} // namespace Core
+
+#endif // RESULTCACHE_H
@@ -1,9 +1,23 @@
 #include "TableData.h"
+#include "ResultCache.h"
 #include <QDebug>
 #include <QMetaType>
+#include <atomic>
+#include <utility>
 
 namespace Core {
 
+namespace {
+
+// 全局递增的版本号，保证被修改的列永远不会复用旧版本号
+quint64 nextGeneration()
+{
+    static std::atomic<quint64> generation{0};
+    return ++generation;
+}
+
+} // namespace
+
 // PIMPL 实现
 struct TableData::Impl
 {
@@ -11,6 +25,32 @@ struct TableData::Impl
     QStringList m_headers;
     int m_rowCount = 0;
     int m_columnCount = 0;
+
+    quint64 m_id = nextGeneration();
+    quint64 m_version = 0;
+    QVector<quint64> m_columnVersions;
+    QVector<quint64> m_prefixVersions;     // 已有行被修改时才变化（追加行不变）
+
+    void touchColumn(int column)
+    {
+        m_version = nextGeneration();
+        m_columnVersions[column] = m_version;
+        m_prefixVersions[column] = m_version;
+    }
+
+    void touchAll()
+    {
+        m_version = nextGeneration();
+        m_columnVersions.fill(m_version, m_columnCount);
+        m_prefixVersions.fill(m_version, m_columnCount);
+    }
+
+    // 仅追加了行：内容版本变化，已有行的版本保持不变
+    void touchAppend()
+    {
+        m_version = nextGeneration();
+        m_columnVersions.fill(m_version, m_columnCount);
+    }
 };
 
 TableData::TableData()
@@ -24,7 +64,11 @@ TableData::TableData(int rows, int columns)
     resize(rows, columns);
 }
 
-TableData::~TableData() = default;
+TableData::~TableData()
+{
+    // 释放该表格的所有缓存结果
+    ResultCache::instance().removeTable(m_impl->m_id);
+}
 
 // === 数据访问 ===
 QVariant TableData::at(int row, int column) const
@@ -35,7 +79,8 @@ QVariant TableData::at(int row, int column) const
         return QVariant();
     }
 
-    return m_impl->m_data[row][column];
+    // 只读访问，避免共享数据时触发隐式分离（保证多线程并发读取安全）
+    return std::as_const(m_impl->m_data)[row][column];
 }
 
 void TableData::set(int row, int column, const QVariant& value)
@@ -47,6 +92,7 @@ void TableData::set(int row, int column, const QVariant& value)
     }
 
     m_impl->m_data[row][column] = value;
+    m_impl->touchColumn(column);
 }
 
 // === 维度信息 ===
@@ -80,6 +126,7 @@ void TableData::resize(int rows, int columns)
 
     m_impl->m_rowCount = rows;
     m_impl->m_columnCount = columns;
+    m_impl->touchAll();
 
     // 调整表头
     while (m_impl->m_headers.size() < columns) {
@@ -94,6 +141,7 @@ void TableData::clear()
     m_impl->m_headers.clear();
     m_impl->m_rowCount = 0;
     m_impl->m_columnCount = 0;
+    m_impl->touchAll();
 }
 
 // === 表头 ===
@@ -130,7 +178,7 @@ QVector<QVariant> TableData::getRow(int row) const
         return QVector<QVariant>();
     }
 
-    return m_impl->m_data[row];
+    return std::as_const(m_impl->m_data)[row];
 }
 
 QVector<QVariant> TableData::getColumn(int column) const
@@ -143,8 +191,9 @@ QVector<QVariant> TableData::getColumn(int column) const
     QVector<QVariant> result;
     result.reserve(m_impl->m_rowCount);
 
+    const auto& data = std::as_const(m_impl->m_data);
     for (int row = 0; row < m_impl->m_rowCount; ++row) {
-        result.append(m_impl->m_data[row][column]);
+        result.append(data[row][column]);
     }
 
     return result;
@@ -163,6 +212,7 @@ void TableData::setRow(int row, const QVector<QVariant>& values)
     }
 
     m_impl->m_data[row] = values;
+    m_impl->touchAll();
 }
 
 void TableData::setColumn(int column, const QVector<QVariant>& values)
@@ -180,6 +230,38 @@ void TableData::setColumn(int column, const QVector<QVariant>& values)
     for (int row = 0; row < m_impl->m_rowCount; ++row) {
         m_impl->m_data[row][column] = values[row];
     }
+    m_impl->touchColumn(column);
+}
+
+int TableData::appendColumn(const QString& name, const QVector<QVariant>& values)
+{
+    if (values.size() != m_impl->m_rowCount) {
+        qWarning() << "TableData::appendColumn: Values size mismatch:" << values.size();
+        return -1;
+    }
+
+    for (int row = 0; row < m_impl->m_rowCount; ++row) {
+        m_impl->m_data[row].append(values[row]);
+    }
+
+    int column = m_impl->m_columnCount++;
+    m_impl->m_headers.append(name);
+    m_impl->m_columnVersions.append(0);
+    m_impl->m_prefixVersions.append(0);
+    m_impl->touchColumn(column);
+    return column;
+}
+
+int TableData::appendRow(const QVector<QVariant>& values)
+{
+    if (values.size() != m_impl->m_columnCount) {
+        qWarning() << "TableData::appendRow: Values size mismatch:" << values.size();
+        return -1;
+    }
+
+    m_impl->m_data.append(values);
+    m_impl->touchAppend();
+    return m_impl->m_rowCount++;
 }
 
 // === 数据类型处理 ===
@@ -228,8 +310,39 @@ TableData* TableData::clone() const
 
     copy->m_impl->m_data = m_impl->m_data;
     copy->m_impl->m_headers = m_impl->m_headers;
+    copy->m_impl->touchAll();
 
     return copy;
 }
 
+// === 版本 ===
+quint64 TableData::id() const
+{
+    return m_impl->m_id;
+}
+
+quint64 TableData::prefixVersion(int column) const
+{
+    if (column < 0 || column >= m_impl->m_columnCount) {
+        qWarning() << "TableData::prefixVersion: Column index out of range:" << column;
+        return 0;
+    }
+    return m_impl->m_prefixVersions[column];
+}
+
+quint64 TableData::columnVersion(int column) const
+{
+    if (column < 0 || column >= m_impl->m_columnCount) {
+        qWarning() << "TableData::columnVersion: Column index out of range:" << column;
+        return 0;
+    }
+
+    return m_impl->m_columnVersions[column];
+}
+
+quint64 TableData::version() const
+{
+    return m_impl->m_version;
+}
+
 } // namespace Core
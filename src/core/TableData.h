@@ -44,6 +44,20 @@ public:
     void setRow(int row, const QVector<QVariant>& values);
     void setColumn(int column, const QVector<QVariant>& values);
 
+    /**
+     * @brief 在末尾追加一列（其余列的版本号保持不变）
+     * @return 新列的索引，values 长度与行数不符时返回 -1
+     */
+    int appendColumn(const QString& name, const QVector<QVariant>& values);
+
+    /**
+     * @brief 在末尾追加一行（不改变各列的 prefixVersion）
+     *
+     * 供导入等追加数据的场景使用；表格视图的插入行只修改显示模型，不经过此接口。
+     * @return 新行的索引，values 长度与列数不符时返回 -1
+     */
+    int appendRow(const QVector<QVariant>& values);
+
     // === 数据类型处理 ===
     bool isNumeric(int row, int column) const;
     bool isNumeric(int column) const;
@@ -53,6 +67,33 @@ public:
     // === 克隆 ===
     TableData* clone() const;
 
+    // === 版本（用于缓存失效）===
+    /**
+     * @brief 表格实例的唯一标识（克隆得到新标识）
+     */
+    quint64 id() const;
+
+    /**
+     * @brief 列的数据版本号
+     *
+     * 该列内容每次被 set/setRow/setColumn/resize/clear 修改后都会取得一个
+     * 全局递增的新值，因此"标识 + 列 + 版本号"可唯一确定列内容。
+     */
+    quint64 columnVersion(int column) const;
+
+    /**
+     * @brief 列中已有行的版本号
+     *
+     * 只有 appendRow 追加行时保持不变，其余修改与 columnVersion 同步变化。
+     * 增量计算可记录已处理的行数与该版本号，版本未变时只需处理新增的行。
+     */
+    quint64 prefixVersion(int column) const;
+
+    /**
+     * @brief 整表的数据版本号（任意一列被修改后即变化）
+     */
+    quint64 version() const;
+
 private:
     struct Impl;
     std::unique_ptr<Impl> m_impl;
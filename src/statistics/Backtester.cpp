@@ -0,0 +1,349 @@
+#include "Backtester.h"
+#include "OnlineForecaster.h"
+#include "ParallelUtils.h"
+#include "SmoothingKernels.h"
+#include "SmoothingOptimizer.h"
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace Statistics {
+
+namespace {
+
+// 增量回测时每段至少包含的起点数（每段需从头预热一次）
+const int MIN_FOLDS_PER_SEGMENT = 32;
+
+// 逐折重新拟合时每个任务至少包含的起点数
+const int MIN_FOLDS_PER_TASK = 4;
+
+/**
+ * 误差累计（按段合并）
+ */
+struct ErrorSums
+{
+    int folds = 0;
+    qint64 points = 0;
+    double sse = 0.0;
+    double sae = 0.0;
+    double sape = 0.0;
+    qint64 percentPoints = 0;
+    QString errorMessage;
+
+    void merge(const ErrorSums& other)
+    {
+        folds += other.folds;
+        points += other.points;
+        sse += other.sse;
+        sae += other.sae;
+        sape += other.sape;
+        percentPoints += other.percentPoints;
+        if (errorMessage.isEmpty()) {
+            errorMessage = other.errorMessage;
+        }
+    }
+};
+
+/**
+ * 一个并行任务：候选模型 candidate 在起点下标 [begin, end) 上的回测
+ */
+struct Task
+{
+    int candidate = 0;
+    int begin = 0;
+    int end = 0;
+};
+
+OnlineForecaster makeForecaster(const BacktestCandidate& candidate)
+{
+    switch (candidate.method) {
+    case ForecastMethod::SimpleMovingAverage:
+        return OnlineForecaster::movingAverage(candidate.window);
+    case ForecastMethod::WeightedMovingAverage:
+        return OnlineForecaster::weightedMovingAverage(candidate.weights);
+    case ForecastMethod::ExponentialSmoothing:
+        return OnlineForecaster::exponentialSmoothing(SmoothingModel::Simple, candidate.parameters);
+    case ForecastMethod::HoltLinear:
+        return OnlineForecaster::exponentialSmoothing(SmoothingModel::Holt, candidate.parameters);
+    case ForecastMethod::HoltWintersAdditive:
+        return OnlineForecaster::exponentialSmoothing(SmoothingModel::HoltWintersAdditive, candidate.parameters,
+                                                      candidate.seasonLength);
+    case ForecastMethod::HoltWintersMultiplicative:
+        return OnlineForecaster::exponentialSmoothing(SmoothingModel::HoltWintersMultiplicative,
+                                                      candidate.parameters, candidate.seasonLength);
+    case ForecastMethod::LinearRegression:
+        break;
+    }
+    return OnlineForecaster::linearRegression();
+}
+
+bool isMovingAverage(ForecastMethod method)
+{
+    return method == ForecastMethod::SimpleMovingAverage || method == ForecastMethod::WeightedMovingAverage;
+}
+
+/**
+ * 用当前状态预测起点 origin 之后 horizon 期并累计误差
+ */
+void scoreFold(const OnlineForecaster& forecaster, const double* y, qsizetype origin, int horizon,
+               ErrorSums& sums)
+{
+    if (!forecaster.isReady()) {
+        return;     // 训练数据中有效值不足（含 NaN 时），跳过该起点
+    }
+
+    ForecastResult forecast = forecaster.forecast(horizon, 0.0);
+    if (!forecast.isValid) {
+        sums.errorMessage = forecast.errorMessage;
+        return;
+    }
+
+    ++sums.folds;
+    for (int h = 0; h < horizon; ++h) {
+        double actual = y[origin + h];
+        if (!std::isfinite(actual)) {
+            continue;
+        }
+        double e = actual - forecast.predicted[h];
+        ++sums.points;
+        sums.sse += e * e;
+        sums.sae += std::fabs(e);
+        if (actual != 0.0) {
+            sums.sape += std::fabs(e / actual);
+            ++sums.percentPoints;
+        }
+    }
+}
+
+QString validateCandidate(const BacktestCandidate& candidate, int trainingSize)
+{
+    if (candidate.method == ForecastMethod::SimpleMovingAverage && candidate.window <= 0) {
+        return "窗口大小无效";
+    }
+    if (candidate.method == ForecastMethod::WeightedMovingAverage &&
+        (candidate.weights.isEmpty() ||
+         std::accumulate(candidate.weights.cbegin(), candidate.weights.cend(), 0.0) == 0.0)) {
+        return "权重维度无效或权重和为零";
+    }
+    if ((candidate.method == ForecastMethod::HoltWintersAdditive ||
+         candidate.method == ForecastMethod::HoltWintersMultiplicative) && candidate.seasonLength < 2) {
+        return "季节周期至少为 2";
+    }
+    if (Backtester::minimumTrainingSize(candidate) > trainingSize) {
+        return QString("训练窗口小于模型所需的最少数据（%1 个）").arg(Backtester::minimumTrainingSize(candidate));
+    }
+    return QString();
+}
+
+} // namespace
+
+BacktestResult Backtester::run(const QVector<double>& data, const QVector<BacktestCandidate>& candidates,
+                               const BacktestOptions& options)
+{
+    BacktestResult result;
+    const qsizetype n = data.size();
+    const int horizon = options.horizon;
+    const int trainingSize = options.trainingSize > 0 ? options.trainingSize : static_cast<int>(n / 2);
+
+    if (candidates.isEmpty()) {
+        result.isValid = false;
+        result.errorMessage = "没有候选模型";
+        return result;
+    }
+    if (horizon < 1 || options.step < 1) {
+        result.isValid = false;
+        result.errorMessage = "预测期数与起点间隔至少为 1";
+        return result;
+    }
+    if (trainingSize < 1 || trainingSize + horizon > n) {
+        result.isValid = false;
+        result.errorMessage = "数据量不足：训练窗口加预测期数超过了数据长度";
+        return result;
+    }
+
+    // === 预测起点：训练集为 [起点 - 训练长度, 起点)（扩展窗口从 0 开始） ===
+    QVector<qsizetype> origins;
+    for (qsizetype t = trainingSize; t + horizon <= n; t += options.step) {
+        origins.append(t);
+    }
+    if (options.maxFolds > 0 && origins.size() > options.maxFolds) {
+        origins = origins.mid(origins.size() - options.maxFolds);
+    }
+    const int folds = origins.size();
+    result.folds = folds;
+
+    // === 切分任务 ===
+    const bool sliding = options.windowType == BacktestWindow::Sliding;
+    QVector<QString> invalidReasons(candidates.size());
+    QVector<Task> tasks;
+    for (int c = 0; c < candidates.size(); ++c) {
+        invalidReasons[c] = validateCandidate(candidates[c], trainingSize);
+        if (!invalidReasons[c].isEmpty()) {
+            continue;
+        }
+
+        // 移动平均只依赖最近 window 个值，两种窗口下都可以增量更新
+        bool incremental = !sliding || isMovingAverage(candidates[c].method);
+        int segments = Parallel::chunkCount(folds, incremental ? MIN_FOLDS_PER_SEGMENT : MIN_FOLDS_PER_TASK);
+        for (int s = 0; s < segments; ++s) {
+            tasks.append({c, static_cast<int>(Parallel::chunkBegin(folds, segments, s)),
+                          static_cast<int>(Parallel::chunkBegin(folds, segments, s + 1))});
+        }
+    }
+
+    // === 并行执行（各任务只写自己的误差累计） ===
+    const double* y = data.constData();
+    QVector<ErrorSums> taskSums(tasks.size());
+
+    Parallel::forEach(tasks.size(), [&](int index) {
+        const Task& task = tasks[index];
+        const BacktestCandidate& candidate = candidates[task.candidate];
+        ErrorSums& sums = taskSums[index];
+        if (task.begin >= task.end) {
+            return;
+        }
+
+        OnlineForecaster forecaster = makeForecaster(candidate);
+
+        if (!sliding || isMovingAverage(candidate.method)) {
+            // 扩展窗口：预热到本段第一个起点，之后每个起点只追加相差的 step 行
+            qsizetype consumed = 0;
+            for (int k = task.begin; k < task.end; ++k) {
+                for (; consumed < origins[k]; ++consumed) {
+                    forecaster.update(y[consumed]);
+                }
+                scoreFold(forecaster, y, origins[k], horizon, sums);
+            }
+        } else {
+            // 滑动窗口：每折只用窗口内的数据重新拟合
+            for (int k = task.begin; k < task.end; ++k) {
+                forecaster.reset();
+                for (qsizetype i = origins[k] - trainingSize; i < origins[k]; ++i) {
+                    forecaster.update(y[i]);
+                }
+                scoreFold(forecaster, y, origins[k], horizon, sums);
+            }
+        }
+    });
+
+    // === 按候选模型合并（按段顺序，结果与线程数无关） ===
+    QVector<ErrorSums> candidateSums(candidates.size());
+    for (int t = 0; t < tasks.size(); ++t) {
+        candidateSums[tasks[t].candidate].merge(taskSums[t]);
+    }
+
+    for (int c = 0; c < candidates.size(); ++c) {
+        BacktestScore score;
+        score.candidate = candidates[c];
+        score.name = candidateName(candidates[c]);
+
+        const ErrorSums& sums = candidateSums[c];
+        if (!invalidReasons[c].isEmpty()) {
+            score.isValid = false;
+            score.errorMessage = invalidReasons[c];
+        } else if (sums.points == 0) {
+            score.isValid = false;
+            score.errorMessage = sums.errorMessage.isEmpty() ? "没有可评估的预测" : sums.errorMessage;
+        } else {
+            score.folds = sums.folds;
+            score.points = sums.points;
+            score.mse = sums.sse / sums.points;
+            score.rmse = std::sqrt(score.mse);
+            score.mae = sums.sae / sums.points;
+            score.mape = sums.percentPoints > 0 ? 100.0 * sums.sape / sums.percentPoints
+                                                : std::numeric_limits<double>::quiet_NaN();
+            score.errorMessage = sums.errorMessage;
+        }
+        result.scores.append(score);
+    }
+
+    return result;
+}
+
+Core::TableData* Backtester::toTable(const BacktestResult& result)
+{
+    QVector<int> order(result.scores.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        const BacktestScore& left = result.scores[a];
+        const BacktestScore& right = result.scores[b];
+        if (left.isValid != right.isValid) {
+            return left.isValid;
+        }
+        return left.isValid && left.rmse < right.rmse;
+    });
+
+    const QStringList headers = {"模型", "起点数", "预测值个数", "RMSE", "MSE", "MAE", "MAPE(%)", "说明"};
+    auto* table = new Core::TableData(order.size(), headers.size());
+    for (int col = 0; col < headers.size(); ++col) {
+        table->setHeader(col, headers[col]);
+    }
+
+    for (int row = 0; row < order.size(); ++row) {
+        const BacktestScore& score = result.scores[order[row]];
+        QVector<QVariant> values(headers.size());
+        values[0] = score.name;
+        if (score.isValid) {
+            values[1] = score.folds;
+            values[2] = score.points;
+            values[3] = score.rmse;
+            values[4] = score.mse;
+            values[5] = score.mae;
+            values[6] = std::isfinite(score.mape) ? QVariant(score.mape) : QVariant();
+        }
+        values[7] = score.errorMessage;
+        table->setRow(row, values);
+    }
+    return table;
+}
+
+int Backtester::minimumTrainingSize(const BacktestCandidate& candidate)
+{
+    switch (candidate.method) {
+    case ForecastMethod::SimpleMovingAverage:       return std::max(1, candidate.window);
+    case ForecastMethod::WeightedMovingAverage:     return std::max(1, static_cast<int>(candidate.weights.size()));
+    case ForecastMethod::ExponentialSmoothing:      return 1;
+    case ForecastMethod::HoltLinear:                return 2;
+    case ForecastMethod::HoltWintersAdditive:
+        return static_cast<int>(SmoothingKernels::minimumLength(SmoothingModel::HoltWintersAdditive,
+                                                                candidate.seasonLength));
+    case ForecastMethod::HoltWintersMultiplicative:
+        return static_cast<int>(SmoothingKernels::minimumLength(SmoothingModel::HoltWintersMultiplicative,
+                                                                candidate.seasonLength));
+    case ForecastMethod::LinearRegression:          return 2;
+    }
+    return 1;
+}
+
+QString Backtester::candidateName(const BacktestCandidate& candidate)
+{
+    const SmoothingParameters& p = candidate.parameters;
+    switch (candidate.method) {
+    case ForecastMethod::SimpleMovingAverage:
+        return QString("简单移动平均（窗口 %1）").arg(candidate.window);
+    case ForecastMethod::WeightedMovingAverage:
+        return QString("加权移动平均（窗口 %1）").arg(candidate.weights.size());
+    case ForecastMethod::ExponentialSmoothing:
+        return QString("%1（α=%2）").arg(SmoothingOptimizer::modelName(SmoothingModel::Simple))
+                                    .arg(p.alpha, 0, 'f', 3);
+    case ForecastMethod::HoltLinear:
+        return QString("%1（α=%2, β=%3）").arg(SmoothingOptimizer::modelName(SmoothingModel::Holt))
+                                           .arg(p.alpha, 0, 'f', 3).arg(p.beta, 0, 'f', 3);
+    case ForecastMethod::HoltWintersAdditive:
+    case ForecastMethod::HoltWintersMultiplicative: {
+        SmoothingModel model = candidate.method == ForecastMethod::HoltWintersAdditive
+                                   ? SmoothingModel::HoltWintersAdditive
+                                   : SmoothingModel::HoltWintersMultiplicative;
+        return QString("%1（α=%2, β=%3, γ=%4, 周期 %5）").arg(SmoothingOptimizer::modelName(model))
+                                                         .arg(p.alpha, 0, 'f', 3).arg(p.beta, 0, 'f', 3)
+                                                         .arg(p.gamma, 0, 'f', 3).arg(candidate.seasonLength);
+    }
+    case ForecastMethod::LinearRegression:
+        return "线性回归";
+    }
+    return QString();
+}
+
+} // namespace Statistics
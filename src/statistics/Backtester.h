@@ -0,0 +1,114 @@
+#ifndef BACKTESTER_H
+#define BACKTESTER_H
+
+#include "StatisticTypes.h"
+#include "core/TableData.h"
+#include <QVector>
+#include <QString>
+
+namespace Statistics {
+
+/**
+ * @brief 回测训练窗口类型
+ */
+enum class BacktestWindow
+{
+    Expanding,      // 扩展窗口：训练集为起点之前的全部数据
+    Sliding         // 滑动窗口：训练集为起点之前固定长度的数据
+};
+
+/**
+ * @brief 参与回测的候选模型（预测方法 + 参数）
+ */
+struct BacktestCandidate
+{
+    ForecastMethod method = ForecastMethod::SimpleMovingAverage;
+    int window = 5;                     // 简单移动平均窗口
+    QVector<double> weights;            // 加权移动平均权重
+    SmoothingParameters parameters;     // 平滑系数
+    int seasonLength = 12;              // 季节周期（仅 Holt-Winters）
+};
+
+/**
+ * @brief 回测参数
+ */
+struct BacktestOptions
+{
+    BacktestWindow windowType = BacktestWindow::Expanding;
+    int trainingSize = 0;       // 扩展窗口的初始训练长度 / 滑动窗口长度（0 表示取数据量的一半）
+    int horizon = 1;            // 每个起点预测的期数
+    int step = 1;               // 相邻起点的间隔
+    int maxFolds = 0;           // 最多使用最近的多少个起点（0 表示不限）
+};
+
+/**
+ * @brief 单个候选模型的回测误差
+ */
+struct BacktestScore
+{
+    BacktestCandidate candidate;
+    QString name;               // 方法与参数的描述
+    int folds = 0;              // 参与评估的起点数
+    qint64 points = 0;          // 参与评估的预测值个数
+    double mse = 0.0;
+    double rmse = 0.0;
+    double mae = 0.0;
+    double mape = 0.0;          // 百分比，实际值为 0 的点不计入
+    bool isValid = true;
+    QString errorMessage;
+};
+
+/**
+ * @brief 回测结果
+ */
+struct BacktestResult
+{
+    QVector<BacktestScore> scores;      // 与候选模型顺序一致
+    int folds = 0;                      // 起点总数
+    bool isValid = true;
+    QString errorMessage;
+};
+
+/**
+ * @brief 滚动起点回测（时间序列交叉验证）
+ *
+ * 对每个候选模型，在一系列预测起点 t 上用 t 之前的数据训练、预测
+ * t 之后 horizon 期并与实际值比较，汇总 MSE/RMSE/MAE/MAPE。
+ *
+ * 扩展窗口下相邻起点的训练集只差 step 行，各模型以 OnlineForecaster
+ * 增量更新状态而不是重新拟合；每个模型的起点序列再切成若干段，
+ * 各段从头预热后并行执行（各段以及各模型之间互不共享可写数据，
+ * 按段顺序合并误差，结果与线程数无关）。滑动窗口下平滑模型的状态
+ * 依赖窗口起点，无法从上一折增量得到，每折只用窗口内数据重新拟合，
+ * 各折并行执行；移动平均只依赖最近 window 个值，两种窗口下都增量更新。
+ *
+ * 输入中的 NaN 跳过：不参与训练，作为实际值时不计入误差。
+ */
+class Backtester
+{
+public:
+    /**
+     * @brief 对若干候选模型执行回测
+     */
+    static BacktestResult run(const QVector<double>& data, const QVector<BacktestCandidate>& candidates,
+                              const BacktestOptions& options);
+
+    /**
+     * @brief 将回测结果整理为表格（每个候选模型一行，按 RMSE 升序），由调用方负责释放
+     */
+    static Core::TableData* toTable(const BacktestResult& result);
+
+    /**
+     * @brief 候选模型所需的最少训练数据个数
+     */
+    static int minimumTrainingSize(const BacktestCandidate& candidate);
+
+    /**
+     * @brief 候选模型的描述（方法名与参数）
+     */
+    static QString candidateName(const BacktestCandidate& candidate);
+};
+
+} // namespace Statistics
+
+#endif // BACKTESTER_H
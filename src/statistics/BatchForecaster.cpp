@@ -0,0 +1,231 @@
+#include "BatchForecaster.h"
+#include "CachedStatistics.h"
+#include "ParallelUtils.h"
+#include "SmoothingKernels.h"
+#include "core/ColumnDictionary.h"
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Statistics {
+
+namespace {
+
+const int FAILED_MODEL = -1;
+
+// 批量优化时每维的粗网格点数（比单序列默认值更粗，主要依靠 Nelder–Mead 细化）
+const int BATCH_GRID_STEPS = 5;
+
+/**
+ * 按序列长度和取值选择实际可用的模型
+ */
+SmoothingModel chooseModel(SmoothingModel requested, const double* y, qsizetype n, int seasonLength)
+{
+    SmoothingModel model = requested;
+
+    if (model == SmoothingModel::HoltWintersMultiplicative &&
+        std::any_of(y, y + n, [](double value) { return value <= 0.0; })) {
+        model = SmoothingModel::HoltWintersAdditive;
+    }
+    if (SmoothingKernels::isSeasonal(model) && n < SmoothingKernels::minimumLength(model, seasonLength)) {
+        model = SmoothingModel::Holt;
+    }
+    if (model == SmoothingModel::Holt && n < SmoothingKernels::minimumLength(model, seasonLength)) {
+        model = SmoothingModel::Simple;
+    }
+    return model;
+}
+
+} // namespace
+
+Core::TableData* BatchForecaster::forecastByGroup(const Core::TableData& table, int keyColumn, int valueColumn,
+                                                  const BatchForecastOptions& options,
+                                                  BatchForecastSummary* summary)
+{
+    if (keyColumn < 0 || keyColumn >= table.columnCount() ||
+        valueColumn < 0 || valueColumn >= table.columnCount()) {
+        qWarning() << "BatchForecaster: 列索引无效" << keyColumn << valueColumn;
+        return nullptr;
+    }
+
+    const bool seasonalModel = SmoothingKernels::isSeasonal(options.model);
+    if (options.forecastPeriods <= 0 || (seasonalModel && options.seasonLength < 2)) {
+        qWarning() << "BatchForecaster: 预测期数或季节周期无效";
+        return nullptr;
+    }
+
+    const auto dictionary = Core::ColumnDictionary::cached(table, keyColumn);
+    const auto values = CachedStatistics::values(table, valueColumn);
+    const int groups = dictionary->categoryCount();
+    const int rows = table.rowCount();
+
+    // === 按分组做计数排序，各组序列连续存放（保持行顺序） ===
+    QVector<qsizetype> offsets(groups + 1, 0);
+    for (int row = 0; row < rows; ++row) {
+        int code = dictionary->codes[row];
+        if (code != Core::ColumnDictionary::NULL_CODE && std::isfinite((*values)[row])) {
+            ++offsets[code + 1];
+        }
+    }
+    for (int g = 0; g < groups; ++g) {
+        offsets[g + 1] += offsets[g];
+    }
+
+    QVector<double> series(offsets[groups]);
+    QVector<qsizetype> cursor = offsets.mid(0, groups);
+    for (int row = 0; row < rows; ++row) {
+        int code = dictionary->codes[row];
+        double value = (*values)[row];
+        if (code != Core::ColumnDictionary::NULL_CODE && std::isfinite(value)) {
+            series[cursor[code]++] = value;
+        }
+    }
+
+    // === 结构数组状态：每个字段一个数组，季节项按组连续存放 ===
+    const int m = seasonalModel ? options.seasonLength : 1;
+    QVector<int> models(groups, FAILED_MODEL);
+    QVector<double> levels(groups, 0.0);
+    QVector<double> trends(groups, 0.0);
+    QVector<int> phases(groups, 0);
+    QVector<double> seasonals(static_cast<qsizetype>(groups) * m, 0.0);
+    QVector<double> alphas(groups, 0.0);
+    QVector<double> betas(groups, 0.0);
+    QVector<double> gammas(groups, 0.0);
+    QVector<double> errors(groups, std::numeric_limits<double>::quiet_NaN());
+
+    // 并行区内只按组下标写入各自的槽位
+    int* modelOut = models.data();
+    double* levelOut = levels.data();
+    double* trendOut = trends.data();
+    int* phaseOut = phases.data();
+    double* seasonalOut = seasonals.data();
+    double* alphaOut = alphas.data();
+    double* betaOut = betas.data();
+    double* gammaOut = gammas.data();
+    double* errorOut = errors.data();
+
+    Parallel::forChunks(groups, Parallel::chunkCount(groups, 16), [&](int, qsizetype begin, qsizetype end) {
+        for (qsizetype g = begin; g < end; ++g) {
+            const double* y = series.constData() + offsets[g];
+            const qsizetype n = offsets[g + 1] - offsets[g];
+            if (n == 0) {
+                continue;
+            }
+
+            SmoothingKernels::State state;
+            double* seasonal = seasonalOut + g * m;
+            SmoothingModel model = chooseModel(options.model, y, n, m);
+            SmoothingParameters parameters = options.parameters;
+
+            if (n == 1) {
+                // 单个观测：只能以该值作为水平外推
+                model = SmoothingModel::Simple;
+                state.level = y[0];
+            } else {
+                if (options.autoTune) {
+                    SmoothingFitOptions fitOptions;
+                    fitOptions.model = model;
+                    fitOptions.seasonLength = m;
+                    fitOptions.criterion = options.criterion;
+                    fitOptions.parallel = false;   // 外层已按组并行
+                    fitOptions.gridSteps = BATCH_GRID_STEPS;
+
+                    SmoothingFitResult fit = SmoothingOptimizer::optimize(QVector<double>(y, y + n), fitOptions);
+                    if (fit.isValid) {
+                        parameters = fit.parameters;
+                    }
+                }
+
+                qsizetype start = SmoothingKernels::initialize(y, model, m, state, seasonal);
+                double sse = SmoothingKernels::run<SmoothingKernels::SquaredLoss>(
+                    y, start, n, model, parameters, m, state, seasonal);
+
+                if (!std::isfinite(sse) && model != SmoothingModel::Simple) {
+                    // 乘法/趋势模型发散时退回简单指数平滑
+                    model = SmoothingModel::Simple;
+                    start = SmoothingKernels::initialize(y, model, m, state, seasonal);
+                    sse = SmoothingKernels::run<SmoothingKernels::SquaredLoss>(
+                        y, start, n, model, parameters, m, state, seasonal);
+                }
+                errorOut[g] = sse / (n - start);
+            }
+
+            modelOut[g] = static_cast<int>(model);
+            levelOut[g] = state.level;
+            trendOut[g] = state.trend;
+            phaseOut[g] = state.phase;
+            alphaOut[g] = parameters.alpha;
+            betaOut[g] = model == SmoothingModel::Simple ? 0.0 : parameters.beta;
+            gammaOut[g] = SmoothingKernels::isSeasonal(model) ? parameters.gamma : 0.0;
+        }
+    });
+
+    // === 由各组状态外推并组装长表 ===
+    BatchForecastSummary stats;
+    stats.groupCount = groups;
+
+    int fitted = 0;
+    for (int g = 0; g < groups; ++g) {
+        if (models[g] == FAILED_MODEL) {
+            ++stats.failedCount;
+            continue;
+        }
+        ++fitted;
+        if (models[g] != static_cast<int>(options.model)) {
+            ++stats.fallbackCount;
+        }
+    }
+
+    const int periods = options.forecastPeriods;
+    const int outputRows = fitted * periods;
+    QVector<QVariant> keyColumnOut, stepColumn, forecastColumn, modelColumn;
+    QVector<QVariant> alphaColumn, betaColumn, gammaColumn, errorColumn;
+    for (QVector<QVariant>* column : {&keyColumnOut, &stepColumn, &forecastColumn, &modelColumn,
+                                      &alphaColumn, &betaColumn, &gammaColumn, &errorColumn}) {
+        column->reserve(outputRows);
+    }
+
+    for (int g = 0; g < groups; ++g) {
+        if (models[g] == FAILED_MODEL) {
+            continue;
+        }
+
+        auto model = static_cast<SmoothingModel>(models[g]);
+        SmoothingKernels::State state;
+        state.level = levels[g];
+        state.trend = trends[g];
+        state.phase = phases[g];
+        const double* seasonal = seasonals.constData() + static_cast<qsizetype>(g) * m;
+        const QString label = dictionary->labels[g];
+        const QString modelText = SmoothingOptimizer::modelName(model);
+        const QVariant error = std::isfinite(errors[g]) ? QVariant(errors[g]) : QVariant();
+
+        for (int h = 1; h <= periods; ++h) {
+            keyColumnOut.append(label);
+            stepColumn.append(h);
+            forecastColumn.append(SmoothingKernels::forecast(model, state, seasonal, m, h));
+            modelColumn.append(modelText);
+            alphaColumn.append(alphas[g]);
+            betaColumn.append(betas[g]);
+            gammaColumn.append(gammas[g]);
+            errorColumn.append(error);
+        }
+    }
+
+    auto* result = new Core::TableData(outputRows, 8);
+    const QStringList headers = {table.header(keyColumn), "预测期", "预测值", "模型", "α", "β", "γ", "拟合MSE"};
+    const QVector<QVariant>* columns[] = {&keyColumnOut, &stepColumn, &forecastColumn, &modelColumn,
+                                          &alphaColumn, &betaColumn, &gammaColumn, &errorColumn};
+    for (int col = 0; col < 8; ++col) {
+        result->setHeader(col, headers[col]);
+        result->setColumn(col, *columns[col]);
+    }
+
+    if (summary) {
+        *summary = stats;
+    }
+    return result;
+}
+
+} // namespace Statistics
@@ -0,0 +1,63 @@
+#ifndef BATCHFORECASTER_H
+#define BATCHFORECASTER_H
+
+#include "StatisticTypes.h"
+#include "SmoothingOptimizer.h"
+#include "core/TableData.h"
+#include <QString>
+
+namespace Statistics {
+
+/**
+ * @brief 分组批量预测参数
+ */
+struct BatchForecastOptions
+{
+    SmoothingModel model = SmoothingModel::HoltWintersAdditive;
+    int seasonLength = 12;                  // 季节周期（仅季节模型）
+    int forecastPeriods = 12;               // 每组预测期数
+    SmoothingParameters parameters;         // 固定平滑系数（autoTune 为 false 时使用）
+    bool autoTune = false;                  // 是否为每组单独优化平滑系数
+    FitCriterion criterion = FitCriterion::MSE;
+};
+
+/**
+ * @brief 分组批量预测统计
+ */
+struct BatchForecastSummary
+{
+    int groupCount = 0;         // 分组数
+    int fallbackCount = 0;      // 因数据不足或含非正值而降级为较简单模型的分组数
+    int failedCount = 0;        // 有效数据不足 1 个而无法预测的分组数
+};
+
+/**
+ * @brief 分组批量预测
+ *
+ * 按分组列把数值列拆成多条序列（行顺序即时间顺序），为每组各拟合一个
+ * 指数平滑模型并外推。各组的序列连续存放在同一数组中，平滑状态
+ * （水平、趋势、季节项、误差）按"结构数组"布局集中存放，各组在线程池
+ * 中并行拟合，互不共享可写数据。
+ *
+ * 数据不足以支撑所选模型的分组自动降级（季节 → Holt → 简单指数平滑），
+ * 乘法季节模型遇到非正值时降级为加法季节模型。
+ */
+class BatchForecaster
+{
+public:
+    /**
+     * @brief 对每个分组拟合模型并预测
+     * @param keyColumn 分组列
+     * @param valueColumn 数值列（NaN 跳过）
+     * @param summary 可选的统计输出
+     * @return 长表格式的预测结果（分组、预测期、预测值、模型、α、β、γ、拟合 MSE），
+     *         由调用方负责释放；参数无效时返回 nullptr
+     */
+    static Core::TableData* forecastByGroup(const Core::TableData& table, int keyColumn, int valueColumn,
+                                            const BatchForecastOptions& options,
+                                            BatchForecastSummary* summary = nullptr);
+};
+
+} // namespace Statistics
+
+#endif // BATCHFORECASTER_H
@@ -0,0 +1,385 @@
+#include "Bootstrap.h"
+#include "ParallelUtils.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace Statistics {
+
+namespace {
+
+// 分层近似的最多层数与每层最少元素数
+const int MAX_STRATA = 256;
+const qsizetype MIN_STRATUM_SIZE = 64;
+
+// 逐点重抽样时每批生成的下标个数（先批量生成下标，再顺序累加）
+const int INDEX_BLOCK = 256;
+
+/**
+ * 一层数据 d 与 d² 的均值及 (d, d²) 协方差矩阵的 Cholesky 因子
+ */
+struct Stratum
+{
+    qsizetype size = 0;
+    double mean1 = 0.0;
+    double mean2 = 0.0;
+    double l11 = 0.0;
+    double l21 = 0.0;
+    double l22 = 0.0;
+};
+
+/**
+ * 由重抽样样本的个数、Σd、Σd² 得到统计量（d 为减去 shift 后的值）
+ */
+double momentStatistic(BootstrapStatistic statistic, double count, double s1, double s2, double shift)
+{
+    if (statistic == BootstrapStatistic::Mean) {
+        return shift + s1 / count;
+    }
+    if (count < 2.0) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return std::sqrt(std::max(0.0, (s2 - s1 * s1 / count) / (count - 1.0)));
+}
+
+void exactMomentReplicates(const QVector<double>& centered, double shift, BootstrapStatistic statistic,
+                           const BootstrapOptions& options, double* out)
+{
+    const qsizetype n = centered.size();
+    const double* d = centered.constData();
+    const int resamples = options.resamples;
+
+    Parallel::forChunks(resamples, Parallel::chunkCount(resamples, 1), [&](int, qsizetype begin, qsizetype end) {
+        qsizetype index[INDEX_BLOCK];
+        for (qsizetype r = begin; r < end; ++r) {
+            RandomStream rng(options.seed, static_cast<quint64>(r));
+            double s1 = 0.0;
+            double s2 = 0.0;
+
+            for (qsizetype done = 0; done < n; done += INDEX_BLOCK) {
+                const int count = static_cast<int>(std::min<qsizetype>(INDEX_BLOCK, n - done));
+                for (int k = 0; k < count; ++k) {
+                    index[k] = static_cast<qsizetype>(rng.bounded(static_cast<quint64>(n)));
+                }
+                for (int k = 0; k < count; ++k) {
+                    double v = d[index[k]];
+                    s1 += v;
+                    s2 += v * v;
+                }
+            }
+            out[r] = momentStatistic(statistic, static_cast<double>(n), s1, s2, shift);
+        }
+    });
+}
+
+void stratifiedMomentReplicates(const QVector<double>& centered, double shift, BootstrapStatistic statistic,
+                                const BootstrapOptions& options, double* out)
+{
+    const qsizetype n = centered.size();
+    const int strata = static_cast<int>(std::clamp<qsizetype>(n / MIN_STRATUM_SIZE, 1, MAX_STRATA));
+
+    // 升序数据等分成层，层内取值范围窄，层内和的正态近似足够准确
+    QVector<Stratum> layers(strata);
+    for (int j = 0; j < strata; ++j) {
+        qsizetype begin = n * j / strata;
+        qsizetype end = n * (j + 1) / strata;
+        Stratum& layer = layers[j];
+        layer.size = end - begin;
+
+        double m1 = 0.0, m2 = 0.0;
+        for (qsizetype i = begin; i < end; ++i) {
+            double v = centered[i];
+            m1 += v;
+            m2 += v * v;
+        }
+        m1 /= layer.size;
+        m2 /= layer.size;
+
+        double v11 = 0.0, v12 = 0.0, v22 = 0.0;
+        for (qsizetype i = begin; i < end; ++i) {
+            double a = centered[i] - m1;
+            double b = centered[i] * centered[i] - m2;
+            v11 += a * a;
+            v12 += a * b;
+            v22 += b * b;
+        }
+        v11 /= layer.size;
+        v12 /= layer.size;
+        v22 /= layer.size;
+
+        layer.mean1 = m1;
+        layer.mean2 = m2;
+        layer.l11 = std::sqrt(v11);
+        layer.l21 = layer.l11 > 0.0 ? v12 / layer.l11 : 0.0;
+        layer.l22 = std::sqrt(std::max(0.0, v22 - layer.l21 * layer.l21));
+    }
+
+    const qsizetype smallSize = n / strata;
+    const int resamples = options.resamples;
+
+    Parallel::forChunks(resamples, Parallel::chunkCount(resamples, 16), [&](int, qsizetype begin, qsizetype end) {
+        for (qsizetype r = begin; r < end; ++r) {
+            RandomStream rng(options.seed, static_cast<quint64>(r));
+            std::normal_distribution<double> normal;
+            // 各层大小只有 ⌊n/层数⌋ 与 ⌈n/层数⌉ 两种
+            std::poisson_distribution<qint64> smallCount(static_cast<double>(smallSize));
+            std::poisson_distribution<qint64> largeCount(static_cast<double>(smallSize + 1));
+
+            double total = 0.0;
+            double s1 = 0.0;
+            double s2 = 0.0;
+            for (const Stratum& layer : layers) {
+                qint64 c = layer.size == smallSize ? smallCount(rng) : largeCount(rng);
+                if (c == 0) {
+                    continue;
+                }
+                double root = std::sqrt(static_cast<double>(c));
+                double z1 = normal(rng);
+                double z2 = normal(rng);
+                total += c;
+                s1 += c * layer.mean1 + root * layer.l11 * z1;
+                s2 += c * layer.mean2 + root * (layer.l21 * z1 + layer.l22 * z2);
+            }
+            out[r] = total > 0.0 ? momentStatistic(statistic, total, s1, s2, shift)
+                                 : std::numeric_limits<double>::quiet_NaN();
+        }
+    });
+}
+
+void orderStatisticReplicates(const QVector<double>& sorted, double p, const BootstrapOptions& options,
+                              double* out)
+{
+    const qsizetype n = sorted.size();
+    const double* s = sorted.constData();
+    const double h = p * (n - 1);
+    const qsizetype lower = std::min<qsizetype>(n - 1, static_cast<qsizetype>(std::floor(h)));
+    const double weight = h - lower;
+    const double k = static_cast<double>(lower + 1);     // 1 起的次序
+    const int resamples = options.resamples;
+
+    auto indexOf = [n](double u) {
+        return std::min<qsizetype>(n - 1, static_cast<qsizetype>(u * n));
+    };
+
+    Parallel::forChunks(resamples, Parallel::chunkCount(resamples, 64), [&](int, qsizetype begin, qsizetype end) {
+        for (qsizetype r = begin; r < end; ++r) {
+            RandomStream rng(options.seed, static_cast<quint64>(r));
+
+            // U(k) ~ Beta(k, n-k+1)
+            std::gamma_distribution<double> gammaA(k, 1.0);
+            std::gamma_distribution<double> gammaB(n - k + 1.0, 1.0);
+            double a = gammaA(rng);
+            double b = gammaB(rng);
+            double u = a / (a + b);
+            double value = s[indexOf(u)];
+
+            if (weight > 0.0 && lower + 1 < n) {
+                // U(k+1) 为 (U(k), 1) 上 n-k 个均匀数的最小值
+                double v = 1.0 - std::pow(1.0 - rng.uniform(), 1.0 / (n - k));
+                double next = s[indexOf(u + (1.0 - u) * v)];
+                value = value * (1.0 - weight) + next * weight;
+            }
+            out[r] = value;
+        }
+    });
+}
+
+QVector<double> finiteSorted(const QVector<double>& data)
+{
+    QVector<double> values;
+    values.reserve(data.size());
+    for (double value : data) {
+        if (std::isfinite(value)) {
+            values.append(value);
+        }
+    }
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+BootstrapInterval invalid(const QString& message)
+{
+    BootstrapInterval result;
+    result.errorMessage = message;
+    return result;
+}
+
+} // namespace
+
+// === 常用统计量 ===
+
+BootstrapInterval Bootstrap::interval(const QVector<double>& data, BootstrapStatistic statistic,
+                                      const BootstrapOptions& options, double percentile)
+{
+    return intervalSorted(finiteSorted(data), statistic, options, percentile);
+}
+
+BootstrapInterval Bootstrap::intervalSorted(const QVector<double>& sortedData, BootstrapStatistic statistic,
+                                            const BootstrapOptions& options, double percentile)
+{
+    const qsizetype n = sortedData.size();
+    if (n == 0) {
+        return invalid("没有有效数据");
+    }
+    if (options.resamples < 1) {
+        return invalid("重抽样次数至少为 1");
+    }
+    if (!(options.confidence > 0.0 && options.confidence < 1.0)) {
+        return invalid("置信水平必须在 0 到 1 之间");
+    }
+    if (statistic == BootstrapStatistic::Quantile && !(percentile >= 0.0 && percentile <= 100.0)) {
+        return invalid("分位数必须在0-100之间");
+    }
+    if (statistic == BootstrapStatistic::StandardDeviation && n < 2) {
+        return invalid("样本量至少需要2个");
+    }
+
+    QVector<double> replicates(options.resamples);
+    double estimate = 0.0;
+    bool approximate = false;
+
+    switch (statistic) {
+    case BootstrapStatistic::Median:
+    case BootstrapStatistic::Quantile: {
+        double p = statistic == BootstrapStatistic::Median ? 0.5 : percentile / 100.0;
+        estimate = sortedQuantile(sortedData.constData(), n, p);
+        orderStatisticReplicates(sortedData, p, options, replicates.data());
+        break;
+    }
+
+    case BootstrapStatistic::Mean:
+    case BootstrapStatistic::StandardDeviation: {
+        // 减去均值后再累加平方和，避免大偏移量下的抵消误差
+        double shift = 0.0;
+        for (double value : sortedData) {
+            shift += value;
+        }
+        shift /= n;
+
+        QVector<double> centered(n);
+        double s1 = 0.0, s2 = 0.0;
+        for (qsizetype i = 0; i < n; ++i) {
+            centered[i] = sortedData[i] - shift;
+            s1 += centered[i];
+            s2 += centered[i] * centered[i];
+        }
+        estimate = momentStatistic(statistic, static_cast<double>(n), s1, s2, shift);
+
+        if (static_cast<double>(n) * options.resamples <= static_cast<double>(options.exactBudget)) {
+            exactMomentReplicates(centered, shift, statistic, options, replicates.data());
+        } else {
+            stratifiedMomentReplicates(centered, shift, statistic, options, replicates.data());
+            approximate = true;
+        }
+        break;
+    }
+    }
+
+    BootstrapInterval result = fromReplicates(estimate, replicates, options.confidence);
+    result.approximate = approximate;
+    return result;
+}
+
+// === 任意统计量 ===
+
+BootstrapInterval Bootstrap::interval(const QVector<double>& data, const Statistic& statistic,
+                                      const BootstrapOptions& options)
+{
+    QVector<double> values;
+    values.reserve(data.size());
+    for (double value : data) {
+        if (std::isfinite(value)) {
+            values.append(value);
+        }
+    }
+
+    const qsizetype n = values.size();
+    if (n == 0) {
+        return invalid("没有有效数据");
+    }
+    if (options.resamples < 1) {
+        return invalid("重抽样次数至少为 1");
+    }
+    if (!(options.confidence > 0.0 && options.confidence < 1.0)) {
+        return invalid("置信水平必须在 0 到 1 之间");
+    }
+
+    const int resamples = options.resamples;
+    QVector<double> replicates(resamples);
+    double* out = replicates.data();
+
+    Parallel::forChunks(resamples, Parallel::chunkCount(resamples, 1), [&](int, qsizetype begin, qsizetype end) {
+        QVector<double> sample(n);    // 每块复用一个缓冲区
+        for (qsizetype r = begin; r < end; ++r) {
+            RandomStream rng(options.seed, static_cast<quint64>(r));
+            for (qsizetype i = 0; i < n; ++i) {
+                sample[i] = values[rng.bounded(static_cast<quint64>(n))];
+            }
+            out[r] = statistic(sample);
+        }
+    });
+
+    return fromReplicates(statistic(values), replicates, options.confidence);
+}
+
+// === 辅助函数 ===
+
+BootstrapInterval Bootstrap::fromReplicates(double estimate, QVector<double> replicates, double confidence)
+{
+    replicates.erase(std::remove_if(replicates.begin(), replicates.end(),
+                                    [](double value) { return !std::isfinite(value); }),
+                     replicates.end());
+    if (replicates.isEmpty()) {
+        return invalid("重抽样统计量均无效");
+    }
+
+    std::sort(replicates.begin(), replicates.end());
+    const qsizetype count = replicates.size();
+    const double tail = (1.0 - confidence) / 2.0;
+
+    double mean = 0.0;
+    for (double value : replicates) {
+        mean += value;
+    }
+    mean /= count;
+    double squares = 0.0;
+    for (double value : replicates) {
+        squares += (value - mean) * (value - mean);
+    }
+
+    BootstrapInterval result;
+    result.estimate = estimate;
+    result.lower = sortedQuantile(replicates.constData(), count, tail);
+    result.upper = sortedQuantile(replicates.constData(), count, 1.0 - tail);
+    result.standardError = count > 1 ? std::sqrt(squares / (count - 1)) : 0.0;
+    result.resamples = static_cast<int>(count);
+    result.isValid = true;
+    return result;
+}
+
+double Bootstrap::sortedQuantile(const double* sorted, qsizetype n, double p)
+{
+    double index = p * (n - 1);
+    qsizetype lower = static_cast<qsizetype>(std::floor(index));
+    qsizetype upper = static_cast<qsizetype>(std::ceil(index));
+    double weight = index - lower;
+
+    if (upper >= n) {
+        return sorted[n - 1];
+    }
+    return sorted[lower] * (1.0 - weight) + sorted[upper] * weight;
+}
+
+QString Bootstrap::statisticName(BootstrapStatistic statistic)
+{
+    switch (statistic) {
+    case BootstrapStatistic::Mean:              return "均值";
+    case BootstrapStatistic::Median:            return "中位数";
+    case BootstrapStatistic::Quantile:          return "分位数";
+    case BootstrapStatistic::StandardDeviation: return "标准差";
+    }
+    return QString();
+}
+
+} // namespace Statistics
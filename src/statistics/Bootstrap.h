@@ -0,0 +1,164 @@
+#ifndef BOOTSTRAP_H
+#define BOOTSTRAP_H
+
+#include <QVector>
+#include <QString>
+#include <functional>
+
+namespace Statistics {
+
+/**
+ * @brief 可复现的随机数流（xoshiro256**）
+ *
+ * 由 (种子, 流编号) 经 SplitMix64 生成初始状态，不同流之间互不相关。
+ * 自助法按重抽样（或模拟路径）编号分配流，结果与线程数和调度顺序无关。
+ * 满足 UniformRandomBitGenerator 要求，可配合 <random> 中的分布使用。
+ */
+class RandomStream
+{
+public:
+    using result_type = quint64;
+
+    RandomStream(quint64 seed, quint64 stream)
+    {
+        quint64 x = seed ^ (stream * 0xD1B54A32D192ED03ULL);
+        for (quint64& word : m_state) {
+            x += 0x9E3779B97F4A7C15ULL;
+            quint64 z = x;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~result_type(0); }
+
+    result_type operator()()
+    {
+        const quint64 result = rotl(m_state[1] * 5, 7) * 9;
+        const quint64 t = m_state[1] << 17;
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= t;
+        m_state[3] = rotl(m_state[3], 45);
+        return result;
+    }
+
+    /**
+     * @brief [0, 1) 上的均匀分布
+     */
+    double uniform() { return static_cast<double>((*this)() >> 11) * (1.0 / 9007199254740992.0); }
+
+    /**
+     * @brief [0, range) 上的均匀整数（range 不超过 2^53 时偏差可忽略）
+     */
+    quint64 bounded(quint64 range)
+    {
+        quint64 value = static_cast<quint64>(uniform() * static_cast<double>(range));
+        return value < range ? value : range - 1;
+    }
+
+private:
+    static quint64 rotl(quint64 x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    quint64 m_state[4];
+};
+
+/**
+ * @brief 自助法统计量
+ */
+enum class BootstrapStatistic
+{
+    Mean,               // 均值
+    Median,             // 中位数
+    Quantile,           // 分位数（线性插值，同 DescriptiveStats::quantile）
+    StandardDeviation   // 样本标准差
+};
+
+/**
+ * @brief 自助法参数
+ */
+struct BootstrapOptions
+{
+    int resamples = 2000;                   // 重抽样次数
+    double confidence = 0.95;               // 置信水平
+    quint64 seed = 0x5EED5EEDULL;           // 随机种子（相同种子结果相同）
+    qint64 exactBudget = qint64(1) << 27;   // 均值/标准差逐点重抽样的最大抽样总数（n × 次数）
+};
+
+/**
+ * @brief 自助法置信区间
+ */
+struct BootstrapInterval
+{
+    double estimate = 0.0;          // 原样本上的统计量
+    double lower = 0.0;             // 区间下限（百分位法）
+    double upper = 0.0;             // 区间上限
+    double standardError = 0.0;     // 重抽样统计量的标准差
+    int resamples = 0;
+    bool approximate = false;       // 是否使用了分层近似（见 Bootstrap）
+    bool isValid = false;
+    QString errorMessage;
+};
+
+/**
+ * @brief 自助法（Bootstrap）置信区间
+ *
+ * 各次重抽样在线程池中并行执行，第 r 次重抽样使用编号为 r 的随机数流，
+ * 相同种子下结果可复现。针对常用统计量避免逐点重抽样：
+ * - 中位数/分位数：重抽样样本的第 k 个次序统计量对应原样本升序序列中
+ *   下标 ⌊n·U(k)⌋ 的值，U(k) ~ Beta(k, n−k+1)，每次重抽样只需 O(1)
+ *   次随机数（结果与逐点重抽样同分布）
+ * - 均值/标准差：n × 次数不超过 exactBudget 时逐点重抽样；否则把升序
+ *   数据等分为若干层，每层的抽中个数取泊松分布，层内和按正态近似
+ *   （泊松自助法 + 分层中心极限定理），每次重抽样只需 O(层数)
+ *
+ * 百万级数据做一万次重抽样也只需亚秒级时间。
+ */
+class Bootstrap
+{
+public:
+    using Statistic = std::function<double(const QVector<double>&)>;
+
+    /**
+     * @brief 常用统计量的置信区间
+     * @param data 样本（NaN 跳过）
+     * @param percentile 分位数（0-100，仅 Quantile 使用）
+     */
+    static BootstrapInterval interval(const QVector<double>& data, BootstrapStatistic statistic,
+                                      const BootstrapOptions& options = BootstrapOptions(),
+                                      double percentile = 50.0);
+
+    /**
+     * @brief 同上，输入为已剔除 NaN 的升序数据（可直接使用 CachedStatistics::sortedValues）
+     */
+    static BootstrapInterval intervalSorted(const QVector<double>& sortedData, BootstrapStatistic statistic,
+                                            const BootstrapOptions& options = BootstrapOptions(),
+                                            double percentile = 50.0);
+
+    /**
+     * @brief 任意统计量的置信区间（逐点重抽样，每次 O(n) 加上统计量本身的开销）
+     * @param statistic 作用于一次重抽样样本的函数，会被多个线程同时调用
+     */
+    static BootstrapInterval interval(const QVector<double>& data, const Statistic& statistic,
+                                      const BootstrapOptions& options = BootstrapOptions());
+
+    /**
+     * @brief 由重抽样统计量计算百分位区间与标准误
+     */
+    static BootstrapInterval fromReplicates(double estimate, QVector<double> replicates, double confidence);
+
+    /**
+     * @brief 升序数据的线性插值分位数（p 取值 [0, 1]）
+     */
+    static double sortedQuantile(const double* sorted, qsizetype n, double p);
+
+    static QString statisticName(BootstrapStatistic statistic);
+};
+
+} // namespace Statistics
+
+#endif // BOOTSTRAP_H
@@ -0,0 +1,135 @@
+#include "CachedStatistics.h"
+#include "DescriptiveStats.h"
+#include "core/ResultCache.h"
+#include <algorithm>
+
+namespace Statistics {
+
+namespace {
+
+qint64 vectorCost(const QVector<double>& values)
+{
+    return values.size() * static_cast<qint64>(sizeof(double));
+}
+
+QString histogramParams(const HistogramOptions& options)
+{
+    auto optionalText = [](const std::optional<double>& value) {
+        return value ? QString::number(*value, 'g', 17) : QString("auto");
+    };
+
+    return QString("%1;%2;%3;%4;%5;%6;%7;%8")
+        .arg(static_cast<int>(options.method))
+        .arg(options.binCount)
+        .arg(options.binWidth, 0, 'g', 17)
+        .arg(optionalText(options.minValue))
+        .arg(optionalText(options.maxValue))
+        .arg(options.computeDensity ? 1 : 0)
+        .arg(options.densityPoints)
+        .arg(options.bandwidth, 0, 'g', 17);
+}
+
+QString bootstrapParams(BootstrapStatistic statistic, const BootstrapOptions& options, double percentile)
+{
+    return QString("%1;%2;%3;%4;%5;%6")
+        .arg(static_cast<int>(statistic))
+        .arg(options.resamples)
+        .arg(options.confidence, 0, 'g', 17)
+        .arg(options.seed)
+        .arg(options.exactBudget)
+        .arg(percentile, 0, 'g', 17);
+}
+
+} // namespace
+
+QSharedPointer<const QVector<double>> CachedStatistics::values(const Core::TableData& table, int column)
+{
+    return Core::ResultCache::instance().getOrCompute<QVector<double>>(
+        Core::ResultCache::makeKey(table, column, "values"),
+        [&]() { return table.toDoubleVector(column); },
+        vectorCost);
+}
+
+void CachedStatistics::storeValues(const Core::TableData& table, int column, const QVector<double>& values)
+{
+    QSharedPointer<const QVector<double>> value(new QVector<double>(values));
+    Core::ResultCache::instance().insert(Core::ResultCache::makeKey(table, column, "values"), value, vectorCost(values));
+}
+
+QSharedPointer<const QVector<double>> CachedStatistics::sortedValues(const Core::TableData& table, int column)
+{
+    return Core::ResultCache::instance().getOrCompute<QVector<double>>(
+        Core::ResultCache::makeKey(table, column, "sorted"),
+        [&]() {
+            QVector<double> sorted;
+            const auto data = values(table, column);
+            sorted.reserve(data->size());
+            for (double value : *data) {
+                if (qIsFinite(value)) {
+                    sorted.append(value);
+                }
+            }
+            std::sort(sorted.begin(), sorted.end());
+            return sorted;
+        },
+        vectorCost);
+}
+
+QSharedPointer<const DescriptiveSummary> CachedStatistics::summary(const Core::TableData& table, int column)
+{
+    return Core::ResultCache::instance().getOrCompute<DescriptiveSummary>(
+        Core::ResultCache::makeKey(table, column, "summary"),
+        [&]() { return DescriptiveStats::summarize(*values(table, column)); },
+        [](const DescriptiveSummary& summary) {
+            return static_cast<qint64>(sizeof(DescriptiveSummary)) +
+                   summary.topValues.size() * static_cast<qint64>(sizeof(FrequencyItem) + 32);
+        });
+}
+
+QSharedPointer<const HistogramResult> CachedStatistics::histogram(const Core::TableData& table, int column,
+                                                                  const HistogramOptions& options)
+{
+    return Core::ResultCache::instance().getOrCompute<HistogramResult>(
+        Core::ResultCache::makeKey(table, column, "histogram", histogramParams(options)),
+        [&]() { return Histogram::compute(*values(table, column), options); },
+        [](const HistogramResult& result) {
+            qint64 doubles = result.edges.size() + result.density.size() +
+                             result.densityX.size() + result.densityY.size();
+            return static_cast<qint64>(sizeof(HistogramResult)) +
+                   doubles * static_cast<qint64>(sizeof(double)) +
+                   result.counts.size() * static_cast<qint64>(sizeof(qint64));
+        });
+}
+
+QSharedPointer<const BootstrapInterval> CachedStatistics::bootstrapInterval(const Core::TableData& table, int column,
+                                                                           BootstrapStatistic statistic,
+                                                                           const BootstrapOptions& options,
+                                                                           double percentile)
+{
+    return Core::ResultCache::instance().getOrCompute<BootstrapInterval>(
+        Core::ResultCache::makeKey(table, column, "bootstrap", bootstrapParams(statistic, options, percentile)),
+        [&]() { return Bootstrap::intervalSorted(*sortedValues(table, column), statistic, options, percentile); },
+        [](const BootstrapInterval& interval) {
+            return static_cast<qint64>(sizeof(BootstrapInterval)) + interval.errorMessage.size() * 2;
+        });
+}
+
+StatisticResult CachedStatistics::quantile(const Core::TableData& table, int column, double p)
+{
+    if (p < 0.0 || p > 1.0) {
+        return StatisticResult::error("分位数必须在 [0, 1] 之间");
+    }
+
+    const auto sorted = sortedValues(table, column);
+    if (sorted->isEmpty()) {
+        return StatisticResult::error("没有有效数据");
+    }
+
+    double index = p * (sorted->size() - 1);
+    qsizetype lower = static_cast<qsizetype>(index);
+    qsizetype upper = std::min<qsizetype>(lower + 1, sorted->size() - 1);
+    double weight = index - lower;
+    return StatisticResult::ok((*sorted)[lower] * (1.0 - weight) + (*sorted)[upper] * weight);
+}
+
+} // namespace Statistics
@@ -0,0 +1,68 @@
+#ifndef CACHEDSTATISTICS_H
+#define CACHEDSTATISTICS_H
+
+#include "StatisticTypes.h"
+#include "Histogram.h"
+#include "Bootstrap.h"
+#include "core/TableData.h"
+#include <QSharedPointer>
+#include <QVector>
+
+namespace Statistics {
+
+/**
+ * @brief 带缓存的列统计
+ *
+ * 对同一列（且列未被修改）重复请求时直接返回 Core::ResultCache 中的结果，
+ * 避免重新转换整列数据和重复计算。
+ */
+class CachedStatistics
+{
+public:
+    /**
+     * @brief 列的数值数据（同 TableData::toDoubleVector）
+     */
+    static QSharedPointer<const QVector<double>> values(const Core::TableData& table, int column);
+
+    /**
+     * @brief 把已知的列数值放入缓存（如只重新读取了被修改的行），之后 values() 不必再整列转换
+     *
+     * 数值须与 TableData::toDoubleVector 的结果一致。
+     */
+    static void storeValues(const Core::TableData& table, int column, const QVector<double>& values);
+
+    /**
+     * @brief 列的有效数值升序副本（用于分位数等）
+     */
+    static QSharedPointer<const QVector<double>> sortedValues(const Core::TableData& table, int column);
+
+    /**
+     * @brief 列的描述性统计汇总
+     */
+    static QSharedPointer<const DescriptiveSummary> summary(const Core::TableData& table, int column);
+
+    /**
+     * @brief 列的直方图
+     */
+    static QSharedPointer<const HistogramResult> histogram(const Core::TableData& table, int column,
+                                                           const HistogramOptions& options);
+
+    /**
+     * @brief 列的自助法置信区间（基于升序副本）
+     *
+     * 重抽样的开销远大于其他统计量，缓存后重新打开对话框不必再次计算。
+     */
+    static QSharedPointer<const BootstrapInterval> bootstrapInterval(const Core::TableData& table, int column,
+                                                                     BootstrapStatistic statistic,
+                                                                     const BootstrapOptions& options,
+                                                                     double percentile = 50.0);
+
+    /**
+     * @brief 基于升序副本的分位数（线性插值，p 取值 [0, 1]）
+     */
+    static StatisticResult quantile(const Core::TableData& table, int column, double p);
+};
+
+} // namespace Statistics
+
+#endif // CACHEDSTATISTICS_H
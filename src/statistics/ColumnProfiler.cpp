@@ -0,0 +1,330 @@
+#include "ColumnProfiler.h"
+#include "ParallelUtils.h"
+#include <QHash>
+#include <QAtomicInt>
+#include <QMetaType>
+#include <QtMath>
+#include <algorithm>
+#include <limits>
+#include <memory>
+
+namespace Statistics {
+
+namespace {
+
+// HyperLogLog 寄存器位数（2^10 = 1024 个寄存器，标准误差约 3.2%）
+const int HLL_PRECISION = 10;
+const int HLL_REGISTERS = 1 << HLL_PRECISION;
+
+// 每个行块最多跟踪的不同取值个数（用于高频值统计）
+const int MAX_TRACKED_VALUES = 1024;
+
+// 每个行块的最小行数
+const qsizetype MIN_ROWS_PER_CHUNK = 16384;
+
+quint64 mixHash(quint64 x)
+{
+    // splitmix64 终结函数，使低质量哈希的各位分布均匀
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+/**
+ * @brief 单个行块的局部统计状态
+ */
+struct PartialProfile
+{
+    int nullCount = 0;
+    int numericCount = 0;
+    int textCount = 0;
+
+    // Welford 在线均值/方差
+    double mean = 0.0;
+    double m2 = 0.0;
+    double min = std::numeric_limits<double>::max();
+    double max = std::numeric_limits<double>::lowest();
+
+    QVector<double> numericValues;
+    QVector<quint8> registers;
+    QHash<QString, int> frequency;
+
+    void addNumeric(double value)
+    {
+        ++numericCount;
+        double delta = value - mean;
+        mean += delta / numericCount;
+        m2 += delta * (value - mean);
+        min = std::min(min, value);
+        max = std::max(max, value);
+        numericValues.append(value);
+    }
+
+    void addDistinct(const QString& text)
+    {
+        quint64 hash = mixHash(static_cast<quint64>(qHash(text)));
+        int index = static_cast<int>(hash >> (64 - HLL_PRECISION));
+        quint64 rest = (hash << HLL_PRECISION) | (1ULL << (HLL_PRECISION - 1));
+
+        quint8 rank = 1;
+        while ((rest & (1ULL << 63)) == 0) {
+            ++rank;
+            rest <<= 1;
+        }
+
+        if (rank > registers[index]) {
+            registers[index] = rank;
+        }
+
+        auto it = frequency.find(text);
+        if (it != frequency.end()) {
+            ++it.value();
+        } else if (frequency.size() < MAX_TRACKED_VALUES) {
+            frequency.insert(text, 1);
+        }
+    }
+};
+
+void mergeInto(PartialProfile& target, const PartialProfile& source)
+{
+    target.nullCount += source.nullCount;
+    target.textCount += source.textCount;
+
+    // Chan 等人的并行方差合并公式
+    int n = target.numericCount + source.numericCount;
+    if (source.numericCount > 0) {
+        double delta = source.mean - target.mean;
+        target.mean += delta * source.numericCount / n;
+        target.m2 += source.m2 + delta * delta *
+                     (static_cast<double>(target.numericCount) * source.numericCount / n);
+        target.min = std::min(target.min, source.min);
+        target.max = std::max(target.max, source.max);
+        target.numericValues += source.numericValues;
+    }
+    target.numericCount = n;
+
+    for (int i = 0; i < HLL_REGISTERS; ++i) {
+        target.registers[i] = std::max(target.registers[i], source.registers[i]);
+    }
+
+    for (auto it = source.frequency.constBegin(); it != source.frequency.constEnd(); ++it) {
+        target.frequency[it.key()] += it.value();
+    }
+}
+
+qint64 estimateDistinct(const QVector<quint8>& registers)
+{
+    const double m = HLL_REGISTERS;
+    const double alpha = 0.7213 / (1.0 + 1.079 / m);
+
+    double sum = 0.0;
+    int zeros = 0;
+    for (quint8 reg : registers) {
+        sum += std::ldexp(1.0, -static_cast<int>(reg));
+        if (reg == 0) {
+            ++zeros;
+        }
+    }
+
+    double estimate = alpha * m * m / sum;
+
+    // 小基数修正（线性计数）
+    if (estimate <= 2.5 * m && zeros > 0) {
+        estimate = m * qLn(m / zeros);
+    }
+
+    return qRound64(estimate);
+}
+
+// 使用 nth_element 选取线性插值分位数，p 取值 [0, 1]
+double selectQuantile(QVector<double>& values, double p)
+{
+    qsizetype n = values.size();
+    double index = p * (n - 1);
+    qsizetype lower = static_cast<qsizetype>(qFloor(index));
+    double weight = index - lower;
+
+    std::nth_element(values.begin(), values.begin() + lower, values.end());
+    double lowerValue = values[lower];
+
+    if (weight <= 0.0 || lower + 1 >= n) {
+        return lowerValue;
+    }
+
+    double upperValue = *std::min_element(values.begin() + lower + 1, values.end());
+    return lowerValue * (1.0 - weight) + upperValue * weight;
+}
+
+void scanRows(const Core::TableData& table, int column,
+              qsizetype begin, qsizetype end, PartialProfile& partial)
+{
+    partial.registers.fill(0, HLL_REGISTERS);
+
+    for (qsizetype row = begin; row < end; ++row) {
+        QVariant value = table.at(static_cast<int>(row), column);
+
+        if (value.isNull()) {
+            ++partial.nullCount;
+            continue;
+        }
+
+        int typeId = value.typeId();
+        if (typeId == QMetaType::Double || typeId == QMetaType::Int ||
+            typeId == QMetaType::LongLong) {
+            double number = value.toDouble();
+            partial.addNumeric(number);
+            partial.addDistinct(QString::number(number, 'g', 17));
+            continue;
+        }
+
+        QString text = value.toString().trimmed();
+        if (text.isEmpty()) {
+            ++partial.nullCount;
+            continue;
+        }
+
+        bool ok = false;
+        double number = text.toDouble(&ok);
+        if (ok && qIsFinite(number)) {
+            partial.addNumeric(number);
+        } else {
+            ++partial.textCount;
+        }
+        partial.addDistinct(text);
+    }
+}
+
+ColumnProfile finalizeProfile(const Core::TableData& table, int column,
+                              PartialProfile& merged, int topCount)
+{
+    ColumnProfile profile;
+    profile.column = column;
+    profile.name = table.header(column);
+    profile.rowCount = table.rowCount();
+    profile.nullCount = merged.nullCount;
+    profile.numericCount = merged.numericCount;
+    profile.textCount = merged.textCount;
+    profile.distinctEstimate = (merged.numericCount + merged.textCount) > 0
+        ? std::max<qint64>(1, estimateDistinct(merged.registers))
+        : 0;
+
+    if (merged.numericCount > 0 && merged.textCount > 0) {
+        profile.type = InferredType::Mixed;
+    } else if (merged.numericCount > 0) {
+        profile.type = InferredType::Numeric;
+    } else if (merged.textCount > 0) {
+        profile.type = InferredType::Text;
+    }
+
+    if (merged.numericCount > 0) {
+        profile.min = merged.min;
+        profile.max = merged.max;
+        profile.mean = merged.mean;
+        profile.stdDev = merged.numericCount > 1
+            ? qSqrt(merged.m2 / (merged.numericCount - 1))
+            : 0.0;
+
+        profile.q1 = selectQuantile(merged.numericValues, 0.25);
+        profile.median = selectQuantile(merged.numericValues, 0.50);
+        profile.q3 = selectQuantile(merged.numericValues, 0.75);
+    }
+
+    QVector<QPair<QString, int>> entries;
+    entries.reserve(merged.frequency.size());
+    for (auto it = merged.frequency.constBegin(); it != merged.frequency.constEnd(); ++it) {
+        entries.append(qMakePair(it.key(), it.value()));
+    }
+
+    int keep = std::min<int>(topCount, entries.size());
+    std::partial_sort(entries.begin(), entries.begin() + keep, entries.end(),
+                      [](const QPair<QString, int>& a, const QPair<QString, int>& b) {
+                          return a.second != b.second ? a.second > b.second : a.first < b.first;
+                      });
+    entries.resize(keep);
+    profile.topValues = entries;
+
+    return profile;
+}
+
+} // namespace
+
+QString ColumnProfile::typeName(InferredType type)
+{
+    switch (type) {
+        case InferredType::Numeric: return "数值";
+        case InferredType::Text:    return "文本";
+        case InferredType::Mixed:   return "混合";
+        case InferredType::Empty:   break;
+    }
+    return "空";
+}
+
+QVector<ColumnProfile> ColumnProfiler::profile(const Core::TableData& table,
+                                               const ColumnCallback& onColumnFinished,
+                                               int topCount,
+                                               const std::atomic_bool* cancelled)
+{
+    int columns = table.columnCount();
+    qsizetype rows = table.rowCount();
+    QVector<ColumnProfile> results(columns);
+
+    if (columns == 0) {
+        return results;
+    }
+
+    // 按"列 × 行块"切分任务，宽表时列间并行，长表时行块间并行
+    int chunks = Parallel::chunkCount(rows, MIN_ROWS_PER_CHUNK);
+    QVector<PartialProfile> partials(columns * chunks);
+    std::unique_ptr<QAtomicInt[]> remaining(new QAtomicInt[columns]);
+    for (int col = 0; col < columns; ++col) {
+        remaining[col].storeRelaxed(chunks);
+    }
+
+    Parallel::forEach(columns * chunks, [&](int task) {
+        if (cancelled && cancelled->load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        int column = task / chunks;
+        int chunk = task % chunks;
+
+        qsizetype begin = Parallel::chunkBegin(rows, chunks, chunk);
+        qsizetype end = Parallel::chunkBegin(rows, chunks, chunk + 1);
+        scanRows(table, column, begin, end, partials[task]);
+
+        // 最后完成的行块负责合并该列的结果
+        if (remaining[column].fetchAndAddOrdered(-1) != 1) {
+            return;
+        }
+
+        PartialProfile& merged = partials[column * chunks];
+        for (int i = 1; i < chunks; ++i) {
+            PartialProfile& part = partials[column * chunks + i];
+            mergeInto(merged, part);
+            part = PartialProfile();
+        }
+
+        results[column] = finalizeProfile(table, column, merged, topCount);
+        merged = PartialProfile();
+
+        if (onColumnFinished) {
+            onColumnFinished(results[column]);
+        }
+    });
+
+    return results;
+}
+
+ColumnProfile ColumnProfiler::profileColumn(const Core::TableData& table, int column, int topCount)
+{
+    if (column < 0 || column >= table.columnCount()) {
+        return ColumnProfile();
+    }
+
+    PartialProfile partial;
+    scanRows(table, column, 0, table.rowCount(), partial);
+    return finalizeProfile(table, column, partial, topCount);
+}
+
+} // namespace Statistics
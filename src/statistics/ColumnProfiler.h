@@ -0,0 +1,90 @@
+#ifndef COLUMNPROFILER_H
+#define COLUMNPROFILER_H
+
+#include "core/TableData.h"
+#include <QVector>
+#include <QString>
+#include <QPair>
+#include <atomic>
+#include <functional>
+
+namespace Statistics {
+
+/**
+ * @brief 推断的列数据类型
+ */
+enum class InferredType
+{
+    Empty,      // 全部为空
+    Numeric,    // 数值
+    Text,       // 文本
+    Mixed       // 数值与文本混合
+};
+
+/**
+ * @brief 单列数据概览
+ */
+struct ColumnProfile
+{
+    int column = -1;                 // 列索引
+    QString name;                    // 列名
+    InferredType type = InferredType::Empty;
+
+    int rowCount = 0;                // 总行数
+    int nullCount = 0;               // 空值个数
+    int numericCount = 0;            // 数值单元格个数
+    int textCount = 0;               // 文本单元格个数
+    qint64 distinctEstimate = 0;     // 不同值个数（HyperLogLog 估计）
+
+    // 数值统计（仅对数值单元格）
+    double min = 0.0;
+    double max = 0.0;
+    double mean = 0.0;
+    double stdDev = 0.0;
+    double q1 = 0.0;
+    double median = 0.0;
+    double q3 = 0.0;
+
+    QVector<QPair<QString, int>> topValues;  // 高频值及其出现次数
+
+    static QString typeName(InferredType type);
+};
+
+/**
+ * @brief 全列数据概览计算器
+ *
+ * 一次并行扫描计算所有列的概览：任务按"列 × 行块"切分到线程池，
+ * 每列的所有行块完成后立即合并并通过回调通知，便于界面逐列显示结果。
+ */
+class ColumnProfiler
+{
+public:
+    /**
+     * @brief 单列完成回调
+     * @note 在工作线程中调用，回调内部需自行保证线程安全
+     */
+    using ColumnCallback = std::function<void(const ColumnProfile&)>;
+
+    /**
+     * @brief 计算所有列的概览
+     * @param table 表格数据（计算期间不得修改）
+     * @param onColumnFinished 每列完成时的回调（可为空）
+     * @param topCount 每列保留的高频值个数
+     * @param cancelled 取消标志（可为空）；置位后尚未开始的行块直接跳过，
+     *                  未完成的列不再回调，返回的结果不完整
+     * @return 按列顺序排列的概览结果
+     */
+    static QVector<ColumnProfile> profile(const Core::TableData& table,
+                                          const ColumnCallback& onColumnFinished = ColumnCallback(),
+                                          int topCount = 5,
+                                          const std::atomic_bool* cancelled = nullptr);
+
+    /**
+     * @brief 计算单列概览
+     */
+    static ColumnProfile profileColumn(const Core::TableData& table, int column, int topCount = 5);
+};
+
+} // namespace Statistics
+
+#endif // COLUMNPROFILER_H
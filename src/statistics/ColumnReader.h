@@ -0,0 +1,85 @@
+#ifndef COLUMNREADER_H
+#define COLUMNREADER_H
+
+#include "DenseMatrix.h"
+#include "core/TableData.h"
+#include <QMetaType>
+#include <QVariant>
+#include <QVector>
+#include <QtMath>
+#include <algorithm>
+#include <functional>
+
+namespace Statistics {
+
+// 统计模块内部使用：多列算法读取输入数据的公共接口，不属于对外 API
+
+/**
+ * @brief 单元格转数值：空值与无法解析的文本为 NaN
+ *
+ * 比 TableData::toDoubleVector 严格：数值类型直接转换，其余按去除首尾空白的文本解析。
+ */
+inline double cellToDouble(const QVariant& value)
+{
+    if (value.isNull()) {
+        return qQNaN();
+    }
+
+    int typeId = value.typeId();
+    if (typeId == QMetaType::Double || typeId == QMetaType::Int ||
+        typeId == QMetaType::LongLong) {
+        return value.toDouble();
+    }
+
+    bool ok = false;
+    double number = value.toString().trimmed().toDouble(&ok);
+    return ok ? number : qQNaN();
+}
+
+/**
+ * @brief 把第 column 列 [begin, end) 行读入 out（缺失值写 NaN）
+ */
+using ColumnReader = std::function<void(int column, qsizetype begin, qsizetype end, double* out)>;
+
+/**
+ * @brief 逐单元格读取表格中选定的列（不复制整表，适合只扫描少数几遍的算法）
+ *
+ * 返回的读取器引用 table 与 columns，二者须在使用期间保持有效。
+ */
+inline ColumnReader tableColumnReader(const Core::TableData& table, const QVector<int>& columns)
+{
+    return [&table, &columns](int column, qsizetype begin, qsizetype end, double* out) {
+        const int sourceColumn = columns[column];
+        for (qsizetype row = begin; row < end; ++row) {
+            *out++ = cellToDouble(table.at(static_cast<int>(row), sourceColumn));
+        }
+    };
+}
+
+/**
+ * @brief 读取若干等长数据列（引用 columns，须在使用期间保持有效）
+ */
+inline ColumnReader vectorColumnReader(const QVector<QVector<double>>& columns)
+{
+    return [&columns](int column, qsizetype begin, qsizetype end, double* out) {
+        std::copy(columns[column].constBegin() + begin, columns[column].constBegin() + end, out);
+    };
+}
+
+/**
+ * @brief 读取列优先矩阵的各列（如 DenseMatrix::fromTable 的结果，引用 matrix）
+ *
+ * 需要多遍扫描的算法先整体转换一次再从矩阵读取，避免每遍都逐单元格解析 QVariant。
+ */
+inline ColumnReader matrixColumnReader(const DenseMatrix& matrix)
+{
+    Q_ASSERT(matrix.layout() == MatrixLayout::ColumnMajor);
+    return [&matrix](int column, qsizetype begin, qsizetype end, double* out) {
+        const double* source = matrix.data() + column * matrix.leadingDimension();
+        std::copy(source + begin, source + end, out);
+    };
+}
+
+} // namespace Statistics
+
+#endif // COLUMNREADER_H
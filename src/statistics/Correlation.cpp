@@ -0,0 +1,667 @@
+#include "Correlation.h"
+#include "ColumnReader.h"
+#include "ParallelUtils.h"
+#include <QtMath>
+#include <algorithm>
+#include <numeric>
+
+namespace Statistics {
+
+namespace {
+
+// 列分块大小（须为 4 的倍数）
+const int TILE_COLUMNS = 32;
+
+// 每个行块（面板）读入的行数
+const qsizetype PANEL_ROWS = 16384;
+
+// 面板中相邻两列的间距：多留一个缓存行，避免各列起始地址映射到同一缓存组
+const qsizetype PANEL_STRIDE = PANEL_ROWS + 8;
+
+// 内核每次处理的行数，使两个列块的数据留在 L2 缓存中
+const qsizetype KERNEL_ROWS = 256;
+
+// 求参考值和推断列类型时检查的行数
+const int SAMPLE_ROWS = 1000;
+
+/**
+ * @brief 所有列对的累加和（p×p 行优先，仅使用上三角）
+ */
+struct PairSums
+{
+    int p = 0;
+    QVector<double> n;      // 同时有效的行数
+    QVector<double> sx;     // Σx（仅同时有效的行）
+    QVector<double> sy;     // Σy
+    QVector<double> sxx;    // Σx²
+    QVector<double> syy;    // Σy²
+    QVector<double> sxy;    // Σxy
+
+    void init(int columns)
+    {
+        p = columns;
+        for (QVector<double>* field : {&n, &sx, &sy, &sxx, &syy, &sxy}) {
+            field->fill(0.0, p * p);
+        }
+    }
+
+    void add(const PairSums& other)
+    {
+        QVector<double>* targets[] = {&n, &sx, &sy, &sxx, &syy, &sxy};
+        const QVector<double>* sources[] = {&other.n, &other.sx, &other.sy,
+                                            &other.sxx, &other.syy, &other.sxy};
+        for (int f = 0; f < 6; ++f) {
+            double* target = targets[f]->data();
+            const double* source = sources[f]->constData();
+            for (int i = 0; i < p * p; ++i) {
+                target[i] += source[i];
+            }
+        }
+    }
+};
+
+/**
+ * @brief 列优先的行块缓冲区
+ *
+ * 有效值减去该列参考值后存入 values，缺失值存 0；mask 有效为 1、缺失为 0。
+ * 这样 Σxy 无需判断掩码，缺失行自动贡献 0。
+ */
+struct Panel
+{
+    int columns = 0;
+    qsizetype rows = 0;
+    QVector<double> values;
+    QVector<double> mask;
+    QVector<char> complete;     // 该列在本行块内是否没有缺失值
+    QVector<double> sum;
+    QVector<double> sumSq;
+
+    void reserve(int p)
+    {
+        columns = p;
+        values.resize(PANEL_STRIDE * p);
+        mask.resize(PANEL_STRIDE * p);
+        complete.resize(p);
+        sum.resize(p);
+        sumSq.resize(p);
+    }
+
+    const double* value(int column) const { return values.constData() + column * PANEL_STRIDE; }
+    const double* valid(int column) const { return mask.constData() + column * PANEL_STRIDE; }
+    double* value(int column) { return values.data() + column * PANEL_STRIDE; }
+    double* valid(int column) { return mask.data() + column * PANEL_STRIDE; }
+
+    bool groupComplete(int first, int count) const
+    {
+        for (int c = first; c < first + count; ++c) {
+            if (!complete[c]) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+void fillColumn(Panel& panel, int column, qsizetype begin,
+                const ColumnReader& reader, double shift)
+{
+    double* x = panel.value(column);
+    double* m = panel.valid(column);
+    reader(column, begin, begin + panel.rows, x);
+
+    bool complete = true;
+    double sum = 0.0;
+    double sumSq = 0.0;
+    for (qsizetype r = 0; r < panel.rows; ++r) {
+        bool valid = qIsFinite(x[r]);
+        double v = valid ? x[r] - shift : 0.0;
+        x[r] = v;
+        m[r] = valid ? 1.0 : 0.0;
+        complete = complete && valid;
+        sum += v;
+        sumSq += v * v;
+    }
+
+    panel.complete[column] = complete;
+    panel.sum[column] = sum;
+    panel.sumSq[column] = sumSq;
+}
+
+/**
+ * @brief 4×4 寄存器分块的 Σxy 内核（16 个独立累加器）
+ */
+void kernel4x4(const double* const a[4], const double* const b[4],
+               qsizetype len, double acc[4][4])
+{
+    double c[4][4] = {};
+    for (qsizetype r = 0; r < len; ++r) {
+        double av[4] = {a[0][r], a[1][r], a[2][r], a[3][r]};
+        double bv[4] = {b[0][r], b[1][r], b[2][r], b[3][r]};
+        for (int i = 0; i < 4; ++i) {
+            for (int j = 0; j < 4; ++j) {
+                c[i][j] += av[i] * bv[j];
+            }
+        }
+    }
+
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            acc[i][j] += c[i][j];
+        }
+    }
+}
+
+double dot(const double* a, const double* b, qsizetype len)
+{
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    qsizetype r = 0;
+    for (; r + 4 <= len; r += 4) {
+        s0 += a[r] * b[r];
+        s1 += a[r + 1] * b[r + 1];
+        s2 += a[r + 2] * b[r + 2];
+        s3 += a[r + 3] * b[r + 3];
+    }
+    for (; r < len; ++r) {
+        s0 += a[r] * b[r];
+    }
+    return (s0 + s1) + (s2 + s3);
+}
+
+/**
+ * @brief 含缺失值的列对：同时累加掩码相关的 6 个和
+ */
+void maskedPair(const Panel& panel, int i, int j, qsizetype r0, qsizetype len, PairSums& sums)
+{
+    const double* x = panel.value(i) + r0;
+    const double* y = panel.value(j) + r0;
+    const double* mx = panel.valid(i) + r0;
+    const double* my = panel.valid(j) + r0;
+
+    double n = 0.0, sx = 0.0, sy = 0.0, sxx = 0.0, syy = 0.0, sxy = 0.0;
+    for (qsizetype r = 0; r < len; ++r) {
+        n += mx[r] * my[r];
+        sx += x[r] * my[r];
+        sy += y[r] * mx[r];
+        sxx += x[r] * x[r] * my[r];
+        syy += y[r] * y[r] * mx[r];
+        sxy += x[r] * y[r];
+    }
+
+    int index = i * sums.p + j;
+    sums.n[index] += n;
+    sums.sx[index] += sx;
+    sums.sy[index] += sy;
+    sums.sxx[index] += sxx;
+    sums.syy[index] += syy;
+    sums.sxy[index] += sxy;
+}
+
+/**
+ * @brief 累加列块 tileA × tileB 中所有列对（i ≤ j）在本行块上的贡献
+ */
+void accumulateTilePair(const Panel& panel, int tileA, int tileB, PairSums& sums)
+{
+    const int p = panel.columns;
+    const int aBegin = tileA * TILE_COLUMNS;
+    const int aEnd = std::min(p, aBegin + TILE_COLUMNS);
+    const int bBegin = tileB * TILE_COLUMNS;
+    const int bEnd = std::min(p, bBegin + TILE_COLUMNS);
+
+    for (qsizetype r0 = 0; r0 < panel.rows; r0 += KERNEL_ROWS) {
+        qsizetype len = std::min(KERNEL_ROWS, panel.rows - r0);
+
+        for (int a = aBegin; a < aEnd; a += 4) {
+            int aCount = std::min(4, aEnd - a);
+            int bStart = tileA == tileB ? a : bBegin;
+
+            for (int b = bStart; b < bEnd; b += 4) {
+                int bCount = std::min(4, bEnd - b);
+
+                if (aCount == 4 && bCount == 4 &&
+                    panel.groupComplete(a, 4) && panel.groupComplete(b, 4)) {
+                    const double* aPtr[4];
+                    const double* bPtr[4];
+                    for (int k = 0; k < 4; ++k) {
+                        aPtr[k] = panel.value(a + k) + r0;
+                        bPtr[k] = panel.value(b + k) + r0;
+                    }
+
+                    double acc[4][4] = {};
+                    kernel4x4(aPtr, bPtr, len, acc);
+                    for (int i = 0; i < 4; ++i) {
+                        for (int j = 0; j < 4; ++j) {
+                            if (a + i <= b + j) {
+                                sums.sxy[(a + i) * p + b + j] += acc[i][j];
+                            }
+                        }
+                    }
+                    continue;
+                }
+
+                for (int i = a; i < a + aCount; ++i) {
+                    for (int j = std::max(b, i); j < b + bCount; ++j) {
+                        if (panel.complete[i] && panel.complete[j]) {
+                            sums.sxy[i * p + j] += dot(panel.value(i) + r0, panel.value(j) + r0, len);
+                        } else {
+                            maskedPair(panel, i, j, r0, len, sums);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // 两列在本行块内都完整时，其余的和直接由列和得到
+    for (int i = aBegin; i < aEnd; ++i) {
+        if (!panel.complete[i]) {
+            continue;
+        }
+        for (int j = std::max(bBegin, i); j < bEnd; ++j) {
+            if (!panel.complete[j]) {
+                continue;
+            }
+            int index = i * p + j;
+            sums.n[index] += panel.rows;
+            sums.sx[index] += panel.sum[i];
+            sums.sy[index] += panel.sum[j];
+            sums.sxx[index] += panel.sumSq[i];
+            sums.syy[index] += panel.sumSq[j];
+        }
+    }
+}
+
+/**
+ * @brief 每列前若干行中的第一个有效值，作为平移参考值
+ */
+QVector<double> referenceValues(int p, qsizetype n, const ColumnReader& reader)
+{
+    qsizetype rows = std::min<qsizetype>(n, SAMPLE_ROWS);
+    QVector<double> shifts(p, 0.0);
+    QVector<double> buffer(rows);
+
+    for (int c = 0; c < p; ++c) {
+        reader(c, 0, rows, buffer.data());
+        for (double v : buffer) {
+            if (qIsFinite(v)) {
+                shifts[c] = v;
+                break;
+            }
+        }
+    }
+    return shifts;
+}
+
+PairSums accumulateAll(int p, qsizetype n, const ColumnReader& reader)
+{
+    const QVector<double> shifts = referenceValues(p, n, reader);
+
+    int tiles = (p + TILE_COLUMNS - 1) / TILE_COLUMNS;
+    QVector<QPair<int, int>> tilePairs;
+    for (int a = 0; a < tiles; ++a) {
+        for (int b = a; b < tiles; ++b) {
+            tilePairs.append(qMakePair(a, b));
+        }
+    }
+
+    // 列数少时列块对不足以占满线程，改为按行切分，各段使用独立的累加器
+    int panels = static_cast<int>((n + PANEL_ROWS - 1) / PANEL_ROWS);
+    int splits = std::clamp(Parallel::threadCount() * 2 / static_cast<int>(tilePairs.size()),
+                            1, std::max(1, panels));
+
+    if (splits == 1) {
+        PairSums sums;
+        sums.init(p);
+        Panel panel;
+        panel.reserve(p);
+
+        for (qsizetype begin = 0; begin < n; begin += PANEL_ROWS) {
+            panel.rows = std::min(PANEL_ROWS, n - begin);
+            Parallel::forEach(p, [&](int column) {
+                fillColumn(panel, column, begin, reader, shifts[column]);
+            });
+            Parallel::forEach(tilePairs.size(), [&](int task) {
+                accumulateTilePair(panel, tilePairs[task].first, tilePairs[task].second, sums);
+            });
+        }
+        return sums;
+    }
+
+    QVector<PairSums> partials(splits);
+    Parallel::forEach(splits, [&](int split) {
+        PairSums& sums = partials[split];
+        sums.init(p);
+        Panel panel;
+        panel.reserve(p);
+
+        qsizetype splitBegin = Parallel::chunkBegin(panels, splits, split) * PANEL_ROWS;
+        qsizetype splitEnd = std::min(n, Parallel::chunkBegin(panels, splits, split + 1) * PANEL_ROWS);
+        for (qsizetype begin = splitBegin; begin < splitEnd; begin += PANEL_ROWS) {
+            panel.rows = std::min(PANEL_ROWS, splitEnd - begin);
+            for (int column = 0; column < p; ++column) {
+                fillColumn(panel, column, begin, reader, shifts[column]);
+            }
+            for (const auto& tilePair : tilePairs) {
+                accumulateTilePair(panel, tilePair.first, tilePair.second, sums);
+            }
+        }
+    });
+
+    // 按段顺序合并，结果与线程调度无关
+    for (int split = 1; split < splits; ++split) {
+        partials[0].add(partials[split]);
+    }
+    return partials[0];
+}
+
+CorrelationResult finalize(const PairSums& sums, CorrelationMethod method)
+{
+    const int p = sums.p;
+    CorrelationResult result;
+    result.method = method;
+    result.matrix = MatrixOperations::Matrix(p, QVector<double>(p, qQNaN()));
+    result.pairCounts = QVector<QVector<qint64>>(p, QVector<qint64>(p, 0));
+
+    for (int i = 0; i < p; ++i) {
+        for (int j = i; j < p; ++j) {
+            int index = i * p + j;
+            double n = sums.n[index];
+            qint64 count = qRound64(n);
+            result.pairCounts[i][j] = result.pairCounts[j][i] = count;
+
+            if (count < 2) {
+                continue;
+            }
+
+            double cxy = sums.sxy[index] - sums.sx[index] * sums.sy[index] / n;
+            double cxx = sums.sxx[index] - sums.sx[index] * sums.sx[index] / n;
+            double cyy = sums.syy[index] - sums.sy[index] * sums.sy[index] / n;
+
+            double value = qQNaN();
+            if (method == CorrelationMethod::Covariance) {
+                value = cxy / (n - 1.0);
+            } else if (cxx > 0.0 && cyy > 0.0) {
+                value = i == j ? 1.0 : std::clamp(cxy / std::sqrt(cxx * cyy), -1.0, 1.0);
+            }
+
+            result.matrix[i][j] = result.matrix[j][i] = value;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief 两列在同时有效的行上重新求秩后的皮尔逊相关
+ * @return 相关系数（有效行少于 2 或秩的方差为 0 时为 NaN）；count 为有效行数
+ */
+double spearmanPair(int a, int b, qsizetype n, const ColumnReader& reader, qint64& count)
+{
+    QVector<double> x(n);
+    QVector<double> y(n);
+    reader(a, 0, n, x.data());
+    reader(b, 0, n, y.data());
+
+    qsizetype m = 0;
+    for (qsizetype row = 0; row < n; ++row) {
+        if (qIsFinite(x[row]) && qIsFinite(y[row])) {
+            x[m] = x[row];
+            y[m] = y[row];
+            ++m;
+        }
+    }
+    x.resize(m);
+    y.resize(m);
+    count = m;
+    if (m < 2) {
+        return qQNaN();
+    }
+
+    const QVector<double> rx = Correlation::averageRanks(x);
+    const QVector<double> ry = Correlation::averageRanks(y);
+
+    // 秩的均值恒为 (m + 1) / 2
+    const double mean = (m + 1) / 2.0;
+    double cxy = 0.0, cxx = 0.0, cyy = 0.0;
+    for (qsizetype i = 0; i < m; ++i) {
+        const double dx = rx[i] - mean;
+        const double dy = ry[i] - mean;
+        cxy += dx * dy;
+        cxx += dx * dx;
+        cyy += dy * dy;
+    }
+    if (cxx <= 0.0 || cyy <= 0.0) {
+        return qQNaN();
+    }
+    return a == b ? 1.0 : std::clamp(cxy / std::sqrt(cxx * cyy), -1.0, 1.0);
+}
+
+/**
+ * @brief 斯皮尔曼相关矩阵（成对完整）
+ *
+ * 秩必须在每对列同时有效的行上计算，整列求一次秩只对没有缺失值的列
+ * 成立。没有缺失值的列整列求秩后走分块内核；涉及含缺失值列的列对
+ * 逐对读取两列、取同时有效的行重新求秩。整列的秩存为 2×秩 的整数
+ * （并列取平均时秩为半整数），内存为同样行列数的 double 的一半。
+ */
+CorrelationResult spearmanFromReader(int p, qsizetype n, const ColumnReader& reader)
+{
+    QVector<QVector<quint32>> doubledRanks(p);
+    QVector<char> complete(p, 1);
+    Parallel::forEach(p, [&](int column) {
+        QVector<double> values(n);
+        reader(column, 0, n, values.data());
+        for (double v : values) {
+            if (!qIsFinite(v)) {
+                complete[column] = 0;
+                return;
+            }
+        }
+
+        const QVector<double> ranks = Correlation::averageRanks(values);
+        QVector<quint32>& doubled = doubledRanks[column];
+        doubled.resize(n);
+        for (qsizetype row = 0; row < n; ++row) {
+            doubled[row] = static_cast<quint32>(ranks[row] * 2.0);
+        }
+    });
+
+    QVector<int> full;
+    for (int column = 0; column < p; ++column) {
+        if (complete[column]) {
+            full.append(column);
+        }
+    }
+
+    CorrelationResult result;
+    result.method = CorrelationMethod::Spearman;
+    result.matrix = MatrixOperations::Matrix(p, QVector<double>(p, qQNaN()));
+    result.pairCounts = QVector<QVector<qint64>>(p, QVector<qint64>(p, 0));
+
+    // 完整列之间：2×秩与秩的皮尔逊相关相同
+    if (!full.isEmpty()) {
+        ColumnReader rankReader = [&doubledRanks, &full](int column, qsizetype begin, qsizetype end, double* out) {
+            const quint32* ranks = doubledRanks[full[column]].constData();
+            for (qsizetype row = begin; row < end; ++row) {
+                *out++ = ranks[row];
+            }
+        };
+
+        const CorrelationResult fullResult =
+            finalize(accumulateAll(full.size(), n, rankReader), CorrelationMethod::Pearson);
+        for (int i = 0; i < full.size(); ++i) {
+            for (int j = 0; j < full.size(); ++j) {
+                result.matrix[full[i]][full[j]] = fullResult.matrix[i][j];
+                result.pairCounts[full[i]][full[j]] = fullResult.pairCounts[i][j];
+            }
+        }
+    }
+
+    QVector<QPair<int, int>> pairs;
+    for (int i = 0; i < p; ++i) {
+        for (int j = i; j < p; ++j) {
+            if (!complete[i] || !complete[j]) {
+                pairs.append(qMakePair(i, j));
+            }
+        }
+    }
+
+    // 矩阵各行仍隐式共享，结果先写入按任务划分的数组再统一填入
+    QVector<double> values(pairs.size());
+    QVector<qint64> counts(pairs.size());
+    Parallel::forEach(pairs.size(), [&](int task) {
+        values[task] = spearmanPair(pairs[task].first, pairs[task].second, n, reader, counts[task]);
+    });
+
+    for (int task = 0; task < pairs.size(); ++task) {
+        const int i = pairs[task].first;
+        const int j = pairs[task].second;
+        result.matrix[i][j] = result.matrix[j][i] = values[task];
+        result.pairCounts[i][j] = result.pairCounts[j][i] = counts[task];
+    }
+
+    return result;
+}
+
+CorrelationResult computeFromReader(int p, qsizetype n, const ColumnReader& reader,
+                                    CorrelationMethod method)
+{
+    if (method == CorrelationMethod::Spearman) {
+        return spearmanFromReader(p, n, reader);
+    }
+    return finalize(accumulateAll(p, n, reader), method);
+}
+
+} // namespace
+
+CorrelationResult Correlation::compute(const Core::TableData& table,
+                                       CorrelationMethod method,
+                                       const QVector<int>& columns)
+{
+    QVector<int> selected = columns.isEmpty() ? numericColumns(table) : columns;
+
+    for (int column : selected) {
+        if (column < 0 || column >= table.columnCount()) {
+            CorrelationResult result;
+            result.isValid = false;
+            result.errorMessage = QString("列索引无效: %1").arg(column);
+            return result;
+        }
+    }
+
+    if (selected.size() < 2) {
+        CorrelationResult result;
+        result.isValid = false;
+        result.errorMessage = "至少需要两个数值列";
+        return result;
+    }
+
+    CorrelationResult result = computeFromReader(selected.size(), table.rowCount(),
+                                                 tableColumnReader(table, selected), method);
+    result.columns = selected;
+    for (int column : selected) {
+        result.names.append(table.header(column));
+    }
+    return result;
+}
+
+CorrelationResult Correlation::compute(const QVector<QVector<double>>& columns,
+                                       const QStringList& names,
+                                       CorrelationMethod method)
+{
+    if (columns.size() < 2) {
+        CorrelationResult result;
+        result.isValid = false;
+        result.errorMessage = "至少需要两个数据列";
+        return result;
+    }
+
+    qsizetype n = columns.first().size();
+    for (const auto& column : columns) {
+        if (column.size() != n) {
+            CorrelationResult result;
+            result.isValid = false;
+            result.errorMessage = "各列数据长度不一致";
+            return result;
+        }
+    }
+
+    CorrelationResult result = computeFromReader(columns.size(), n, vectorColumnReader(columns), method);
+    for (int i = 0; i < columns.size(); ++i) {
+        result.columns.append(i);
+        result.names.append(i < names.size() ? names[i] : QString("列%1").arg(i + 1));
+    }
+    return result;
+}
+
+QVector<int> Correlation::numericColumns(const Core::TableData& table)
+{
+    QVector<int> result;
+
+    for (int column = 0; column < table.columnCount(); ++column) {
+        int checked = 0;
+        bool numeric = true;
+
+        for (int row = 0; row < table.rowCount() && checked < SAMPLE_ROWS; ++row) {
+            QVariant value = table.at(row, column);
+            if (value.isNull() || value.toString().trimmed().isEmpty()) {
+                continue;
+            }
+            ++checked;
+            if (!qIsFinite(cellToDouble(value))) {
+                numeric = false;
+                break;
+            }
+        }
+
+        if (numeric && checked > 0) {
+            result.append(column);
+        }
+    }
+
+    return result;
+}
+
+QVector<double> Correlation::averageRanks(const QVector<double>& values)
+{
+    QVector<double> ranks(values.size(), qQNaN());
+
+    QVector<qsizetype> order;
+    order.reserve(values.size());
+    for (qsizetype i = 0; i < values.size(); ++i) {
+        if (qIsFinite(values[i])) {
+            order.append(i);
+        }
+    }
+
+    std::sort(order.begin(), order.end(), [&values](qsizetype a, qsizetype b) {
+        return values[a] < values[b];
+    });
+
+    for (qsizetype i = 0; i < order.size();) {
+        qsizetype j = i + 1;
+        while (j < order.size() && values[order[j]] == values[order[i]]) {
+            ++j;
+        }
+
+        // 第 i..j-1 位（从 1 开始计为 i+1..j）并列，取平均秩
+        double rank = (i + 1 + j) / 2.0;
+        for (qsizetype k = i; k < j; ++k) {
+            ranks[order[k]] = rank;
+        }
+        i = j;
+    }
+
+    return ranks;
+}
+
+QString Correlation::methodName(CorrelationMethod method)
+{
+    switch (method) {
+        case CorrelationMethod::Pearson:    return "皮尔逊相关";
+        case CorrelationMethod::Spearman:   return "斯皮尔曼秩相关";
+        case CorrelationMethod::Covariance: return "协方差";
+    }
+    return QString();
+}
+
+} // namespace Statistics
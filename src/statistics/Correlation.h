@@ -0,0 +1,82 @@
+#ifndef CORRELATION_H
+#define CORRELATION_H
+
+#include "MatrixOperations.h"
+#include "core/TableData.h"
+#include <QVector>
+#include <QStringList>
+
+namespace Statistics {
+
+/**
+ * @brief 相关性度量
+ */
+enum class CorrelationMethod
+{
+    Pearson,        // 皮尔逊积矩相关系数
+    Spearman,       // 斯皮尔曼秩相关系数
+    Covariance      // 样本协方差
+};
+
+/**
+ * @brief 相关/协方差矩阵结果
+ */
+struct CorrelationResult
+{
+    CorrelationMethod method = CorrelationMethod::Pearson;
+    QVector<int> columns;                   // 参与计算的列索引
+    QStringList names;                      // 列名
+    MatrixOperations::Matrix matrix;        // p×p 结果矩阵，有效数据不足处为 NaN
+    QVector<QVector<qint64>> pairCounts;    // 两列同时有效的行数
+
+    bool isValid = true;
+    QString errorMessage;
+};
+
+/**
+ * @brief 相关与协方差矩阵计算器
+ *
+ * 按行块把数据读入列优先的连续缓冲区（减去每列的参考值以改善数值
+ * 稳定性），再按列分块并行计算 XᵀX。缺失值按"成对完整"处理：每对
+ * 列只使用两者同时有效的行。行块内没有缺失值的列对走 4×4 寄存器
+ * 分块的快速内核，其余列对额外累加掩码相关的和。斯皮尔曼相关同样按
+ * 成对完整计算：涉及含缺失值列的列对在同时有效的行上重新求秩。
+ */
+class Correlation
+{
+public:
+    /**
+     * @brief 计算表格中若干列的相关/协方差矩阵
+     * @param table 表格数据（计算期间不得修改）
+     * @param method 相关性度量
+     * @param columns 列索引（为空时使用所有数值列）
+     */
+    static CorrelationResult compute(const Core::TableData& table,
+                                     CorrelationMethod method,
+                                     const QVector<int>& columns = QVector<int>());
+
+    /**
+     * @brief 计算若干数据列的相关/协方差矩阵
+     * @param columns 数据列（长度须相同，NaN 表示缺失）
+     * @param names 列名
+     */
+    static CorrelationResult compute(const QVector<QVector<double>>& columns,
+                                     const QStringList& names,
+                                     CorrelationMethod method);
+
+    /**
+     * @brief 推断数值列（检查每列前若干个非空单元格）
+     */
+    static QVector<int> numericColumns(const Core::TableData& table);
+
+    /**
+     * @brief 平均秩（并列值取平均秩，NaN 保持为 NaN）
+     */
+    static QVector<double> averageRanks(const QVector<double>& values);
+
+    static QString methodName(CorrelationMethod method);
+};
+
+} // namespace Statistics
+
+#endif // CORRELATION_H
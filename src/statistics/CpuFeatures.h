@@ -0,0 +1,72 @@
+#ifndef CPUFEATURES_H
+#define CPUFEATURES_H
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define STATISTICS_X86_64 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/Clang 需要为使用 AVX2 指令的函数单独开启目标特性（其余代码仍按基线编译）
+#if defined(__GNUC__) || defined(__clang__)
+#define STATISTICS_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+#define STATISTICS_TARGET_AVX2
+#endif
+
+namespace Statistics {
+
+/**
+ * @brief 运行时检测 CPU 指令集（x86-64 的基线为 SSE2）
+ */
+namespace CpuFeatures {
+
+#ifdef STATISTICS_X86_64
+
+/**
+ * @brief CPU 与操作系统是否都支持 AVX2 + FMA（结果在首次调用时确定）
+ */
+inline bool hasAvx2Fma()
+{
+    static const bool supported = []() {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#elif defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) {
+            return false;
+        }
+        __cpuid(info, 1);
+        const bool fma = (info[2] & (1 << 12)) != 0;
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        const bool avx = (info[2] & (1 << 28)) != 0;
+        if (!fma || !osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+            return false;   // 操作系统未保存 ymm 寄存器状态
+        }
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        return false;
+#endif
+    }();
+    return supported;
+}
+
+#else
+
+inline bool hasAvx2Fma()
+{
+    return false;
+}
+
+#endif // STATISTICS_X86_64
+
+} // namespace CpuFeatures
+
+} // namespace Statistics
+
+#endif // CPUFEATURES_H
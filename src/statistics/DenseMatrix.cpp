@@ -0,0 +1,274 @@
+#include "DenseMatrix.h"
+#include "ColumnReader.h"
+#include "Gemm.h"
+#include "ParallelUtils.h"
+#include <QDebug>
+#include <QtMath>
+#include <algorithm>
+#include <cstring>
+
+namespace Statistics {
+
+namespace {
+
+// 缓冲区对齐（缓存行大小，也满足 AVX-512 的对齐要求）
+const size_t BUFFER_ALIGNMENT = 64;
+
+// 读取表格时每块的最少行数
+const qsizetype MIN_ROWS_PER_CHUNK = 4096;
+
+} // namespace
+
+// === MatrixView ===
+
+void MatrixView::fill(double value) const
+{
+    if (isRowContiguous()) {
+        for (qsizetype i = 0; i < m_rows; ++i) {
+            std::fill_n(ptr(i, 0), m_cols, value);
+        }
+    } else {
+        for (qsizetype j = 0; j < m_cols; ++j) {
+            for (qsizetype i = 0; i < m_rows; ++i) {
+                (*this)(i, j) = value;
+            }
+        }
+    }
+}
+
+void MatrixView::assign(const ConstMatrixView& source) const
+{
+    if (source.rows() != m_rows || source.cols() != m_cols) {
+        qWarning() << "矩阵维度不匹配";
+        return;
+    }
+
+    if (isRowContiguous() && source.isRowContiguous()) {
+        for (qsizetype i = 0; i < m_rows; ++i) {
+            std::memmove(ptr(i, 0), source.ptr(i, 0), static_cast<size_t>(m_cols) * sizeof(double));
+        }
+        return;
+    }
+    if (isColumnContiguous() && source.isColumnContiguous()) {
+        for (qsizetype j = 0; j < m_cols; ++j) {
+            std::memmove(ptr(0, j), source.ptr(0, j), static_cast<size_t>(m_rows) * sizeof(double));
+        }
+        return;
+    }
+
+    // 存储顺序不同（如行优先 ← 列优先）：按转置处理，走缓存无关的分块复制
+    Gemm::transpose(source.transposed(), *this);
+}
+
+// === 构造与析构 ===
+
+DenseMatrix::DenseMatrix(qsizetype rows, qsizetype cols, MatrixLayout layout)
+{
+    allocate(rows, cols, layout);
+}
+
+DenseMatrix::DenseMatrix(qsizetype rows, qsizetype cols, double value, MatrixLayout layout)
+{
+    allocate(rows, cols, layout);
+    fill(value);
+}
+
+DenseMatrix::~DenseMatrix()
+{
+    release();
+}
+
+DenseMatrix::DenseMatrix(const DenseMatrix& other)
+{
+    allocate(other.m_rows, other.m_cols, other.m_layout);
+    if (m_data && other.m_data) {
+        std::memcpy(m_data, other.m_data, static_cast<size_t>(size()) * sizeof(double));
+    }
+}
+
+DenseMatrix::DenseMatrix(DenseMatrix&& other) noexcept
+    : m_data(other.m_data), m_rows(other.m_rows), m_cols(other.m_cols), m_layout(other.m_layout)
+{
+    other.m_data = nullptr;
+    other.m_rows = 0;
+    other.m_cols = 0;
+}
+
+DenseMatrix& DenseMatrix::operator=(const DenseMatrix& other)
+{
+    if (this != &other) {
+        DenseMatrix copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+DenseMatrix& DenseMatrix::operator=(DenseMatrix&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        m_data = other.m_data;
+        m_rows = other.m_rows;
+        m_cols = other.m_cols;
+        m_layout = other.m_layout;
+        other.m_data = nullptr;
+        other.m_rows = 0;
+        other.m_cols = 0;
+    }
+    return *this;
+}
+
+void DenseMatrix::allocate(qsizetype rows, qsizetype cols, MatrixLayout layout)
+{
+    m_rows = std::max<qsizetype>(0, rows);
+    m_cols = std::max<qsizetype>(0, cols);
+    m_layout = layout;
+    m_data = nullptr;
+
+    if (m_rows > 0 && m_cols > 0) {
+        m_data = static_cast<double*>(qMallocAligned(static_cast<size_t>(m_rows * m_cols) * sizeof(double),
+                                                     BUFFER_ALIGNMENT));
+        Q_CHECK_PTR(m_data);
+    }
+}
+
+void DenseMatrix::release()
+{
+    if (m_data) {
+        qFreeAligned(m_data);
+        m_data = nullptr;
+    }
+}
+
+// === 工厂函数 ===
+
+DenseMatrix DenseMatrix::zeros(qsizetype rows, qsizetype cols, MatrixLayout layout)
+{
+    return DenseMatrix(rows, cols, 0.0, layout);
+}
+
+DenseMatrix DenseMatrix::identity(qsizetype size, MatrixLayout layout)
+{
+    DenseMatrix result(size, size, 0.0, layout);
+    for (qsizetype i = 0; i < size; ++i) {
+        result(i, i) = 1.0;
+    }
+    return result;
+}
+
+DenseMatrix DenseMatrix::fromView(const ConstMatrixView& view, MatrixLayout layout)
+{
+    DenseMatrix result(view.rows(), view.cols(), layout);
+    result.view().assign(view);
+    return result;
+}
+
+DenseMatrix DenseMatrix::fromRows(const QVector<QVector<double>>& rows)
+{
+    const qsizetype cols = rows.isEmpty() ? 0 : rows[0].size();
+    for (const QVector<double>& row : rows) {
+        if (row.size() != cols) {
+            qWarning() << "各行长度不一致";
+            return DenseMatrix();
+        }
+    }
+
+    DenseMatrix result(rows.size(), cols, MatrixLayout::RowMajor);
+    for (qsizetype i = 0; i < rows.size() && cols > 0; ++i) {
+        std::memcpy(result.m_data + i * cols, rows[i].constData(), static_cast<size_t>(cols) * sizeof(double));
+    }
+    return result;
+}
+
+DenseMatrix DenseMatrix::fromColumns(const QVector<QVector<double>>& columns)
+{
+    const qsizetype rows = columns.isEmpty() ? 0 : columns[0].size();
+    for (const QVector<double>& column : columns) {
+        if (column.size() != rows) {
+            qWarning() << "各列长度不一致";
+            return DenseMatrix();
+        }
+    }
+
+    DenseMatrix result(rows, columns.size(), MatrixLayout::ColumnMajor);
+    for (qsizetype j = 0; j < columns.size() && rows > 0; ++j) {
+        std::memcpy(result.m_data + j * rows, columns[j].constData(), static_cast<size_t>(rows) * sizeof(double));
+    }
+    return result;
+}
+
+DenseMatrix DenseMatrix::fromTable(const Core::TableData& table, const QVector<int>& columns, MatrixLayout layout)
+{
+    QVector<int> sources = columns;
+    if (sources.isEmpty()) {
+        for (int col = 0; col < table.columnCount(); ++col) {
+            sources.append(col);
+        }
+    }
+    for (int col : sources) {
+        if (col < 0 || col >= table.columnCount()) {
+            qWarning() << "列索引无效:" << col;
+            return DenseMatrix();
+        }
+    }
+
+    const qsizetype rows = table.rowCount();
+    DenseMatrix result(rows, sources.size(), layout);
+    MatrixView target = result.view();
+
+    Parallel::forChunks(rows, Parallel::chunkCount(rows, MIN_ROWS_PER_CHUNK),
+                        [&](int, qsizetype begin, qsizetype end) {
+        for (qsizetype j = 0; j < sources.size(); ++j) {
+            for (qsizetype row = begin; row < end; ++row) {
+                target(row, j) = cellToDouble(table.at(static_cast<int>(row), sources[j]));
+            }
+        }
+    });
+
+    return result;
+}
+
+QVector<QVector<double>> DenseMatrix::toRows() const
+{
+    QVector<QVector<double>> result(m_rows, QVector<double>(m_cols));
+    for (qsizetype i = 0; i < m_rows; ++i) {
+        double* out = result[i].data();
+        for (qsizetype j = 0; j < m_cols; ++j) {
+            out[j] = (*this)(i, j);
+        }
+    }
+    return result;
+}
+
+// === 视图 ===
+
+MatrixView DenseMatrix::view()
+{
+    return m_layout == MatrixLayout::RowMajor ? MatrixView(m_data, m_rows, m_cols, m_cols, 1)
+                                              : MatrixView(m_data, m_rows, m_cols, 1, m_rows);
+}
+
+ConstMatrixView DenseMatrix::view() const
+{
+    return m_layout == MatrixLayout::RowMajor ? ConstMatrixView(m_data, m_rows, m_cols, m_cols, 1)
+                                              : ConstMatrixView(m_data, m_rows, m_cols, 1, m_rows);
+}
+
+MatrixView DenseMatrix::block(qsizetype row, qsizetype col, qsizetype rows, qsizetype cols)
+{
+    return view().block(row, col, rows, cols);
+}
+
+ConstMatrixView DenseMatrix::block(qsizetype row, qsizetype col, qsizetype rows, qsizetype cols) const
+{
+    return view().block(row, col, rows, cols);
+}
+
+void DenseMatrix::fill(double value)
+{
+    if (m_data) {
+        std::fill_n(m_data, size(), value);
+    }
+}
+
+} // namespace Statistics
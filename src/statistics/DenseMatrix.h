@@ -0,0 +1,232 @@
+#ifndef DENSEMATRIX_H
+#define DENSEMATRIX_H
+
+#include "core/TableData.h"
+#include <QVector>
+
+namespace Statistics {
+
+template<typename Derived>
+class MatrixExpression;
+
+/**
+ * @brief 稠密矩阵的存储顺序
+ */
+enum class MatrixLayout
+{
+    RowMajor,       // 行优先：同一行的元素连续
+    ColumnMajor     // 列优先：同一列的元素连续（与 BLAS/LAPACK 一致）
+};
+
+/**
+ * @brief 只读矩阵视图
+ *
+ * 不拥有数据，元素 (i, j) 位于 data[i·rowStride + j·colStride]。
+ * 子块、行、列与转置都只调整指针和步长，不复制数据；视图的有效期
+ * 不得超过底层矩阵。
+ */
+class ConstMatrixView
+{
+public:
+    ConstMatrixView() = default;
+    ConstMatrixView(const double* data, qsizetype rows, qsizetype cols, qsizetype rowStride, qsizetype colStride)
+        : m_data(data), m_rows(rows), m_cols(cols), m_rowStride(rowStride), m_colStride(colStride)
+    {
+    }
+
+    qsizetype rows() const { return m_rows; }
+    qsizetype cols() const { return m_cols; }
+    qsizetype rowStride() const { return m_rowStride; }
+    qsizetype colStride() const { return m_colStride; }
+    bool isEmpty() const { return m_rows == 0 || m_cols == 0; }
+
+    const double* data() const { return m_data; }
+    const double* ptr(qsizetype i, qsizetype j) const { return m_data + i * m_rowStride + j * m_colStride; }
+    double operator()(qsizetype i, qsizetype j) const { return m_data[i * m_rowStride + j * m_colStride]; }
+
+    /**
+     * @brief 行内元素是否连续（colStride == 1）
+     */
+    bool isRowContiguous() const { return m_colStride == 1 || m_cols <= 1; }
+
+    /**
+     * @brief 列内元素是否连续（rowStride == 1）
+     */
+    bool isColumnContiguous() const { return m_rowStride == 1 || m_rows <= 1; }
+
+    /**
+     * @brief 从 (row, col) 开始的 rows×cols 子块
+     */
+    ConstMatrixView block(qsizetype row, qsizetype col, qsizetype rows, qsizetype cols) const
+    {
+        return ConstMatrixView(ptr(row, col), rows, cols, m_rowStride, m_colStride);
+    }
+
+    ConstMatrixView row(qsizetype i) const { return block(i, 0, 1, m_cols); }
+    ConstMatrixView column(qsizetype j) const { return block(0, j, m_rows, 1); }
+    ConstMatrixView transposed() const { return ConstMatrixView(m_data, m_cols, m_rows, m_colStride, m_rowStride); }
+
+protected:
+    const double* m_data = nullptr;
+    qsizetype m_rows = 0;
+    qsizetype m_cols = 0;
+    qsizetype m_rowStride = 0;
+    qsizetype m_colStride = 0;
+};
+
+/**
+ * @brief 可写矩阵视图
+ */
+class MatrixView : public ConstMatrixView
+{
+public:
+    MatrixView() = default;
+    MatrixView(double* data, qsizetype rows, qsizetype cols, qsizetype rowStride, qsizetype colStride)
+        : ConstMatrixView(data, rows, cols, rowStride, colStride)
+    {
+    }
+
+    double* data() const { return const_cast<double*>(m_data); }
+    double* ptr(qsizetype i, qsizetype j) const { return data() + i * m_rowStride + j * m_colStride; }
+    double& operator()(qsizetype i, qsizetype j) const { return data()[i * m_rowStride + j * m_colStride]; }
+
+    MatrixView block(qsizetype row, qsizetype col, qsizetype rows, qsizetype cols) const
+    {
+        return MatrixView(ptr(row, col), rows, cols, m_rowStride, m_colStride);
+    }
+
+    MatrixView row(qsizetype i) const { return block(i, 0, 1, m_cols); }
+    MatrixView column(qsizetype j) const { return block(0, j, m_rows, 1); }
+    MatrixView transposed() const { return MatrixView(data(), m_cols, m_rows, m_colStride, m_rowStride); }
+
+    void fill(double value) const;
+
+    /**
+     * @brief 逐元素复制 source（维度须相同，两者不得部分重叠）
+     */
+    void assign(const ConstMatrixView& source) const;
+};
+
+/**
+ * @brief 稠密矩阵
+ *
+ * 所有元素存放在一块 64 字节对齐的连续缓冲区中（行优先或列优先），
+ * 每列/每行的起始位置不额外填充，便于与 QVector<double> 列互相拷贝。
+ * 复制构造做深拷贝，移动构造只转移缓冲区；需要共享数据时使用视图。
+ */
+class DenseMatrix
+{
+public:
+    DenseMatrix() = default;
+    DenseMatrix(qsizetype rows, qsizetype cols, MatrixLayout layout = MatrixLayout::RowMajor);
+    DenseMatrix(qsizetype rows, qsizetype cols, double value, MatrixLayout layout = MatrixLayout::RowMajor);
+    ~DenseMatrix();
+
+    DenseMatrix(const DenseMatrix& other);
+    DenseMatrix(DenseMatrix&& other) noexcept;
+    DenseMatrix& operator=(const DenseMatrix& other);
+    DenseMatrix& operator=(DenseMatrix&& other) noexcept;
+
+    // === 表达式模板（定义见 MatrixExpression.h） ===
+
+    /**
+     * @brief 由表达式（如 A + 2.0 * B）单循环求值构造，维度不匹配时为空矩阵
+     */
+    template<typename Derived>
+    DenseMatrix(const MatrixExpression<Derived>& expression, MatrixLayout layout = MatrixLayout::RowMajor);
+
+    template<typename Derived>
+    DenseMatrix& operator=(const MatrixExpression<Derived>& expression);
+
+    /**
+     * @brief 原地加/减矩阵或表达式（维度不匹配时输出警告，矩阵不变）
+     */
+    template<typename Operand>
+    DenseMatrix& operator+=(const Operand& operand);
+
+    template<typename Operand>
+    DenseMatrix& operator-=(const Operand& operand);
+
+    // === 构造 ===
+
+    static DenseMatrix zeros(qsizetype rows, qsizetype cols, MatrixLayout layout = MatrixLayout::RowMajor);
+    static DenseMatrix identity(qsizetype size, MatrixLayout layout = MatrixLayout::RowMajor);
+
+    /**
+     * @brief 复制视图中的数据
+     */
+    static DenseMatrix fromView(const ConstMatrixView& view, MatrixLayout layout = MatrixLayout::RowMajor);
+
+    /**
+     * @brief 由嵌套向量（按行）构造，各行长度须相同
+     */
+    static DenseMatrix fromRows(const QVector<QVector<double>>& rows);
+
+    /**
+     * @brief 由若干等长数据列构造列优先矩阵（每列一次连续拷贝）
+     */
+    static DenseMatrix fromColumns(const QVector<QVector<double>>& columns);
+
+    /**
+     * @brief 读取表格中的若干列（非数值单元格为 NaN），按行块并行转换
+     * @param columns 列索引（为空时使用所有列）
+     */
+    static DenseMatrix fromTable(const Core::TableData& table, const QVector<int>& columns = QVector<int>(),
+                                 MatrixLayout layout = MatrixLayout::ColumnMajor);
+
+    /**
+     * @brief 转换为嵌套向量（按行）
+     */
+    QVector<QVector<double>> toRows() const;
+
+    // === 访问 ===
+
+    qsizetype rows() const { return m_rows; }
+    qsizetype cols() const { return m_cols; }
+    qsizetype size() const { return m_rows * m_cols; }
+    bool isEmpty() const { return m_rows == 0 || m_cols == 0; }
+    MatrixLayout layout() const { return m_layout; }
+
+    /**
+     * @brief 相邻两行（行优先）或两列（列优先）起点之间的距离
+     */
+    qsizetype leadingDimension() const { return m_layout == MatrixLayout::RowMajor ? m_cols : m_rows; }
+
+    double* data() { return m_data; }
+    const double* data() const { return m_data; }
+
+    double& operator()(qsizetype i, qsizetype j) { return m_data[index(i, j)]; }
+    double operator()(qsizetype i, qsizetype j) const { return m_data[index(i, j)]; }
+
+    MatrixView view();
+    ConstMatrixView view() const;
+    operator ConstMatrixView() const { return view(); }
+
+    MatrixView block(qsizetype row, qsizetype col, qsizetype rows, qsizetype cols);
+    ConstMatrixView block(qsizetype row, qsizetype col, qsizetype rows, qsizetype cols) const;
+    MatrixView row(qsizetype i) { return view().row(i); }
+    ConstMatrixView row(qsizetype i) const { return view().row(i); }
+    MatrixView column(qsizetype j) { return view().column(j); }
+    ConstMatrixView column(qsizetype j) const { return view().column(j); }
+    ConstMatrixView transposed() const { return view().transposed(); }
+
+    void fill(double value);
+
+private:
+    qsizetype index(qsizetype i, qsizetype j) const
+    {
+        return m_layout == MatrixLayout::RowMajor ? i * m_cols + j : j * m_rows + i;
+    }
+
+    void allocate(qsizetype rows, qsizetype cols, MatrixLayout layout);
+    void release();
+
+    double* m_data = nullptr;
+    qsizetype m_rows = 0;
+    qsizetype m_cols = 0;
+    MatrixLayout m_layout = MatrixLayout::RowMajor;
+};
+
+} // namespace Statistics
+
+#endif // DENSEMATRIX_H
@@ -1,4 +1,5 @@
 #include "DescriptiveStats.h"
+#include "FrequencyCounter.h"
 #include <algorithm>
 #include <numeric>
 #include <cmath>
@@ -64,27 +65,22 @@ StatisticResult DescriptiveStats::median(const QVector<double>& data)
 
 StatisticResult DescriptiveStats::mode(const QVector<double>& data)
 {
-    QVector<double> validData = removeInvalid(data);
-    if (validData.isEmpty()) {
+    QVector<FrequencyItem> modeItems = FrequencyCounter::modes(data);
+    if (modeItems.isEmpty()) {
         return StatisticResult::error("没有有效数据");
     }
 
-    // 简化实现：使用 QMap 统计频次
-    QMap<double, int> frequency;
-    for (double value : validData) {
-        frequency[value]++;
-    }
+    return StatisticResult::ok(modeItems.first().value);
+}
 
-    double modeValue = validData[0];
-    int maxCount = 0;
-    for (auto it = frequency.begin(); it != frequency.end(); ++it) {
-        if (it.value() > maxCount) {
-            maxCount = it.value();
-            modeValue = it.key();
-        }
-    }
+QVector<FrequencyItem> DescriptiveStats::modes(const QVector<double>& data)
+{
+    return FrequencyCounter::modes(data);
+}
 
-    return StatisticResult::ok(modeValue);
+TopKResult DescriptiveStats::topValues(const QVector<double>& data, int k)
+{
+    return FrequencyCounter::topK(data, k);
 }
 
 StatisticResult DescriptiveStats::geometricMean(const QVector<double>& data)
@@ -368,6 +364,7 @@ DescriptiveSummary DescriptiveStats::summarize(const QVector<double>& data)
     summary.sum = sumResult.value;
     summary.mean = meanResult.value;
     summary.median = medianResult.value;
+    summary.mode = mode(validData).value;
     summary.variance = varResult.value;
     summary.stdDev = stdResult.value;
     summary.min = minResult.value;
@@ -383,9 +380,20 @@ DescriptiveSummary DescriptiveStats::summarize(const QVector<double>& data)
     summary.skewness = skewness(validData).value;
     summary.kurtosis = kurtosis(validData).value;
 
+    // 高频值
+    summary.topValues = topValues(validData, 5).items;
+
     return summary;
 }
 
+// === 置信区间 ===
+
+BootstrapInterval DescriptiveStats::bootstrapInterval(const QVector<double>& data, BootstrapStatistic statistic,
+                                                      const BootstrapOptions& options, double percentile)
+{
+    return Bootstrap::interval(data, statistic, options, percentile);
+}
+
 // === 辅助函数 ===
 
 QVector<double> DescriptiveStats::removeInvalid(const QVector<double>& data)
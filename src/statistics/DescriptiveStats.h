@@ -2,6 +2,7 @@
 #define DESCRIPTIVESTATS_H
 
 #include "StatisticTypes.h"
+#include "Bootstrap.h"
 #include <QVector>
 #include <algorithm>
 #include <cmath>
@@ -35,10 +36,20 @@ public:
     static StatisticResult median(const QVector<double>& data);
 
     /**
-     * @brief 计算众数
+     * @brief 计算众数（多个众数时返回最小者）
      */
     static StatisticResult mode(const QVector<double>& data);
 
+    /**
+     * @brief 计算所有众数
+     */
+    static QVector<FrequencyItem> modes(const QVector<double>& data);
+
+    /**
+     * @brief 计算出现次数最多的 k 个值
+     */
+    static TopKResult topValues(const QVector<double>& data, int k);
+
     /**
      * @brief 计算几何均值
      */
@@ -137,6 +148,16 @@ public:
      */
     static DescriptiveSummary summarize(const QVector<double>& data);
 
+    // === 置信区间 ===
+
+    /**
+     * @brief 均值、中位数、分位数或标准差的自助法置信区间（NaN 跳过，见 Bootstrap）
+     * @param percentile 分位数（0-100，仅 BootstrapStatistic::Quantile 使用）
+     */
+    static BootstrapInterval bootstrapInterval(const QVector<double>& data, BootstrapStatistic statistic,
+                                               const BootstrapOptions& options = BootstrapOptions(),
+                                               double percentile = 50.0);
+
 private:
     // 辅助函数
     static QVector<double> removeInvalid(const QVector<double>& data);
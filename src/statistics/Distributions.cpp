@@ -0,0 +1,186 @@
+#include "Distributions.h"
+#include <cmath>
+#include <limits>
+
+namespace Statistics {
+
+namespace {
+
+const double NaN = std::numeric_limits<double>::quiet_NaN();
+const double PI = 3.14159265358979323846;
+
+const int MAX_CF_ITERATIONS = 300;
+const double CF_EPSILON = 1e-15;
+const double CF_TINY = 1e-300;
+
+/**
+ * 不完全 Beta 函数的连分式（修正 Lentz 算法）
+ */
+double betaContinuedFraction(double a, double b, double x)
+{
+    double qab = a + b;
+    double qap = a + 1.0;
+    double qam = a - 1.0;
+    double c = 1.0;
+    double d = 1.0 - qab * x / qap;
+    if (std::fabs(d) < CF_TINY) d = CF_TINY;
+    d = 1.0 / d;
+    double h = d;
+
+    for (int m = 1; m <= MAX_CF_ITERATIONS; ++m) {
+        int m2 = 2 * m;
+        double aa = m * (b - m) * x / ((qam + m2) * (a + m2));
+        d = 1.0 + aa * d;
+        if (std::fabs(d) < CF_TINY) d = CF_TINY;
+        c = 1.0 + aa / c;
+        if (std::fabs(c) < CF_TINY) c = CF_TINY;
+        d = 1.0 / d;
+        h *= d * c;
+
+        aa = -(a + m) * (qab + m) * x / ((a + m2) * (qap + m2));
+        d = 1.0 + aa * d;
+        if (std::fabs(d) < CF_TINY) d = CF_TINY;
+        c = 1.0 + aa / c;
+        if (std::fabs(c) < CF_TINY) c = CF_TINY;
+        d = 1.0 / d;
+        double delta = d * c;
+        h *= delta;
+        if (std::fabs(delta - 1.0) < CF_EPSILON) {
+            break;
+        }
+    }
+    return h;
+}
+
+double studentTDensity(double t, double nu)
+{
+    double logNorm = std::lgamma((nu + 1.0) / 2.0) - std::lgamma(nu / 2.0) - 0.5 * std::log(nu * PI);
+    return std::exp(logNorm - (nu + 1.0) / 2.0 * std::log1p(t * t / nu));
+}
+
+} // namespace
+
+// === 标准正态分布 ===
+
+double Distributions::normalCdf(double x)
+{
+    return 0.5 * std::erfc(-x / std::sqrt(2.0));
+}
+
+double Distributions::normalQuantile(double p)
+{
+    if (!(p > 0.0 && p < 1.0)) {
+        if (p == 0.0) return -std::numeric_limits<double>::infinity();
+        if (p == 1.0) return std::numeric_limits<double>::infinity();
+        return NaN;
+    }
+
+    static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                               1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+    static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                               6.680131188771972e+01, -1.328068155288572e+01};
+    static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                               -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+    static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                               3.754408661907416e+00};
+    const double low = 0.02425;
+
+    double x;
+    if (p < low) {
+        double q = std::sqrt(-2.0 * std::log(p));
+        x = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+            ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    } else if (p <= 1.0 - low) {
+        double q = p - 0.5;
+        double r = q * q;
+        x = (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+            (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+    } else {
+        double q = std::sqrt(-2.0 * std::log1p(-p));
+        x = -(((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+            ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    }
+
+    // 一次 Halley 修正
+    double e = normalCdf(x) - p;
+    double u = e * std::sqrt(2.0 * PI) * std::exp(x * x / 2.0);
+    return x - u / (1.0 + x * u / 2.0);
+}
+
+// === t 分布 ===
+
+double Distributions::studentTCdf(double t, double degreesOfFreedom)
+{
+    if (!(degreesOfFreedom > 0.0) || std::isnan(t)) {
+        return NaN;
+    }
+    if (std::isinf(t)) {
+        return t > 0.0 ? 1.0 : 0.0;
+    }
+
+    double x = degreesOfFreedom / (degreesOfFreedom + t * t);
+    double tail = 0.5 * incompleteBeta(degreesOfFreedom / 2.0, 0.5, x);
+    return t > 0.0 ? 1.0 - tail : tail;
+}
+
+double Distributions::studentTQuantile(double p, double degreesOfFreedom)
+{
+    const double nu = degreesOfFreedom;
+    if (!(nu > 0.0) || !(p > 0.0 && p < 1.0)) {
+        return NaN;
+    }
+
+    // 自由度 1、2 有闭式解
+    if (nu == 1.0) {
+        return std::tan(PI * (p - 0.5));
+    }
+    if (nu == 2.0) {
+        return (2.0 * p - 1.0) / std::sqrt(2.0 * p * (1.0 - p));
+    }
+
+    // Cornish-Fisher 展开（Abramowitz & Stegun 26.7.5）
+    double z = normalQuantile(p);
+    double z2 = z * z;
+    double g1 = (z2 + 1.0) * z / 4.0;
+    double g2 = ((5.0 * z2 + 16.0) * z2 + 3.0) * z / 96.0;
+    double g3 = (((3.0 * z2 + 19.0) * z2 + 17.0) * z2 - 15.0) * z / 384.0;
+    double g4 = ((((79.0 * z2 + 776.0) * z2 + 1482.0) * z2 - 1920.0) * z2 - 945.0) * z / 92160.0;
+    double t = z + g1 / nu + g2 / (nu * nu) + g3 / (nu * nu * nu) + g4 / (nu * nu * nu * nu);
+
+    // 牛顿法修正
+    for (int iteration = 0; iteration < 8; ++iteration) {
+        double density = studentTDensity(t, nu);
+        if (!(density > 0.0)) {
+            break;
+        }
+        double step = (studentTCdf(t, nu) - p) / density;
+        t -= step;
+        if (std::fabs(step) <= 1e-12 * (1.0 + std::fabs(t))) {
+            break;
+        }
+    }
+    return t;
+}
+
+// === 特殊函数 ===
+
+double Distributions::incompleteBeta(double a, double b, double x)
+{
+    if (!(a > 0.0 && b > 0.0) || std::isnan(x)) {
+        return NaN;
+    }
+    if (x <= 0.0) return 0.0;
+    if (x >= 1.0) return 1.0;
+
+    double logFront = std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) +
+                      a * std::log(x) + b * std::log1p(-x);
+    double front = std::exp(logFront);
+
+    // 连分式在 x < (a+1)/(a+b+2) 时收敛较快，否则利用对称性
+    if (x < (a + 1.0) / (a + b + 2.0)) {
+        return front * betaContinuedFraction(a, b, x) / a;
+    }
+    return 1.0 - front * betaContinuedFraction(b, a, 1.0 - x) / b;
+}
+
+} // namespace Statistics
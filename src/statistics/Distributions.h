@@ -0,0 +1,43 @@
+#ifndef DISTRIBUTIONS_H
+#define DISTRIBUTIONS_H
+
+namespace Statistics {
+
+/**
+ * @brief 常用概率分布的分布函数与分位数
+ *
+ * 用于置信区间和预测区间。参数无效（如概率不在 (0, 1) 内、自由度
+ * 不为正）时返回 NaN。
+ */
+class Distributions
+{
+public:
+    // === 标准正态分布 ===
+
+    static double normalCdf(double x);
+
+    /**
+     * @brief 标准正态分布分位数（Acklam 有理逼近 + 一次 Halley 修正，相对误差约 1e-15）
+     */
+    static double normalQuantile(double p);
+
+    // === t 分布 ===
+
+    static double studentTCdf(double t, double degreesOfFreedom);
+
+    /**
+     * @brief t 分布分位数（Cornish-Fisher 展开作初值，再用牛顿法修正）
+     */
+    static double studentTQuantile(double p, double degreesOfFreedom);
+
+    // === 特殊函数 ===
+
+    /**
+     * @brief 正则化不完全 Beta 函数 I_x(a, b)（连分式展开）
+     */
+    static double incompleteBeta(double a, double b, double x);
+};
+
+} // namespace Statistics
+
+#endif // DISTRIBUTIONS_H
@@ -0,0 +1,513 @@
+#include "FFT.h"
+#include "ParallelUtils.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Statistics {
+
+namespace {
+
+const double TWO_PI = 6.28318530717958647692;
+
+// 两级旋转因子表：低位表的位数
+const int LOW_BITS = 10;
+const qsizetype LOW_SIZE = qsizetype(1) << LOW_BITS;
+
+// 前若干级蝶形逐块完成的块长（复数个数，32 KB）
+const qsizetype SMALL_BLOCK = 2048;
+
+// 其余各级每次合并的级数与"列"宽（64 行 × 8 个复数 = 8 KB）
+const int GROUP_STAGES = 6;
+const qsizetype COLUMN_WIDTH = 8;
+
+// 位反转置换的小块边长（2^4 = 16）
+const int TILE_BITS = 4;
+
+// 并行时每个任务至少处理的复数个数
+const qsizetype MIN_PARALLEL_ELEMENTS = qsizetype(1) << 15;
+
+// 不经过 std::complex 的乘法（避免 NaN/Inf 检查的库函数调用）
+inline Complex mul(const Complex& a, const Complex& b)
+{
+    return Complex(a.real() * b.real() - a.imag() * b.imag(),
+                   a.real() * b.imag() + a.imag() * b.real());
+}
+
+inline double norm2(const Complex& a)
+{
+    return a.real() * a.real() + a.imag() * a.imag();
+}
+
+/**
+ * @brief 旋转因子 e^(-2πi·m/n) = 高位表[m >> 10] × 低位表[m & 1023]（逆变换取共轭）
+ */
+struct Twiddles
+{
+    QVector<Complex> low;
+    QVector<Complex> high;
+
+    explicit Twiddles(qsizetype n, bool conjugate = false)
+    {
+        const double sign = conjugate ? 1.0 : -1.0;
+        low.resize(LOW_SIZE);
+        for (qsizetype j = 0; j < LOW_SIZE; ++j) {
+            low[j] = std::polar(1.0, sign * TWO_PI * static_cast<double>(j) / static_cast<double>(n));
+        }
+        high.resize(n / LOW_SIZE + 1);
+        for (qsizetype j = 0; j < high.size(); ++j) {
+            high[j] = std::polar(1.0, sign * TWO_PI * static_cast<double>(j * LOW_SIZE) / static_cast<double>(n));
+        }
+    }
+
+    Complex operator()(qsizetype m) const
+    {
+        return mul(high[m >> LOW_BITS], low[m & (LOW_SIZE - 1)]);
+    }
+};
+
+template<typename Body>
+void parallelRange(qsizetype count, qsizetype grain, Body body)
+{
+    Parallel::forChunks(count, Parallel::chunkCount(count, grain),
+                        [&](int, qsizetype begin, qsizetype end) { body(begin, end); });
+}
+
+int log2Exact(qsizetype n)
+{
+    int bits = 0;
+    while ((qsizetype(1) << bits) < n) {
+        ++bits;
+    }
+    return bits;
+}
+
+/**
+ * @brief 位反转置换
+ *
+ * 下标按位拆为 [a | m | c]（a、c 各 TILE_BITS 位），其反转为
+ * [rev(c) | rev(m) | rev(a)]。对每对 (m, rev(m)) 读入两个 16×16 的
+ * 小块再交叉写回，每次访问的都是连续 16 个复数，避免逐元素随机访问。
+ */
+void bitReverse(Complex* data, qsizetype n)
+{
+    const int bits = log2Exact(n);
+    quint32 rev8[256];
+    for (quint32 i = 0; i < 256; ++i) {
+        quint32 r = 0;
+        for (int b = 0; b < 8; ++b) {
+            r |= ((i >> b) & 1u) << (7 - b);
+        }
+        rev8[i] = r;
+    }
+    auto reverse = [&rev8](quint32 v, int width) {
+        quint32 r = (rev8[v & 255u] << 24) | (rev8[(v >> 8) & 255u] << 16) |
+                    (rev8[(v >> 16) & 255u] << 8) | rev8[v >> 24];
+        return width > 0 ? r >> (32 - width) : 0u;
+    };
+
+    if (bits < 2 * TILE_BITS) {
+        for (qsizetype i = 0; i < n; ++i) {
+            qsizetype j = static_cast<qsizetype>(reverse(static_cast<quint32>(i), bits));
+            if (i < j) {
+                std::swap(data[i], data[j]);
+            }
+        }
+        return;
+    }
+
+    const qsizetype tile = qsizetype(1) << TILE_BITS;
+    const int middleBits = bits - 2 * TILE_BITS;
+    const int highShift = bits - TILE_BITS;
+    quint32 revTile[16];
+    for (quint32 c = 0; c < static_cast<quint32>(tile); ++c) {
+        revTile[c] = reverse(c, TILE_BITS);
+    }
+
+    const qsizetype middles = qsizetype(1) << middleBits;
+    parallelRange(middles, std::max<qsizetype>(1, MIN_PARALLEL_ELEMENTS / (tile * tile)),
+                  [&](qsizetype begin, qsizetype end) {
+        Complex first[16][16];
+        Complex second[16][16];
+        for (qsizetype m = begin; m < end; ++m) {
+            const qsizetype mr = reverse(static_cast<quint32>(m), middleBits);
+            if (mr < m) {
+                continue;   // 由较小的一方处理
+            }
+
+            for (qsizetype a = 0; a < tile; ++a) {
+                const Complex* row = data + (a << highShift) + (m << TILE_BITS);
+                std::copy(row, row + tile, first[a]);
+                if (mr != m) {
+                    const Complex* other = data + (a << highShift) + (mr << TILE_BITS);
+                    std::copy(other, other + tile, second[a]);
+                }
+            }
+
+            // 元素 [a | m | c] 写到 [rev(c) | rev(m) | rev(a)]
+            for (qsizetype c = 0; c < tile; ++c) {
+                Complex* target = data + (static_cast<qsizetype>(revTile[c]) << highShift) + (mr << TILE_BITS);
+                for (qsizetype a = 0; a < tile; ++a) {
+                    target[revTile[a]] = first[a][c];
+                }
+                if (mr != m) {
+                    Complex* back = data + (static_cast<qsizetype>(revTile[c]) << highShift) + (m << TILE_BITS);
+                    for (qsizetype a = 0; a < tile; ++a) {
+                        back[revTile[a]] = second[a][c];
+                    }
+                }
+            }
+        }
+    });
+}
+
+/**
+ * @brief 合并相邻两级的基 4 蝶形
+ *
+ * 第一级 (x0,x1)、(x2,x3) 的旋转因子为 wa = wb²，第二级 (x0,x2) 为 wb，
+ * (x1,x3) 为 wb·(∓i)。
+ */
+inline void radix4(Complex& x0, Complex& x1, Complex& x2, Complex& x3, const Complex& wb, bool inverse)
+{
+    Complex wa = mul(wb, wb);
+    Complex t1 = mul(x1, wa);
+    Complex t3 = mul(x3, wa);
+    Complex u0 = x0 + t1;
+    Complex u1 = x0 - t1;
+    Complex u2 = x2 + t3;
+    Complex u3 = x2 - t3;
+    Complex v2 = mul(u2, wb);
+    Complex v3 = mul(u3, wb);
+    Complex r3 = inverse ? Complex(-v3.imag(), v3.real()) : Complex(v3.imag(), -v3.real());
+    x0 = u0 + v2;
+    x2 = u0 - v2;
+    x1 = u1 + r3;
+    x3 = u1 - r3;
+}
+
+inline void radix2(Complex& x0, Complex& x1, const Complex& w)
+{
+    Complex t = mul(x1, w);
+    Complex u = x0;
+    x0 = u + t;
+    x1 = u - t;
+}
+
+/**
+ * @brief 块长不超过 SMALL_BLOCK 的各级蝶形，逐块完成
+ */
+void smallStages(Complex* data, qsizetype n, const Twiddles& twiddles, bool inverse)
+{
+    const qsizetype block = std::min(n, SMALL_BLOCK);
+
+    // 块内各级共用 e^(-2πi·p/block)，半长为 h 的一级取步长 block/(2h)
+    QVector<Complex> table(block / 2);
+    for (qsizetype p = 0; p < block / 2; ++p) {
+        table[p] = twiddles(p * (n / block));
+    }
+
+    parallelRange(n / block, std::max<qsizetype>(1, MIN_PARALLEL_ELEMENTS / block),
+                  [&](qsizetype begin, qsizetype end) {
+        for (qsizetype b = begin; b < end; ++b) {
+            Complex* x = data + b * block;
+            qsizetype h = 1;
+            while (h < block) {
+                if (4 * h <= block) {
+                    const qsizetype stride = block / (4 * h);
+                    for (qsizetype s = 0; s < block; s += 4 * h) {
+                        for (qsizetype p = 0; p < h; ++p) {
+                            radix4(x[s + p], x[s + p + h], x[s + p + 2 * h], x[s + p + 3 * h],
+                                   table[p * stride], inverse);
+                        }
+                    }
+                    h *= 4;
+                } else {
+                    const qsizetype stride = block / (2 * h);
+                    for (qsizetype s = 0; s < block; s += 2 * h) {
+                        for (qsizetype p = 0; p < h; ++p) {
+                            radix2(x[s + p], x[s + p + h], table[p * stride]);
+                        }
+                    }
+                    h *= 2;
+                }
+            }
+        }
+    });
+}
+
+/**
+ * @brief 其余各级：每 GROUP_STAGES 级一遍扫描，按"列"在缓存中完成
+ *
+ * 半长为 hStart 起的连续若干级中，元素 b + i + j·hStart（j = 0..2^级数-1）
+ * 只与同一列的元素做蝶形运算，连续 COLUMN_WIDTH 个 i 组成一列；
+ * 列内相邻两级合并为基 4 蝶形。
+ */
+void largeStages(Complex* data, qsizetype n, const Twiddles& twiddles, bool inverse)
+{
+    for (qsizetype hStart = SMALL_BLOCK; hStart < n;) {
+        int stages = 0;
+        qsizetype span = hStart;
+        while (stages < GROUP_STAGES && span < n) {
+            span *= 2;
+            ++stages;
+        }
+
+        const qsizetype rows = span / hStart;
+        const qsizetype columns = hStart / COLUMN_WIDTH;
+        const qsizetype tasks = (n / span) * columns;
+
+        parallelRange(tasks, std::max<qsizetype>(1, MIN_PARALLEL_ELEMENTS / (rows * COLUMN_WIDTH)),
+                      [&](qsizetype begin, qsizetype end) {
+            for (qsizetype task = begin; task < end; ++task) {
+                const qsizetype base = (task / columns) * span;
+                const qsizetype i0 = (task % columns) * COLUMN_WIDTH;
+                Complex* column = data + base + i0;
+
+                int t = 0;
+                while (t < stages) {
+                    const qsizetype half = qsizetype(1) << t;
+                    const qsizetype hh = hStart << t;
+
+                    if (t + 1 < stages) {
+                        const qsizetype step = n / (4 * hh);
+                        for (qsizetype j = 0; j < rows; j += 4 * half) {
+                            for (qsizetype jj = 0; jj < half; ++jj) {
+                                Complex* x0 = column + (j + jj) * hStart;
+                                const qsizetype p0 = i0 + jj * hStart;
+                                for (qsizetype k = 0; k < COLUMN_WIDTH; ++k) {
+                                    radix4(x0[k], x0[k + hh], x0[k + 2 * hh], x0[k + 3 * hh],
+                                           twiddles((p0 + k) * step), inverse);
+                                }
+                            }
+                        }
+                        t += 2;
+                    } else {
+                        const qsizetype step = n / (2 * hh);
+                        for (qsizetype j = 0; j < rows; j += 2 * half) {
+                            for (qsizetype jj = 0; jj < half; ++jj) {
+                                Complex* x0 = column + (j + jj) * hStart;
+                                const qsizetype p0 = i0 + jj * hStart;
+                                for (qsizetype k = 0; k < COLUMN_WIDTH; ++k) {
+                                    radix2(x0[k], x0[k + hh], twiddles((p0 + k) * step));
+                                }
+                            }
+                        }
+                        t += 1;
+                    }
+                }
+            }
+        });
+
+        hStart = span;
+    }
+}
+
+void transform(Complex* data, qsizetype n, bool inverse)
+{
+    if (n <= 1) {
+        return;
+    }
+
+    Twiddles twiddles(n, inverse);
+    bitReverse(data, n);
+    smallStages(data, n, twiddles, inverse);
+    largeStages(data, n, twiddles, inverse);
+}
+
+/**
+ * @brief 由 n/2 点复数变换 Z 的一对频点 (k, M-k) 得到实序列的 X_k
+ *
+ * X_k = E + w^k·O，X_(M-k) = conj(E - w^k·O)，
+ * 其中 E = (Z_k + conj(Z_(M-k)))/2，O = -i·(Z_k - conj(Z_(M-k)))/2。
+ */
+inline void splitPair(const Complex& zk, const Complex& zm, const Complex& w, Complex& xk, Complex& xm)
+{
+    Complex e = 0.5 * (zk + std::conj(zm));
+    Complex d = zk - std::conj(zm);
+    Complex o(0.5 * d.imag(), -0.5 * d.real());
+    Complex wo = mul(w, o);
+    xk = e + wo;
+    xm = std::conj(e - wo);
+}
+
+/**
+ * @brief splitPair 的逆：由实序列频谱的 (X_k, X_(M-k)) 恢复 Z_k
+ *
+ * Z_k = E + i·O，E = (X_k + conj(X_(M-k)))/2，O = (X_k - conj(X_(M-k)))·conj(w^k)/2。
+ */
+inline Complex mergePair(const Complex& xk, const Complex& xm, const Complex& w)
+{
+    Complex e = 0.5 * (xk + std::conj(xm));
+    Complex o = mul(0.5 * (xk - std::conj(xm)), std::conj(w));
+    return Complex(e.real() - o.imag(), e.imag() + o.real());
+}
+
+} // namespace
+
+qsizetype FFT::paddedSize(qsizetype n)
+{
+    qsizetype size = 1;
+    while (size < n) {
+        size *= 2;
+    }
+    return size;
+}
+
+void FFT::forward(Complex* data, qsizetype n)
+{
+    transform(data, n, false);
+}
+
+void FFT::inverse(Complex* data, qsizetype n)
+{
+    transform(data, n, true);
+
+    const double scale = 1.0 / static_cast<double>(n);
+    parallelRange(n, MIN_PARALLEL_ELEMENTS, [&](qsizetype begin, qsizetype end) {
+        for (qsizetype i = begin; i < end; ++i) {
+            data[i] *= scale;
+        }
+    });
+}
+
+QVector<Complex> FFT::realForward(const QVector<double>& x, qsizetype size)
+{
+    if (size <= 0) {
+        size = paddedSize(x.size());
+    }
+    size = std::max<qsizetype>(2, paddedSize(size));
+    const qsizetype m = size / 2;
+    const qsizetype n = std::min<qsizetype>(x.size(), size);
+
+    // 偶数下标为实部、奇数下标为虚部，打包为 M 点复数序列
+    QVector<Complex> spectrum(m + 1);
+    Complex* z = spectrum.data();
+    for (qsizetype j = 0; j < m; ++j) {
+        double re = 2 * j < n ? x[2 * j] : 0.0;
+        double im = 2 * j + 1 < n ? x[2 * j + 1] : 0.0;
+        z[j] = Complex(re, im);
+    }
+    forward(z, m);
+
+    Twiddles twiddles(size);
+    const Complex z0 = z[0];
+    parallelRange(m / 2 + 1, MIN_PARALLEL_ELEMENTS, [&](qsizetype begin, qsizetype end) {
+        for (qsizetype k = std::max<qsizetype>(1, begin); k < end; ++k) {
+            Complex xk, xm;
+            splitPair(z[k], z[m - k], twiddles(k), xk, xm);
+            z[k] = xk;
+            z[m - k] = xm;
+        }
+    });
+    z[0] = Complex(z0.real() + z0.imag(), 0.0);
+    z[m] = Complex(z0.real() - z0.imag(), 0.0);
+    return spectrum;
+}
+
+QVector<double> FFT::realInverse(const QVector<Complex>& spectrum, qsizetype size)
+{
+    size = std::max<qsizetype>(2, paddedSize(size));
+    const qsizetype m = size / 2;
+    if (spectrum.size() != m + 1) {
+        return QVector<double>();
+    }
+
+    Twiddles twiddles(size);
+    QVector<Complex> buffer(m);
+    Complex* z = buffer.data();
+    parallelRange(m, MIN_PARALLEL_ELEMENTS, [&](qsizetype begin, qsizetype end) {
+        for (qsizetype k = begin; k < end; ++k) {
+            z[k] = mergePair(spectrum[k], spectrum[m - k], twiddles(k));
+        }
+    });
+    inverse(z, m);
+
+    QVector<double> x(size);
+    for (qsizetype j = 0; j < m; ++j) {
+        x[2 * j] = z[j].real();
+        x[2 * j + 1] = z[j].imag();
+    }
+    return x;
+}
+
+QVector<double> FFT::autocorrelation(const double* x, qsizetype n, qsizetype maxLag)
+{
+    maxLag = std::clamp<qsizetype>(maxLag, 0, std::max<qsizetype>(0, n - 1));
+    const qsizetype size = std::max<qsizetype>(2, paddedSize(n + maxLag));
+    const qsizetype m = size / 2;
+
+    QVector<Complex> buffer(m, Complex(0.0, 0.0));
+    Complex* z = buffer.data();
+    parallelRange(m, MIN_PARALLEL_ELEMENTS, [&](qsizetype begin, qsizetype end) {
+        for (qsizetype j = begin; j < end; ++j) {
+            double re = 2 * j < n ? x[2 * j] : 0.0;
+            double im = 2 * j + 1 < n ? x[2 * j + 1] : 0.0;
+            z[j] = Complex(re, im);
+        }
+    });
+    forward(z, m);
+
+    // 成对处理 (k, M-k)：求实序列频谱的 |X|²，再原地打包为逆变换的输入
+    Twiddles twiddles(size);
+    const Complex z0 = z[0];
+    parallelRange(m / 2 + 1, MIN_PARALLEL_ELEMENTS, [&](qsizetype begin, qsizetype end) {
+        for (qsizetype k = std::max<qsizetype>(1, begin); k < end; ++k) {
+            const Complex w = twiddles(k);
+            Complex xk, xm;
+            splitPair(z[k], z[m - k], w, xk, xm);
+            Complex sk(norm2(xk), 0.0);
+            Complex sm(norm2(xm), 0.0);
+            z[k] = mergePair(sk, sm, w);
+            z[m - k] = mergePair(sm, sk, Complex(-w.real(), w.imag()));   // w^(M-k) = -conj(w^k)
+        }
+    });
+    const double s0 = (z0.real() + z0.imag()) * (z0.real() + z0.imag());
+    const double sm = (z0.real() - z0.imag()) * (z0.real() - z0.imag());
+    z[0] = mergePair(Complex(s0, 0.0), Complex(sm, 0.0), Complex(1.0, 0.0));
+    inverse(z, m);
+
+    QVector<double> result(maxLag + 1);
+    for (qsizetype k = 0; k <= maxLag; ++k) {
+        result[k] = k % 2 == 0 ? z[k / 2].real() : z[k / 2].imag();
+    }
+    return result;
+}
+
+QVector<double> FFT::crossCorrelation(const double* x, const double* y, qsizetype n, qsizetype maxLag)
+{
+    maxLag = std::clamp<qsizetype>(maxLag, 0, std::max<qsizetype>(0, n - 1));
+    const qsizetype size = std::max<qsizetype>(2, paddedSize(n + maxLag));
+
+    // z = x + i·y，一次复数变换同时得到 X 与 Y
+    QVector<Complex> buffer(size, Complex(0.0, 0.0));
+    Complex* z = buffer.data();
+    parallelRange(n, MIN_PARALLEL_ELEMENTS, [&](qsizetype begin, qsizetype end) {
+        for (qsizetype j = begin; j < end; ++j) {
+            z[j] = Complex(x[j], y[j]);
+        }
+    });
+    forward(z, size);
+
+    // C_k = X_k·conj(Y_k)，C_(N-k) = conj(C_k)
+    parallelRange(size / 2 + 1, MIN_PARALLEL_ELEMENTS, [&](qsizetype begin, qsizetype end) {
+        for (qsizetype k = begin; k < end; ++k) {
+            const qsizetype mirror = (size - k) % size;
+            Complex zk = z[k];
+            Complex zm = std::conj(z[mirror]);
+            Complex xk = 0.5 * (zk + zm);
+            Complex d = zk - zm;
+            Complex yk(0.5 * d.imag(), -0.5 * d.real());
+            Complex ck = mul(xk, std::conj(yk));
+            z[k] = ck;
+            z[mirror] = std::conj(ck);
+        }
+    });
+    inverse(z, size);
+
+    QVector<double> result(2 * maxLag + 1);
+    for (qsizetype k = -maxLag; k <= maxLag; ++k) {
+        result[k + maxLag] = z[(k + size) % size].real();
+    }
+    return result;
+}
+
+} // namespace Statistics
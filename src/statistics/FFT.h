@@ -0,0 +1,71 @@
+#ifndef FFT_H
+#define FFT_H
+
+#include <QVector>
+#include <complex>
+
+namespace Statistics {
+
+using Complex = std::complex<double>;
+
+/**
+ * @brief 快速傅里叶变换
+ *
+ * 迭代式时间抽取（DIT）变换，相邻两级合并为基 4 蝶形（级数为奇数时
+ * 最后补一级基 2）。长度须为 2 的幂，其他长度的输入由调用方补零到
+ * paddedSize()。为了在大规模数据上保持缓存友好：
+ * - 前若干级蝶形（块长不超过 2048 个复数）逐块完成，数据留在 L1/L2
+ * - 其余各级每 6 级合并为一遍扫描：每次取连续 8 个复数宽、64 行的
+ *   "列"，在缓存中完成这 6 级后再处理下一列
+ * 旋转因子用两级表（高位表 × 低位表）相乘得到，表的大小约为 √n，
+ * 不需要按变换长度缓存大表。各块、各列之间并行执行。
+ *
+ * 实数序列用 n/2 点复数变换加一次拆分得到 n/2+1 个频点。
+ */
+class FFT
+{
+public:
+    /**
+     * @brief 不小于 n 的最小 2 的幂
+     */
+    static qsizetype paddedSize(qsizetype n);
+
+    /**
+     * @brief 原地正变换 X_k = Σ x_j·e^(-2πijk/n)（n 须为 2 的幂）
+     */
+    static void forward(Complex* data, qsizetype n);
+
+    /**
+     * @brief 原地逆变换（含 1/n 缩放）
+     */
+    static void inverse(Complex* data, qsizetype n);
+
+    /**
+     * @brief 实序列补零到 size 点后的正变换
+     * @param size 变换长度（2 的幂，至少为 2；0 表示 paddedSize(x.size())）
+     * @return 频点 0..size/2 的系数
+     */
+    static QVector<Complex> realForward(const QVector<double>& x, qsizetype size = 0);
+
+    /**
+     * @brief realForward 的逆变换（spectrum 为频点 0..size/2 的系数）
+     */
+    static QVector<double> realInverse(const QVector<Complex>& spectrum, qsizetype size);
+
+    /**
+     * @brief 自相关和 r_k = Σ_t x_t·x_(t+k)，k = 0..maxLag
+     *
+     * 补零到不小于 n + maxLag 的 2 的幂，避免循环卷绕；功率谱在复数
+     * 缓冲区中原地计算，内存约为补零后长度的 8 字节/点。
+     */
+    static QVector<double> autocorrelation(const double* x, qsizetype n, qsizetype maxLag);
+
+    /**
+     * @brief 互相关和 r_k = Σ_t x_(t+k)·y_t，k = -maxLag..maxLag（下标 k + maxLag）
+     */
+    static QVector<double> crossCorrelation(const double* x, const double* y, qsizetype n, qsizetype maxLag);
+};
+
+} // namespace Statistics
+
+#endif // FFT_H
@@ -0,0 +1,721 @@
+#include "Factorizations.h"
+#include "Gemm.h"
+#include <QDebug>
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Statistics {
+
+namespace {
+
+// 分块宽度：LU/Cholesky 的面板与三角求解的对角块为 64 列，QR 面板为 32 列
+const qsizetype LU_BLOCK = 64;
+const qsizetype CHOLESKY_BLOCK = 64;
+const qsizetype QR_BLOCK = 32;
+const qsizetype TRIANGULAR_BLOCK = 64;
+
+// R 的对角元低于最大对角元的该倍数时视为列不满秩
+const double QR_RANK_TOLERANCE = 1e-12;
+
+// Hager–Higham 估计的最大迭代次数
+const int CONDITION_ITERATIONS = 5;
+
+/**
+ * @brief 分块三角求解 T·X = B，X 原地由 B 变为解
+ *
+ * 只读取 T 中 lower 指定的三角部分；unitDiagonal 为真时对角元视为 1。
+ * 对角块逐列前代/回代，其余部分用 GEMM 更新。T 可以是转置视图。
+ */
+void triangularSolve(const ConstMatrixView& T, const MatrixView& X, bool lower, bool unitDiagonal)
+{
+    const qsizetype n = T.rows();
+    const qsizetype r = X.cols();
+
+    if (lower) {
+        for (qsizetype k0 = 0; k0 < n; k0 += TRIANGULAR_BLOCK) {
+            const qsizetype k1 = std::min(n, k0 + TRIANGULAR_BLOCK);
+            for (qsizetype c = 0; c < r; ++c) {
+                for (qsizetype j = k0; j < k1; ++j) {
+                    double x = X(j, c);
+                    if (!unitDiagonal) {
+                        x /= T(j, j);
+                        X(j, c) = x;
+                    }
+                    for (qsizetype i = j + 1; i < k1; ++i) {
+                        X(i, c) -= T(i, j) * x;
+                    }
+                }
+            }
+            if (k1 < n) {
+                Gemm::multiply(-1.0, T.block(k1, k0, n - k1, k1 - k0), X.block(k0, 0, k1 - k0, r),
+                               1.0, X.block(k1, 0, n - k1, r));
+            }
+        }
+    } else {
+        for (qsizetype k1 = n; k1 > 0; k1 -= TRIANGULAR_BLOCK) {
+            const qsizetype k0 = std::max<qsizetype>(0, k1 - TRIANGULAR_BLOCK);
+            for (qsizetype c = 0; c < r; ++c) {
+                for (qsizetype j = k1 - 1; j >= k0; --j) {
+                    double x = X(j, c);
+                    if (!unitDiagonal) {
+                        x /= T(j, j);
+                        X(j, c) = x;
+                    }
+                    for (qsizetype i = k0; i < j; ++i) {
+                        X(i, c) -= T(i, j) * x;
+                    }
+                }
+            }
+            if (k0 > 0) {
+                Gemm::multiply(-1.0, T.block(0, k0, k0, k1 - k0), X.block(k0, 0, k1 - k0, r),
+                               1.0, X.block(0, 0, k0, r));
+            }
+        }
+    }
+}
+
+double norm1(const ConstMatrixView& A)
+{
+    double result = 0.0;
+    for (qsizetype j = 0; j < A.cols(); ++j) {
+        double sum = 0.0;
+        for (qsizetype i = 0; i < A.rows(); ++i) {
+            sum += std::abs(A(i, j));
+        }
+        result = std::max(result, sum);
+    }
+    return result;
+}
+
+/**
+ * @brief 向量包装为 n×1 的列视图
+ */
+MatrixView columnView(QVector<double>& v)
+{
+    return MatrixView(v.data(), v.size(), 1, 1, v.size());
+}
+
+/**
+ * @brief Hager–Higham 算法估计 ‖A⁻¹‖₁
+ *
+ * 只需要若干次 A⁻¹x 与 A⁻ᵀx 的求解（solve/solveTransposed 原地修改向量），
+ * 最后再用 Higham 的交错向量做一次下界修正。
+ */
+template<typename Solve, typename SolveTransposed>
+double inverseNorm1Estimate(qsizetype n, Solve solve, SolveTransposed solveTransposed)
+{
+    QVector<double> x(n, 1.0 / static_cast<double>(n));
+    double estimate = 0.0;
+    qsizetype previous = -1;
+
+    for (int iteration = 0; iteration < CONDITION_ITERATIONS; ++iteration) {
+        QVector<double> y = x;
+        solve(y);
+        estimate = 0.0;
+        for (double value : y) {
+            estimate += std::abs(value);
+        }
+
+        QVector<double> z(n);
+        for (qsizetype i = 0; i < n; ++i) {
+            z[i] = y[i] >= 0.0 ? 1.0 : -1.0;
+        }
+        solveTransposed(z);
+
+        qsizetype best = 0;
+        double zx = 0.0;
+        for (qsizetype i = 0; i < n; ++i) {
+            if (std::abs(z[i]) > std::abs(z[best])) {
+                best = i;
+            }
+            zx += z[i] * x[i];
+        }
+        if (iteration > 0 && (std::abs(z[best]) <= zx || best == previous)) {
+            break;
+        }
+
+        x.fill(0.0);
+        x[best] = 1.0;
+        previous = best;
+    }
+
+    QVector<double> alternating(n);
+    for (qsizetype i = 0; i < n; ++i) {
+        double magnitude = 1.0 + static_cast<double>(i) / static_cast<double>(std::max<qsizetype>(1, n - 1));
+        alternating[i] = i % 2 == 0 ? magnitude : -magnitude;
+    }
+    solve(alternating);
+    double alternate = 0.0;
+    for (double value : alternating) {
+        alternate += std::abs(value);
+    }
+
+    return std::max(estimate, 2.0 * alternate / (3.0 * static_cast<double>(n)));
+}
+
+/**
+ * @brief 面板 [k0, k0+kb) 的反射向量（单位下梯形，(m-k0)×kb，列优先）
+ */
+DenseMatrix panelReflectors(const DenseMatrix& qr, qsizetype k0, qsizetype kb)
+{
+    const qsizetype m = qr.rows();
+    DenseMatrix V(m - k0, kb, 0.0, MatrixLayout::ColumnMajor);
+    for (qsizetype c = 0; c < kb; ++c) {
+        const qsizetype j = k0 + c;
+        V(c, c) = 1.0;
+        for (qsizetype i = j + 1; i < m; ++i) {
+            V(i - k0, c) = qr(i, j);
+        }
+    }
+    return V;
+}
+
+/**
+ * @brief X ← QᵀX（transpose 为真）或 X ← QX，Q = H₁H₂…Hₙ，按面板以块反射变换作用
+ */
+void applyReflectors(const DenseMatrix& qr, const DenseMatrix& t, const MatrixView& X, bool transpose)
+{
+    const qsizetype m = qr.rows();
+    const qsizetype n = qr.cols();
+    const qsizetype r = X.cols();
+    const qsizetype panels = (n + QR_BLOCK - 1) / QR_BLOCK;
+
+    for (qsizetype step = 0; step < panels; ++step) {
+        const qsizetype panel = transpose ? step : panels - 1 - step;
+        const qsizetype k0 = panel * QR_BLOCK;
+        const qsizetype kb = std::min(QR_BLOCK, n - k0);
+
+        // (I - V·T·Vᵀ)ᵀ X = X - V·Tᵀ·(VᵀX)，不转置时用 T
+        DenseMatrix V = panelReflectors(qr, k0, kb);
+        ConstMatrixView T = t.block(0, k0, kb, kb);
+        MatrixView target = X.block(k0, 0, m - k0, r);
+
+        DenseMatrix W(kb, r, MatrixLayout::ColumnMajor);
+        Gemm::multiply(1.0, V.transposed(), target, 0.0, W.view());
+        DenseMatrix TW(kb, r, MatrixLayout::ColumnMajor);
+        Gemm::multiply(1.0, transpose ? T.transposed() : T, W, 0.0, TW.view());
+        Gemm::multiply(-1.0, V, TW, 1.0, target);
+    }
+}
+
+} // namespace
+
+// === LU 分解 ===
+
+LUDecomposition::LUDecomposition(const ConstMatrixView& A)
+{
+    if (A.rows() != A.cols()) {
+        m_errorMessage = "矩阵不是方阵";
+        return;
+    }
+
+    const qsizetype n = A.rows();
+    m_lu = DenseMatrix::fromView(A, MatrixLayout::ColumnMajor);
+    m_pivots.resize(n);
+    m_norm1 = norm1(A);
+    m_errorMessage.clear();
+
+    MatrixView a = m_lu.view();
+    for (qsizetype k0 = 0; k0 < n; k0 += LU_BLOCK) {
+        const qsizetype k1 = std::min(n, k0 + LU_BLOCK);
+
+        // 面板内逐列选主元、消元（列优先，列内连续）
+        for (qsizetype j = k0; j < k1; ++j) {
+            double* column = a.ptr(0, j);
+            qsizetype pivot = j;
+            for (qsizetype i = j + 1; i < n; ++i) {
+                if (std::abs(column[i]) > std::abs(column[pivot])) {
+                    pivot = i;
+                }
+            }
+            m_pivots[j] = pivot;
+            if (pivot != j) {
+                for (qsizetype c = 0; c < n; ++c) {
+                    std::swap(a(j, c), a(pivot, c));
+                }
+            }
+            if (column[j] == 0.0) {
+                m_singular = true;      // 该列主元以下全为 0，无需消元
+                continue;
+            }
+
+            const double inversePivot = 1.0 / column[j];
+            for (qsizetype i = j + 1; i < n; ++i) {
+                column[i] *= inversePivot;
+            }
+            for (qsizetype c = j + 1; c < k1; ++c) {
+                double* target = a.ptr(0, c);
+                const double u = target[j];
+                if (u != 0.0) {
+                    for (qsizetype i = j + 1; i < n; ++i) {
+                        target[i] -= column[i] * u;
+                    }
+                }
+            }
+        }
+
+        if (k1 < n) {
+            // U12 = L11⁻¹·A12，A22 -= L21·U12
+            triangularSolve(a.block(k0, k0, k1 - k0, k1 - k0), a.block(k0, k1, k1 - k0, n - k1), true, true);
+            Gemm::multiply(-1.0, a.block(k1, k0, n - k1, k1 - k0), a.block(k0, k1, k1 - k0, n - k1),
+                           1.0, a.block(k1, k1, n - k1, n - k1));
+        }
+    }
+}
+
+DenseMatrix LUDecomposition::solve(const ConstMatrixView& B) const
+{
+    if (!isValid() || m_singular || B.rows() != size()) {
+        qWarning() << "LU 求解失败：矩阵奇异或维度不匹配";
+        return DenseMatrix();
+    }
+
+    DenseMatrix X = DenseMatrix::fromView(B, MatrixLayout::ColumnMajor);
+    for (qsizetype i = 0; i < size(); ++i) {
+        if (m_pivots[i] != i) {
+            for (qsizetype c = 0; c < X.cols(); ++c) {
+                std::swap(X(i, c), X(m_pivots[i], c));
+            }
+        }
+    }
+    triangularSolve(m_lu, X.view(), true, true);
+    triangularSolve(m_lu, X.view(), false, false);
+    return X;
+}
+
+QVector<double> LUDecomposition::solve(const QVector<double>& b) const
+{
+    DenseMatrix x = solve(ConstMatrixView(b.constData(), b.size(), 1, 1, b.size()));
+    return x.isEmpty() ? QVector<double>() : QVector<double>(x.data(), x.data() + x.rows());
+}
+
+DenseMatrix LUDecomposition::solveTransposed(const ConstMatrixView& B) const
+{
+    if (!isValid() || m_singular || B.rows() != size()) {
+        qWarning() << "LU 求解失败：矩阵奇异或维度不匹配";
+        return DenseMatrix();
+    }
+
+    // Aᵀ = UᵀLᵀP：依次解 Uᵀ、Lᵀ，再按相反顺序撤销行交换
+    DenseMatrix X = DenseMatrix::fromView(B, MatrixLayout::ColumnMajor);
+    triangularSolve(m_lu.transposed(), X.view(), true, false);
+    triangularSolve(m_lu.transposed(), X.view(), false, true);
+    for (qsizetype i = size() - 1; i >= 0; --i) {
+        if (m_pivots[i] != i) {
+            for (qsizetype c = 0; c < X.cols(); ++c) {
+                std::swap(X(i, c), X(m_pivots[i], c));
+            }
+        }
+    }
+    return X;
+}
+
+double LUDecomposition::determinant() const
+{
+    if (!isValid()) {
+        return qQNaN();
+    }
+    if (m_singular) {
+        return 0.0;
+    }
+
+    double det = 1.0;
+    for (qsizetype i = 0; i < size(); ++i) {
+        det *= m_pivots[i] != i ? -m_lu(i, i) : m_lu(i, i);
+    }
+    return det;
+}
+
+std::optional<DenseMatrix> LUDecomposition::inverse() const
+{
+    if (!isValid() || m_singular) {
+        return std::nullopt;
+    }
+    return solve(DenseMatrix::identity(size(), MatrixLayout::ColumnMajor));
+}
+
+double LUDecomposition::reciprocalCondition() const
+{
+    if (!isValid() || m_singular || size() == 0 || m_norm1 == 0.0) {
+        return 0.0;
+    }
+
+    double inverseNorm = inverseNorm1Estimate(size(),
+        [this](QVector<double>& v) { columnView(v).assign(solve(columnView(v))); },
+        [this](QVector<double>& v) { columnView(v).assign(solveTransposed(columnView(v))); });
+    return 1.0 / (m_norm1 * inverseNorm);
+}
+
+// === Cholesky 分解 ===
+
+CholeskyDecomposition::CholeskyDecomposition(const ConstMatrixView& A)
+{
+    if (A.rows() != A.cols()) {
+        m_errorMessage = "矩阵不是方阵";
+        return;
+    }
+
+    const qsizetype n = A.rows();
+    m_l = DenseMatrix::fromView(A, MatrixLayout::ColumnMajor);
+
+    // 由下三角计算对称矩阵的 1-范数
+    QVector<double> columnSums(n, 0.0);
+    for (qsizetype j = 0; j < n; ++j) {
+        for (qsizetype i = j; i < n; ++i) {
+            const double value = std::abs(A(i, j));
+            columnSums[j] += value;
+            if (i != j) {
+                columnSums[i] += value;
+            }
+        }
+    }
+    m_norm1 = n > 0 ? *std::max_element(columnSums.begin(), columnSums.end()) : 0.0;
+
+    MatrixView l = m_l.view();
+    for (qsizetype k0 = 0; k0 < n; k0 += CHOLESKY_BLOCK) {
+        const qsizetype k1 = std::min(n, k0 + CHOLESKY_BLOCK);
+        const qsizetype kb = k1 - k0;
+
+        // 对角块（此前各块的贡献已在尾部更新中减去）
+        for (qsizetype j = k0; j < k1; ++j) {
+            double diagonal = l(j, j);
+            for (qsizetype p = k0; p < j; ++p) {
+                diagonal -= l(j, p) * l(j, p);
+            }
+            if (!(diagonal > 0.0)) {
+                m_errorMessage = "矩阵不是正定矩阵";
+                m_l = DenseMatrix();
+                return;
+            }
+            diagonal = std::sqrt(diagonal);
+            l(j, j) = diagonal;
+
+            for (qsizetype i = j + 1; i < k1; ++i) {
+                double value = l(i, j);
+                for (qsizetype p = k0; p < j; ++p) {
+                    value -= l(i, p) * l(j, p);
+                }
+                l(i, j) = value / diagonal;
+            }
+        }
+
+        if (k1 < n) {
+            // L21 = A21·L11⁻ᵀ，即 L11·L21ᵀ = A21ᵀ
+            MatrixView L21 = l.block(k1, k0, n - k1, kb);
+            triangularSolve(l.block(k0, k0, kb, kb), L21.transposed(), true, false);
+
+            // A22 -= L21·L21ᵀ，按列块只更新下三角
+            for (qsizetype j0 = k1; j0 < n; j0 += CHOLESKY_BLOCK) {
+                const qsizetype width = std::min(CHOLESKY_BLOCK, n - j0);
+                Gemm::multiply(-1.0, L21.block(j0 - k1, 0, n - j0, kb),
+                               L21.block(j0 - k1, 0, width, kb).transposed(),
+                               1.0, l.block(j0, j0, n - j0, width));
+            }
+        }
+    }
+
+    for (qsizetype j = 1; j < n; ++j) {
+        for (qsizetype i = 0; i < j; ++i) {
+            l(i, j) = 0.0;
+        }
+    }
+    m_errorMessage.clear();
+}
+
+DenseMatrix CholeskyDecomposition::solve(const ConstMatrixView& B) const
+{
+    if (!isValid() || B.rows() != size()) {
+        qWarning() << "Cholesky 求解失败：分解无效或维度不匹配";
+        return DenseMatrix();
+    }
+
+    DenseMatrix X = DenseMatrix::fromView(B, MatrixLayout::ColumnMajor);
+    triangularSolve(m_l, X.view(), true, false);
+    triangularSolve(m_l.transposed(), X.view(), false, false);
+    return X;
+}
+
+QVector<double> CholeskyDecomposition::solve(const QVector<double>& b) const
+{
+    DenseMatrix x = solve(ConstMatrixView(b.constData(), b.size(), 1, 1, b.size()));
+    return x.isEmpty() ? QVector<double>() : QVector<double>(x.data(), x.data() + x.rows());
+}
+
+double CholeskyDecomposition::determinant() const
+{
+    if (!isValid()) {
+        return qQNaN();
+    }
+
+    double det = 1.0;
+    for (qsizetype i = 0; i < size(); ++i) {
+        det *= m_l(i, i) * m_l(i, i);
+    }
+    return det;
+}
+
+double CholeskyDecomposition::logDeterminant() const
+{
+    if (!isValid()) {
+        return qQNaN();
+    }
+
+    double sum = 0.0;
+    for (qsizetype i = 0; i < size(); ++i) {
+        sum += std::log(m_l(i, i));
+    }
+    return 2.0 * sum;
+}
+
+std::optional<DenseMatrix> CholeskyDecomposition::inverse() const
+{
+    if (!isValid()) {
+        return std::nullopt;
+    }
+    return solve(DenseMatrix::identity(size(), MatrixLayout::ColumnMajor));
+}
+
+double CholeskyDecomposition::reciprocalCondition() const
+{
+    if (!isValid() || size() == 0 || m_norm1 == 0.0) {
+        return 0.0;
+    }
+
+    auto solveInPlace = [this](QVector<double>& v) { columnView(v).assign(solve(columnView(v))); };
+    return 1.0 / (m_norm1 * inverseNorm1Estimate(size(), solveInPlace, solveInPlace));
+}
+
+// === QR 分解 ===
+
+QRDecomposition::QRDecomposition(const ConstMatrixView& A)
+{
+    const qsizetype m = A.rows();
+    const qsizetype n = A.cols();
+    if (n == 0) {
+        m_errorMessage = "矩阵为空";
+        return;
+    }
+    if (m < n) {
+        m_errorMessage = "行数少于列数";
+        return;
+    }
+
+    m_qr = DenseMatrix::fromView(A, MatrixLayout::ColumnMajor);
+    m_tau.fill(0.0, n);
+    m_t = DenseMatrix(std::min(QR_BLOCK, n), n, 0.0, MatrixLayout::ColumnMajor);
+
+    MatrixView a = m_qr.view();
+    QVector<double> w(QR_BLOCK);
+
+    for (qsizetype k0 = 0; k0 < n; k0 += QR_BLOCK) {
+        const qsizetype k1 = std::min(n, k0 + QR_BLOCK);
+        const qsizetype kb = k1 - k0;
+
+        for (qsizetype j = k0; j < k1; ++j) {
+            // 生成 Householder 反射 H = I - τ·v·vᵀ，使 H·x = β·e₁
+            double* column = a.ptr(0, j);
+            double scale = 0.0;
+            for (qsizetype i = j + 1; i < m; ++i) {
+                scale = std::max(scale, std::abs(column[i]));
+            }
+
+            double tau = 0.0;
+            if (scale > 0.0) {
+                double sumSquares = 0.0;
+                for (qsizetype i = j + 1; i < m; ++i) {
+                    const double scaled = column[i] / scale;
+                    sumSquares += scaled * scaled;
+                }
+                const double alpha = column[j];
+                const double beta = -std::copysign(std::hypot(alpha, scale * std::sqrt(sumSquares)), alpha);
+                tau = (beta - alpha) / beta;
+                const double factor = 1.0 / (alpha - beta);
+                for (qsizetype i = j + 1; i < m; ++i) {
+                    column[i] *= factor;
+                }
+                column[j] = beta;
+            }
+            m_tau[j] = tau;
+
+            // 作用于面板内其余列
+            if (tau != 0.0) {
+                for (qsizetype c = j + 1; c < k1; ++c) {
+                    double* target = a.ptr(0, c);
+                    double dot = target[j];
+                    for (qsizetype i = j + 1; i < m; ++i) {
+                        dot += column[i] * target[i];
+                    }
+                    dot *= tau;
+                    target[j] -= dot;
+                    for (qsizetype i = j + 1; i < m; ++i) {
+                        target[i] -= column[i] * dot;
+                    }
+                }
+            }
+        }
+
+        // 紧凑 WY：T(0:jj, jj) = -τ_jj·T(0:jj, 0:jj)·V(:, 0:jj)ᵀ·v_jj
+        MatrixView T = m_t.block(0, k0, kb, kb);
+        for (qsizetype jj = 0; jj < kb; ++jj) {
+            const qsizetype j = k0 + jj;
+            const double* vj = a.ptr(0, j);
+            for (qsizetype p = 0; p < jj; ++p) {
+                const double* vp = a.ptr(0, k0 + p);
+                double dot = vp[j];
+                for (qsizetype i = j + 1; i < m; ++i) {
+                    dot += vp[i] * vj[i];
+                }
+                w[p] = dot;
+            }
+            for (qsizetype p = 0; p < jj; ++p) {
+                double sum = 0.0;
+                for (qsizetype q = p; q < jj; ++q) {
+                    sum += T(p, q) * w[q];
+                }
+                T(p, jj) = -m_tau[j] * sum;
+            }
+            T(jj, jj) = m_tau[j];
+        }
+
+        // 面板右侧：A2 ← A2 - V·Tᵀ·(Vᵀ·A2)
+        if (k1 < n) {
+            DenseMatrix V = panelReflectors(m_qr, k0, kb);
+            MatrixView trailing = a.block(k0, k1, m - k0, n - k1);
+            DenseMatrix W(kb, n - k1, MatrixLayout::ColumnMajor);
+            Gemm::multiply(1.0, V.transposed(), trailing, 0.0, W.view());
+            DenseMatrix TW(kb, n - k1, MatrixLayout::ColumnMajor);
+            Gemm::multiply(1.0, ConstMatrixView(T).transposed(), W, 0.0, TW.view());
+            Gemm::multiply(-1.0, V, TW, 1.0, trailing);
+        }
+    }
+
+    m_errorMessage.clear();
+}
+
+bool QRDecomposition::isFullRank() const
+{
+    if (!isValid()) {
+        return false;
+    }
+
+    double largest = 0.0;
+    for (qsizetype i = 0; i < cols(); ++i) {
+        largest = std::max(largest, std::abs(m_qr(i, i)));
+    }
+    for (qsizetype i = 0; i < cols(); ++i) {
+        if (!(std::abs(m_qr(i, i)) > QR_RANK_TOLERANCE * largest)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+DenseMatrix QRDecomposition::applyQTranspose(const ConstMatrixView& B) const
+{
+    if (!isValid() || B.rows() != rows()) {
+        qWarning() << "QR 求解失败：分解无效或维度不匹配";
+        return DenseMatrix();
+    }
+
+    DenseMatrix X = DenseMatrix::fromView(B, MatrixLayout::ColumnMajor);
+    applyReflectors(m_qr, m_t, X.view(), true);
+    return X;
+}
+
+DenseMatrix QRDecomposition::solve(const ConstMatrixView& B) const
+{
+    if (!isFullRank()) {
+        qWarning() << "QR 求解失败：列不满秩";
+        return DenseMatrix();
+    }
+
+    DenseMatrix X = applyQTranspose(B);
+    if (X.isEmpty() && !B.isEmpty()) {
+        return DenseMatrix();
+    }
+
+    MatrixView top = X.block(0, 0, cols(), X.cols());
+    triangularSolve(m_qr.block(0, 0, cols(), cols()), top, false, false);
+    return DenseMatrix::fromView(top, MatrixLayout::ColumnMajor);
+}
+
+QVector<double> QRDecomposition::solve(const QVector<double>& b) const
+{
+    DenseMatrix x = solve(ConstMatrixView(b.constData(), b.size(), 1, 1, b.size()));
+    return x.isEmpty() ? QVector<double>() : QVector<double>(x.data(), x.data() + x.rows());
+}
+
+std::optional<double> QRDecomposition::determinant() const
+{
+    if (!isValid() || rows() != cols()) {
+        return std::nullopt;
+    }
+
+    // 每个非平凡的反射变换行列式为 -1
+    double det = 1.0;
+    for (qsizetype i = 0; i < cols(); ++i) {
+        det *= m_tau[i] != 0.0 ? -m_qr(i, i) : m_qr(i, i);
+    }
+    return det;
+}
+
+std::optional<DenseMatrix> QRDecomposition::inverse() const
+{
+    if (!isValid() || rows() != cols() || !isFullRank()) {
+        return std::nullopt;
+    }
+    return solve(DenseMatrix::identity(rows(), MatrixLayout::ColumnMajor));
+}
+
+double QRDecomposition::reciprocalCondition() const
+{
+    if (!isFullRank()) {
+        return 0.0;
+    }
+
+    const qsizetype n = cols();
+    ConstMatrixView R = m_qr.block(0, 0, n, n);
+    double normR = 0.0;
+    for (qsizetype j = 0; j < n; ++j) {
+        double sum = 0.0;
+        for (qsizetype i = 0; i <= j; ++i) {
+            sum += std::abs(R(i, j));
+        }
+        normR = std::max(normR, sum);
+    }
+
+    double inverseNorm = inverseNorm1Estimate(n,
+        [&](QVector<double>& v) { triangularSolve(R, columnView(v), false, false); },
+        [&](QVector<double>& v) { triangularSolve(R.transposed(), columnView(v), true, false); });
+    return 1.0 / (normR * inverseNorm);
+}
+
+DenseMatrix QRDecomposition::R() const
+{
+    const qsizetype n = cols();
+    DenseMatrix result(n, n, 0.0);
+    for (qsizetype i = 0; i < n; ++i) {
+        for (qsizetype j = i; j < n; ++j) {
+            result(i, j) = m_qr(i, j);
+        }
+    }
+    return result;
+}
+
+DenseMatrix QRDecomposition::thinQ() const
+{
+    if (!isValid()) {
+        return DenseMatrix();
+    }
+
+    DenseMatrix Q(rows(), cols(), 0.0, MatrixLayout::ColumnMajor);
+    for (qsizetype i = 0; i < cols(); ++i) {
+        Q(i, i) = 1.0;
+    }
+    applyReflectors(m_qr, m_t, Q.view(), false);
+    return Q;
+}
+
+} // namespace Statistics
@@ -0,0 +1,176 @@
+#ifndef FACTORIZATIONS_H
+#define FACTORIZATIONS_H
+
+#include "DenseMatrix.h"
+#include <QVector>
+#include <QString>
+#include <optional>
+
+namespace Statistics {
+
+/**
+ * @brief 带部分选主元的 LU 分解 PA = LU
+ *
+ * 分解只做一次，之后可对任意多个右端项求解、求行列式、逆矩阵与条件数
+ * 估计。按 64 列的面板分块（右视算法）：面板内逐列消元，面板右侧的
+ * U 块用三角求解得到，尾部子矩阵的更新 A22 -= L21·U12 交给 GEMM，
+ * 绝大部分运算量落在缓存分块的矩阵乘法中。
+ *
+ * 遇到零主元时分解仍会完成，但 isSingular() 为真，solve/inverse 不可用；
+ * 此时 determinant() 返回 0。
+ */
+class LUDecomposition
+{
+public:
+    LUDecomposition() = default;
+    explicit LUDecomposition(const ConstMatrixView& A);
+
+    bool isValid() const { return m_errorMessage.isEmpty(); }
+    bool isSingular() const { return m_singular; }
+    QString errorMessage() const { return m_errorMessage; }
+    qsizetype size() const { return m_lu.rows(); }
+
+    /**
+     * @brief 求解 AX = B（B 为 n×r，一次求解 r 个右端项）
+     * @return 矩阵奇异或维度不符时返回空矩阵
+     */
+    DenseMatrix solve(const ConstMatrixView& B) const;
+    QVector<double> solve(const QVector<double>& b) const;
+
+    /**
+     * @brief 求解 AᵀX = B
+     */
+    DenseMatrix solveTransposed(const ConstMatrixView& B) const;
+
+    double determinant() const;
+    std::optional<DenseMatrix> inverse() const;
+
+    /**
+     * @brief 1-范数倒数条件数估计 1/(‖A‖₁·‖A⁻¹‖₁)（Hager–Higham 估计，奇异时为 0）
+     */
+    double reciprocalCondition() const;
+
+    /**
+     * @brief 紧凑存储的因子（严格下三角为 L，单位对角不存储；上三角为 U），列优先
+     */
+    const DenseMatrix& factors() const { return m_lu; }
+
+    /**
+     * @brief 行交换：第 i 步把第 i 行与第 pivots()[i] 行交换
+     */
+    const QVector<qsizetype>& pivots() const { return m_pivots; }
+
+private:
+    DenseMatrix m_lu;
+    QVector<qsizetype> m_pivots;
+    double m_norm1 = 0.0;
+    bool m_singular = false;
+    QString m_errorMessage = "未分解";
+};
+
+/**
+ * @brief 对称正定矩阵的 Cholesky 分解 A = LLᵀ
+ *
+ * 只读取 A 的下三角。按 64 列分块：对角块逐列分解，其下方的块用三角
+ * 求解，尾部只更新下三角部分（按列块调用 GEMM）。矩阵非正定时
+ * isValid() 为假。
+ */
+class CholeskyDecomposition
+{
+public:
+    CholeskyDecomposition() = default;
+    explicit CholeskyDecomposition(const ConstMatrixView& A);
+
+    bool isValid() const { return m_errorMessage.isEmpty(); }
+    QString errorMessage() const { return m_errorMessage; }
+    qsizetype size() const { return m_l.rows(); }
+
+    DenseMatrix solve(const ConstMatrixView& B) const;
+    QVector<double> solve(const QVector<double>& b) const;
+
+    double determinant() const;
+
+    /**
+     * @brief ln det(A) = 2·Σ ln L_ii（大矩阵的行列式容易溢出时使用）
+     */
+    double logDeterminant() const;
+
+    std::optional<DenseMatrix> inverse() const;
+    double reciprocalCondition() const;
+
+    /**
+     * @brief 下三角因子 L（上三角为 0），列优先
+     */
+    const DenseMatrix& factor() const { return m_l; }
+
+private:
+    DenseMatrix m_l;
+    double m_norm1 = 0.0;
+    QString m_errorMessage = "未分解";
+};
+
+/**
+ * @brief Householder QR 分解 A = QR（m ≥ n）
+ *
+ * 按 32 列分块，面板内逐列生成反射变换并构造紧凑 WY 表示
+ * I - V·T·Vᵀ，面板右侧的列用两次 GEMM 一次性更新。solve() 给出
+ * 最小二乘解 argmin ‖AX - B‖，不形成 AᵀA，条件数不会被平方。
+ */
+class QRDecomposition
+{
+public:
+    QRDecomposition() = default;
+    explicit QRDecomposition(const ConstMatrixView& A);
+
+    bool isValid() const { return m_errorMessage.isEmpty(); }
+    QString errorMessage() const { return m_errorMessage; }
+    qsizetype rows() const { return m_qr.rows(); }
+    qsizetype cols() const { return m_qr.cols(); }
+
+    /**
+     * @brief R 的对角元相对最大值不低于 1e-12 时视为列满秩
+     */
+    bool isFullRank() const;
+
+    /**
+     * @brief 最小二乘解（B 为 m×r，结果为 n×r；列不满秩时返回空矩阵）
+     */
+    DenseMatrix solve(const ConstMatrixView& B) const;
+    QVector<double> solve(const QVector<double>& b) const;
+
+    /**
+     * @brief 计算 QᵀB（B 为 m×r），前 n 行为最小二乘问题的右端项，其余行的平方和即残差平方和
+     */
+    DenseMatrix applyQTranspose(const ConstMatrixView& B) const;
+
+    /**
+     * @brief 行列式（仅方阵）
+     */
+    std::optional<double> determinant() const;
+    std::optional<DenseMatrix> inverse() const;
+
+    /**
+     * @brief R 的 1-范数倒数条件数估计
+     */
+    double reciprocalCondition() const;
+
+    /**
+     * @brief 上三角因子 R（n×n）
+     */
+    DenseMatrix R() const;
+
+    /**
+     * @brief 显式的 Q 的前 n 列（m×n，列正交）
+     */
+    DenseMatrix thinQ() const;
+
+private:
+    DenseMatrix m_qr;           // 上三角为 R，严格下三角为反射向量（首元为 1，不存储）
+    QVector<double> m_tau;      // 各反射变换的系数
+    DenseMatrix m_t;            // 各面板的三角因子 T，按面板横向排列（块宽×n）
+    QString m_errorMessage = "未分解";
+};
+
+} // namespace Statistics
+
+#endif // FACTORIZATIONS_H
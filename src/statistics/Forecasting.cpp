@@ -1,15 +1,179 @@
 #include "Forecasting.h"
+#include "Bootstrap.h"
+#include "Distributions.h"
+#include "ParallelUtils.h"
+#include "Regression.h"
+#include "RollingWindow.h"
+#include "SmoothingKernels.h"
 #include <cmath>
 #include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <vector>
 #include <QDebug>
 
 namespace Statistics {
 
+namespace {
+
+// 乘法 Holt-Winters 预测区间的模拟路径数、每批路径数与随机种子
+const int SIMULATION_PATHS = 4000;
+const int PATH_BLOCK = 64;
+const quint64 SIMULATION_SEED = 0x5EED5EEDULL;
+
+bool validConfidence(double confidence)
+{
+    return confidence > 0.0 && confidence < 1.0;
+}
+
+/**
+ * 线性插值分位数（p 取值 [0, 1]），用部分排序代替全排序，会重排 values
+ */
+double selectQuantile(std::vector<double>& values, double p)
+{
+    const qsizetype n = static_cast<qsizetype>(values.size());
+    double index = p * (n - 1);
+    qsizetype lower = static_cast<qsizetype>(std::floor(index));
+    double weight = index - lower;
+
+    std::nth_element(values.begin(), values.begin() + lower, values.end());
+    double value = values[lower];
+    if (weight > 0.0 && lower + 1 < n) {
+        double next = *std::min_element(values.begin() + lower + 1, values.end());
+        value = value * (1.0 - weight) + next * weight;
+    }
+    return value;
+}
+
+/**
+ * 经验预测区间：origins[t] 为在 t 期末做出的（各步长相同的）预测，
+ * 第 h 期的区间取样本内所有 h 步预测误差 y[t+h] - origins[t] 的分位数
+ */
+void empiricalIntervals(ForecastResult& result, const QVector<double>& data, const QVector<double>& origins,
+                        qsizetype firstOrigin, double confidence)
+{
+    const qsizetype n = data.size();
+    const int periods = result.predicted.size();
+    if (!validConfidence(confidence) || periods == 0 || n - firstOrigin - periods < 2) {
+        return;     // 最长步长的误差样本不足
+    }
+
+    const double tail = (1.0 - confidence) / 2.0;
+    QVector<double> lower(periods);
+    QVector<double> upper(periods);
+
+    Parallel::forEach(periods, [&](int step) {
+        const int h = step + 1;
+        std::vector<double> errors;
+        errors.reserve(n - firstOrigin - h);
+        for (qsizetype t = firstOrigin; t + h < n; ++t) {
+            errors.push_back(data[t + h] - origins[t]);
+        }
+        lower[step] = result.predicted[step] + selectQuantile(errors, tail);
+        upper[step] = result.predicted[step] + selectQuantile(errors, 1.0 - tail);
+    });
+
+    result.lowerBound = lower;
+    result.upperBound = upper;
+}
+
+/**
+ * 乘法 Holt-Winters 的残差自助模拟：从当前状态出发，每期从一步残差中
+ * 有放回抽取误差，按模型递推得到未来路径，区间取各期模拟值的分位数。
+ *
+ * 路径按批处理，每批的状态按"结构数组"存放（季节项为 [相位][路径]），
+ * 先批量抽取误差再统一递推，内层循环可以向量化；第 p 条路径使用
+ * 编号为 p 的随机数流，结果与线程数无关。
+ */
+void simulatedIntervals(ForecastResult& result, const QVector<double>& residuals,
+                        const SmoothingParameters& parameters, int seasonLength,
+                        const SmoothingKernels::State& state, const QVector<double>& seasonal,
+                        double confidence)
+{
+    const int periods = result.predicted.size();
+    const qsizetype residualCount = residuals.size();
+    if (!validConfidence(confidence) || periods == 0 || residualCount < 2) {
+        return;
+    }
+
+    const int m = seasonLength;
+    const double alpha = parameters.alpha;
+    const double beta = parameters.beta;
+    const double gamma = parameters.gamma;
+
+    // paths[(h - 1) * SIMULATION_PATHS + path]
+    std::vector<double> paths(static_cast<size_t>(periods) * SIMULATION_PATHS);
+    const int blocks = (SIMULATION_PATHS + PATH_BLOCK - 1) / PATH_BLOCK;
+
+    Parallel::forEach(blocks, [&](int block) {
+        const int first = block * PATH_BLOCK;
+        const int count = std::min(PATH_BLOCK, SIMULATION_PATHS - first);
+
+        std::vector<RandomStream> streams;
+        streams.reserve(count);
+        for (int p = 0; p < count; ++p) {
+            streams.emplace_back(SIMULATION_SEED, static_cast<quint64>(first + p));
+        }
+
+        double level[PATH_BLOCK];
+        double trend[PATH_BLOCK];
+        double error[PATH_BLOCK];
+        std::vector<double> season(static_cast<size_t>(m) * PATH_BLOCK);
+        for (int p = 0; p < count; ++p) {
+            level[p] = state.level;
+            trend[p] = state.trend;
+        }
+        for (int j = 0; j < m; ++j) {
+            std::fill_n(season.begin() + static_cast<qsizetype>(j) * PATH_BLOCK, count, seasonal[j]);
+        }
+
+        for (int h = 0; h < periods; ++h) {
+            for (int p = 0; p < count; ++p) {
+                error[p] = residuals[streams[p].bounded(static_cast<quint64>(residualCount))];
+            }
+
+            double* s = season.data() + static_cast<qsizetype>((state.phase + h) % m) * PATH_BLOCK;
+            double* out = paths.data() + static_cast<qsizetype>(h) * SIMULATION_PATHS + first;
+            for (int p = 0; p < count; ++p) {
+                double base = level[p] + trend[p];
+                double y = base * s[p] + error[p];
+                double newLevel = alpha * (y / s[p]) + (1.0 - alpha) * base;
+                trend[p] = beta * (newLevel - level[p]) + (1.0 - beta) * trend[p];
+                s[p] = gamma * (y / newLevel) + (1.0 - gamma) * s[p];
+                level[p] = newLevel;
+                out[p] = y;
+            }
+        }
+    });
+
+    const double tail = (1.0 - confidence) / 2.0;
+    QVector<double> lower(periods);
+    QVector<double> upper(periods);
+    for (int h = 0; h < periods; ++h) {
+        auto begin = paths.begin() + static_cast<qsizetype>(h) * SIMULATION_PATHS;
+        std::vector<double> values;
+        values.reserve(SIMULATION_PATHS);
+        std::copy_if(begin, begin + SIMULATION_PATHS, std::back_inserter(values),
+                     [](double value) { return std::isfinite(value); });
+        if (values.size() < 2) {
+            return;
+        }
+        lower[h] = selectQuantile(values, tail);
+        upper[h] = selectQuantile(values, 1.0 - tail);
+    }
+
+    result.lowerBound = lower;
+    result.upperBound = upper;
+}
+
+} // namespace
+
 // === 简单移动平均 ===
 
 ForecastResult Forecasting::simpleMovingAverage(const QVector<double>& data,
                                                   int window,
-                                                  int forecastPeriods)
+                                                  int forecastPeriods,
+                                                  double confidence)
 {
     ForecastResult result;
 
@@ -19,13 +183,12 @@ ForecastResult Forecasting::simpleMovingAverage(const QVector<double>& data,
         return result;
     }
 
-    // 计算最后一个窗口的平均值
-    double sum = 0.0;
-    for (int i = data.size() - window; i < data.size(); ++i) {
-        sum += data[i];
-    }
+    // 滑动均值一次算出所有窗口：means[i] 为 data[i-window+1..i] 的平均值
+    RollingOptions options;
+    options.window = window;
+    QVector<double> means = RollingWindow::mean(data, options);
 
-    double lastMA = sum / window;
+    double lastMA = means.last();
 
     // 生成预测值
     QVector<double> predictions;
@@ -36,26 +199,20 @@ ForecastResult Forecasting::simpleMovingAverage(const QVector<double>& data,
     result.predicted = predictions;
     result.isValid = true;
 
-    // 计算拟合误差
-    QVector<double> fitted;
-    for (int i = window; i < data.size(); ++i) {
-        double ma = 0.0;
-        for (int j = i - window; j < i; ++j) {
-            ma += data[j];
-        }
-        ma /= window;
-        fitted.append(ma);
-    }
-
+    // 计算拟合误差（第 i 期的拟合值为前 window 期的平均值）
+    QVector<double> fitted = means.mid(window - 1, data.size() - window);
     QVector<double> actual = data.mid(window);
     result.errorMetric = calculateMSE(actual, fitted);
 
+    empiricalIntervals(result, data, means, window - 1, confidence);
+
     return result;
 }
 
 ForecastResult Forecasting::weightedMovingAverage(const QVector<double>& data,
                                                    const QVector<double>& weights,
-                                                   int forecastPeriods)
+                                                   int forecastPeriods,
+                                                   double confidence)
 {
     ForecastResult result;
 
@@ -74,13 +231,17 @@ ForecastResult Forecasting::weightedMovingAverage(const QVector<double>& data,
         return result;
     }
 
-    // 计算最后一个窗口的加权平均值
-    double weightedSum = 0.0;
-    for (int i = 0; i < window; ++i) {
-        weightedSum += data[data.size() - window + i] * weights[i];
+    // 各期末的加权平均值（origins[t] 对应 data[t-window+1..t]）
+    QVector<double> origins(data.size(), 0.0);
+    for (int t = window - 1; t < data.size(); ++t) {
+        double weightedSum = 0.0;
+        for (int i = 0; i < window; ++i) {
+            weightedSum += data[t - window + 1 + i] * weights[i];
+        }
+        origins[t] = weightedSum / weightSum;
     }
 
-    double lastWMA = weightedSum / weightSum;
+    double lastWMA = origins.last();
 
     QVector<double> predictions;
     for (int i = 0; i < forecastPeriods; ++i) {
@@ -90,6 +251,13 @@ ForecastResult Forecasting::weightedMovingAverage(const QVector<double>& data,
     result.predicted = predictions;
     result.isValid = true;
 
+    // 拟合误差（第 i 期的拟合值为前 window 期的加权平均值）
+    QVector<double> fitted = origins.mid(window - 1, data.size() - window);
+    QVector<double> actual = data.mid(window);
+    result.errorMetric = calculateMSE(actual, fitted);
+
+    empiricalIntervals(result, data, origins, window - 1, confidence);
+
     return result;
 }
 
@@ -102,16 +270,15 @@ QVector<double> Forecasting::centeredMovingAverage(const QVector<double>& data,
         window += 1;
     }
 
-    int halfWindow = window / 2;
-
-    for (int i = halfWindow; i < data.size() - halfWindow; ++i) {
-        double sum = 0.0;
-        for (int j = i - halfWindow; j <= i + halfWindow; ++j) {
-            sum += data[j];
-        }
-        result.append(sum / window);
+    if (window <= 0 || data.size() < window) {
+        return result;
     }
 
+    // 右对齐滑动均值的第 window-1 项起即为各完整居中窗口的平均值
+    RollingOptions options;
+    options.window = window;
+    result = RollingWindow::mean(data, options).mid(window - 1);
+
     return result;
 }
 
@@ -119,7 +286,8 @@ QVector<double> Forecasting::centeredMovingAverage(const QVector<double>& data,
 
 ForecastResult Forecasting::exponentialSmoothing(const QVector<double>& data,
                                                   double alpha,
-                                                  int forecastPeriods)
+                                                  int forecastPeriods,
+                                                  double confidence)
 {
     ForecastResult result;
 
@@ -129,16 +297,16 @@ ForecastResult Forecasting::exponentialSmoothing(const QVector<double>& data,
         return result;
     }
 
-    QVector<double> smoothed;
+    // 一步预测值：第 i 期的预测为前一期的平滑水平
+    QVector<double> fitted;
 
     // 初始化
     double level = data[0];
-    smoothed.append(level);
 
     // 平滑
     for (int i = 1; i < data.size(); ++i) {
+        fitted.append(level);
         level = alpha * data[i] + (1.0 - alpha) * level;
-        smoothed.append(level);
     }
 
     // 预测
@@ -149,7 +317,11 @@ ForecastResult Forecasting::exponentialSmoothing(const QVector<double>& data,
 
     result.predicted = predictions;
     result.isValid = true;
-    result.errorMetric = calculateMSE(data, smoothed);
+    result.errorMetric = data.size() > 1 ? calculateMSE(data.mid(1), fitted) : 0.0;
+
+    if (data.size() > 1) {
+        smoothingIntervals(result, SmoothingModel::Simple, SmoothingParameters{alpha, 0.0, 0.0}, 1, confidence);
+    }
 
     return result;
 }
@@ -157,7 +329,8 @@ ForecastResult Forecasting::exponentialSmoothing(const QVector<double>& data,
 ForecastResult Forecasting::doubleExponentialSmoothing(const QVector<double>& data,
                                                         double alpha,
                                                         double beta,
-                                                        int forecastPeriods)
+                                                        int forecastPeriods,
+                                                        double confidence)
 {
     ForecastResult result;
 
@@ -175,12 +348,12 @@ ForecastResult Forecasting::doubleExponentialSmoothing(const QVector<double>& da
 
     QVector<double> fitted;
 
-    // 平滑
+    // 平滑（fitted 为各期的一步预测值）
     for (int i = 1; i < data.size(); ++i) {
+        fitted.append(level + trend);
         double lastLevel = level;
         level = alpha * data[i] + (1.0 - alpha) * (level + trend);
         trend = beta * (level - lastLevel) + (1.0 - beta) * trend;
-        fitted.append(level + trend);
     }
 
     // 预测
@@ -193,13 +366,93 @@ ForecastResult Forecasting::doubleExponentialSmoothing(const QVector<double>& da
     result.isValid = true;
     result.errorMetric = calculateMSE(data.mid(1), fitted);
 
+    smoothingIntervals(result, SmoothingModel::Holt, SmoothingParameters{alpha, beta, 0.0}, 1, confidence);
+
+    return result;
+}
+
+ForecastResult Forecasting::holtWinters(const QVector<double>& data,
+                                         int seasonLength,
+                                         double alpha,
+                                         double beta,
+                                         double gamma,
+                                         bool multiplicative,
+                                         int forecastPeriods,
+                                         double confidence)
+{
+    ForecastResult result;
+
+    SmoothingModel model = multiplicative ? SmoothingModel::HoltWintersMultiplicative
+                                          : SmoothingModel::HoltWintersAdditive;
+
+    if (alpha <= 0.0 || alpha >= 1.0 ||
+        beta <= 0.0 || beta >= 1.0 ||
+        gamma <= 0.0 || gamma >= 1.0 ||
+        seasonLength < 2 ||
+        data.size() < SmoothingKernels::minimumLength(model, seasonLength)) {
+        result.isValid = false;
+        result.errorMessage = "参数无效或数据量不足（至少需要两个完整周期）";
+        return result;
+    }
+
+    if (multiplicative && *std::min_element(data.begin(), data.end()) <= 0.0) {
+        result.isValid = false;
+        result.errorMessage = "乘法季节模型要求数据全部为正";
+        return result;
+    }
+
+    SmoothingParameters parameters{alpha, beta, gamma};
+    SmoothingKernels::State state;
+    QVector<double> seasonal(seasonLength);
+
+    qsizetype begin = SmoothingKernels::initialize(data.constData(), model, seasonLength,
+                                                   state, seasonal.data());
+    // 乘法模型没有解析的预测区间，逐期递推并记录一步残差供模拟使用
+    QVector<double> residuals;
+    double sse = 0.0;
+    if (multiplicative) {
+        residuals.reserve(data.size() - begin);
+        for (qsizetype i = begin; i < data.size() && std::isfinite(sse); ++i) {
+            double forecast = SmoothingKernels::forecast(model, state, seasonal.constData(), seasonLength, 1);
+            residuals.append(data[i] - forecast);
+            sse += SmoothingKernels::run<SmoothingKernels::SquaredLoss>(
+                data.constData(), i, i + 1, model, parameters, seasonLength, state, seasonal.data());
+        }
+    } else {
+        sse = SmoothingKernels::run<SmoothingKernels::SquaredLoss>(
+            data.constData(), begin, data.size(), model, parameters, seasonLength, state, seasonal.data());
+    }
+
+    if (!std::isfinite(sse)) {
+        result.isValid = false;
+        result.errorMessage = "计算溢出，请检查数据或参数";
+        return result;
+    }
+
+    // 预测
+    QVector<double> predictions;
+    for (int h = 1; h <= forecastPeriods; ++h) {
+        predictions.append(SmoothingKernels::forecast(model, state, seasonal.constData(), seasonLength, h));
+    }
+
+    result.predicted = predictions;
+    result.isValid = true;
+    result.errorMetric = sse / (data.size() - begin);
+
+    if (multiplicative) {
+        simulatedIntervals(result, residuals, parameters, seasonLength, state, seasonal, confidence);
+    } else {
+        smoothingIntervals(result, model, parameters, seasonLength, confidence);
+    }
+
     return result;
 }
 
 // === 线性回归 ===
 
 ForecastResult Forecasting::linearRegression(const QVector<double>& data,
-                                              int forecastPeriods)
+                                              int forecastPeriods,
+                                              double confidence)
 {
     ForecastResult result;
 
@@ -239,16 +492,82 @@ ForecastResult Forecasting::linearRegression(const QVector<double>& data,
 
     // 预测值
     for (int i = 0; i < forecastPeriods; ++i) {
-        predictions.append(a + b * (n + i));
+        predictions.append(a + b * (n + 1 + i));
     }
 
     result.predicted = predictions;
     result.isValid = true;
     result.errorMetric = calculateMSE(data, fitted);
 
+    // x = 1..n：均值 (n+1)/2，离差平方和 n(n²-1)/12
+    double meanX = (n + 1) / 2.0;
+    double sxx = static_cast<double>(n) * (static_cast<double>(n) * n - 1.0) / 12.0;
+    regressionIntervals(result, n, meanX, sxx, result.errorMetric * n, confidence);
+
     return result;
 }
 
+// === 预测区间 ===
+
+void Forecasting::smoothingIntervals(ForecastResult& result, SmoothingModel model,
+                                     const SmoothingParameters& parameters, int seasonLength,
+                                     double confidence)
+{
+    if (!validConfidence(confidence) || model == SmoothingModel::HoltWintersMultiplicative ||
+        !std::isfinite(result.errorMetric)) {
+        return;
+    }
+
+    const double z = Distributions::normalQuantile((1.0 + confidence) / 2.0);
+    const double alpha = parameters.alpha;
+    const double beta = model == SmoothingModel::Simple ? 0.0 : parameters.beta;
+    const bool seasonal = SmoothingKernels::isSeasonal(model);
+
+    // 误差修正形式下第 j 期的系数：c_j = α(1 + jβ) + γ(1-α)·[j 为周期整数倍]
+    QVector<double> lower;
+    QVector<double> upper;
+    double coefficientSum = 0.0;
+    for (int h = 1; h <= result.predicted.size(); ++h) {
+        if (h > 1) {
+            int j = h - 1;
+            double c = alpha * (1.0 + j * beta);
+            if (seasonal && j % seasonLength == 0) {
+                c += parameters.gamma * (1.0 - alpha);
+            }
+            coefficientSum += c * c;
+        }
+        double halfWidth = z * std::sqrt(result.errorMetric * (1.0 + coefficientSum));
+        lower.append(result.predicted[h - 1] - halfWidth);
+        upper.append(result.predicted[h - 1] + halfWidth);
+    }
+
+    result.lowerBound = lower;
+    result.upperBound = upper;
+}
+
+void Forecasting::regressionIntervals(ForecastResult& result, qint64 n, double meanX, double sxx,
+                                      double sse, double confidence)
+{
+    if (!validConfidence(confidence) || n < 3 || !(sxx > 0.0)) {
+        return;
+    }
+
+    const double t = Distributions::studentTQuantile((1.0 + confidence) / 2.0, static_cast<double>(n - 2));
+    const double s = std::sqrt(std::max(0.0, sse) / (n - 2));
+
+    QVector<double> lower;
+    QVector<double> upper;
+    for (int h = 1; h <= result.predicted.size(); ++h) {
+        double dx = static_cast<double>(n + h) - meanX;
+        double halfWidth = t * s * std::sqrt(1.0 + 1.0 / n + dx * dx / sxx);
+        lower.append(result.predicted[h - 1] - halfWidth);
+        upper.append(result.predicted[h - 1] + halfWidth);
+    }
+
+    result.lowerBound = lower;
+    result.upperBound = upper;
+}
+
 // === 误差计算 ===
 
 double Forecasting::calculateMSE(const QVector<double>& actual,
@@ -308,68 +627,17 @@ QVector<double> Forecasting::leastSquares(const QVector<double>& x,
                                            const QVector<double>& y,
                                            int degree)
 {
-    int n = x.size();
-    int m = degree + 1;
+    // QR/Cholesky 求解，高阶多项式也不会因正规方程病态而失真
+    RegressionOptions options;
+    options.keepResiduals = false;
+    RegressionResult fit = Regression::polynomial(x, y, degree, options);
 
-    if (n < m) {
-        qWarning() << "数据量不足，无法进行" << degree << "阶多项式拟合";
+    if (!fit.isValid) {
+        qWarning() << "无法进行" << degree << "阶多项式拟合:" << fit.errorMessage;
         return QVector<double>();
     }
 
-    // 构造正规方程矩阵
-    QVector<QVector<double>> XTX(m, QVector<double>(m, 0.0));
-    QVector<double> XTy(m, 0.0);
-
-    for (int i = 0; i < n; ++i) {
-        QVector<double> powers(m);
-        powers[0] = 1.0;
-        for (int j = 1; j < m; ++j) {
-            powers[j] = powers[j-1] * x[i];
-        }
-
-        for (int row = 0; row < m; ++row) {
-            for (int col = 0; col < m; ++col) {
-                XTX[row][col] += powers[row] * powers[col];
-            }
-            XTy[row] += powers[row] * y[i];
-        }
-    }
-
-    // 高斯消元法求解
-    for (int col = 0; col < m; ++col) {
-        // 找主元
-        int maxRow = col;
-        for (int row = col + 1; row < m; ++row) {
-            if (qAbs(XTX[row][col]) > qAbs(XTX[maxRow][col])) {
-                maxRow = row;
-            }
-        }
-
-        // 交换行
-        std::swap(XTX[col], XTX[maxRow]);
-        std::swap(XTy[col], XTy[maxRow]);
-
-        // 消元
-        for (int row = col + 1; row < m; ++row) {
-            double factor = XTX[row][col] / XTX[col][col];
-            for (int i = col; i < m; ++i) {
-                XTX[row][i] -= factor * XTX[col][i];
-            }
-            XTy[row] -= factor * XTy[col];
-        }
-    }
-
-    // 回代
-    QVector<double> coefficients(m);
-    for (int i = m - 1; i >= 0; --i) {
-        coefficients[i] = XTy[i];
-        for (int j = i + 1; j < m; ++j) {
-            coefficients[i] -= XTX[i][j] * coefficients[j];
-        }
-        coefficients[i] /= XTX[i][i];
-    }
-
-    return coefficients;
+    return fit.coefficients;
 }
 
 } // namespace Statistics
@@ -9,7 +9,12 @@ namespace Statistics {
 /**
  * @brief 预测算法类
  *
- * 提供各种时间序列预测方法
+ * 提供各种时间序列预测方法。各方法同时给出置信水平为 confidence 的
+ * 预测区间（lowerBound/upperBound，数据不足以估计时为空）：
+ * - 指数平滑、Holt、加法 Holt-Winters：按一步预测误差方差的解析公式
+ * - 线性回归：t 分布预测区间
+ * - 移动平均：样本内各步长预测误差的经验分位数
+ * - 乘法 Holt-Winters：重抽样一步残差并行模拟未来路径
  */
 class Forecasting
 {
@@ -25,14 +30,16 @@ public:
      */
     static ForecastResult simpleMovingAverage(const QVector<double>& data,
                                                int window,
-                                               int forecastPeriods = 1);
+                                               int forecastPeriods = 1,
+                                               double confidence = 0.95);
 
     /**
      * @brief 加权移动平均
      */
     static ForecastResult weightedMovingAverage(const QVector<double>& data,
                                                 const QVector<double>& weights,
-                                                int forecastPeriods = 1);
+                                                int forecastPeriods = 1,
+                                                double confidence = 0.95);
 
     /**
      * @brief 中心移动平均
@@ -46,7 +53,8 @@ public:
      */
     static ForecastResult exponentialSmoothing(const QVector<double>& data,
                                                 double alpha,
-                                                int forecastPeriods = 1);
+                                                int forecastPeriods = 1,
+                                                double confidence = 0.95);
 
     /**
      * @brief 双指数平滑（Holt 线性趋势方法）
@@ -54,7 +62,22 @@ public:
     static ForecastResult doubleExponentialSmoothing(const QVector<double>& data,
                                                       double alpha,
                                                       double beta,
-                                                      int forecastPeriods = 1);
+                                                      int forecastPeriods = 1,
+                                                      double confidence = 0.95);
+
+    /**
+     * @brief Holt-Winters 季节指数平滑
+     * @param seasonLength 季节周期（至少 2，数据至少需要两个完整周期）
+     * @param multiplicative 是否使用乘法季节（要求数据全部为正）
+     */
+    static ForecastResult holtWinters(const QVector<double>& data,
+                                      int seasonLength,
+                                      double alpha,
+                                      double beta,
+                                      double gamma,
+                                      bool multiplicative = false,
+                                      int forecastPeriods = 1,
+                                      double confidence = 0.95);
 
     // === 线性回归 ===
 
@@ -62,7 +85,29 @@ public:
      * @brief 简单线性回归
      */
     static ForecastResult linearRegression(const QVector<double>& data,
-                                            int forecastPeriods = 1);
+                                            int forecastPeriods = 1,
+                                            double confidence = 0.95);
+
+    // === 预测区间 ===
+
+    /**
+     * @brief 按解析公式填充指数平滑的预测区间
+     *
+     * 以 result.errorMetric（一步预测 MSE）为误差方差，第 h 期方差为
+     * σ²(1 + Σc_j²)，c_j 由平滑系数决定。乘法季节模型没有解析公式，不做处理。
+     */
+    static void smoothingIntervals(ForecastResult& result, SmoothingModel model,
+                                   const SmoothingParameters& parameters, int seasonLength,
+                                   double confidence);
+
+    /**
+     * @brief 填充线性趋势回归的 t 分布预测区间（x = 1..n，预测点为 n+1, n+2, ...）
+     * @param meanX x 的均值
+     * @param sxx x 的离差平方和
+     * @param sse 残差平方和
+     */
+    static void regressionIntervals(ForecastResult& result, qint64 n, double meanX, double sxx,
+                                    double sse, double confidence);
 
     // === 误差计算 ===
 
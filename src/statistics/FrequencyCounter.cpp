@@ -0,0 +1,266 @@
+#include "FrequencyCounter.h"
+#include <QHash>
+#include <QtMath>
+#include <algorithm>
+
+namespace Statistics {
+
+namespace {
+
+/**
+ * @brief Space-Saving 高频值摘要
+ *
+ * 维护固定个数的计数器（最小堆 + 哈希索引）。新元素替换计数最小的
+ * 计数器并继承其计数作为误差上界，保证真实频次 ≥ count - error。
+ */
+template<typename Key>
+class SpaceSaving
+{
+public:
+    struct Counter
+    {
+        Key key;
+        qint64 count;
+        qint64 error;
+    };
+
+    explicit SpaceSaving(int capacity)
+        : m_capacity(std::max(1, capacity))
+    {
+        m_heap.reserve(m_capacity);
+        m_index.reserve(m_capacity);
+    }
+
+    void offer(const Key& key)
+    {
+        auto it = m_index.find(key);
+        if (it != m_index.end()) {
+            int pos = it.value();
+            ++m_heap[pos].count;
+            siftDown(pos);
+            return;
+        }
+
+        if (m_heap.size() < m_capacity) {
+            m_heap.append(Counter{key, 1, 0});
+            int pos = m_heap.size() - 1;
+            m_index.insert(key, pos);
+            siftUp(pos);
+            return;
+        }
+
+        // 替换计数最小的计数器
+        Counter& root = m_heap[0];
+        m_index.remove(root.key);
+        root.error = root.count;
+        root.count += 1;
+        root.key = key;
+        m_index.insert(key, 0);
+        siftDown(0);
+    }
+
+    const QVector<Counter>& counters() const { return m_heap; }
+
+private:
+    void swapAt(int a, int b)
+    {
+        std::swap(m_heap[a], m_heap[b]);
+        m_index[m_heap[a].key] = a;
+        m_index[m_heap[b].key] = b;
+    }
+
+    void siftUp(int pos)
+    {
+        while (pos > 0) {
+            int parent = (pos - 1) / 2;
+            if (m_heap[parent].count <= m_heap[pos].count) {
+                break;
+            }
+            swapAt(pos, parent);
+            pos = parent;
+        }
+    }
+
+    void siftDown(int pos)
+    {
+        int n = m_heap.size();
+        while (true) {
+            int smallest = pos;
+            int left = 2 * pos + 1;
+            int right = left + 1;
+            if (left < n && m_heap[left].count < m_heap[smallest].count) smallest = left;
+            if (right < n && m_heap[right].count < m_heap[smallest].count) smallest = right;
+            if (smallest == pos) {
+                break;
+            }
+            swapAt(pos, smallest);
+            pos = smallest;
+        }
+    }
+
+    int m_capacity;
+    QVector<Counter> m_heap;
+    QHash<Key, int> m_index;
+};
+
+double normalizeKey(double value)
+{
+    // +0.0 与 -0.0 视为同一取值
+    return value == 0.0 ? 0.0 : value;
+}
+
+FrequencyItem makeItem(double value, qint64 count, qint64 error)
+{
+    FrequencyItem item;
+    item.value = value;
+    item.label = QString::number(value, 'g', 15);
+    item.count = count;
+    item.error = error;
+    return item;
+}
+
+FrequencyItem makeItem(const QString& value, qint64 count, qint64 error)
+{
+    FrequencyItem item;
+    item.value = qQNaN();
+    item.label = value;
+    item.count = count;
+    item.error = error;
+    return item;
+}
+
+bool keyLess(double a, double b) { return a < b; }
+bool keyLess(const QString& a, const QString& b) { return a < b; }
+
+/**
+ * @brief 通用 Top-K：先尝试精确哈希计数，不同值过多时切换 Space-Saving
+ */
+template<typename Key, typename Accept, typename Normalize>
+TopKResult computeTopK(const QVector<Key>& data, int k, Accept accept, Normalize normalize)
+{
+    TopKResult result;
+    if (k <= 0) {
+        return result;
+    }
+
+    struct Entry
+    {
+        Key key;
+        qint64 count;
+        qint64 error;
+    };
+    QVector<Entry> entries;
+
+    QHash<Key, qint64> counts;
+    bool overflow = false;
+
+    for (const Key& raw : data) {
+        if (!accept(raw)) {
+            continue;
+        }
+        ++result.total;
+
+        auto it = counts.find(normalize(raw));
+        if (it != counts.end()) {
+            ++it.value();
+        } else if (counts.size() < FrequencyCounter::EXACT_DISTINCT_LIMIT) {
+            counts.insert(normalize(raw), 1);
+        } else {
+            overflow = true;
+            break;
+        }
+    }
+
+    if (!overflow) {
+        entries.reserve(counts.size());
+        for (auto it = counts.constBegin(); it != counts.constEnd(); ++it) {
+            entries.append(Entry{it.key(), it.value(), 0});
+        }
+    } else {
+        // 基数过大：用固定内存的 Space-Saving 重新扫描
+        counts = QHash<Key, qint64>();
+        result.total = 0;
+        result.exact = false;
+
+        SpaceSaving<Key> summary(std::max(64 * k, 4096));
+        for (const Key& raw : data) {
+            if (accept(raw)) {
+                ++result.total;
+                summary.offer(normalize(raw));
+            }
+        }
+
+        for (const auto& counter : summary.counters()) {
+            entries.append(Entry{counter.key, counter.count, counter.error});
+        }
+    }
+
+    int keep = std::min<int>(k, entries.size());
+    std::partial_sort(entries.begin(), entries.begin() + keep, entries.end(),
+                      [](const Entry& a, const Entry& b) {
+                          return a.count != b.count ? a.count > b.count : keyLess(a.key, b.key);
+                      });
+
+    result.items.reserve(keep);
+    for (int i = 0; i < keep; ++i) {
+        result.items.append(makeItem(entries[i].key, entries[i].count, entries[i].error));
+    }
+
+    return result;
+}
+
+} // namespace
+
+TopKResult FrequencyCounter::topK(const QVector<double>& data, int k)
+{
+    return computeTopK(data, k,
+                       [](double value) { return qIsFinite(value); },
+                       [](double value) { return normalizeKey(value); });
+}
+
+TopKResult FrequencyCounter::topK(const QVector<QString>& data, int k)
+{
+    return computeTopK(data, k,
+                       [](const QString& value) { return !value.isEmpty(); },
+                       [](const QString& value) { return value; });
+}
+
+QVector<FrequencyItem> FrequencyCounter::modes(const QVector<double>& data)
+{
+    QVector<double> sorted;
+    sorted.reserve(data.size());
+    for (double value : data) {
+        if (qIsFinite(value)) {
+            sorted.append(normalizeKey(value));
+        }
+    }
+
+    QVector<FrequencyItem> result;
+    if (sorted.isEmpty()) {
+        return result;
+    }
+
+    std::sort(sorted.begin(), sorted.end());
+
+    // 游程计数：第一遍求最大频次，第二遍收集所有众数
+    qint64 best = 0;
+    for (qsizetype i = 0; i < sorted.size();) {
+        qsizetype j = i + 1;
+        while (j < sorted.size() && sorted[j] == sorted[i]) ++j;
+        best = std::max<qint64>(best, j - i);
+        i = j;
+    }
+
+    for (qsizetype i = 0; i < sorted.size();) {
+        qsizetype j = i + 1;
+        while (j < sorted.size() && sorted[j] == sorted[i]) ++j;
+        if (j - i == best) {
+            result.append(makeItem(sorted[i], best, 0));
+        }
+        i = j;
+    }
+
+    return result;
+}
+
+} // namespace Statistics
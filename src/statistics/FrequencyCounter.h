@@ -0,0 +1,47 @@
+#ifndef FREQUENCYCOUNTER_H
+#define FREQUENCYCOUNTER_H
+
+#include "StatisticTypes.h"
+#include <QVector>
+#include <QString>
+
+namespace Statistics {
+
+/**
+ * @brief 频数统计引擎
+ *
+ * 基于哈希表/排序进行频数统计，替代逐节点分配的红黑树（QMap）。
+ * 不同值较少时精确计数；不同值超过上限时改用 Space-Saving
+ * 算法在固定内存内近似求出高频值（Top-K）。
+ */
+class FrequencyCounter
+{
+public:
+    // 精确计数允许的最大不同值个数，超过后切换为 Space-Saving
+    static const int EXACT_DISTINCT_LIMIT = 200000;
+
+    /**
+     * @brief 数值数据的高频值
+     * @param data 数据（NaN/Inf 被忽略）
+     * @param k 返回的条目数
+     */
+    static TopKResult topK(const QVector<double>& data, int k);
+
+    /**
+     * @brief 文本数据的高频值
+     * @param data 数据（空字符串被忽略）
+     * @param k 返回的条目数
+     */
+    static TopKResult topK(const QVector<QString>& data, int k);
+
+    /**
+     * @brief 所有众数（出现次数最多的值，按数值升序）
+     *
+     * 基于排序后的游程计数，O(n log n) 且无逐节点内存分配
+     */
+    static QVector<FrequencyItem> modes(const QVector<double>& data);
+};
+
+} // namespace Statistics
+
+#endif // FREQUENCYCOUNTER_H
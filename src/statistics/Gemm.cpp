@@ -0,0 +1,386 @@
+#include "Gemm.h"
+#include "CpuFeatures.h"
+#include "ParallelUtils.h"
+#include <QDebug>
+#include <QtGlobal>
+#include <algorithm>
+#include <cstring>
+
+namespace Statistics {
+
+namespace {
+
+// 分块参数（double）：A 块 MC×KC 约 192 KB 留在 L2，B 条带 KC×NR 约 12 KB 留在 L1
+const qsizetype KC = 256;
+const qsizetype MC = 96;
+const qsizetype NC = 3072;
+
+// m·n·k 不超过该值时打包开销占主导，直接用 i-k-j 循环
+const qsizetype SMALL_WORK = 48 * 48 * 48;
+
+// 转置递归到面积不超过该值的子块后逐元素复制（两个 32×32 块约 16 KB）
+const qsizetype TRANSPOSE_LEAF = 32 * 32;
+
+// 并行转置时每块的最少源行数
+const qsizetype MIN_TRANSPOSE_ROWS = 64;
+
+// 微内核：计算 MR×NR 子块 ab = Σ_p a[p]·b[p]ᵀ，结果按列优先写入 ab
+using MicroKernel = void (*)(qsizetype kc, const double* a, const double* b, double* ab);
+
+struct KernelInfo
+{
+    int mr;
+    int nr;
+    MicroKernel kernel;
+    const char* name;
+};
+
+// === 微内核 ===
+
+#ifndef STATISTICS_X86_64
+
+void scalarKernel4x4(qsizetype kc, const double* a, const double* b, double* ab)
+{
+    double c[16] = {};
+    for (qsizetype p = 0; p < kc; ++p) {
+        for (int j = 0; j < 4; ++j) {
+            for (int i = 0; i < 4; ++i) {
+                c[j * 4 + i] += a[i] * b[j];
+            }
+        }
+        a += 4;
+        b += 4;
+    }
+    std::memcpy(ab, c, sizeof(c));
+}
+
+#else
+
+void sse2Kernel4x4(qsizetype kc, const double* a, const double* b, double* ab)
+{
+    __m128d c00 = _mm_setzero_pd(), c01 = _mm_setzero_pd();
+    __m128d c10 = _mm_setzero_pd(), c11 = _mm_setzero_pd();
+    __m128d c20 = _mm_setzero_pd(), c21 = _mm_setzero_pd();
+    __m128d c30 = _mm_setzero_pd(), c31 = _mm_setzero_pd();
+
+    for (qsizetype p = 0; p < kc; ++p) {
+        const __m128d a0 = _mm_loadu_pd(a);
+        const __m128d a1 = _mm_loadu_pd(a + 2);
+        __m128d bj = _mm_set1_pd(b[0]);
+        c00 = _mm_add_pd(c00, _mm_mul_pd(a0, bj));
+        c01 = _mm_add_pd(c01, _mm_mul_pd(a1, bj));
+        bj = _mm_set1_pd(b[1]);
+        c10 = _mm_add_pd(c10, _mm_mul_pd(a0, bj));
+        c11 = _mm_add_pd(c11, _mm_mul_pd(a1, bj));
+        bj = _mm_set1_pd(b[2]);
+        c20 = _mm_add_pd(c20, _mm_mul_pd(a0, bj));
+        c21 = _mm_add_pd(c21, _mm_mul_pd(a1, bj));
+        bj = _mm_set1_pd(b[3]);
+        c30 = _mm_add_pd(c30, _mm_mul_pd(a0, bj));
+        c31 = _mm_add_pd(c31, _mm_mul_pd(a1, bj));
+        a += 4;
+        b += 4;
+    }
+
+    _mm_storeu_pd(ab + 0, c00);
+    _mm_storeu_pd(ab + 2, c01);
+    _mm_storeu_pd(ab + 4, c10);
+    _mm_storeu_pd(ab + 6, c11);
+    _mm_storeu_pd(ab + 8, c20);
+    _mm_storeu_pd(ab + 10, c21);
+    _mm_storeu_pd(ab + 12, c30);
+    _mm_storeu_pd(ab + 14, c31);
+}
+
+// 12 个累加寄存器 + 2 个 A 寄存器 + 1 个广播寄存器，共用 15 个 ymm
+STATISTICS_TARGET_AVX2
+void avx2Kernel8x6(qsizetype kc, const double* a, const double* b, double* ab)
+{
+    __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+    __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+    __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+    __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+    __m256d c40 = _mm256_setzero_pd(), c41 = _mm256_setzero_pd();
+    __m256d c50 = _mm256_setzero_pd(), c51 = _mm256_setzero_pd();
+
+    for (qsizetype p = 0; p < kc; ++p) {
+        const __m256d a0 = _mm256_loadu_pd(a);
+        const __m256d a1 = _mm256_loadu_pd(a + 4);
+        __m256d bj = _mm256_broadcast_sd(b + 0);
+        c00 = _mm256_fmadd_pd(a0, bj, c00);
+        c01 = _mm256_fmadd_pd(a1, bj, c01);
+        bj = _mm256_broadcast_sd(b + 1);
+        c10 = _mm256_fmadd_pd(a0, bj, c10);
+        c11 = _mm256_fmadd_pd(a1, bj, c11);
+        bj = _mm256_broadcast_sd(b + 2);
+        c20 = _mm256_fmadd_pd(a0, bj, c20);
+        c21 = _mm256_fmadd_pd(a1, bj, c21);
+        bj = _mm256_broadcast_sd(b + 3);
+        c30 = _mm256_fmadd_pd(a0, bj, c30);
+        c31 = _mm256_fmadd_pd(a1, bj, c31);
+        bj = _mm256_broadcast_sd(b + 4);
+        c40 = _mm256_fmadd_pd(a0, bj, c40);
+        c41 = _mm256_fmadd_pd(a1, bj, c41);
+        bj = _mm256_broadcast_sd(b + 5);
+        c50 = _mm256_fmadd_pd(a0, bj, c50);
+        c51 = _mm256_fmadd_pd(a1, bj, c51);
+        a += 8;
+        b += 6;
+    }
+
+    _mm256_storeu_pd(ab + 0, c00);
+    _mm256_storeu_pd(ab + 4, c01);
+    _mm256_storeu_pd(ab + 8, c10);
+    _mm256_storeu_pd(ab + 12, c11);
+    _mm256_storeu_pd(ab + 16, c20);
+    _mm256_storeu_pd(ab + 20, c21);
+    _mm256_storeu_pd(ab + 24, c30);
+    _mm256_storeu_pd(ab + 28, c31);
+    _mm256_storeu_pd(ab + 32, c40);
+    _mm256_storeu_pd(ab + 36, c41);
+    _mm256_storeu_pd(ab + 40, c50);
+    _mm256_storeu_pd(ab + 44, c51);
+}
+
+#endif // STATISTICS_X86_64
+
+const KernelInfo& selectedKernel()
+{
+    static const KernelInfo kernel = []() {
+#ifdef STATISTICS_X86_64
+        if (CpuFeatures::hasAvx2Fma()) {
+            return KernelInfo{8, 6, avx2Kernel8x6, "AVX2/FMA 8×6"};
+        }
+        return KernelInfo{4, 4, sse2Kernel4x4, "SSE2 4×4"};
+#else
+        return KernelInfo{4, 4, scalarKernel4x4, "标量 4×4"};
+#endif
+    }();
+    return kernel;
+}
+
+// === 打包 ===
+
+/**
+ * @brief 64 字节对齐的临时缓冲区（不初始化）
+ */
+class AlignedBuffer
+{
+public:
+    explicit AlignedBuffer(qsizetype count)
+        : m_data(static_cast<double*>(qMallocAligned(static_cast<size_t>(std::max<qsizetype>(1, count)) * sizeof(double),
+                                                     64)))
+    {
+        Q_CHECK_PTR(m_data);
+    }
+    ~AlignedBuffer() { qFreeAligned(m_data); }
+    AlignedBuffer(const AlignedBuffer&) = delete;
+    AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+
+    double* data() const { return m_data; }
+
+private:
+    double* m_data;
+};
+
+/**
+ * @brief A[i0:i0+mc, p0:p0+kc] → 高 mr 的条带，条带内按 k 排列（不足 mr 行补 0）
+ */
+void packA(const ConstMatrixView& A, qsizetype i0, qsizetype mc, qsizetype p0, qsizetype kc, int mr, double* out)
+{
+    const qsizetype stride = A.rowStride();
+    for (qsizetype s = 0; s < mc; s += mr) {
+        const qsizetype rows = std::min<qsizetype>(mr, mc - s);
+        for (qsizetype p = 0; p < kc; ++p) {
+            const double* source = A.ptr(i0 + s, p0 + p);
+            qsizetype i = 0;
+            for (; i < rows; ++i) {
+                out[i] = source[i * stride];
+            }
+            for (; i < mr; ++i) {
+                out[i] = 0.0;
+            }
+            out += mr;
+        }
+    }
+}
+
+/**
+ * @brief B[p0:p0+kc, j0:j0+nc] → 宽 nr 的条带，条带内按 k 排列（不足 nr 列补 0）
+ */
+void packB(const ConstMatrixView& B, qsizetype p0, qsizetype kc, qsizetype j0, qsizetype nc, int nr, double* out)
+{
+    const qsizetype stride = B.colStride();
+    const qsizetype slivers = (nc + nr - 1) / nr;
+
+    Parallel::forChunks(slivers, Parallel::chunkCount(slivers, 8), [&](int, qsizetype begin, qsizetype end) {
+        for (qsizetype sliver = begin; sliver < end; ++sliver) {
+            const qsizetype s = sliver * nr;
+            const qsizetype cols = std::min<qsizetype>(nr, nc - s);
+            double* target = out + s * kc;
+            for (qsizetype p = 0; p < kc; ++p) {
+                const double* source = B.ptr(p0 + p, j0 + s);
+                qsizetype j = 0;
+                for (; j < cols; ++j) {
+                    target[j] = source[j * stride];
+                }
+                for (; j < nr; ++j) {
+                    target[j] = 0.0;
+                }
+                target += nr;
+            }
+        }
+    });
+}
+
+/**
+ * @brief 已打包的 A 块（mc×kc）乘已打包的 B 面板（kc×nc），累加到 C 的对应子块
+ */
+void macroKernel(const KernelInfo& info, qsizetype mc, qsizetype nc, qsizetype kc,
+                 const double* packedA, const double* packedB,
+                 double alpha, double beta, const MatrixView& C, qsizetype i0, qsizetype j0)
+{
+    alignas(64) double ab[8 * 8];
+
+    for (qsizetype jr = 0; jr < nc; jr += info.nr) {
+        const qsizetype cols = std::min<qsizetype>(info.nr, nc - jr);
+        for (qsizetype ir = 0; ir < mc; ir += info.mr) {
+            const qsizetype rows = std::min<qsizetype>(info.mr, mc - ir);
+            info.kernel(kc, packedA + ir * kc, packedB + jr * kc, ab);
+
+            for (qsizetype j = 0; j < cols; ++j) {
+                for (qsizetype i = 0; i < rows; ++i) {
+                    double& c = C(i0 + ir + i, j0 + jr + j);
+                    c = (beta == 0.0 ? 0.0 : beta * c) + alpha * ab[j * info.mr + i];
+                }
+            }
+        }
+    }
+}
+
+void smallMultiply(double alpha, const ConstMatrixView& A, const ConstMatrixView& B,
+                   double beta, const MatrixView& C)
+{
+    for (qsizetype i = 0; i < C.rows(); ++i) {
+        for (qsizetype j = 0; j < C.cols(); ++j) {
+            C(i, j) = beta == 0.0 ? 0.0 : beta * C(i, j);
+        }
+        for (qsizetype k = 0; k < A.cols(); ++k) {
+            const double a = alpha * A(i, k);
+            for (qsizetype j = 0; j < C.cols(); ++j) {
+                C(i, j) += a * B(k, j);
+            }
+        }
+    }
+}
+
+void transposeBlock(const ConstMatrixView& source, const MatrixView& target,
+                    qsizetype r0, qsizetype r1, qsizetype c0, qsizetype c1)
+{
+    const qsizetype rows = r1 - r0;
+    const qsizetype cols = c1 - c0;
+    if (rows * cols <= TRANSPOSE_LEAF) {
+        for (qsizetype r = r0; r < r1; ++r) {
+            for (qsizetype c = c0; c < c1; ++c) {
+                target(c, r) = source(r, c);
+            }
+        }
+        return;
+    }
+
+    if (rows >= cols) {
+        const qsizetype mid = r0 + rows / 2;
+        transposeBlock(source, target, r0, mid, c0, c1);
+        transposeBlock(source, target, mid, r1, c0, c1);
+    } else {
+        const qsizetype mid = c0 + cols / 2;
+        transposeBlock(source, target, r0, r1, c0, mid);
+        transposeBlock(source, target, r0, r1, mid, c1);
+    }
+}
+
+} // namespace
+
+// === 矩阵乘法 ===
+
+void Gemm::multiply(double alpha, const ConstMatrixView& A, const ConstMatrixView& B,
+                    double beta, const MatrixView& C)
+{
+    if (A.cols() != B.rows() || C.rows() != A.rows() || C.cols() != B.cols()) {
+        qWarning() << "矩阵维度不匹配，无法相乘";
+        return;
+    }
+
+    const qsizetype m = A.rows();
+    const qsizetype n = B.cols();
+    const qsizetype k = A.cols();
+    if (m == 0 || n == 0) {
+        return;
+    }
+    if (k == 0 || alpha == 0.0) {
+        for (qsizetype i = 0; i < m; ++i) {
+            for (qsizetype j = 0; j < n; ++j) {
+                C(i, j) = beta == 0.0 ? 0.0 : beta * C(i, j);
+            }
+        }
+        return;
+    }
+    if (m * n * k <= SMALL_WORK) {
+        smallMultiply(alpha, A, B, beta, C);
+        return;
+    }
+
+    const KernelInfo& info = selectedKernel();
+
+    // 行块数少于线程数时缩小 MC，保证每个线程都有 C 的行块可算
+    const qsizetype threads = Parallel::threadCount();
+    qsizetype mcStep = MC;
+    if ((m + MC - 1) / MC < threads) {
+        mcStep = std::max<qsizetype>(info.mr, ((m + threads - 1) / threads + info.mr - 1) / info.mr * info.mr);
+    }
+    const qsizetype rowBlocks = (m + mcStep - 1) / mcStep;
+
+    const qsizetype ncMax = std::min(NC, (n + info.nr - 1) / info.nr * info.nr);
+    AlignedBuffer packedB(KC * ncMax);
+
+    for (qsizetype jc = 0; jc < n; jc += NC) {
+        const qsizetype nc = std::min(NC, n - jc);
+        for (qsizetype pc = 0; pc < k; pc += KC) {
+            const qsizetype kc = std::min(KC, k - pc);
+            const double blockBeta = pc == 0 ? beta : 1.0;
+            packB(B, pc, kc, jc, nc, info.nr, packedB.data());
+
+            Parallel::forEach(static_cast<int>(rowBlocks), [&](int block) {
+                const qsizetype ic = block * mcStep;
+                const qsizetype mc = std::min(mcStep, m - ic);
+                AlignedBuffer packedA(((mc + info.mr - 1) / info.mr) * info.mr * kc);
+                packA(A, ic, mc, pc, kc, info.mr, packedA.data());
+                macroKernel(info, mc, nc, kc, packedA.data(), packedB.data(), alpha, blockBeta, C, ic, jc);
+            });
+        }
+    }
+}
+
+// === 转置 ===
+
+void Gemm::transpose(const ConstMatrixView& source, const MatrixView& target)
+{
+    if (target.rows() != source.cols() || target.cols() != source.rows()) {
+        qWarning() << "矩阵维度不匹配";
+        return;
+    }
+
+    const qsizetype rows = source.rows();
+    const qsizetype cols = source.cols();
+    const int chunks = Parallel::chunkCount(rows * cols, std::max<qsizetype>(1, MIN_TRANSPOSE_ROWS * cols));
+    Parallel::forChunks(rows, chunks, [&](int, qsizetype begin, qsizetype end) {
+        transposeBlock(source, target, begin, end, 0, cols);
+    });
+}
+
+QString Gemm::kernelName()
+{
+    return QString::fromUtf8(selectedKernel().name);
+}
+
+} // namespace Statistics
@@ -0,0 +1,50 @@
+#ifndef GEMM_H
+#define GEMM_H
+
+#include "DenseMatrix.h"
+#include <QString>
+
+namespace Statistics {
+
+/**
+ * @brief 通用矩阵乘法 C = α·A·B + β·C
+ *
+ * 按 BLIS/GotoBLAS 的方式分层分块：
+ * - B 的 KC×NC 面板打包为 NR 列宽的条带（放在 L3 中）
+ * - A 的 MC×KC 块打包为 MR 行高的条带（放在 L2 中）
+ * - 寄存器分块的微内核每次计算 MR×NR 的 C 子块，A、B 条带沿 k 连续读取
+ * 打包时按步长读取，因此 A、B、C 可以是任意存储顺序的视图（含转置视图）。
+ *
+ * 微内核在运行时按 CPU 选择：AVX2 + FMA（8×6）、SSE2（4×4），
+ * 其他平台使用可由编译器自动向量化的标量内核。各 MC 行块并行计算。
+ * 小矩阵（打包开销占主导）直接使用 i-k-j 循环。
+ */
+class Gemm
+{
+public:
+    /**
+     * @brief C = α·A·B + β·C（β 为 0 时不读取 C 的原值）
+     *
+     * A 为 m×k，B 为 k×n，C 为 m×n；C 不得与 A、B 重叠。
+     * 维度不匹配时输出警告且不修改 C。
+     */
+    static void multiply(double alpha, const ConstMatrixView& A, const ConstMatrixView& B,
+                         double beta, const MatrixView& C);
+
+    /**
+     * @brief 缓存无关的分块转置：target(i, j) = source(j, i)
+     *
+     * 递归地沿较长的一维对半切分，直到子块能放进 L1，再逐元素复制；
+     * 不需要针对具体缓存大小调参。target 须为 source.cols()×source.rows()。
+     */
+    static void transpose(const ConstMatrixView& source, const MatrixView& target);
+
+    /**
+     * @brief 当前使用的微内核名称（如 "AVX2/FMA 8×6"）
+     */
+    static QString kernelName();
+};
+
+} // namespace Statistics
+
+#endif // GEMM_H
@@ -0,0 +1,439 @@
+#include "Histogram.h"
+#include "ParallelUtils.h"
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Statistics {
+
+namespace {
+
+// 每个并行块的最小数据量
+const qsizetype MIN_VALUES_PER_CHUNK = 65536;
+
+// 估计分位数时的最大抽样个数
+const qsizetype QUANTILE_SAMPLE_SIZE = 65536;
+
+// 批量计算箱下标的块大小
+const int INDEX_BLOCK = 256;
+
+/**
+ * @brief 单个数据块的范围与矩
+ */
+struct RangeStats
+{
+    qint64 count = 0;
+    qint64 invalid = 0;
+    double min = std::numeric_limits<double>::max();
+    double max = std::numeric_limits<double>::lowest();
+    double mean = 0.0;
+    double m2 = 0.0;
+};
+
+RangeStats scanRange(const double* data, qsizetype begin, qsizetype end)
+{
+    RangeStats stats;
+    double sum = 0.0;
+
+    // 块内两遍：先求和与极值，再求离差平方和（数据仍在缓存中）
+    for (qsizetype i = begin; i < end; ++i) {
+        double x = data[i];
+        if (!qIsFinite(x)) {
+            ++stats.invalid;
+            continue;
+        }
+        ++stats.count;
+        sum += x;
+        stats.min = std::min(stats.min, x);
+        stats.max = std::max(stats.max, x);
+    }
+
+    if (stats.count == 0) {
+        return stats;
+    }
+
+    stats.mean = sum / stats.count;
+    for (qsizetype i = begin; i < end; ++i) {
+        double x = data[i];
+        if (qIsFinite(x)) {
+            double d = x - stats.mean;
+            stats.m2 += d * d;
+        }
+    }
+
+    return stats;
+}
+
+void mergeRange(RangeStats& target, const RangeStats& source)
+{
+    target.invalid += source.invalid;
+    if (source.count == 0) {
+        return;
+    }
+
+    // Chan 等人的并行方差合并公式
+    qint64 n = target.count + source.count;
+    double delta = source.mean - target.mean;
+    target.mean += delta * source.count / n;
+    target.m2 += source.m2 + delta * delta *
+                 (static_cast<double>(target.count) * source.count / n);
+    target.min = std::min(target.min, source.min);
+    target.max = std::max(target.max, source.max);
+    target.count = n;
+}
+
+/**
+ * @brief 等间隔抽取范围内的有限值并排序，用于估计分位数
+ */
+QVector<double> sortedSample(const QVector<double>& data, double lo, double hi)
+{
+    qsizetype step = std::max<qsizetype>(1, data.size() / QUANTILE_SAMPLE_SIZE);
+
+    QVector<double> sample;
+    sample.reserve(data.size() / step + 1);
+    for (qsizetype i = 0; i < data.size(); i += step) {
+        double x = data[i];
+        if (x >= lo && x <= hi) {
+            sample.append(x);
+        }
+    }
+
+    std::sort(sample.begin(), sample.end());
+    return sample;
+}
+
+double sampleQuantile(const QVector<double>& sorted, double p)
+{
+    if (sorted.isEmpty()) {
+        return 0.0;
+    }
+
+    double index = p * (sorted.size() - 1);
+    qsizetype lower = static_cast<qsizetype>(qFloor(index));
+    qsizetype upper = std::min<qsizetype>(lower + 1, sorted.size() - 1);
+    double weight = index - lower;
+    return sorted[lower] * (1.0 - weight) + sorted[upper] * weight;
+}
+
+/**
+ * @brief 等宽分箱计数
+ * @param counts 长度为 bins + 1，最后一格收集范围外的值与 NaN
+ */
+void countUniform(const double* data, qsizetype begin, qsizetype end,
+                  double lo, double hi, int bins, qint64* counts)
+{
+    const double scale = bins / (hi - lo);
+    const double lastBin = bins - 1;
+    const double discard = bins;
+    int index[INDEX_BLOCK];
+
+    for (qsizetype base = begin; base < end; base += INDEX_BLOCK) {
+        int len = static_cast<int>(std::min<qsizetype>(INDEX_BLOCK, end - base));
+        const double* x = data + base;
+
+        // 无分支地计算箱下标（NaN 的比较结果为 false，落入丢弃格）
+        for (int i = 0; i < len; ++i) {
+            double v = x[i];
+            bool inside = v >= lo && v <= hi;
+            double t = std::min((v - lo) * scale, lastBin);
+            index[i] = static_cast<int>(inside ? t : discard);
+        }
+
+        for (int i = 0; i < len; ++i) {
+            ++counts[index[i]];
+        }
+    }
+}
+
+/**
+ * @brief 不等宽分箱计数（二分查找边界）
+ */
+void countByEdges(const double* data, qsizetype begin, qsizetype end,
+                  const QVector<double>& edges, qint64* counts)
+{
+    int bins = edges.size() - 1;
+    double lo = edges.first();
+    double hi = edges.last();
+    auto innerBegin = edges.constBegin() + 1;
+    auto innerEnd = edges.constEnd() - 1;
+
+    for (qsizetype i = begin; i < end; ++i) {
+        double v = data[i];
+        if (!(v >= lo && v <= hi)) {
+            ++counts[bins];
+            continue;
+        }
+        ++counts[std::upper_bound(innerBegin, innerEnd, v) - innerBegin];
+    }
+}
+
+QVector<double> uniformEdges(double lo, double hi, int bins)
+{
+    QVector<double> edges(bins + 1);
+    double width = (hi - lo) / bins;
+    for (int i = 0; i <= bins; ++i) {
+        edges[i] = lo + i * width;
+    }
+    edges[bins] = hi;
+    return edges;
+}
+
+int binsForWidth(double lo, double hi, double width)
+{
+    double bins = std::ceil((hi - lo) / width);
+    return static_cast<int>(std::clamp(bins, 1.0, static_cast<double>(Histogram::MAX_BINS)));
+}
+
+/**
+ * @brief 在分箱网格上做高斯核卷积
+ * @param grid 网格频数（gridBins 个，覆盖 [lo, hi]）
+ */
+void convolveDensity(const QVector<qint64>& grid, double lo, double hi,
+                     qint64 total, double bandwidth, HistogramResult& result)
+{
+    int gridBins = grid.size();
+    double step = (hi - lo) / gridBins;
+
+    // 两侧各延伸 3 个带宽，使密度曲线在端点处自然衰减
+    int pad = std::min(gridBins, static_cast<int>(std::ceil(3.0 * bandwidth / step)));
+    int reach = std::min(gridBins + pad, static_cast<int>(std::ceil(4.0 * bandwidth / step)));
+
+    QVector<double> kernel(reach + 1);
+    const double norm = 1.0 / (std::sqrt(2.0 * M_PI) * bandwidth * total);
+    for (int k = 0; k <= reach; ++k) {
+        double u = k * step / bandwidth;
+        kernel[k] = std::exp(-0.5 * u * u) * norm;
+    }
+
+    int points = gridBins + 2 * pad;
+    result.densityX.resize(points);
+    result.densityY.resize(points);
+
+    Parallel::forChunks(points, Parallel::chunkCount(points, 256),
+                        [&](int, qsizetype begin, qsizetype end) {
+        for (qsizetype p = begin; p < end; ++p) {
+            int j = static_cast<int>(p) - pad;
+            int first = std::max(0, j - reach);
+            int last = std::min(gridBins - 1, j + reach);
+
+            double y = 0.0;
+            for (int i = first; i <= last; ++i) {
+                y += grid[i] * kernel[std::abs(i - j)];
+            }
+
+            result.densityX[p] = lo + (j + 0.5) * step;
+            result.densityY[p] = y;
+        }
+    });
+}
+
+HistogramResult makeError(const QString& message)
+{
+    HistogramResult result;
+    result.isValid = false;
+    result.errorMessage = message;
+    return result;
+}
+
+} // namespace
+
+int Histogram::sturgesBinCount(qint64 n)
+{
+    if (n <= 1) {
+        return 1;
+    }
+    return static_cast<int>(std::ceil(std::log2(static_cast<double>(n)))) + 1;
+}
+
+double Histogram::freedmanDiaconisWidth(double iqr, qint64 n)
+{
+    if (n <= 0 || iqr <= 0.0) {
+        return 0.0;
+    }
+    return 2.0 * iqr / std::cbrt(static_cast<double>(n));
+}
+
+double Histogram::silvermanBandwidth(double stdDev, double iqr, qint64 n)
+{
+    if (n <= 0) {
+        return 0.0;
+    }
+
+    double spread = stdDev;
+    if (iqr > 0.0) {
+        spread = std::min(spread, iqr / 1.34);
+    }
+    return 0.9 * spread * std::pow(static_cast<double>(n), -0.2);
+}
+
+QString Histogram::methodName(BinningMethod method)
+{
+    switch (method) {
+        case BinningMethod::FixedWidth:       return "固定宽度";
+        case BinningMethod::FreedmanDiaconis: return "Freedman-Diaconis";
+        case BinningMethod::Sturges:          return "Sturges";
+        case BinningMethod::Quantile:         return "等频分箱";
+    }
+    return QString();
+}
+
+HistogramResult Histogram::compute(const QVector<double>& data, const HistogramOptions& options)
+{
+    const double* values = data.constData();
+    qsizetype n = data.size();
+    int chunks = Parallel::chunkCount(n, MIN_VALUES_PER_CHUNK);
+
+    // === 第一遍：范围与矩 ===
+
+    QVector<RangeStats> partialRanges(chunks);
+    Parallel::forChunks(n, chunks, [&](int chunk, qsizetype begin, qsizetype end) {
+        partialRanges[chunk] = scanRange(values, begin, end);
+    });
+
+    RangeStats stats;
+    for (const RangeStats& partial : partialRanges) {
+        mergeRange(stats, partial);
+    }
+
+    if (stats.count == 0) {
+        return makeError("没有有效数据");
+    }
+
+    double lo = options.minValue.value_or(stats.min);
+    double hi = options.maxValue.value_or(stats.max);
+    if (!qIsFinite(lo) || !qIsFinite(hi) || lo > hi) {
+        return makeError("统计范围无效");
+    }
+    if (lo == hi) {
+        lo -= 0.5;
+        hi += 0.5;
+    }
+
+    // === 确定箱边界 ===
+
+    bool needSample = options.method == BinningMethod::FreedmanDiaconis ||
+                      options.method == BinningMethod::Quantile ||
+                      options.computeDensity;
+    QVector<double> sample = needSample ? sortedSample(data, lo, hi) : QVector<double>();
+    double iqr = sampleQuantile(sample, 0.75) - sampleQuantile(sample, 0.25);
+
+    HistogramResult result;
+
+    switch (options.method) {
+        case BinningMethod::FixedWidth:
+            if (options.binWidth > 0.0) {
+                double bins = std::ceil((hi - lo) / options.binWidth);
+                if (bins > MAX_BINS) {
+                    return makeError(QString("箱数超过上限 %1，请增大箱宽").arg(MAX_BINS));
+                }
+                int binCount = std::max(1, static_cast<int>(bins));
+                hi = lo + binCount * options.binWidth;
+                result.edges = uniformEdges(lo, hi, binCount);
+            } else {
+                int binCount = options.binCount > 0 ? options.binCount : sturgesBinCount(stats.count);
+                if (binCount > MAX_BINS) {
+                    return makeError(QString("箱数超过上限 %1").arg(MAX_BINS));
+                }
+                result.edges = uniformEdges(lo, hi, binCount);
+            }
+            break;
+
+        case BinningMethod::FreedmanDiaconis: {
+            double width = freedmanDiaconisWidth(iqr, stats.count);
+            int binCount = width > 0.0 ? binsForWidth(lo, hi, width) : sturgesBinCount(stats.count);
+            result.edges = uniformEdges(lo, hi, binCount);
+            break;
+        }
+
+        case BinningMethod::Sturges:
+            result.edges = uniformEdges(lo, hi, sturgesBinCount(stats.count));
+            break;
+
+        case BinningMethod::Quantile: {
+            int binCount = std::min(options.binCount > 0 ? options.binCount : 10, MAX_BINS);
+            result.edges.append(lo);
+            for (int i = 1; i < binCount; ++i) {
+                result.edges.append(sampleQuantile(sample, static_cast<double>(i) / binCount));
+            }
+            result.edges.append(hi);
+
+            // 重复值较多时相邻分位数可能相同，合并为一个箱
+            result.edges.erase(std::unique(result.edges.begin(), result.edges.end()),
+                               result.edges.end());
+            result.uniformWidth = false;
+            break;
+        }
+    }
+
+    int bins = result.edges.size() - 1;
+
+    // === 第二遍：各线程局部分箱后按块顺序合并 ===
+
+    int gridBins = options.computeDensity ? std::clamp(options.densityPoints, 16, 4096) : 0;
+
+    QVector<QVector<qint64>> partialCounts(chunks);
+    QVector<QVector<qint64>> partialGrids(chunks);
+
+    Parallel::forChunks(n, chunks, [&](int chunk, qsizetype begin, qsizetype end) {
+        QVector<qint64>& counts = partialCounts[chunk];
+        counts.fill(0, bins + 1);
+        if (result.uniformWidth) {
+            countUniform(values, begin, end, lo, hi, bins, counts.data());
+        } else {
+            countByEdges(values, begin, end, result.edges, counts.data());
+        }
+
+        if (gridBins > 0) {
+            QVector<qint64>& grid = partialGrids[chunk];
+            grid.fill(0, gridBins + 1);
+            countUniform(values, begin, end, lo, hi, gridBins, grid.data());
+        }
+    });
+
+    result.counts.fill(0, bins);
+    QVector<qint64> grid(gridBins, 0);
+    for (int chunk = 0; chunk < chunks; ++chunk) {
+        const QVector<qint64>& counts = partialCounts[chunk];
+        for (int i = 0; i < bins && !counts.isEmpty(); ++i) {
+            result.counts[i] += counts[i];
+        }
+        const QVector<qint64>& partialGrid = partialGrids[chunk];
+        for (int i = 0; i < gridBins && !partialGrid.isEmpty(); ++i) {
+            grid[i] += partialGrid[i];
+        }
+    }
+
+    for (qint64 count : result.counts) {
+        result.total += count;
+    }
+    result.outOfRange = stats.count - result.total;
+    result.invalidCount = stats.invalid;
+
+    result.density.resize(bins);
+    for (int i = 0; i < bins; ++i) {
+        double width = result.edges[i + 1] - result.edges[i];
+        result.density[i] = result.total > 0 && width > 0.0
+            ? result.counts[i] / (result.total * width)
+            : 0.0;
+    }
+
+    // === 核密度估计 ===
+
+    if (gridBins > 0 && result.total > 0) {
+        double stdDev = stats.count > 1 ? std::sqrt(stats.m2 / (stats.count - 1)) : 0.0;
+        double bandwidth = options.bandwidth > 0.0
+            ? options.bandwidth
+            : silvermanBandwidth(stdDev, iqr, result.total);
+
+        // 带宽小于半个网格步长时网格卷积会失真；常数列等退化情况取一个步长
+        double step = (hi - lo) / gridBins;
+        result.bandwidth = bandwidth > 0.0 ? std::max(bandwidth, step * 0.5) : step;
+
+        convolveDensity(grid, lo, hi, result.total, result.bandwidth, result);
+    }
+
+    return result;
+}
+
+} // namespace Statistics
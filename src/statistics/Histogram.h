@@ -0,0 +1,103 @@
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include <QVector>
+#include <QString>
+#include <optional>
+
+namespace Statistics {
+
+/**
+ * @brief 分箱方法
+ */
+enum class BinningMethod
+{
+    FixedWidth,         // 固定宽度（指定箱宽或箱数）
+    FreedmanDiaconis,   // Freedman–Diaconis 规则：宽度 = 2·IQR·n^(-1/3)
+    Sturges,            // Sturges 规则：箱数 = ⌈log2 n⌉ + 1
+    Quantile            // 等频分箱（按分位数确定边界）
+};
+
+/**
+ * @brief 直方图参数
+ */
+struct HistogramOptions
+{
+    BinningMethod method = BinningMethod::FreedmanDiaconis;
+    int binCount = 0;                   // FixedWidth/Quantile 的箱数（0 表示自动）
+    double binWidth = 0.0;              // FixedWidth 的箱宽（> 0 时优先于 binCount）
+    std::optional<double> minValue;     // 统计范围下限（默认取数据最小值）
+    std::optional<double> maxValue;     // 统计范围上限（默认取数据最大值）
+
+    bool computeDensity = false;        // 是否计算核密度估计（KDE）
+    int densityPoints = 512;            // KDE 网格点数
+    double bandwidth = 0.0;             // KDE 带宽（0 表示 Silverman 规则自动选择）
+};
+
+/**
+ * @brief 直方图结果
+ */
+struct HistogramResult
+{
+    QVector<double> edges;          // 箱边界（箱数 + 1 个）
+    QVector<qint64> counts;         // 每箱频数
+    QVector<double> density;        // 每箱频率密度 = 频数 / (总数 × 箱宽)
+    bool uniformWidth = true;       // 各箱宽度是否相同
+
+    QVector<double> densityX;       // KDE 网格坐标
+    QVector<double> densityY;       // KDE 密度值（积分为 1）
+    double bandwidth = 0.0;         // KDE 实际使用的带宽
+
+    qint64 total = 0;               // 落入统计范围的数据个数
+    qint64 outOfRange = 0;          // 超出统计范围的数据个数
+    qint64 invalidCount = 0;        // NaN/Inf 个数
+
+    bool isValid = true;
+    QString errorMessage;
+
+    int binCount() const { return counts.size(); }
+};
+
+/**
+ * @brief 直方图与密度计算器
+ *
+ * 先并行扫描一次求范围与矩，再并行扫描一次分箱：每个线程维护局部
+ * 直方图，按块顺序合并，因此结果与线程数无关。等宽分箱的内层循环
+ * 先批量计算箱下标（可被编译器向量化）再累加计数。
+ * KDE 在细分网格上对分箱后的频数做高斯核卷积，代价与数据量无关。
+ */
+class Histogram
+{
+public:
+    // 自动分箱允许的最大箱数
+    static constexpr int MAX_BINS = 10000;
+
+    /**
+     * @brief 计算直方图
+     * @param data 数据（NaN/Inf 被忽略）
+     * @param options 分箱参数
+     */
+    static HistogramResult compute(const QVector<double>& data,
+                                   const HistogramOptions& options = HistogramOptions());
+
+    /**
+     * @brief Sturges 规则的箱数
+     */
+    static int sturgesBinCount(qint64 n);
+
+    /**
+     * @brief Freedman–Diaconis 规则的箱宽
+     */
+    static double freedmanDiaconisWidth(double iqr, qint64 n);
+
+    /**
+     * @brief Silverman 经验带宽 0.9·min(σ, IQR/1.34)·n^(-1/5)
+     */
+    static double silvermanBandwidth(double stdDev, double iqr, qint64 n);
+
+    static QString methodName(BinningMethod method);
+};
+
+} // namespace Statistics
+
+#endif // HISTOGRAM_H
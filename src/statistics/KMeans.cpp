@@ -0,0 +1,743 @@
+#include "KMeans.h"
+#include "Bootstrap.h"
+#include "ColumnReader.h"
+#include "CpuFeatures.h"
+#include "ParallelUtils.h"
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Statistics {
+
+namespace {
+
+// 读入数据时每块的最少行数
+const qsizetype MIN_LOAD_ROWS = 8192;
+
+// 分配步骤每块的最少点数
+const qsizetype MIN_ASSIGN_ROWS = 16384;
+
+// 距离内核每次处理的点数（标签与距离先写入栈上的缓冲区）
+const qsizetype KERNEL_BLOCK = 256;
+
+// mini-batch：平滑后的批内平方和连续这么多批没有下降时停止
+const int MAX_STALLED_BATCHES = 10;
+
+struct Source
+{
+    int variables = 0;
+    qsizetype rows = 0;
+    ColumnReader reader;
+};
+
+KMeansResult invalidResult(const QString& message)
+{
+    KMeansResult result;
+    result.isValid = false;
+    result.errorMessage = message;
+    return result;
+}
+
+// === 距离内核 ===
+
+/**
+ * @brief 对点 [begin, end) 求最近的质心
+ * @param features 各特征数组的起始地址（结构数组布局）
+ * @param centers k×dims 的质心（行优先）
+ * @param labels 输出最近质心的下标，labels[i - begin]
+ * @param distances 输出到最近质心的平方距离
+ */
+using NearestKernel = void (*)(const float* const* features, int dims, qsizetype begin, qsizetype end,
+                               const float* centers, int k, int* labels, float* distances);
+
+void scalarNearest(const float* const* features, int dims, qsizetype begin, qsizetype end,
+                   const float* centers, int k, int* labels, float* distances)
+{
+    for (qsizetype i = begin; i < end; ++i) {
+        float best = std::numeric_limits<float>::max();
+        int bestLabel = 0;
+        for (int c = 0; c < k; ++c) {
+            const float* center = centers + c * dims;
+            float sum = 0.0f;
+            for (int f = 0; f < dims; ++f) {
+                const float d = features[f][i] - center[f];
+                sum += d * d;
+            }
+            if (sum < best) {
+                best = sum;
+                bestLabel = c;
+            }
+        }
+        labels[i - begin] = bestLabel;
+        distances[i - begin] = best;
+    }
+}
+
+#ifdef STATISTICS_X86_64
+
+void sse2Nearest(const float* const* features, int dims, qsizetype begin, qsizetype end,
+                 const float* centers, int k, int* labels, float* distances)
+{
+    qsizetype i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m128 best = _mm_set1_ps(std::numeric_limits<float>::max());
+        __m128i bestLabel = _mm_setzero_si128();
+        for (int c = 0; c < k; ++c) {
+            const float* center = centers + c * dims;
+            __m128 sum = _mm_setzero_ps();
+            for (int f = 0; f < dims; ++f) {
+                const __m128 d = _mm_sub_ps(_mm_loadu_ps(features[f] + i), _mm_set1_ps(center[f]));
+                sum = _mm_add_ps(sum, _mm_mul_ps(d, d));
+            }
+            // SSE2 没有 blendv，用掩码的与/或选择新标签
+            const __m128i closer = _mm_castps_si128(_mm_cmplt_ps(sum, best));
+            best = _mm_min_ps(sum, best);
+            bestLabel = _mm_or_si128(_mm_and_si128(closer, _mm_set1_epi32(c)), _mm_andnot_si128(closer, bestLabel));
+        }
+        _mm_storeu_ps(distances + (i - begin), best);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(labels + (i - begin)), bestLabel);
+    }
+    scalarNearest(features, dims, i, end, centers, k, labels + (i - begin), distances + (i - begin));
+}
+
+STATISTICS_TARGET_AVX2
+void avx2Nearest(const float* const* features, int dims, qsizetype begin, qsizetype end,
+                 const float* centers, int k, int* labels, float* distances)
+{
+    qsizetype i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m256 best = _mm256_set1_ps(std::numeric_limits<float>::max());
+        __m256 bestLabel = _mm256_castsi256_ps(_mm256_setzero_si256());
+        for (int c = 0; c < k; ++c) {
+            const float* center = centers + c * dims;
+            __m256 sum = _mm256_setzero_ps();
+            for (int f = 0; f < dims; ++f) {
+                const __m256 d = _mm256_sub_ps(_mm256_loadu_ps(features[f] + i), _mm256_set1_ps(center[f]));
+                sum = _mm256_fmadd_ps(d, d, sum);
+            }
+            const __m256 closer = _mm256_cmp_ps(sum, best, _CMP_LT_OQ);
+            best = _mm256_min_ps(sum, best);
+            bestLabel = _mm256_blendv_ps(bestLabel, _mm256_castsi256_ps(_mm256_set1_epi32(c)), closer);
+        }
+        _mm256_storeu_ps(distances + (i - begin), best);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(labels + (i - begin)), _mm256_castps_si256(bestLabel));
+    }
+    scalarNearest(features, dims, i, end, centers, k, labels + (i - begin), distances + (i - begin));
+}
+
+#endif // STATISTICS_X86_64
+
+struct KernelInfo
+{
+    NearestKernel kernel;
+    const char* name;
+};
+
+const KernelInfo& selectedKernel()
+{
+    static const KernelInfo kernel = []() {
+#ifdef STATISTICS_X86_64
+        if (CpuFeatures::hasAvx2Fma()) {
+            return KernelInfo{avx2Nearest, "AVX2/FMA ×8"};
+        }
+        return KernelInfo{sse2Nearest, "SSE2 ×4"};
+#else
+        return KernelInfo{scalarNearest, "标量"};
+#endif
+    }();
+    return kernel;
+}
+
+// === 数据 ===
+
+/**
+ * @brief 结构数组布局的特征：第 f 个特征的全部点连续存放（只含完整的行）
+ */
+struct Features
+{
+    int dims = 0;
+    qsizetype points = 0;
+    QVector<QVector<float>> columns;
+    QVector<const float*> pointers;
+    QVector<int> sourceRows;            // 各点在输入中的行号
+    QVector<double> means;
+    QVector<double> scales;
+    QVector<double> m2;                 // 工作尺度下各特征的离差平方和
+};
+
+/**
+ * @brief 并行读入各列，剔除不完整的行，按需标准化
+ */
+Features loadFeatures(const Source& source, bool standardize)
+{
+    const int dims = source.variables;
+    const int chunks = Parallel::chunkCount(source.rows, MIN_LOAD_ROWS);
+
+    struct Chunk
+    {
+        QVector<QVector<float>> columns;
+        QVector<int> rows;
+    };
+    QVector<Chunk> parts(chunks);
+
+    Parallel::forChunks(source.rows, chunks, [&](int chunk, qsizetype begin, qsizetype end) {
+        const qsizetype len = end - begin;
+        QVector<double> values(len * dims);
+        QVector<char> valid(len, 1);
+        for (int f = 0; f < dims; ++f) {
+            double* x = values.data() + f * len;
+            source.reader(f, begin, end, x);
+            for (qsizetype r = 0; r < len; ++r) {
+                valid[r] &= static_cast<char>(std::isfinite(x[r]));
+            }
+        }
+
+        Chunk& part = parts[chunk];
+        for (qsizetype r = 0; r < len; ++r) {
+            if (valid[r]) {
+                part.rows.append(static_cast<int>(begin + r));
+            }
+        }
+        part.columns.resize(dims);
+        for (int f = 0; f < dims; ++f) {
+            const double* x = values.constData() + f * len;
+            QVector<float>& column = part.columns[f];
+            column.reserve(part.rows.size());
+            for (qsizetype r = 0; r < len; ++r) {
+                if (valid[r]) {
+                    column.append(static_cast<float>(x[r]));
+                }
+            }
+        }
+    });
+
+    Features features;
+    features.dims = dims;
+    for (const Chunk& part : parts) {
+        features.points += part.rows.size();
+    }
+    features.sourceRows.reserve(features.points);
+    for (const Chunk& part : parts) {
+        features.sourceRows += part.rows;
+    }
+
+    // 各特征拼接、求均值与方差并原地标准化
+    features.columns.resize(dims);
+    features.means.fill(0.0, dims);
+    features.scales.fill(1.0, dims);
+    features.m2.fill(0.0, dims);
+    Parallel::forEach(dims, [&](int f) {
+        QVector<float>& column = features.columns[f];
+        column.reserve(features.points);
+        for (const Chunk& part : parts) {
+            column += part.columns[f];
+        }
+
+        const qsizetype n = column.size();
+        double sum = 0.0;
+        for (float x : column) {
+            sum += x;
+        }
+        const double mean = n > 0 ? sum / n : 0.0;
+        double m2 = 0.0;
+        for (float x : column) {
+            m2 += (x - mean) * (x - mean);
+        }
+
+        double scale = 1.0;
+        if (standardize && n > 1 && m2 > 0.0) {
+            scale = std::sqrt(m2 / (n - 1));
+        }
+        const float center = static_cast<float>(mean);
+        const float inverse = static_cast<float>(1.0 / scale);
+        for (float& x : column) {
+            x = (x - center) * inverse;
+        }
+
+        features.means[f] = mean;
+        features.scales[f] = scale;
+        features.m2[f] = m2 / (scale * scale);
+    });
+
+    features.pointers.resize(dims);
+    for (int f = 0; f < dims; ++f) {
+        features.pointers[f] = features.columns[f].constData();
+    }
+    return features;
+}
+
+QVector<float> toFloat(const QVector<double>& values)
+{
+    QVector<float> result(values.size());
+    std::transform(values.begin(), values.end(), result.begin(), [](double x) { return static_cast<float>(x); });
+    return result;
+}
+
+// === 分配步骤 ===
+
+/**
+ * @brief 一块点的分配结果：各簇的坐标和、点数与簇内平方和
+ */
+struct Accumulator
+{
+    QVector<double> sums;
+    QVector<qint64> counts;
+    QVector<double> withinSS;
+    qint64 changes = 0;             // 标签发生变化的点数
+
+    void init(int k, int dims)
+    {
+        sums.fill(0.0, k * dims);
+        counts.fill(0, k);
+        withinSS.fill(0.0, k);
+        changes = 0;
+    }
+
+    void merge(const Accumulator& other)
+    {
+        for (int i = 0; i < sums.size(); ++i) {
+            sums[i] += other.sums[i];
+        }
+        for (int c = 0; c < counts.size(); ++c) {
+            counts[c] += other.counts[c];
+            withinSS[c] += other.withinSS[c];
+        }
+        changes += other.changes;
+    }
+};
+
+/**
+ * @brief 把全部点分配到最近的质心（各块并行，局部累加器按块顺序合并）
+ */
+Accumulator assignAll(const Features& x, const QVector<double>& centers, int k, QVector<int>& labels,
+                      QVector<float>& distances)
+{
+    const int dims = x.dims;
+    const QVector<float> centersF = toFloat(centers);
+    const NearestKernel kernel = selectedKernel().kernel;
+
+    const int chunks = Parallel::chunkCount(x.points, MIN_ASSIGN_ROWS);
+    QVector<Accumulator> partials(chunks);
+    Parallel::forChunks(x.points, chunks, [&](int chunk, qsizetype begin, qsizetype end) {
+        Accumulator& local = partials[chunk];
+        local.init(k, dims);
+        int blockLabels[KERNEL_BLOCK];
+        float blockDistances[KERNEL_BLOCK];
+
+        for (qsizetype b = begin; b < end; b += KERNEL_BLOCK) {
+            const qsizetype e = std::min(end, b + KERNEL_BLOCK);
+            kernel(x.pointers.constData(), dims, b, e, centersF.constData(), k, blockLabels, blockDistances);
+            for (qsizetype i = b; i < e; ++i) {
+                const int label = blockLabels[i - b];
+                if (labels[i] != label) {
+                    labels[i] = label;
+                    ++local.changes;
+                }
+                distances[i] = blockDistances[i - b];
+                ++local.counts[label];
+                local.withinSS[label] += blockDistances[i - b];
+                double* sum = local.sums.data() + label * dims;
+                for (int f = 0; f < dims; ++f) {
+                    sum[f] += x.pointers[f][i];
+                }
+            }
+        }
+    });
+
+    for (int chunk = 1; chunk < chunks; ++chunk) {
+        partials[0].merge(partials[chunk]);
+    }
+    return partials[0];
+}
+
+/**
+ * @brief 距所属质心最远的 count 个点（用于给空簇重新播种）
+ */
+QVector<qsizetype> farthestPoints(const QVector<float>& distances, int count)
+{
+    QVector<qsizetype> result;
+    for (qsizetype i = 0; i < distances.size(); ++i) {
+        if (result.size() < count || distances[i] > distances[result.last()]) {
+            if (result.size() == count) {
+                result.removeLast();
+            }
+            auto position = std::upper_bound(result.begin(), result.end(), i, [&](qsizetype a, qsizetype b) {
+                return distances[a] > distances[b];
+            });
+            result.insert(position - result.begin(), i);
+        }
+    }
+    return result;
+}
+
+void setCenter(QVector<double>& centers, int c, const Features& x, qsizetype point)
+{
+    for (int f = 0; f < x.dims; ++f) {
+        centers[c * x.dims + f] = x.pointers[f][point];
+    }
+}
+
+// === 初始化 ===
+
+/**
+ * @brief k-means++：依次按到已选质心的平方距离加权抽取下一个质心
+ */
+QVector<double> kMeansPlusPlus(const Features& x, int k, RandomStream& rng)
+{
+    const int dims = x.dims;
+    const NearestKernel kernel = selectedKernel().kernel;
+    QVector<double> centers(k * dims, 0.0);
+    QVector<float> nearest(x.points, std::numeric_limits<float>::max());
+
+    setCenter(centers, 0, x, static_cast<qsizetype>(rng.bounded(x.points)));
+
+    const int chunks = Parallel::chunkCount(x.points, MIN_ASSIGN_ROWS);
+    QVector<double> chunkSums(chunks);
+    for (int c = 1; c < k; ++c) {
+        // 用新质心更新各点的最近平方距离，同时求各块之和
+        QVector<float> center(dims);
+        for (int f = 0; f < dims; ++f) {
+            center[f] = static_cast<float>(centers[(c - 1) * dims + f]);
+        }
+        Parallel::forChunks(x.points, chunks, [&](int chunk, qsizetype begin, qsizetype end) {
+            int blockLabels[KERNEL_BLOCK];
+            float blockDistances[KERNEL_BLOCK];
+            double sum = 0.0;
+            for (qsizetype b = begin; b < end; b += KERNEL_BLOCK) {
+                const qsizetype e = std::min(end, b + KERNEL_BLOCK);
+                kernel(x.pointers.constData(), dims, b, e, center.constData(), 1, blockLabels, blockDistances);
+                for (qsizetype i = b; i < e; ++i) {
+                    nearest[i] = std::min(nearest[i], blockDistances[i - b]);
+                    sum += nearest[i];
+                }
+            }
+            chunkSums[chunk] = sum;
+        });
+
+        double total = 0.0;
+        for (double sum : chunkSums) {
+            total += sum;
+        }
+        if (!(total > 0.0)) {
+            // 不同的点不足 k 个：其余质心与第一个重合，之后成为空簇
+            setCenter(centers, c, x, 0);
+            continue;
+        }
+
+        // 先定位到块，再在块内顺序累加
+        double target = rng.uniform() * total;
+        int chunk = 0;
+        while (chunk < chunks - 1 && target >= chunkSums[chunk]) {
+            target -= chunkSums[chunk++];
+        }
+        const qsizetype begin = Parallel::chunkBegin(x.points, chunks, chunk);
+        const qsizetype end = Parallel::chunkBegin(x.points, chunks, chunk + 1);
+        qsizetype chosen = end - 1;
+        for (qsizetype i = begin; i < end; ++i) {
+            target -= nearest[i];
+            if (target < 0.0) {
+                chosen = i;
+                break;
+            }
+        }
+        setCenter(centers, c, x, chosen);
+    }
+    return centers;
+}
+
+// === 迭代 ===
+
+struct Clustering
+{
+    QVector<double> centers;
+    QVector<int> labels;
+    Accumulator accumulator;
+    int iterations = 0;
+    bool converged = false;
+};
+
+double centerShift(const QVector<double>& before, const QVector<double>& after)
+{
+    double shift = 0.0;
+    for (int i = 0; i < before.size(); ++i) {
+        shift += (after[i] - before[i]) * (after[i] - before[i]);
+    }
+    return shift;
+}
+
+Clustering lloyd(const Features& x, int k, const KMeansOptions& options, double threshold, RandomStream& rng)
+{
+    Clustering state;
+    state.centers = kMeansPlusPlus(x, k, rng);
+    state.labels.fill(-1, x.points);
+    QVector<float> distances(x.points);
+    state.accumulator = assignAll(x, state.centers, k, state.labels, distances);
+
+    while (state.iterations < options.maxIterations) {
+        ++state.iterations;
+
+        // 各簇均值；空簇改用距所属质心最远的点
+        QVector<double> centers = state.centers;
+        QVector<int> empty;
+        for (int c = 0; c < k; ++c) {
+            const qint64 count = state.accumulator.counts[c];
+            if (count == 0) {
+                empty.append(c);
+                continue;
+            }
+            for (int f = 0; f < x.dims; ++f) {
+                centers[c * x.dims + f] = state.accumulator.sums[c * x.dims + f] / count;
+            }
+        }
+        if (!empty.isEmpty()) {
+            const QVector<qsizetype> points = farthestPoints(distances, empty.size());
+            for (int i = 0; i < empty.size() && i < points.size(); ++i) {
+                setCenter(centers, empty[i], x, points[i]);
+            }
+        }
+
+        const double shift = centerShift(state.centers, centers);
+        state.centers = centers;
+        state.accumulator = assignAll(x, state.centers, k, state.labels, distances);
+
+        if (state.accumulator.changes == 0 || shift <= threshold) {
+            state.converged = true;
+            break;
+        }
+    }
+    return state;
+}
+
+Clustering miniBatch(const Features& x, int k, const KMeansOptions& options, double threshold, RandomStream& rng)
+{
+    const int dims = x.dims;
+    const qsizetype batchSize = std::max<qsizetype>(1, std::min<qsizetype>(options.batchSize, x.points));
+    const NearestKernel kernel = selectedKernel().kernel;
+
+    Clustering state;
+    state.centers = kMeansPlusPlus(x, k, rng);
+
+    // 抽到的点复制到批内的结构数组缓冲区，以便使用同一个距离内核
+    QVector<QVector<float>> batch(dims, QVector<float>(batchSize));
+    QVector<const float*> batchPointers(dims);
+    for (int f = 0; f < dims; ++f) {
+        batchPointers[f] = batch[f].constData();
+    }
+    QVector<qsizetype> sample(batchSize);
+    QVector<int> batchLabels(batchSize);
+    QVector<float> batchDistances(batchSize);
+    QVector<double> seen(k, 0.0);
+
+    // 批内平方和的指数平滑（权重与批占总点数的比例相当）
+    const double alpha = std::min(1.0, 2.0 * batchSize / (x.points + 1.0));
+    double smoothed = -1.0;
+    double best = std::numeric_limits<double>::max();
+    int stalled = 0;
+
+    while (state.iterations < options.maxIterations) {
+        ++state.iterations;
+
+        for (qsizetype j = 0; j < batchSize; ++j) {
+            sample[j] = static_cast<qsizetype>(rng.bounded(x.points));
+            for (int f = 0; f < dims; ++f) {
+                batch[f][j] = x.pointers[f][sample[j]];
+            }
+        }
+        const QVector<float> centersF = toFloat(state.centers);
+        kernel(batchPointers.constData(), dims, 0, batchSize, centersF.constData(), k,
+               batchLabels.data(), batchDistances.data());
+
+        // 逐点更新：质心向该点移动 1/(该质心累计的点数)
+        const QVector<double> before = state.centers;
+        double batchSS = 0.0;
+        for (qsizetype j = 0; j < batchSize; ++j) {
+            const int c = batchLabels[j];
+            batchSS += batchDistances[j];
+            seen[c] += 1.0;
+            const double eta = 1.0 / seen[c];
+            double* center = state.centers.data() + c * dims;
+            for (int f = 0; f < dims; ++f) {
+                center[f] += eta * (batch[f][j] - center[f]);
+            }
+        }
+
+        batchSS /= batchSize;
+        smoothed = smoothed < 0.0 ? batchSS : smoothed * (1.0 - alpha) + batchSS * alpha;
+        if (smoothed < best) {
+            best = smoothed;
+            stalled = 0;
+        } else if (++stalled >= MAX_STALLED_BATCHES) {
+            state.converged = true;
+            break;
+        }
+        if (centerShift(before, state.centers) <= threshold) {
+            state.converged = true;
+            break;
+        }
+    }
+
+    // 最后把全部点分配一遍，得到标签与簇内平方和
+    state.labels.fill(-1, x.points);
+    QVector<float> distances(x.points);
+    state.accumulator = assignAll(x, state.centers, k, state.labels, distances);
+    return state;
+}
+
+KMeansResult computeSource(const Source& source, const KMeansOptions& options)
+{
+    const int k = options.clusters;
+    if (source.variables < 1) {
+        return invalidResult("至少需要一个特征列");
+    }
+    if (k < 1) {
+        return invalidResult("簇数至少为 1");
+    }
+    if (options.maxIterations < 1) {
+        return invalidResult("最大迭代次数至少为 1");
+    }
+
+    const Features x = loadFeatures(source, options.standardize);
+    if (x.points < k) {
+        return invalidResult(QString("有效行数（%1）少于簇数（%2）").arg(x.points).arg(k));
+    }
+
+    // 停止阈值相对于特征的平均方差（与数据尺度无关）
+    double meanVariance = 0.0;
+    for (double m2 : x.m2) {
+        meanVariance += x.points > 1 ? m2 / (x.points - 1) : 0.0;
+    }
+    meanVariance /= x.dims;
+    const double threshold = options.tolerance * meanVariance;
+
+    RandomStream rng(options.seed, 0);
+    Clustering state = options.algorithm == KMeansAlgorithm::MiniBatch ? miniBatch(x, k, options, threshold, rng)
+                                                                       : lloyd(x, k, options, threshold, rng);
+
+    // === 按首次出现的顺序重新编号（空簇排在最后）===
+    QVector<int> order;
+    QVector<int> renumber(k, -1);
+    for (int label : state.labels) {
+        if (renumber[label] < 0) {
+            renumber[label] = order.size();
+            order.append(label);
+            if (order.size() == k) {
+                break;
+            }
+        }
+    }
+    for (int c = 0; c < k; ++c) {
+        if (renumber[c] < 0) {
+            renumber[c] = order.size();
+            order.append(c);
+        }
+    }
+
+    KMeansResult result;
+    result.algorithm = options.algorithm;
+    result.observations = x.points;
+    result.iterations = state.iterations;
+    result.converged = state.converged;
+
+    for (int c : order) {
+        QVector<double> centroid(x.dims);
+        for (int f = 0; f < x.dims; ++f) {
+            centroid[f] = state.centers[c * x.dims + f] * x.scales[f] + x.means[f];
+        }
+        result.centroids.append(centroid);
+        result.sizes.append(state.accumulator.counts[c]);
+        result.withinSS.append(state.accumulator.withinSS[c]);
+        result.inertia += state.accumulator.withinSS[c];
+    }
+    for (double m2 : x.m2) {
+        result.totalSS += m2;
+    }
+
+    result.labels.fill(-1, source.rows);
+    for (qsizetype i = 0; i < x.points; ++i) {
+        result.labels[x.sourceRows[i]] = renumber[state.labels[i]];
+    }
+    return result;
+}
+
+} // namespace
+
+KMeansResult KMeans::compute(const Core::TableData& table, const QVector<int>& columns, const KMeansOptions& options)
+{
+    for (int column : columns) {
+        if (column < 0 || column >= table.columnCount()) {
+            return invalidResult(QString("列索引无效: %1").arg(column));
+        }
+    }
+
+    // 先按列优先整体转换（按行块并行），再从矩阵读取特征
+    const DenseMatrix data = columns.isEmpty() ? DenseMatrix()
+                                               : DenseMatrix::fromTable(table, columns, MatrixLayout::ColumnMajor);
+
+    Source source;
+    source.variables = columns.size();
+    source.rows = table.rowCount();
+    source.reader = matrixColumnReader(data);
+
+    KMeansResult result = computeSource(source, options);
+    if (result.isValid) {
+        result.columns = columns;
+        for (int column : columns) {
+            result.names.append(table.header(column));
+        }
+    }
+    return result;
+}
+
+KMeansResult KMeans::compute(const QVector<QVector<double>>& columns, const QStringList& names,
+                             const KMeansOptions& options)
+{
+    const qsizetype n = columns.isEmpty() ? 0 : columns.first().size();
+    for (const auto& column : columns) {
+        if (column.size() != n) {
+            return invalidResult("各列数据长度不一致");
+        }
+    }
+
+    Source source;
+    source.variables = columns.size();
+    source.rows = n;
+    source.reader = vectorColumnReader(columns);
+
+    KMeansResult result = computeSource(source, options);
+    if (result.isValid) {
+        for (int i = 0; i < columns.size(); ++i) {
+            result.columns.append(i);
+            result.names.append(i < names.size() ? names[i] : QString("x%1").arg(i + 1));
+        }
+    }
+    return result;
+}
+
+Core::ColumnDictionary KMeans::labelDictionary(const KMeansResult& result)
+{
+    // 空簇排在最后，不出现在表格中，也不进入字典（与逐行编码的结果一致）
+    QStringList labels;
+    for (int c = 0; c < result.sizes.size() && result.sizes[c] > 0; ++c) {
+        labels.append(QString("簇%1").arg(c + 1));
+    }
+    return Core::ColumnDictionary::fromCodes(result.labels, labels);
+}
+
+QString KMeans::algorithmName(KMeansAlgorithm algorithm)
+{
+    switch (algorithm) {
+    case KMeansAlgorithm::Lloyd:
+        return "Lloyd";
+    case KMeansAlgorithm::MiniBatch:
+        return "Mini-batch";
+    }
+    return QString();
+}
+
+QString KMeans::kernelName()
+{
+    return QString::fromUtf8(selectedKernel().name);
+}
+
+} // namespace Statistics
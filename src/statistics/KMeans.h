@@ -0,0 +1,104 @@
+#ifndef KMEANS_H
+#define KMEANS_H
+
+#include "core/ColumnDictionary.h"
+#include "core/TableData.h"
+#include <QVector>
+#include <QString>
+#include <QStringList>
+
+namespace Statistics {
+
+/**
+ * @brief k-means 的迭代方式
+ */
+enum class KMeansAlgorithm
+{
+    Lloyd,          // 每轮把全部点分配到最近质心，再以各簇均值更新质心
+    MiniBatch       // 每轮随机抽取一小批点，按各质心累计的点数逐点更新（适合超大表）
+};
+
+/**
+ * @brief k-means 参数
+ */
+struct KMeansOptions
+{
+    int clusters = 3;
+    KMeansAlgorithm algorithm = KMeansAlgorithm::Lloyd;
+    bool standardize = true;        // 各特征先标准化（量纲不同时需要）
+    int maxIterations = 100;        // Lloyd 的最大轮数 / mini-batch 的最大批数
+    double tolerance = 1e-4;        // 各质心移动量的平方和不超过 tolerance × 特征平均方差时停止
+    int batchSize = 4096;           // mini-batch 每批的点数
+    quint64 seed = 20240601;        // k-means++ 初始化与抽样的种子
+};
+
+/**
+ * @brief k-means 结果
+ *
+ * 簇按在输入中首次出现的顺序编号（与 ColumnDictionary::build 的编码一致）。
+ */
+struct KMeansResult
+{
+    QStringList names;                      // 参与聚类的特征
+    QVector<int> columns;
+
+    QVector<QVector<double>> centroids;     // 各簇质心（原始尺度），簇数×特征数
+    QVector<qint64> sizes;                  // 各簇的点数
+    QVector<double> withinSS;               // 各簇的簇内平方和（标准化后的尺度）
+    double inertia = 0.0;                   // 簇内平方和之和
+    double totalSS = 0.0;                   // 总平方和（inertia / totalSS 越小分得越开）
+
+    QVector<int> labels;                    // 每行的簇号，任一特征缺失的行为 -1
+
+    qint64 observations = 0;
+    int iterations = 0;
+    bool converged = false;
+    KMeansAlgorithm algorithm = KMeansAlgorithm::Lloyd;
+
+    bool isValid = true;
+    QString errorMessage;
+};
+
+/**
+ * @brief 并行 k-means 聚类
+ *
+ * 特征按列转换为 float 的连续数组（结构数组布局），距离内核一次处理
+ * 8 个（AVX2）或 4 个（SSE2）点，对每个质心沿特征累加平方差并向量化地
+ * 更新最近质心，运行时按 CPU 选择。分配步骤按行块并行，每块使用自己的
+ * 质心累加器（double），按块顺序合并，结果与线程数无关。
+ *
+ * 初始质心用 k-means++ 选取（每选一个质心并行更新一遍各点的最近距离）。
+ * 簇标签不再变化或质心移动足够小时提前停止；出现空簇时用距所属质心
+ * 最远的点重新播种。
+ */
+class KMeans
+{
+public:
+    /**
+     * @brief 对表格中的若干数值列聚类
+     */
+    static KMeansResult compute(const Core::TableData& table, const QVector<int>& columns,
+                                const KMeansOptions& options = KMeansOptions());
+
+    /**
+     * @brief 对数据列聚类（各列长度须相同，NaN 表示缺失）
+     */
+    static KMeansResult compute(const QVector<QVector<double>>& columns, const QStringList& names,
+                                const KMeansOptions& options = KMeansOptions());
+
+    /**
+     * @brief 簇标签的字典编码（取值为“簇1”“簇2”…，缺失行为空），用于追加分类列
+     */
+    static Core::ColumnDictionary labelDictionary(const KMeansResult& result);
+
+    static QString algorithmName(KMeansAlgorithm algorithm);
+
+    /**
+     * @brief 当前使用的距离内核名称（如 "AVX2/FMA ×8"）
+     */
+    static QString kernelName();
+};
+
+} // namespace Statistics
+
+#endif // KMEANS_H
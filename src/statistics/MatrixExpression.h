@@ -0,0 +1,740 @@
+#ifndef MATRIXEXPRESSION_H
+#define MATRIXEXPRESSION_H
+
+#include "DenseMatrix.h"
+#include "ParallelUtils.h"
+#include <QDebug>
+#include <QtMath>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <initializer_list>
+#include <type_traits>
+
+namespace Statistics {
+
+/**
+ * @brief 维度在运行时确定
+ */
+constexpr qsizetype DynamicSize = -1;
+
+/**
+ * @brief 矩阵表达式（CRTP 基类）
+ *
+ * A + B、2.0 * A、cwiseProduct(A, B)、transposed() 等运算不计算任何元素，
+ * 只返回一个记录运算结构的轻量对象；赋值给 DenseMatrix / StaticMatrix
+ * 时才在一个循环中逐元素求值，不产生中间矩阵，整条运算链只读写一遍内存。
+ *
+ * 操作数可以是 DenseMatrix、ConstMatrixView / MatrixView、StaticMatrix
+ * 或其他表达式。表达式只保存操作数的视图，不拥有数据，因此不要用
+ * auto 保存以临时矩阵为操作数的表达式。
+ *
+ * 维度检查：双方维度都在编译期已知（StaticMatrix）时用 static_assert；
+ * 否则在赋值时检查，不匹配则输出警告并得到空矩阵。
+ */
+template<typename Derived>
+class MatrixExpression
+{
+public:
+    const Derived& derived() const { return static_cast<const Derived&>(*this); }
+
+    qsizetype rows() const { return derived().rows(); }
+    qsizetype cols() const { return derived().cols(); }
+    double operator()(qsizetype i, qsizetype j) const { return derived()(i, j); }
+
+    /**
+     * @brief 转置（不复制，求值时沿另一方向读取）
+     */
+    auto transposed() const;
+};
+
+template<int Rows, int Cols>
+class StaticMatrix;
+
+namespace Expressions {
+
+// === 求值参数 ===
+
+// 元素数不少于该值时按行（列）分块并行求值
+const qsizetype PARALLEL_MIN_ELEMENTS = qsizetype(1) << 18;
+
+// 每块最少的行（列）数
+const qsizetype MIN_LINES_PER_CHUNK = 16;
+
+constexpr qsizetype mergeSize(qsizetype a, qsizetype b)
+{
+    return a != DynamicSize ? a : b;
+}
+
+constexpr bool compatibleSize(qsizetype a, qsizetype b)
+{
+    return a == DynamicSize || b == DynamicSize || a == b;
+}
+
+/**
+ * @brief 视图所占的内存区间 [begin, end)
+ */
+inline bool overlaps(const ConstMatrixView& view, const double* begin, const double* end)
+{
+    if (view.isEmpty()) {
+        return false;
+    }
+    const double* first = view.data();
+    const double* last = view.ptr(view.rows() - 1, view.cols() - 1) + 1;
+    return first < end && begin < last;
+}
+
+// === 行（列）游标 ===
+//
+// 求值按“线”进行：byRow 为真时第 index 条线是第 index 行，否则是第 index 列。
+// 每个结点为一条线生成游标，cursor[k] 即线上第 k 个元素。Contiguous 为真时
+// 所有叶结点在该方向上步长为 1，内层循环只有连续读取，便于编译器向量化。
+
+template<bool Contiguous>
+struct LeafCursor
+{
+    const double* data;
+    qsizetype stride;
+
+    double operator[](qsizetype k) const { return Contiguous ? data[k] : data[k * stride]; }
+};
+
+template<typename Op, typename Cursor>
+struct UnaryCursor
+{
+    Op op;
+    Cursor cursor;
+
+    double operator[](qsizetype k) const { return op(cursor[k]); }
+};
+
+template<typename Op, typename LeftCursor, typename RightCursor>
+struct BinaryCursor
+{
+    Op op;
+    LeftCursor left;
+    RightCursor right;
+
+    double operator[](qsizetype k) const { return op(left[k], right[k]); }
+};
+
+// === 叶结点 ===
+
+/**
+ * @brief 对矩阵视图的引用（Rows/Cols 为编译期维度，未知时为 DynamicSize）
+ */
+template<qsizetype Rows = DynamicSize, qsizetype Cols = DynamicSize>
+class ViewNode : public MatrixExpression<ViewNode<Rows, Cols>>
+{
+public:
+    static constexpr qsizetype RowsAtCompileTime = Rows;
+    static constexpr qsizetype ColsAtCompileTime = Cols;
+
+    explicit ViewNode(const ConstMatrixView& view) : m_view(view) {}
+
+    qsizetype rows() const { return m_view.rows(); }
+    qsizetype cols() const { return m_view.cols(); }
+    double operator()(qsizetype i, qsizetype j) const { return m_view(i, j); }
+
+    bool isConsistent() const { return true; }
+
+    bool isContiguous(bool byRow) const
+    {
+        return byRow ? m_view.isRowContiguous() : m_view.isColumnContiguous();
+    }
+
+    template<bool Contiguous>
+    LeafCursor<Contiguous> line(qsizetype index, bool byRow) const
+    {
+        return byRow ? LeafCursor<Contiguous>{m_view.ptr(index, 0), m_view.colStride()}
+                     : LeafCursor<Contiguous>{m_view.ptr(0, index), m_view.rowStride()};
+    }
+
+    bool reads(const double* begin, const double* end) const { return overlaps(m_view, begin, end); }
+
+    /**
+     * @brief 写入 target 时是否会读到已被覆盖的元素
+     *
+     * 与目标完全相同的视图是安全的（每个元素先读后写），其余重叠都不安全。
+     */
+    bool aliases(const ConstMatrixView& target) const
+    {
+        const bool same = m_view.data() == target.data() && m_view.rows() == target.rows() &&
+                          m_view.cols() == target.cols() && m_view.rowStride() == target.rowStride() &&
+                          m_view.colStride() == target.colStride();
+        if (same) {
+            return false;
+        }
+        return !target.isEmpty() &&
+               overlaps(m_view, target.data(), target.ptr(target.rows() - 1, target.cols() - 1) + 1);
+    }
+
+private:
+    ConstMatrixView m_view;
+};
+
+// === 运算结点 ===
+
+template<typename Op, typename Operand>
+class UnaryNode : public MatrixExpression<UnaryNode<Op, Operand>>
+{
+public:
+    static constexpr qsizetype RowsAtCompileTime = Operand::RowsAtCompileTime;
+    static constexpr qsizetype ColsAtCompileTime = Operand::ColsAtCompileTime;
+
+    UnaryNode(const Operand& operand, Op op) : m_operand(operand), m_op(op) {}
+
+    qsizetype rows() const { return m_operand.rows(); }
+    qsizetype cols() const { return m_operand.cols(); }
+    double operator()(qsizetype i, qsizetype j) const { return m_op(m_operand(i, j)); }
+
+    bool isConsistent() const { return m_operand.isConsistent(); }
+    bool isContiguous(bool byRow) const { return m_operand.isContiguous(byRow); }
+
+    template<bool Contiguous>
+    auto line(qsizetype index, bool byRow) const
+    {
+        using Cursor = decltype(m_operand.template line<Contiguous>(index, byRow));
+        return UnaryCursor<Op, Cursor>{m_op, m_operand.template line<Contiguous>(index, byRow)};
+    }
+
+    bool reads(const double* begin, const double* end) const { return m_operand.reads(begin, end); }
+    bool aliases(const ConstMatrixView& target) const { return m_operand.aliases(target); }
+
+private:
+    Operand m_operand;
+    Op m_op;
+};
+
+template<typename Op, typename Left, typename Right>
+class BinaryNode : public MatrixExpression<BinaryNode<Op, Left, Right>>
+{
+    static_assert(compatibleSize(Left::RowsAtCompileTime, Right::RowsAtCompileTime), "矩阵行数不匹配");
+    static_assert(compatibleSize(Left::ColsAtCompileTime, Right::ColsAtCompileTime), "矩阵列数不匹配");
+
+public:
+    static constexpr qsizetype RowsAtCompileTime = mergeSize(Left::RowsAtCompileTime, Right::RowsAtCompileTime);
+    static constexpr qsizetype ColsAtCompileTime = mergeSize(Left::ColsAtCompileTime, Right::ColsAtCompileTime);
+
+    BinaryNode(const Left& left, const Right& right) : m_left(left), m_right(right) {}
+
+    qsizetype rows() const { return m_left.rows(); }
+    qsizetype cols() const { return m_left.cols(); }
+    double operator()(qsizetype i, qsizetype j) const { return Op()(m_left(i, j), m_right(i, j)); }
+
+    bool isConsistent() const
+    {
+        return m_left.rows() == m_right.rows() && m_left.cols() == m_right.cols() &&
+               m_left.isConsistent() && m_right.isConsistent();
+    }
+
+    bool isContiguous(bool byRow) const { return m_left.isContiguous(byRow) && m_right.isContiguous(byRow); }
+
+    template<bool Contiguous>
+    auto line(qsizetype index, bool byRow) const
+    {
+        using LeftCursor = decltype(m_left.template line<Contiguous>(index, byRow));
+        using RightCursor = decltype(m_right.template line<Contiguous>(index, byRow));
+        return BinaryCursor<Op, LeftCursor, RightCursor>{Op(), m_left.template line<Contiguous>(index, byRow),
+                                                         m_right.template line<Contiguous>(index, byRow)};
+    }
+
+    bool reads(const double* begin, const double* end) const
+    {
+        return m_left.reads(begin, end) || m_right.reads(begin, end);
+    }
+
+    bool aliases(const ConstMatrixView& target) const
+    {
+        return m_left.aliases(target) || m_right.aliases(target);
+    }
+
+private:
+    Left m_left;
+    Right m_right;
+};
+
+/**
+ * @brief 转置：第 i 行即操作数的第 i 列，求值时直接换方向读取
+ */
+template<typename Operand>
+class TransposeNode : public MatrixExpression<TransposeNode<Operand>>
+{
+public:
+    static constexpr qsizetype RowsAtCompileTime = Operand::ColsAtCompileTime;
+    static constexpr qsizetype ColsAtCompileTime = Operand::RowsAtCompileTime;
+
+    explicit TransposeNode(const Operand& operand) : m_operand(operand) {}
+
+    qsizetype rows() const { return m_operand.cols(); }
+    qsizetype cols() const { return m_operand.rows(); }
+    double operator()(qsizetype i, qsizetype j) const { return m_operand(j, i); }
+
+    bool isConsistent() const { return m_operand.isConsistent(); }
+    bool isContiguous(bool byRow) const { return m_operand.isContiguous(!byRow); }
+
+    template<bool Contiguous>
+    auto line(qsizetype index, bool byRow) const
+    {
+        return m_operand.template line<Contiguous>(index, !byRow);
+    }
+
+    bool reads(const double* begin, const double* end) const { return m_operand.reads(begin, end); }
+
+    /**
+     * @brief 转置后元素位置改变，与目标有任何重叠都不安全
+     */
+    bool aliases(const ConstMatrixView& target) const
+    {
+        return !target.isEmpty() &&
+               m_operand.reads(target.data(), target.ptr(target.rows() - 1, target.cols() - 1) + 1);
+    }
+
+private:
+    Operand m_operand;
+};
+
+// === 逐元素运算 ===
+
+struct AddOp { double operator()(double a, double b) const { return a + b; } };
+struct SubtractOp { double operator()(double a, double b) const { return a - b; } };
+struct ProductOp { double operator()(double a, double b) const { return a * b; } };
+struct QuotientOp { double operator()(double a, double b) const { return a / b; } };
+struct MinOp { double operator()(double a, double b) const { return std::min(a, b); } };
+struct MaxOp { double operator()(double a, double b) const { return std::max(a, b); } };
+
+struct NegateOp { double operator()(double a) const { return -a; } };
+struct AbsOp { double operator()(double a) const { return std::fabs(a); } };
+struct SqrtOp { double operator()(double a) const { return std::sqrt(a); } };
+struct SquareOp { double operator()(double a) const { return a * a; } };
+struct ExpOp { double operator()(double a) const { return std::exp(a); } };
+struct LogOp { double operator()(double a) const { return std::log(a); } };
+
+struct ScaleOp
+{
+    double factor;
+    double operator()(double a) const { return a * factor; }
+};
+
+struct ShiftOp
+{
+    double offset;
+    double operator()(double a) const { return a + offset; }
+};
+
+// === 操作数到结点的转换 ===
+
+template<typename T, typename = void>
+struct OperandTraits
+{
+    static constexpr bool IsOperand = false;
+};
+
+template<typename T>
+struct OperandTraits<T, std::enable_if_t<std::is_base_of_v<MatrixExpression<T>, T>>>
+{
+    static constexpr bool IsOperand = true;
+    using Node = T;
+    static const T& node(const T& expression) { return expression; }
+};
+
+template<>
+struct OperandTraits<ConstMatrixView>
+{
+    static constexpr bool IsOperand = true;
+    using Node = ViewNode<>;
+    static Node node(const ConstMatrixView& view) { return Node(view); }
+};
+
+template<>
+struct OperandTraits<MatrixView> : OperandTraits<ConstMatrixView> {};
+
+template<>
+struct OperandTraits<DenseMatrix>
+{
+    static constexpr bool IsOperand = true;
+    using Node = ViewNode<>;
+    static Node node(const DenseMatrix& matrix) { return Node(matrix.view()); }
+};
+
+template<int Rows, int Cols>
+struct OperandTraits<StaticMatrix<Rows, Cols>>
+{
+    static constexpr bool IsOperand = true;
+    using Node = ViewNode<Rows, Cols>;
+    static Node node(const StaticMatrix<Rows, Cols>& matrix) { return Node(matrix.view()); }
+};
+
+template<typename T>
+constexpr bool isOperand = OperandTraits<std::decay_t<T>>::IsOperand;
+
+template<typename T>
+using NodeOf = typename OperandTraits<std::decay_t<T>>::Node;
+
+template<typename T>
+NodeOf<T> toNode(const T& operand)
+{
+    return OperandTraits<std::decay_t<T>>::node(operand);
+}
+
+template<typename Op, typename L, typename R>
+BinaryNode<Op, NodeOf<L>, NodeOf<R>> binary(const L& left, const R& right)
+{
+    return BinaryNode<Op, NodeOf<L>, NodeOf<R>>(toNode(left), toNode(right));
+}
+
+template<typename Op, typename T>
+UnaryNode<Op, NodeOf<T>> unary(const T& operand, Op op = Op())
+{
+    return UnaryNode<Op, NodeOf<T>>(toNode(operand), op);
+}
+
+// === 求值 ===
+
+template<bool Contiguous, typename Node>
+void evaluateLines(const MatrixView& target, const Node& node, bool byRow, qsizetype begin, qsizetype end)
+{
+    const qsizetype length = byRow ? target.cols() : target.rows();
+    const qsizetype outStride = byRow ? target.colStride() : target.rowStride();
+
+    for (qsizetype index = begin; index < end; ++index) {
+        double* out = byRow ? target.ptr(index, 0) : target.ptr(0, index);
+        const auto cursor = node.template line<Contiguous>(index, byRow);
+        if (Contiguous) {
+            for (qsizetype k = 0; k < length; ++k) {
+                out[k] = cursor[k];
+            }
+        } else {
+            for (qsizetype k = 0; k < length; ++k) {
+                out[k * outStride] = cursor[k];
+            }
+        }
+    }
+}
+
+/**
+ * @brief 单循环求值（维度已检查、无不安全别名）
+ *
+ * 沿目标连续的方向逐线写入；目标与所有叶结点在该方向都连续时走连续分支。
+ */
+template<typename Node>
+void evaluate(const MatrixView& target, const Node& node)
+{
+    if (target.isEmpty()) {
+        return;
+    }
+
+    const bool byRow = target.isRowContiguous() || !target.isColumnContiguous();
+    const bool contiguous = (byRow ? target.isRowContiguous() : target.isColumnContiguous()) &&
+                            node.isContiguous(byRow);
+    const qsizetype lines = byRow ? target.rows() : target.cols();
+    const qsizetype elements = target.rows() * target.cols();
+
+    auto body = [&](int, qsizetype begin, qsizetype end) {
+        if (contiguous) {
+            evaluateLines<true>(target, node, byRow, begin, end);
+        } else {
+            evaluateLines<false>(target, node, byRow, begin, end);
+        }
+    };
+
+    if (elements < PARALLEL_MIN_ELEMENTS) {
+        body(0, 0, lines);
+    } else {
+        Parallel::forChunks(lines, Parallel::chunkCount(lines, MIN_LINES_PER_CHUNK), body);
+    }
+}
+
+/**
+ * @brief 检查维度与别名后写入 target；表达式读取目标中将被覆盖的元素时先求值到临时矩阵
+ * @return 维度不匹配时输出警告并返回 false
+ */
+template<typename Node>
+bool assign(const MatrixView& target, const Node& node)
+{
+    if (!node.isConsistent() || node.rows() != target.rows() || node.cols() != target.cols()) {
+        qWarning() << "矩阵维度不匹配";
+        return false;
+    }
+
+    if (node.aliases(target)) {
+        DenseMatrix temporary(target.rows(), target.cols(),
+                              target.isColumnContiguous() && !target.isRowContiguous() ? MatrixLayout::ColumnMajor
+                                                                                       : MatrixLayout::RowMajor);
+        evaluate(temporary.view(), node);
+        target.assign(temporary);
+    } else {
+        evaluate(target, node);
+    }
+    return true;
+}
+
+} // namespace Expressions
+
+template<typename Derived>
+auto MatrixExpression<Derived>::transposed() const
+{
+    return Expressions::TransposeNode<Derived>(derived());
+}
+
+// === 运算符 ===
+
+template<typename L, typename R,
+         typename = std::enable_if_t<Expressions::isOperand<L> && Expressions::isOperand<R>>>
+auto operator+(const L& left, const R& right)
+{
+    return Expressions::binary<Expressions::AddOp>(left, right);
+}
+
+template<typename L, typename R,
+         typename = std::enable_if_t<Expressions::isOperand<L> && Expressions::isOperand<R>>>
+auto operator-(const L& left, const R& right)
+{
+    return Expressions::binary<Expressions::SubtractOp>(left, right);
+}
+
+template<typename T, typename = std::enable_if_t<Expressions::isOperand<T>>>
+auto operator-(const T& operand)
+{
+    return Expressions::unary<Expressions::NegateOp>(operand);
+}
+
+template<typename T, typename = std::enable_if_t<Expressions::isOperand<T>>>
+auto operator*(const T& operand, double factor)
+{
+    return Expressions::unary(operand, Expressions::ScaleOp{factor});
+}
+
+template<typename T, typename = std::enable_if_t<Expressions::isOperand<T>>>
+auto operator*(double factor, const T& operand)
+{
+    return Expressions::unary(operand, Expressions::ScaleOp{factor});
+}
+
+template<typename T, typename = std::enable_if_t<Expressions::isOperand<T>>>
+auto operator/(const T& operand, double divisor)
+{
+    return Expressions::unary(operand, Expressions::ScaleOp{1.0 / divisor});
+}
+
+// === 逐元素函数 ===
+//
+// 矩阵乘法请用 MatrixOperations::multiply / Gemm，运算符 * 只接受标量。
+
+template<typename L, typename R,
+         typename = std::enable_if_t<Expressions::isOperand<L> && Expressions::isOperand<R>>>
+auto cwiseProduct(const L& left, const R& right)
+{
+    return Expressions::binary<Expressions::ProductOp>(left, right);
+}
+
+template<typename L, typename R,
+         typename = std::enable_if_t<Expressions::isOperand<L> && Expressions::isOperand<R>>>
+auto cwiseQuotient(const L& left, const R& right)
+{
+    return Expressions::binary<Expressions::QuotientOp>(left, right);
+}
+
+template<typename L, typename R,
+         typename = std::enable_if_t<Expressions::isOperand<L> && Expressions::isOperand<R>>>
+auto cwiseMin(const L& left, const R& right)
+{
+    return Expressions::binary<Expressions::MinOp>(left, right);
+}
+
+template<typename L, typename R,
+         typename = std::enable_if_t<Expressions::isOperand<L> && Expressions::isOperand<R>>>
+auto cwiseMax(const L& left, const R& right)
+{
+    return Expressions::binary<Expressions::MaxOp>(left, right);
+}
+
+template<typename T, typename = std::enable_if_t<Expressions::isOperand<T>>>
+auto cwiseAbs(const T& operand) { return Expressions::unary<Expressions::AbsOp>(operand); }
+
+template<typename T, typename = std::enable_if_t<Expressions::isOperand<T>>>
+auto cwiseSqrt(const T& operand) { return Expressions::unary<Expressions::SqrtOp>(operand); }
+
+template<typename T, typename = std::enable_if_t<Expressions::isOperand<T>>>
+auto cwiseSquare(const T& operand) { return Expressions::unary<Expressions::SquareOp>(operand); }
+
+template<typename T, typename = std::enable_if_t<Expressions::isOperand<T>>>
+auto cwiseExp(const T& operand) { return Expressions::unary<Expressions::ExpOp>(operand); }
+
+template<typename T, typename = std::enable_if_t<Expressions::isOperand<T>>>
+auto cwiseLog(const T& operand) { return Expressions::unary<Expressions::LogOp>(operand); }
+
+/**
+ * @brief 每个元素加上常数（如中心化 A - mean 时使用 shifted(A, -mean)）
+ */
+template<typename T, typename = std::enable_if_t<Expressions::isOperand<T>>>
+auto shifted(const T& operand, double offset)
+{
+    return Expressions::unary(operand, Expressions::ShiftOp{offset});
+}
+
+/**
+ * @brief 对每个元素应用 f（形如 double(double) 的函数对象）
+ */
+template<typename T, typename F, typename = std::enable_if_t<Expressions::isOperand<T>>>
+auto cwiseMap(const T& operand, F f)
+{
+    return Expressions::unary(operand, f);
+}
+
+/**
+ * @brief 所有元素之和，与表达式求值融合在同一循环中（不生成中间矩阵）
+ *
+ * 例如 elementSum(cwiseSquare(A - B)) 只读一遍 A、B。
+ */
+template<typename T, typename = std::enable_if_t<Expressions::isOperand<T>>>
+double elementSum(const T& operand)
+{
+    const auto node = Expressions::toNode(operand);
+    if (!node.isConsistent()) {
+        qWarning() << "矩阵维度不匹配";
+        return qQNaN();
+    }
+
+    const bool byRow = node.isContiguous(true) || !node.isContiguous(false);
+    const bool contiguous = node.isContiguous(byRow);
+    const qsizetype lines = byRow ? node.rows() : node.cols();
+    const qsizetype length = byRow ? node.cols() : node.rows();
+
+    double sum = 0.0;
+    for (qsizetype index = 0; index < lines; ++index) {
+        double lineSum = 0.0;
+        if (contiguous) {
+            const auto cursor = node.template line<true>(index, byRow);
+            for (qsizetype k = 0; k < length; ++k) {
+                lineSum += cursor[k];
+            }
+        } else {
+            const auto cursor = node.template line<false>(index, byRow);
+            for (qsizetype k = 0; k < length; ++k) {
+                lineSum += cursor[k];
+            }
+        }
+        sum += lineSum;
+    }
+    return sum;
+}
+
+/**
+ * @brief 把表达式写入已有的视图（如 DenseMatrix 的子块）
+ * @return 维度不匹配时输出警告并返回 false，目标不变
+ */
+template<typename T, typename = std::enable_if_t<Expressions::isOperand<T>>>
+bool assignTo(const MatrixView& target, const T& operand)
+{
+    return Expressions::assign(target, Expressions::toNode(operand));
+}
+
+// === DenseMatrix 的表达式构造与赋值 ===
+
+template<typename Derived>
+DenseMatrix::DenseMatrix(const MatrixExpression<Derived>& expression, MatrixLayout layout)
+{
+    const Derived& node = expression.derived();
+    if (!node.isConsistent()) {
+        qWarning() << "矩阵维度不匹配";
+        return;
+    }
+
+    allocate(node.rows(), node.cols(), layout);
+    Expressions::evaluate(view(), node);
+}
+
+template<typename Derived>
+DenseMatrix& DenseMatrix::operator=(const MatrixExpression<Derived>& expression)
+{
+    const Derived& node = expression.derived();
+    if (!node.isConsistent()) {
+        qWarning() << "矩阵维度不匹配";
+        *this = DenseMatrix();
+        return *this;
+    }
+
+    // 维度相同时原地求值（保留存储顺序，不重新分配）
+    if (node.rows() == m_rows && node.cols() == m_cols) {
+        Expressions::assign(view(), node);
+    } else {
+        *this = DenseMatrix(expression, m_layout);
+    }
+    return *this;
+}
+
+template<typename Operand>
+DenseMatrix& DenseMatrix::operator+=(const Operand& operand)
+{
+    static_assert(Expressions::isOperand<Operand>, "操作数必须是矩阵或矩阵表达式");
+    Expressions::assign(view(), *this + operand);
+    return *this;
+}
+
+template<typename Operand>
+DenseMatrix& DenseMatrix::operator-=(const Operand& operand)
+{
+    static_assert(Expressions::isOperand<Operand>, "操作数必须是矩阵或矩阵表达式");
+    Expressions::assign(view(), *this - operand);
+    return *this;
+}
+
+/**
+ * @brief 编译期固定维度的小矩阵（行优先，存放在对象内部，不分配堆内存）
+ *
+ * 与其他固定维度的操作数运算时维度不符会在编译期报错。
+ */
+template<int Rows, int Cols>
+class StaticMatrix
+{
+    static_assert(Rows > 0 && Cols > 0, "矩阵维度必须为正");
+
+public:
+    StaticMatrix() { m_data.fill(0.0); }
+
+    /**
+     * @brief 按行列出元素，个数不足时其余为 0
+     */
+    StaticMatrix(std::initializer_list<double> values)
+    {
+        m_data.fill(0.0);
+        std::copy_n(values.begin(), std::min<size_t>(values.size(), m_data.size()), m_data.begin());
+    }
+
+    template<typename Derived>
+    StaticMatrix(const MatrixExpression<Derived>& expression)
+    {
+        m_data.fill(0.0);
+        *this = expression;
+    }
+
+    template<typename Derived>
+    StaticMatrix& operator=(const MatrixExpression<Derived>& expression)
+    {
+        static_assert(Expressions::compatibleSize(Derived::RowsAtCompileTime, Rows), "矩阵行数不匹配");
+        static_assert(Expressions::compatibleSize(Derived::ColsAtCompileTime, Cols), "矩阵列数不匹配");
+        Expressions::assign(view(), expression.derived());
+        return *this;
+    }
+
+    static constexpr qsizetype rows() { return Rows; }
+    static constexpr qsizetype cols() { return Cols; }
+
+    double& operator()(qsizetype i, qsizetype j) { return m_data[i * Cols + j]; }
+    double operator()(qsizetype i, qsizetype j) const { return m_data[i * Cols + j]; }
+
+    double* data() { return m_data.data(); }
+    const double* data() const { return m_data.data(); }
+
+    MatrixView view() { return MatrixView(m_data.data(), Rows, Cols, Cols, 1); }
+    ConstMatrixView view() const { return ConstMatrixView(m_data.data(), Rows, Cols, Cols, 1); }
+    operator ConstMatrixView() const { return view(); }
+
+private:
+    std::array<double, static_cast<size_t>(Rows) * Cols> m_data;
+};
+
+} // namespace Statistics
+
+#endif // MATRIXEXPRESSION_H
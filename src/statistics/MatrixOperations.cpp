@@ -1,9 +1,27 @@
 #include "MatrixOperations.h"
+#include "Factorizations.h"
+#include "Gemm.h"
+#include "MatrixExpression.h"
 #include <QDebug>
+#include <QtMath>
 #include <algorithm>
+#include <limits>
+#include <numeric>
 
 namespace Statistics {
 
+namespace {
+
+// 倒数条件数低于机器精度时视为数值上不可逆
+const double MIN_RECIPROCAL_CONDITION = std::numeric_limits<double>::epsilon();
+
+bool sameShape(const ConstMatrixView& A, const ConstMatrixView& B)
+{
+    return A.rows() == B.rows() && A.cols() == B.cols();
+}
+
+} // namespace
+
 // === 基本运算 ===
 
 MatrixOperations::Matrix MatrixOperations::add(const Matrix& A, const Matrix& B)
@@ -57,143 +75,26 @@ MatrixOperations::Matrix MatrixOperations::multiply(const Matrix& A, double scal
 
 MatrixOperations::Matrix MatrixOperations::multiply(const Matrix& A, const Matrix& B)
 {
-    int rowsA = A.size();
-    int colsA = A[0].size();
-    int rowsB = B.size();
-    int colsB = B[0].size();
-
-    if (colsA != rowsB) {
-        qWarning() << "矩阵维度不匹配，无法相乘";
-        return Matrix();
-    }
-
-    Matrix result(rowsA, QVector<double>(colsB, 0.0));
-
-    for (int i = 0; i < rowsA; ++i) {
-        for (int j = 0; j < colsB; ++j) {
-            for (int k = 0; k < colsA; ++k) {
-                result[i][j] += A[i][k] * B[k][j];
-            }
-        }
-    }
-
-    return result;
+    return multiply(DenseMatrix::fromRows(A), DenseMatrix::fromRows(B)).toRows();
 }
 
 MatrixOperations::Matrix MatrixOperations::transpose(const Matrix& A)
 {
-    int rows = A.size();
-    int cols = A[0].size();
-
-    Matrix result(cols, QVector<double>(rows));
-
-    for (int i = 0; i < rows; ++i) {
-        for (int j = 0; j < cols; ++j) {
-            result[j][i] = A[i][j];
-        }
-    }
-
-    return result;
+    return transpose(DenseMatrix::fromRows(A)).toRows();
 }
 
 std::optional<double> MatrixOperations::determinant(const Matrix& A)
 {
-    int n = A.size();
-
-    if (n == 0) return 0.0;
-    if (n == 1) return A[0][0];
-    if (n == 2) return A[0][0] * A[1][1] - A[0][1] * A[1][0];
-
-    // LU 分解计算行列式（简化版本）
-    Matrix LU = A;
-    double det = 1.0;
-
-    for (int i = 0; i < n; ++i) {
-        // 找主元
-        int pivot = i;
-        for (int row = i + 1; row < n; ++row) {
-            if (qAbs(LU[row][i]) > qAbs(LU[pivot][i])) {
-                pivot = row;
-            }
-        }
-
-        // 交换行
-        if (pivot != i) {
-            std::swap(LU[i], LU[pivot]);
-            det *= -1.0;
-        }
-
-        det *= LU[i][i];
-
-        if (qAbs(LU[i][i]) < 1e-10) {
-            return 0.0;  // 奇异矩阵
-        }
-
-        // 消元
-        for (int row = i + 1; row < n; ++row) {
-            double factor = LU[row][i] / LU[i][i];
-            for (int col = i; col < n; ++col) {
-                LU[row][col] -= factor * LU[i][col];
-            }
-        }
-    }
-
-    return det;
+    return determinant(DenseMatrix::fromRows(A));
 }
 
 std::optional<MatrixOperations::Matrix> MatrixOperations::inverse(const Matrix& A)
 {
-    int n = A.size();
-
-    if (n == 0) return Matrix();
-
-    auto detResult = determinant(A);
-    if (!detResult.has_value() || qAbs(detResult.value()) < 1e-10) {
-        qWarning() << "矩阵不可逆";
+    std::optional<DenseMatrix> result = inverse(DenseMatrix::fromRows(A));
+    if (!result) {
         return std::nullopt;
     }
-
-    // 高斯-约旦消元法求逆
-    Matrix augmented = A;
-    Matrix result = identity(n);
-
-    for (int col = 0; col < n; ++col) {
-        // 找主元
-        int pivot = col;
-        for (int row = col + 1; row < n; ++row) {
-            if (qAbs(augmented[row][col]) > qAbs(augmented[pivot][col])) {
-                pivot = row;
-            }
-        }
-
-        // 交换行
-        std::swap(augmented[col], augmented[pivot]);
-        std::swap(result[col], result[pivot]);
-
-        // 归一化
-        double pivotValue = augmented[col][col];
-        if (qAbs(pivotValue) < 1e-10) {
-            return std::nullopt;
-        }
-
-        for (int j = 0; j < n; ++j) {
-            augmented[col][j] /= pivotValue;
-            result[col][j] /= pivotValue;
-        }
-
-        // 消元
-        for (int row = 0; row < n; ++row) {
-            if (row != col) {
-                double factor = augmented[row][col];
-                for (int j = 0; j < n; ++j) {
-                    augmented[row][j] -= factor * augmented[col][j];
-                    result[row][j] -= factor * result[col][j];
-                }
-            }
-        }
-    }
-
-    return result;
+    return result->toRows();
 }
 
 // === 向量运算 ===
@@ -380,4 +281,181 @@ MatrixOperations::Matrix MatrixOperations::vertcat(const Matrix& A, const Matrix
     return result;
 }
 
+// === 稠密矩阵重载 ===
+
+DenseMatrix MatrixOperations::add(const ConstMatrixView& A, const ConstMatrixView& B)
+{
+    if (!sameShape(A, B)) {
+        qWarning() << "矩阵维度不匹配";
+        return DenseMatrix();
+    }
+    return A + B;
+}
+
+DenseMatrix MatrixOperations::subtract(const ConstMatrixView& A, const ConstMatrixView& B)
+{
+    if (!sameShape(A, B)) {
+        qWarning() << "矩阵维度不匹配";
+        return DenseMatrix();
+    }
+    return A - B;
+}
+
+DenseMatrix MatrixOperations::multiply(const ConstMatrixView& A, double scalar)
+{
+    return A * scalar;
+}
+
+DenseMatrix MatrixOperations::multiply(const ConstMatrixView& A, const ConstMatrixView& B)
+{
+    if (A.cols() != B.rows()) {
+        qWarning() << "矩阵维度不匹配，无法相乘";
+        return DenseMatrix();
+    }
+
+    DenseMatrix result(A.rows(), B.cols());
+    Gemm::multiply(1.0, A, B, 0.0, result.view());
+    return result;
+}
+
+DenseMatrix MatrixOperations::transpose(const ConstMatrixView& A)
+{
+    DenseMatrix result(A.cols(), A.rows());
+    Gemm::transpose(A, result.view());
+    return result;
+}
+
+std::optional<double> MatrixOperations::determinant(const ConstMatrixView& A)
+{
+    if (A.rows() != A.cols()) {
+        qWarning() << "矩阵不是方阵";
+        return std::nullopt;
+    }
+
+    const qsizetype n = A.rows();
+    if (n == 0) return 0.0;
+    if (n == 1) return A(0, 0);
+    if (n == 2) return A(0, 0) * A(1, 1) - A(0, 1) * A(1, 0);
+
+    return LUDecomposition(A).determinant();
+}
+
+std::optional<DenseMatrix> MatrixOperations::inverse(const ConstMatrixView& A)
+{
+    if (A.rows() != A.cols()) {
+        qWarning() << "矩阵不是方阵";
+        return std::nullopt;
+    }
+    if (A.rows() == 0) return DenseMatrix();
+
+    LUDecomposition lu(A);
+    if (lu.isSingular() || lu.reciprocalCondition() < MIN_RECIPROCAL_CONDITION) {
+        qWarning() << "矩阵不可逆";
+        return std::nullopt;
+    }
+    return DenseMatrix::fromView(lu.solve(DenseMatrix::identity(A.rows(), MatrixLayout::ColumnMajor)));
+}
+
+std::optional<DenseMatrix> MatrixOperations::solve(const ConstMatrixView& A, const ConstMatrixView& B)
+{
+    if (A.rows() != A.cols() || B.rows() != A.rows()) {
+        qWarning() << "矩阵维度不匹配";
+        return std::nullopt;
+    }
+
+    LUDecomposition lu(A);
+    if (lu.isSingular() || lu.reciprocalCondition() < MIN_RECIPROCAL_CONDITION) {
+        qWarning() << "矩阵不可逆";
+        return std::nullopt;
+    }
+    return DenseMatrix::fromView(lu.solve(B));
+}
+
+QVector<double> MatrixOperations::rowSum(const ConstMatrixView& A)
+{
+    QVector<double> result(A.rows(), 0.0);
+    for (qsizetype i = 0; i < A.rows(); ++i) {
+        double sum = 0.0;
+        for (qsizetype j = 0; j < A.cols(); ++j) {
+            sum += A(i, j);
+        }
+        result[i] = sum;
+    }
+    return result;
+}
+
+QVector<double> MatrixOperations::columnSum(const ConstMatrixView& A)
+{
+    QVector<double> result(A.cols(), 0.0);
+    if (A.isColumnContiguous()) {
+        for (qsizetype j = 0; j < A.cols(); ++j) {
+            const double* column = A.ptr(0, j);
+            result[j] = std::accumulate(column, column + A.rows(), 0.0);
+        }
+    } else {
+        for (qsizetype i = 0; i < A.rows(); ++i) {
+            for (qsizetype j = 0; j < A.cols(); ++j) {
+                result[j] += A(i, j);
+            }
+        }
+    }
+    return result;
+}
+
+QVector<double> MatrixOperations::rowMean(const ConstMatrixView& A)
+{
+    QVector<double> sums = rowSum(A);
+    if (A.cols() > 0) {
+        for (double& value : sums) {
+            value /= static_cast<double>(A.cols());
+        }
+    }
+    return sums;
+}
+
+QVector<double> MatrixOperations::columnMean(const ConstMatrixView& A)
+{
+    QVector<double> sums = columnSum(A);
+    for (double& value : sums) {
+        value /= static_cast<double>(A.rows());
+    }
+    return sums;
+}
+
+ConstMatrixView MatrixOperations::submatrix(const ConstMatrixView& A, int rowStart, int rowEnd,
+                                            int colStart, int colEnd)
+{
+    qsizetype r0 = std::clamp<qsizetype>(rowStart, 0, A.rows());
+    qsizetype r1 = std::clamp<qsizetype>(static_cast<qsizetype>(rowEnd) + 1, r0, A.rows());
+    qsizetype c0 = std::clamp<qsizetype>(colStart, 0, A.cols());
+    qsizetype c1 = std::clamp<qsizetype>(static_cast<qsizetype>(colEnd) + 1, c0, A.cols());
+    return A.block(r0, c0, r1 - r0, c1 - c0);
+}
+
+DenseMatrix MatrixOperations::horzcat(const ConstMatrixView& A, const ConstMatrixView& B)
+{
+    if (A.rows() != B.rows()) {
+        qWarning() << "矩阵行数不匹配";
+        return DenseMatrix();
+    }
+
+    DenseMatrix result(A.rows(), A.cols() + B.cols());
+    result.block(0, 0, A.rows(), A.cols()).assign(A);
+    result.block(0, A.cols(), B.rows(), B.cols()).assign(B);
+    return result;
+}
+
+DenseMatrix MatrixOperations::vertcat(const ConstMatrixView& A, const ConstMatrixView& B)
+{
+    if (A.cols() != B.cols()) {
+        qWarning() << "矩阵列数不匹配";
+        return DenseMatrix();
+    }
+
+    DenseMatrix result(A.rows() + B.rows(), A.cols());
+    result.block(0, 0, A.rows(), A.cols()).assign(A);
+    result.block(A.rows(), 0, B.rows(), B.cols()).assign(B);
+    return result;
+}
+
 } // namespace Statistics
@@ -1,6 +1,7 @@
 #ifndef MATRIXOPERATIONS_H
 #define MATRIXOPERATIONS_H
 
+#include "DenseMatrix.h"
 #include <QVector>
 #include <QMap>
 #include <optional>
@@ -10,7 +11,8 @@ namespace Statistics {
 /**
  * @brief 矩阵运算类
  *
- * 提供常用的矩阵运算功能
+ * 提供常用的矩阵运算功能。嵌套向量 Matrix 的接口保留用于兼容，
+ * 大矩阵请使用 DenseMatrix / 矩阵视图的重载（连续存储，无逐行分配）。
  */
 class MatrixOperations
 {
@@ -132,6 +134,51 @@ public:
      * @brief 垂直拼接矩阵
      */
     static Matrix vertcat(const Matrix& A, const Matrix& B);
+
+    // === 稠密矩阵重载 ===
+    //
+    // 参数为视图，DenseMatrix、子块与转置视图都可直接传入；结果为行优先的
+    // DenseMatrix。维度不匹配时输出警告并返回空矩阵。多步逐元素运算请直接
+    // 使用 MatrixExpression.h 中的运算符（如 DenseMatrix C = 2.0 * A + (B - D)），
+    // 整条运算链融合为一个循环，不产生中间矩阵。
+
+    static DenseMatrix add(const ConstMatrixView& A, const ConstMatrixView& B);
+    static DenseMatrix subtract(const ConstMatrixView& A, const ConstMatrixView& B);
+    static DenseMatrix multiply(const ConstMatrixView& A, double scalar);
+    static DenseMatrix multiply(const ConstMatrixView& A, const ConstMatrixView& B);
+
+    /**
+     * @brief 转置并复制为连续存储（只需转置视图时用 A.transposed()）
+     */
+    static DenseMatrix transpose(const ConstMatrixView& A);
+
+    /**
+     * @brief 行列式与逆矩阵，内部使用分块 LU 分解（Factorizations.h）
+     *
+     * 估计的倒数条件数低于机器精度时视为不可逆。同一矩阵需要多次求解时
+     * 直接使用 LUDecomposition，只分解一次。
+     */
+    static std::optional<double> determinant(const ConstMatrixView& A);
+    static std::optional<DenseMatrix> inverse(const ConstMatrixView& A);
+
+    /**
+     * @brief 求解 AX = B（不显式求逆，A 为方阵，B 为 n×r）
+     */
+    static std::optional<DenseMatrix> solve(const ConstMatrixView& A, const ConstMatrixView& B);
+
+    static QVector<double> rowSum(const ConstMatrixView& A);
+    static QVector<double> columnSum(const ConstMatrixView& A);
+    static QVector<double> rowMean(const ConstMatrixView& A);
+    static QVector<double> columnMean(const ConstMatrixView& A);
+
+    /**
+     * @brief 子矩阵视图（行列范围为闭区间，超出部分被截断；不复制数据）
+     */
+    static ConstMatrixView submatrix(const ConstMatrixView& A, int rowStart, int rowEnd,
+                                     int colStart, int colEnd);
+
+    static DenseMatrix horzcat(const ConstMatrixView& A, const ConstMatrixView& B);
+    static DenseMatrix vertcat(const ConstMatrixView& A, const ConstMatrixView& B);
 };
 
 } // namespace Statistics
@@ -0,0 +1,452 @@
+#include "OnlineForecaster.h"
+#include "Forecasting.h"
+#include "SmoothingKernels.h"
+#include <QDataStream>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace Statistics {
+
+namespace {
+
+const quint32 STATE_MAGIC = 0x4F464353;     // "OFCS"
+// 版本 2 起移动平均保存权重；版本 1 的状态按简单移动平均读取
+const qint32 STATE_VERSION = 2;
+
+/**
+ * 指数平滑初始化所需的数据个数（初始化后立即参与递推）
+ */
+int warmupLength(SmoothingModel model, int seasonLength)
+{
+    switch (model) {
+    case SmoothingModel::Simple:                    return 1;
+    case SmoothingModel::Holt:                      return 2;
+    case SmoothingModel::HoltWintersAdditive:
+    case SmoothingModel::HoltWintersMultiplicative: return 2 * seasonLength;
+    }
+    return 1;
+}
+
+} // namespace
+
+// === 构造 ===
+
+OnlineForecaster OnlineForecaster::linearRegression()
+{
+    OnlineForecaster forecaster;
+    forecaster.m_model = OnlineModel::LinearRegression;
+    return forecaster;
+}
+
+OnlineForecaster OnlineForecaster::movingAverage(int window)
+{
+    OnlineForecaster forecaster;
+    forecaster.m_model = OnlineModel::MovingAverage;
+    forecaster.m_window = std::max(1, window);
+    forecaster.m_buffer.fill(0.0, forecaster.m_window);
+    return forecaster;
+}
+
+OnlineForecaster OnlineForecaster::weightedMovingAverage(const QVector<double>& weights)
+{
+    OnlineForecaster forecaster = movingAverage(weights.size());
+    forecaster.m_weights = weights;
+    return forecaster;
+}
+
+OnlineForecaster OnlineForecaster::exponentialSmoothing(SmoothingModel model, const SmoothingParameters& parameters,
+                                                        int seasonLength)
+{
+    OnlineForecaster forecaster;
+    forecaster.m_model = OnlineModel::Smoothing;
+    forecaster.m_smoothingModel = model;
+    forecaster.m_parameters = parameters;
+    forecaster.m_seasonLength = SmoothingKernels::isSeasonal(model) ? std::max(2, seasonLength) : 1;
+    forecaster.m_seasonal.fill(0.0, forecaster.m_seasonLength);
+    forecaster.m_buffer.reserve(warmupLength(model, forecaster.m_seasonLength));
+    return forecaster;
+}
+
+void OnlineForecaster::reset()
+{
+    m_count = 0;
+    m_steps = 0;
+    m_sse = 0.0;
+    m_failed = false;
+
+    m_meanX = m_meanY = 0.0;
+    m_sxx = m_sxy = m_syy = 0.0;
+
+    if (m_model == OnlineModel::MovingAverage) {
+        m_buffer.fill(0.0, m_window);
+    } else {
+        m_buffer.clear();
+    }
+    m_head = 0;
+    m_sum = 0.0;
+
+    m_level = m_trend = 0.0;
+    m_phase = 0;
+    m_seasonal.fill(0.0, m_seasonLength);
+
+    m_tableId = 0;
+    m_column = -1;
+    m_prefixVersion = 0;
+    m_rowsConsumed = 0;
+}
+
+// === 增量更新 ===
+
+void OnlineForecaster::update(double value)
+{
+    // 手动追加的数据不属于任何表格，下次 catchUp 时需要重新拟合
+    m_column = -1;
+
+    if (!std::isfinite(value)) {
+        return;
+    }
+
+    switch (m_model) {
+    case OnlineModel::LinearRegression: updateRegression(value);    break;
+    case OnlineModel::MovingAverage:    updateMovingAverage(value); break;
+    case OnlineModel::Smoothing:        updateSmoothing(value);     break;
+    }
+}
+
+void OnlineForecaster::update(const QVector<double>& values)
+{
+    for (double value : values) {
+        update(value);
+    }
+}
+
+void OnlineForecaster::updateRegression(double y)
+{
+    // x 依次为 1, 2, ...；Welford 递推均值与协方差
+    ++m_count;
+    const double x = static_cast<double>(m_count);
+    const double dx = x - m_meanX;
+    const double dy = y - m_meanY;
+    m_meanX += dx / m_count;
+    m_meanY += dy / m_count;
+    m_sxx += dx * (x - m_meanX);
+    m_sxy += dx * (y - m_meanY);
+    m_syy += dy * (y - m_meanY);
+}
+
+void OnlineForecaster::updateMovingAverage(double value)
+{
+    if (m_count < m_window) {
+        m_buffer[m_count] = value;
+        m_sum += value;
+        ++m_count;
+        return;
+    }
+
+    // 第 i 期的拟合值为前 window 期的（加权）平均值
+    double e = value - movingAverageValue();
+    m_sse += e * e;
+    ++m_steps;
+
+    m_sum += value - m_buffer[m_head];
+    m_buffer[m_head] = value;
+    if (++m_head == m_window) {
+        // 每转一圈重新求和一次，避免滑动和的舍入误差累积（均摊 O(1)）
+        m_head = 0;
+        m_sum = 0.0;
+        for (double v : m_buffer) {
+            m_sum += v;
+        }
+    }
+    ++m_count;
+}
+
+double OnlineForecaster::movingAverageValue() const
+{
+    if (m_weights.isEmpty()) {
+        return m_sum / m_window;
+    }
+
+    double weightedSum = 0.0;
+    double weightSum = 0.0;
+    for (int i = 0; i < m_window; ++i) {
+        int slot = m_head + i < m_window ? m_head + i : m_head + i - m_window;
+        weightedSum += m_buffer[slot] * m_weights[i];
+        weightSum += m_weights[i];
+    }
+    return weightedSum / weightSum;
+}
+
+void OnlineForecaster::updateSmoothing(double value)
+{
+    if (m_failed) {
+        ++m_count;
+        return;
+    }
+
+    if (m_smoothingModel == SmoothingModel::HoltWintersMultiplicative && value <= 0.0) {
+        m_failed = true;
+        ++m_count;
+        return;
+    }
+
+    const int warmup = warmupLength(m_smoothingModel, m_seasonLength);
+    SmoothingKernels::State state;
+    double sse = 0.0;
+
+    if (m_count < warmup) {
+        m_buffer.append(value);
+        ++m_count;
+        if (m_count < warmup) {
+            return;
+        }
+
+        // 预热数据已够：与批量方法相同地初始化，并对其余预热数据递推
+        qsizetype begin = SmoothingKernels::initialize(m_buffer.constData(), m_smoothingModel, m_seasonLength,
+                                                       state, m_seasonal.data());
+        sse = SmoothingKernels::run<SmoothingKernels::SquaredLoss>(
+            m_buffer.constData(), begin, warmup, m_smoothingModel, m_parameters, m_seasonLength,
+            state, m_seasonal.data());
+        m_steps += warmup - begin;
+        m_buffer.clear();
+        m_buffer.squeeze();
+    } else {
+        state.level = m_level;
+        state.trend = m_trend;
+        state.phase = m_phase;
+        sse = SmoothingKernels::run<SmoothingKernels::SquaredLoss>(
+            &value, 0, 1, m_smoothingModel, m_parameters, m_seasonLength, state, m_seasonal.data());
+        ++m_steps;
+        ++m_count;
+    }
+
+    if (!std::isfinite(sse)) {
+        m_failed = true;
+        return;
+    }
+
+    m_sse += sse;
+    m_level = state.level;
+    m_trend = state.trend;
+    m_phase = state.phase;
+}
+
+int OnlineForecaster::catchUp(const Core::TableData& table, int column)
+{
+    if (column < 0 || column >= table.columnCount()) {
+        qWarning() << "OnlineForecaster::catchUp: 列索引无效" << column;
+        return 0;
+    }
+
+    const quint64 prefixVersion = table.prefixVersion(column);
+    const int rows = table.rowCount();
+
+    if (table.id() != m_tableId || column != m_column ||
+        prefixVersion != m_prefixVersion || rows < m_rowsConsumed) {
+        reset();
+    }
+
+    const int first = m_rowsConsumed;
+    for (int row = first; row < rows; ++row) {
+        QVariant cell = table.at(row, column);
+        update(cell.canConvert<double>() ? cell.toDouble() : std::numeric_limits<double>::quiet_NaN());
+    }
+
+    m_tableId = table.id();
+    m_column = column;
+    m_prefixVersion = prefixVersion;
+    m_rowsConsumed = rows;
+    return rows - first;
+}
+
+// === 查询 ===
+
+bool OnlineForecaster::isReady() const
+{
+    switch (m_model) {
+    case OnlineModel::LinearRegression:
+        return m_count >= 2;
+    case OnlineModel::MovingAverage:
+        return m_count >= m_window;
+    case OnlineModel::Smoothing:
+        if (m_failed) {
+            return false;
+        }
+        // 与批量方法的最少数据要求一致（简单指数平滑 1 个即可）
+        if (SmoothingKernels::isSeasonal(m_smoothingModel)) {
+            return m_count >= SmoothingKernels::minimumLength(m_smoothingModel, m_seasonLength);
+        }
+        return m_count >= warmupLength(m_smoothingModel, m_seasonLength);
+    }
+    return false;
+}
+
+ForecastResult OnlineForecaster::forecast(int periods, double confidence) const
+{
+    ForecastResult result;
+
+    if (m_failed) {
+        result.isValid = false;
+        result.errorMessage = "乘法季节模型要求数据全部为正，或计算溢出";
+        return result;
+    }
+    if (!isReady()) {
+        result.isValid = false;
+        result.errorMessage = "数据量不足";
+        return result;
+    }
+
+    QVector<double> predictions;
+    predictions.reserve(std::max(0, periods));
+
+    switch (m_model) {
+    case OnlineModel::LinearRegression: {
+        if (m_sxx <= 0.0) {
+            result.isValid = false;
+            result.errorMessage = "回归失败";
+            return result;
+        }
+        double b = m_sxy / m_sxx;
+        double a = m_meanY - b * m_meanX;
+        for (int h = 1; h <= periods; ++h) {
+            predictions.append(a + b * (m_count + h));
+        }
+        double sse = std::max(0.0, m_syy - m_sxy * b);
+        result.predicted = predictions;
+        result.errorMetric = sse / m_count;
+        Forecasting::regressionIntervals(result, m_count, m_meanX, m_sxx, sse, confidence);
+        break;
+    }
+
+    case OnlineModel::MovingAverage:
+        if (!m_weights.isEmpty() && std::accumulate(m_weights.cbegin(), m_weights.cend(), 0.0) == 0.0) {
+            result.isValid = false;
+            result.errorMessage = "权重和为零";
+            return result;
+        }
+        predictions.fill(movingAverageValue(), std::max(0, periods));
+        result.errorMetric = m_steps > 0 ? m_sse / m_steps : std::numeric_limits<double>::quiet_NaN();
+        break;
+
+    case OnlineModel::Smoothing: {
+        SmoothingKernels::State state;
+        state.level = m_level;
+        state.trend = m_trend;
+        state.phase = m_phase;
+        for (int h = 1; h <= periods; ++h) {
+            predictions.append(SmoothingKernels::forecast(m_smoothingModel, state, m_seasonal.constData(),
+                                                          m_seasonLength, h));
+        }
+        result.predicted = predictions;
+        result.errorMetric = m_steps > 0 ? m_sse / m_steps : 0.0;
+        if (m_steps > 0) {
+            Forecasting::smoothingIntervals(result, m_smoothingModel, m_parameters, m_seasonLength, confidence);
+        }
+        break;
+    }
+    }
+
+    result.predicted = predictions;
+    result.isValid = true;
+    return result;
+}
+
+// === 序列化 ===
+
+QByteArray OnlineForecaster::serialize() const
+{
+    QByteArray bytes;
+    QDataStream out(&bytes, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_6_0);
+
+    out << STATE_MAGIC << STATE_VERSION;
+    out << static_cast<qint32>(m_model) << static_cast<qint32>(m_smoothingModel);
+    out << m_parameters.alpha << m_parameters.beta << m_parameters.gamma;
+    out << static_cast<qint32>(m_window) << static_cast<qint32>(m_seasonLength);
+
+    out << m_count << m_steps << m_sse << m_failed;
+    out << m_meanX << m_meanY << m_sxx << m_sxy << m_syy;
+    out << m_buffer << m_weights << static_cast<qint32>(m_head) << m_sum;
+    out << m_level << m_trend << static_cast<qint32>(m_phase) << m_seasonal;
+
+    out << m_tableId << static_cast<qint32>(m_column) << m_prefixVersion << static_cast<qint32>(m_rowsConsumed);
+    return bytes;
+}
+
+OnlineForecaster OnlineForecaster::deserialize(const QByteArray& bytes, bool* ok)
+{
+    if (ok) {
+        *ok = false;
+    }
+
+    QDataStream in(bytes);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    qint32 version = 0;
+    in >> magic >> version;
+    if (magic != STATE_MAGIC || version < 1 || version > STATE_VERSION) {
+        qWarning() << "OnlineForecaster::deserialize: 无法识别的状态数据";
+        return linearRegression();
+    }
+
+    OnlineForecaster f;
+    qint32 model = 0, smoothingModel = 0, window = 0, seasonLength = 0;
+    qint32 head = 0, phase = 0, column = 0, rowsConsumed = 0;
+
+    in >> model >> smoothingModel;
+    in >> f.m_parameters.alpha >> f.m_parameters.beta >> f.m_parameters.gamma;
+    in >> window >> seasonLength;
+
+    in >> f.m_count >> f.m_steps >> f.m_sse >> f.m_failed;
+    in >> f.m_meanX >> f.m_meanY >> f.m_sxx >> f.m_sxy >> f.m_syy;
+    in >> f.m_buffer;
+    if (version >= 2) {
+        in >> f.m_weights;
+    }
+    in >> head >> f.m_sum;
+    in >> f.m_level >> f.m_trend >> phase >> f.m_seasonal;
+
+    in >> f.m_tableId >> column >> f.m_prefixVersion >> rowsConsumed;
+
+    f.m_model = static_cast<OnlineModel>(model);
+    f.m_smoothingModel = static_cast<SmoothingModel>(smoothingModel);
+    f.m_window = window;
+    f.m_seasonLength = seasonLength;
+    f.m_head = head;
+    f.m_phase = phase;
+    f.m_column = column;
+    f.m_rowsConsumed = rowsConsumed;
+
+    // 校验各数组长度与下标，防止损坏的数据导致越界访问
+    bool consistent = in.status() == QDataStream::Ok &&
+                      model >= 0 && model <= static_cast<qint32>(OnlineModel::Smoothing) &&
+                      smoothingModel >= 0 &&
+                      smoothingModel <= static_cast<qint32>(SmoothingModel::HoltWintersMultiplicative) &&
+                      window >= 1 && seasonLength >= 1 && f.m_count >= 0 &&
+                      phase >= 0 && phase < seasonLength;
+    if (consistent && f.m_model == OnlineModel::MovingAverage) {
+        consistent = f.m_buffer.size() == window && head >= 0 && head < window &&
+                     (f.m_weights.isEmpty() || f.m_weights.size() == window);
+    }
+    if (consistent && f.m_model == OnlineModel::Smoothing) {
+        // 只有指数平滑使用季节项；其他模型未调用 reset() 前 m_seasonal 为空
+        consistent = f.m_seasonal.size() == seasonLength &&
+                     f.m_buffer.size() < warmupLength(f.m_smoothingModel, seasonLength);
+    }
+
+    if (!consistent) {
+        qWarning() << "OnlineForecaster::deserialize: 状态数据损坏";
+        return linearRegression();
+    }
+
+    if (ok) {
+        *ok = true;
+    }
+    return f;
+}
+
+} // namespace Statistics
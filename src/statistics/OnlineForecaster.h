@@ -0,0 +1,153 @@
+#ifndef ONLINEFORECASTER_H
+#define ONLINEFORECASTER_H
+
+#include "StatisticTypes.h"
+#include "core/TableData.h"
+#include <QByteArray>
+#include <QVector>
+#include <QString>
+
+namespace Statistics {
+
+/**
+ * @brief 在线预测模型类型
+ */
+enum class OnlineModel
+{
+    LinearRegression,       // 线性趋势回归（x = 1, 2, ...）
+    MovingAverage,          // 简单/加权移动平均
+    Smoothing               // 指数平滑（简单/Holt/Holt-Winters）
+};
+
+/**
+ * @brief 增量预测器
+ *
+ * 只保存模型的充分统计量，新增数据时按新数据量 O(k) 更新，不必重新扫描
+ * 整个序列：
+ * - 线性回归：x/y 均值及二阶中心矩（Welford 递推），斜率、截距和残差
+ *   平方和均可由其直接得到
+ * - 移动平均：最近 window 个值的环形缓冲与滑动和（加权移动平均每期 O(window)）
+ * - 指数平滑：水平、趋势、季节项和一步预测误差累计（递推与
+ *   SmoothingKernels 一致）
+ *
+ * forecast() 的预测值与误差指标与 Forecasting 中对应的批量方法一致
+ * （NaN 跳过）。状态可用 serialize()/deserialize() 保存和恢复，
+ * catchUp() 可以记住已处理到表格的哪一行，数据追加后只处理新增行。
+ *
+ * 目前由 Backtester 在相邻回测起点之间增量更新时使用；界面中的预测
+ * 仍由 Forecasting 的批量方法按需计算。
+ */
+class OnlineForecaster
+{
+public:
+    // === 构造 ===
+    static OnlineForecaster linearRegression();
+    static OnlineForecaster movingAverage(int window);
+
+    /**
+     * @brief 加权移动平均（weights[0] 对应窗口内最早的值，同 Forecasting::weightedMovingAverage）
+     */
+    static OnlineForecaster weightedMovingAverage(const QVector<double>& weights);
+    static OnlineForecaster exponentialSmoothing(SmoothingModel model, const SmoothingParameters& parameters,
+                                                 int seasonLength = 12);
+
+    OnlineModel model() const { return m_model; }
+    SmoothingModel smoothingModel() const { return m_smoothingModel; }
+    SmoothingParameters parameters() const { return m_parameters; }
+    int window() const { return m_window; }
+    int seasonLength() const { return m_seasonLength; }
+
+    // === 增量更新 ===
+    void update(double value);
+    void update(const QVector<double>& values);
+
+    /**
+     * @brief 与表格列同步
+     *
+     * 若上次同步的是同一表格、同一列且已有行未被修改（prefixVersion 不变），
+     * 只读取新增的行；否则清空状态并从头处理整列。
+     *
+     * @return 本次处理的行数
+     */
+    int catchUp(const Core::TableData& table, int column);
+
+    /**
+     * @brief 清空状态（保留模型与参数）
+     */
+    void reset();
+
+    // === 查询 ===
+    qint64 count() const { return m_count; }
+
+    /**
+     * @brief 数据是否足以预测
+     */
+    bool isReady() const;
+
+    /**
+     * @brief 从当前状态外推
+     *
+     * 线性回归与指数平滑（乘法季节除外）同时给出解析预测区间，
+     * 与 Forecasting 中的批量方法一致；confidence 不在 (0, 1) 内时不计算区间。
+     */
+    ForecastResult forecast(int periods, double confidence = 0.95) const;
+
+    // === 序列化 ===
+    QByteArray serialize() const;
+
+    /**
+     * @brief 从 serialize() 的结果恢复
+     * @param ok 可选，数据格式无效时置为 false（此时返回默认的线性回归预测器）
+     */
+    static OnlineForecaster deserialize(const QByteArray& bytes, bool* ok = nullptr);
+
+private:
+    OnlineForecaster() = default;
+
+    void updateRegression(double value);
+    void updateMovingAverage(double value);
+    void updateSmoothing(double value);
+    double movingAverageValue() const;
+
+    // 模型与参数
+    OnlineModel m_model = OnlineModel::LinearRegression;
+    SmoothingModel m_smoothingModel = SmoothingModel::Simple;
+    SmoothingParameters m_parameters;
+    int m_window = 1;
+    int m_seasonLength = 1;
+
+    // 通用状态
+    qint64 m_count = 0;             // 已处理的有效值个数
+    qint64 m_steps = 0;             // 参与误差计算的预测步数
+    double m_sse = 0.0;             // 一步预测（回归为拟合）误差平方和
+    bool m_failed = false;          // 乘法季节模型遇到非正值
+
+    // 线性回归：均值与中心矩
+    double m_meanX = 0.0;
+    double m_meanY = 0.0;
+    double m_sxx = 0.0;
+    double m_sxy = 0.0;
+    double m_syy = 0.0;
+
+    // 移动平均：环形缓冲（m_head 为最早的值）；指数平滑：初始化前的预热数据
+    QVector<double> m_buffer;
+    QVector<double> m_weights;      // 加权移动平均的权重（为空表示简单移动平均）
+    int m_head = 0;
+    double m_sum = 0.0;
+
+    // 指数平滑状态
+    double m_level = 0.0;
+    double m_trend = 0.0;
+    int m_phase = 0;
+    QVector<double> m_seasonal;
+
+    // 与表格同步的位置
+    quint64 m_tableId = 0;
+    int m_column = -1;
+    quint64 m_prefixVersion = 0;
+    int m_rowsConsumed = 0;
+};
+
+} // namespace Statistics
+
+#endif // ONLINEFORECASTER_H
@@ -0,0 +1,383 @@
+#include "OutlierDetector.h"
+#include "CachedStatistics.h"
+#include "ParallelUtils.h"
+#include <QByteArray>
+#include <QSharedPointer>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+namespace Statistics {
+
+namespace {
+
+const double NaN = std::numeric_limits<double>::quiet_NaN();
+
+// 每块最少行数（打包位图时按 8 行一字节切分）
+const qsizetype MIN_ROWS_PER_CHUNK = 65536;
+
+// 矩累加的小块大小：块内先求和再求离差平方和，两遍都在 L1 缓存中
+const qsizetype MOMENT_BLOCK = 1024;
+
+// 正态分布下标准差与 MAD 之比
+const double MAD_SCALE = 1.4826;
+
+// MAD 为 0（一半以上取值相同）时改用平均绝对偏差，正态分布下标准差与其之比为 √(π/2)
+const double MEAN_AD_SCALE = 1.2533;
+
+using SortedProvider = std::function<QSharedPointer<const QVector<double>>()>;
+
+/**
+ * @brief 有效值的个数、均值与离差平方和（Chan 合并）
+ */
+struct Moments
+{
+    qint64 n = 0;
+    double mean = 0.0;
+    double m2 = 0.0;
+
+    void merge(qint64 otherN, double otherMean, double otherM2)
+    {
+        if (otherN == 0) {
+            return;
+        }
+        const qint64 total = n + otherN;
+        const double delta = otherMean - mean;
+        mean += delta * otherN / total;
+        m2 += otherM2 + delta * delta * static_cast<double>(n) * otherN / total;
+        n = total;
+    }
+};
+
+/**
+ * @brief 并行的一遍矩累加（跳过 NaN 与无穷）
+ */
+Moments columnMoments(const QVector<double>& data)
+{
+    const double* x = data.constData();
+    const qsizetype n = data.size();
+    const int chunks = Parallel::chunkCount(n, MIN_ROWS_PER_CHUNK);
+    QVector<Moments> partials(chunks);
+
+    Parallel::forChunks(n, chunks, [&](int chunk, qsizetype begin, qsizetype end) {
+        Moments& local = partials[chunk];
+        for (qsizetype b = begin; b < end; b += MOMENT_BLOCK) {
+            const qsizetype e = std::min(end, b + MOMENT_BLOCK);
+            qint64 count = 0;
+            double sum = 0.0;
+            for (qsizetype i = b; i < e; ++i) {
+                const bool valid = std::isfinite(x[i]);
+                count += valid;
+                sum += valid ? x[i] : 0.0;
+            }
+            if (count == 0) {
+                continue;
+            }
+            const double mean = sum / count;
+            double m2 = 0.0;
+            for (qsizetype i = b; i < e; ++i) {
+                const double d = std::isfinite(x[i]) ? x[i] - mean : 0.0;
+                m2 += d * d;
+            }
+            local.merge(count, mean, m2);
+        }
+    });
+
+    Moments total;
+    for (const Moments& part : partials) {
+        total.merge(part.n, part.mean, part.m2);
+    }
+    return total;
+}
+
+double sortedQuantile(const QVector<double>& sorted, double p)
+{
+    const double index = p * (sorted.size() - 1);
+    const qsizetype lower = static_cast<qsizetype>(index);
+    const qsizetype upper = std::min<qsizetype>(lower + 1, sorted.size() - 1);
+    const double weight = index - lower;
+    return sorted[lower] * (1.0 - weight) + sorted[upper] * weight;
+}
+
+/**
+ * @brief 有序数据到 center 的绝对偏差的中位数
+ *
+ * center 左侧的偏差自右向左递增、右侧的自左向右递增，两路归并到中间即可，
+ * 不需要再排序。
+ */
+double sortedMedianDeviation(const QVector<double>& sorted, double center)
+{
+    const qsizetype n = sorted.size();
+    qsizetype right = std::upper_bound(sorted.begin(), sorted.end(), center) - sorted.begin();
+    qsizetype left = right - 1;
+
+    auto next = [&]() {
+        if (left >= 0 && (right >= n || center - sorted[left] <= sorted[right] - center)) {
+            return center - sorted[left--];
+        }
+        return sorted[right++] - center;
+    };
+
+    double value = 0.0;
+    for (qsizetype k = 0; k <= (n - 1) / 2; ++k) {
+        value = next();
+    }
+    return n % 2 == 0 ? (value + next()) / 2.0 : value;
+}
+
+/**
+ * @brief 超出 [lower, upper] 的值置位，8 行打包为一字节（NaN 比较为假，不会被标记）
+ */
+void flagOutside(const QVector<double>& data, double lower, double upper, ColumnOutliers& result)
+{
+    const double* x = data.constData();
+    const qsizetype n = data.size();
+    const qsizetype bytes = (n + 7) / 8;
+    QByteArray bits(bytes, '\0');
+    char* out = bits.data();
+
+    const int chunks = Parallel::chunkCount(bytes, MIN_ROWS_PER_CHUNK / 8);
+    QVector<qint64> counts(chunks, 0);
+    Parallel::forChunks(bytes, chunks, [&](int chunk, qsizetype begin, qsizetype end) {
+        qint64 count = 0;
+        for (qsizetype b = begin; b < end; ++b) {
+            const qsizetype first = b * 8;
+            const int width = static_cast<int>(std::min<qsizetype>(8, n - first));
+            unsigned byte = 0;
+            for (int bit = 0; bit < width; ++bit) {
+                const double value = x[first + bit];
+                const unsigned outside = static_cast<unsigned>(value < lower) | static_cast<unsigned>(value > upper);
+                byte |= outside << bit;
+                count += outside;
+            }
+            out[b] = static_cast<char>(byte);
+        }
+        counts[chunk] = count;
+    });
+
+    result.flags = QBitArray::fromBits(bits.constData(), n);
+    result.count = 0;
+    for (qint64 count : counts) {
+        result.count += count;
+    }
+}
+
+/**
+ * @brief 与前 window 行（有效值）的均值相差超过 threshold 倍标准差的值置位
+ *
+ * 窗口的均值与离差平方和用 Welford 增删维护，一遍完成；窗口内有效值
+ * 少于一半（至少 2 个）或方差为 0 时不标记。
+ */
+void flagRolling(const QVector<double>& data, const OutlierOptions& options, ColumnOutliers& result)
+{
+    const double* x = data.constData();
+    const qsizetype n = data.size();
+    const qsizetype window = options.window;
+    const qint64 minPeriods = std::max(2, options.window / 2);
+    QByteArray bits((n + 7) / 8, '\0');
+    char* out = bits.data();
+
+    qint64 count = 0;
+    double mean = 0.0;
+    double m2 = 0.0;
+    for (qsizetype i = 0; i < n; ++i) {
+        const double value = x[i];
+        const bool valid = std::isfinite(value);
+
+        if (valid && count >= minPeriods && m2 > 0.0) {
+            const double deviation = std::fabs(value - mean);
+            if (deviation * deviation > options.threshold * options.threshold * m2 / (count - 1)) {
+                out[i / 8] = static_cast<char>(out[i / 8] | (1 << (i % 8)));
+                ++result.count;
+            }
+        }
+
+        // 加入当前行，移出 i - window 行
+        if (valid) {
+            ++result.validCount;
+            ++count;
+            const double delta = value - mean;
+            mean += delta / count;
+            m2 += delta * (value - mean);
+        }
+        const qsizetype leaving = i - window;
+        if (leaving >= 0 && std::isfinite(x[leaving])) {
+            if (--count == 0) {
+                mean = 0.0;
+                m2 = 0.0;
+            } else {
+                const double delta = x[leaving] - mean;
+                mean -= delta / count;
+                m2 = std::max(0.0, m2 - delta * (x[leaving] - mean));
+            }
+        }
+    }
+
+    result.flags = QBitArray::fromBits(bits.constData(), n);
+    result.lower = NaN;
+    result.upper = NaN;
+}
+
+QString validateOptions(const OutlierOptions& options)
+{
+    if (!(options.threshold > 0.0)) {
+        return "阈值必须大于 0";
+    }
+    if (!(options.iqrFactor >= 0.0)) {
+        return "IQR 倍数不能为负";
+    }
+    if (options.method == OutlierMethod::Rolling && options.window < 2) {
+        return "窗口大小至少为 2";
+    }
+    return QString();
+}
+
+/**
+ * @brief 单列检测：先得到判定区间（或滚动统计），再扫描一遍打包位图
+ * @param sorted 有效值的升序副本（只有 Iqr / Mad 需要）
+ */
+ColumnOutliers detectValues(const QVector<double>& data, const SortedProvider& sorted, const OutlierOptions& options)
+{
+    ColumnOutliers result;
+    result.flags = QBitArray(data.size());
+
+    const QString error = validateOptions(options);
+    if (!error.isEmpty()) {
+        result.isValid = false;
+        result.errorMessage = error;
+        return result;
+    }
+
+    if (options.method == OutlierMethod::Rolling) {
+        flagRolling(data, options, result);
+        return result;
+    }
+
+    double lower = NaN;
+    double upper = NaN;
+    if (options.method == OutlierMethod::ZScore) {
+        const Moments moments = columnMoments(data);
+        result.validCount = moments.n;
+        if (moments.n >= 2) {
+            const double spread = options.threshold * std::sqrt(moments.m2 / (moments.n - 1));
+            lower = moments.mean - spread;
+            upper = moments.mean + spread;
+        }
+    } else {
+        const auto values = sorted();
+        result.validCount = values->size();
+        if (!values->isEmpty()) {
+            if (options.method == OutlierMethod::Iqr) {
+                const double q1 = sortedQuantile(*values, 0.25);
+                const double q3 = sortedQuantile(*values, 0.75);
+                lower = q1 - options.iqrFactor * (q3 - q1);
+                upper = q3 + options.iqrFactor * (q3 - q1);
+            } else {
+                const double median = sortedQuantile(*values, 0.5);
+                double scale = MAD_SCALE * sortedMedianDeviation(*values, median);
+                if (scale == 0.0) {
+                    double total = 0.0;
+                    for (double value : *values) {
+                        total += std::fabs(value - median);
+                    }
+                    scale = MEAN_AD_SCALE * total / values->size();
+                }
+                lower = median - options.threshold * scale;
+                upper = median + options.threshold * scale;
+            }
+        }
+    }
+
+    if (result.validCount == 0) {
+        result.isValid = false;
+        result.errorMessage = "没有有效数据";
+        return result;
+    }
+
+    result.lower = lower;
+    result.upper = upper;
+    if (!std::isnan(lower)) {
+        flagOutside(data, lower, upper, result);
+    }
+    return result;
+}
+
+} // namespace
+
+OutlierScanResult OutlierDetector::scan(const Core::TableData& table, const QVector<int>& columns,
+                                        const OutlierOptions& options)
+{
+    OutlierScanResult result;
+    result.method = options.method;
+
+    const QString error = validateOptions(options);
+    if (!error.isEmpty()) {
+        result.isValid = false;
+        result.errorMessage = error;
+        return result;
+    }
+    for (int column : columns) {
+        if (column < 0 || column >= table.columnCount()) {
+            result.isValid = false;
+            result.errorMessage = QString("列索引无效: %1").arg(column);
+            return result;
+        }
+    }
+
+    // 各列并行（列内的矩累加与位图打包也会按行块并行）
+    result.columns.resize(columns.size());
+    Parallel::forEach(columns.size(), [&](int index) {
+        const int column = columns[index];
+        const auto values = CachedStatistics::values(table, column);
+        ColumnOutliers outliers = detectValues(
+            *values, [&table, column]() { return CachedStatistics::sortedValues(table, column); }, options);
+        outliers.column = column;
+        outliers.name = table.header(column);
+        result.columns[index] = outliers;
+    });
+
+    result.rows = QBitArray(table.rowCount());
+    for (const ColumnOutliers& outliers : result.columns) {
+        if (outliers.isValid) {
+            result.rows |= outliers.flags;
+        }
+    }
+    result.flaggedRows = result.rows.count(true);
+    return result;
+}
+
+ColumnOutliers OutlierDetector::detect(const QVector<double>& data, const OutlierOptions& options)
+{
+    return detectValues(
+        data,
+        [&data]() {
+            auto sorted = QSharedPointer<QVector<double>>::create();
+            sorted->reserve(data.size());
+            for (double value : data) {
+                if (std::isfinite(value)) {
+                    sorted->append(value);
+                }
+            }
+            std::sort(sorted->begin(), sorted->end());
+            return QSharedPointer<const QVector<double>>(sorted);
+        },
+        options);
+}
+
+QString OutlierDetector::methodName(OutlierMethod method)
+{
+    switch (method) {
+    case OutlierMethod::ZScore:
+        return "Z 分数";
+    case OutlierMethod::Iqr:
+        return "IQR 栅栏";
+    case OutlierMethod::Mad:
+        return "MAD（稳健 Z 分数）";
+    case OutlierMethod::Rolling:
+        return "滚动窗口偏离";
+    }
+    return QString();
+}
+
+} // namespace Statistics
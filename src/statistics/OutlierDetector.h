@@ -0,0 +1,98 @@
+#ifndef OUTLIERDETECTOR_H
+#define OUTLIERDETECTOR_H
+
+#include "core/TableData.h"
+#include <QBitArray>
+#include <QVector>
+#include <QString>
+
+namespace Statistics {
+
+/**
+ * @brief 异常值判定方法
+ */
+enum class OutlierMethod
+{
+    ZScore,     // |x - 均值| > threshold × 标准差
+    Iqr,        // 超出 [Q1 - iqrFactor × IQR, Q3 + iqrFactor × IQR]
+    Mad,        // 稳健 z 分数：|x - 中位数| > threshold × 1.4826 × MAD
+    Rolling     // 与前 window 个有效值的均值相差超过 threshold 倍标准差
+};
+
+/**
+ * @brief 异常值检测参数
+ */
+struct OutlierOptions
+{
+    OutlierMethod method = OutlierMethod::ZScore;
+    double threshold = 3.0;         // ZScore / Mad / Rolling 的倍数
+    double iqrFactor = 1.5;         // Iqr 的栅栏倍数
+    int window = 20;                // Rolling 的窗口大小（不含当前行）
+};
+
+/**
+ * @brief 单列的检测结果
+ */
+struct ColumnOutliers
+{
+    int column = -1;
+    QString name;
+
+    QBitArray flags;                // 每行是否为异常值（长度等于行数）
+    qint64 count = 0;               // 异常值个数
+    qint64 validCount = 0;          // 有效数值个数
+
+    // 全局方法的判定区间（Rolling 时为 NaN）
+    double lower = 0.0;
+    double upper = 0.0;
+
+    bool isValid = true;
+    QString errorMessage;
+};
+
+/**
+ * @brief 多列扫描结果
+ */
+struct OutlierScanResult
+{
+    OutlierMethod method = OutlierMethod::ZScore;
+    QVector<ColumnOutliers> columns;
+
+    QBitArray rows;                 // 任一列为异常值的行
+    qint64 flaggedRows = 0;
+
+    bool isValid = true;
+    QString errorMessage;
+};
+
+/**
+ * @brief 异常值检测
+ *
+ * Z 分数、IQR 与 MAD 都归结为一个判定区间 [lower, upper]：区间所需的
+ * 统计量取自列缓存（均值与方差用一遍并行的矩累加求得，分位数与中位数
+ * 取自缓存的有序副本，MAD 在有序副本上双指针求得，不再排序），之后只需
+ * 对列扫描一遍，无分支地比较并按 8 行一字节打包成位图。Rolling 在同一遍
+ * 扫描中用 Welford 增删维护窗口的均值与方差。
+ *
+ * 多列扫描时各列并行，位图可直接交给表格视图按行隐藏，不复制数据。
+ */
+class OutlierDetector
+{
+public:
+    /**
+     * @brief 扫描表格中的若干数值列
+     */
+    static OutlierScanResult scan(const Core::TableData& table, const QVector<int>& columns,
+                                  const OutlierOptions& options = OutlierOptions());
+
+    /**
+     * @brief 检测一列数据（NaN 表示缺失，不会被标记）
+     */
+    static ColumnOutliers detect(const QVector<double>& data, const OutlierOptions& options = OutlierOptions());
+
+    static QString methodName(OutlierMethod method);
+};
+
+} // namespace Statistics
+
+#endif // OUTLIERDETECTOR_H
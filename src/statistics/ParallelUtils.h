@@ -0,0 +1,103 @@
+#ifndef PARALLELUTILS_H
+#define PARALLELUTILS_H
+
+#include <QVector>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrent>
+#include <algorithm>
+
+namespace Statistics {
+
+/**
+ * @brief 并行计算辅助函数
+ *
+ * 基于 Qt 全局线程池（QtConcurrent）将计算任务切分为若干块并行执行。
+ * 调用线程本身也会参与计算，因此可以在后台任务中嵌套调用。
+ */
+namespace Parallel {
+
+/**
+ * @brief 可用的工作线程数
+ */
+inline int threadCount()
+{
+    return std::max(1, QThreadPool::globalInstance()->maxThreadCount());
+}
+
+/**
+ * @brief 计算 n 个元素应切分的块数
+ * @param n 元素个数
+ * @param minGrain 每块最少元素数（避免任务过碎）
+ * @return 块数（至少为 1，最多为线程数的 4 倍）
+ */
+inline int chunkCount(qsizetype n, qsizetype minGrain)
+{
+    if (n <= 0) {
+        return 1;
+    }
+
+    qsizetype grain = std::max<qsizetype>(1, minGrain);
+    qsizetype byGrain = (n + grain - 1) / grain;
+    qsizetype limit = static_cast<qsizetype>(threadCount()) * 4;
+
+    return static_cast<int>(std::max<qsizetype>(1, std::min(byGrain, limit)));
+}
+
+/**
+ * @brief 第 chunk 块的起止下标 [begin, end)
+ */
+inline qsizetype chunkBegin(qsizetype n, int chunks, int chunk)
+{
+    return n * chunk / chunks;
+}
+
+/**
+ * @brief 并行执行 count 个独立任务
+ * @param body 形如 void(int index) 的函数对象
+ */
+template<typename Body>
+void forEach(int count, Body body)
+{
+    if (count <= 0) {
+        return;
+    }
+
+    if (count == 1 || threadCount() == 1) {
+        for (int i = 0; i < count; ++i) {
+            body(i);
+        }
+        return;
+    }
+
+    QVector<int> indices(count);
+    for (int i = 0; i < count; ++i) {
+        indices[i] = i;
+    }
+
+    QtConcurrent::blockingMap(indices, [&body](int& index) { body(index); });
+}
+
+/**
+ * @brief 将 [0, n) 切分为 chunks 块并行执行
+ * @param body 形如 void(int chunk, qsizetype begin, qsizetype end) 的函数对象
+ *
+ * @note 块的划分是确定性的，按块下标合并局部结果即可得到可复现的结果
+ */
+template<typename Body>
+void forChunks(qsizetype n, int chunks, Body body)
+{
+    chunks = std::max(1, chunks);
+    forEach(chunks, [&](int chunk) {
+        qsizetype begin = chunkBegin(n, chunks, chunk);
+        qsizetype end = chunkBegin(n, chunks, chunk + 1);
+        if (begin < end) {
+            body(chunk, begin, end);
+        }
+    });
+}
+
+} // namespace Parallel
+
+} // namespace Statistics
+
+#endif // PARALLELUTILS_H
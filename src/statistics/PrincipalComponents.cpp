@@ -0,0 +1,544 @@
+#include "PrincipalComponents.h"
+#include "Bootstrap.h"
+#include "ColumnReader.h"
+#include "Factorizations.h"
+#include "Gemm.h"
+#include "MatrixExpression.h"
+#include "ParallelUtils.h"
+#include "SymmetricEigen.h"
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace Statistics {
+
+namespace {
+
+// 每个行块读入的行数（500 列时约 16 MB）
+const qsizetype PANEL_ROWS = 4096;
+
+// 自动模式：列数不少于该值、且所需主成分不超过列数的 1/10 时使用随机化 SVD
+const int RANDOMIZED_MIN_COLUMNS = 1000;
+const int RANDOMIZED_MAX_FRACTION = 10;
+
+struct Source
+{
+    int variables = 0;
+    qsizetype rows = 0;
+    ColumnReader reader;
+};
+
+PcaResult invalidResult(const QString& message)
+{
+    PcaResult result;
+    result.isValid = false;
+    result.errorMessage = message;
+    return result;
+}
+
+/**
+ * @brief 列优先的行块缓冲区（列间距 PANEL_ROWS），只保存各列均有效的行
+ */
+struct Panel
+{
+    int columns = 0;
+    qsizetype rows = 0;
+    QVector<double> values;
+    QVector<char> valid;
+    QVector<int> sourceRows;            // 各行在输入中的行号
+
+    void reserve(int p)
+    {
+        columns = p;
+        values.resize(PANEL_ROWS * p);
+        valid.resize(PANEL_ROWS);
+        sourceRows.resize(PANEL_ROWS);
+    }
+
+    double* column(int c) { return values.data() + c * PANEL_ROWS; }
+    MatrixView view() { return MatrixView(values.data(), rows, columns, 1, PANEL_ROWS); }
+};
+
+/**
+ * @brief 读入 [begin, end) 行并紧凑存放完整的行
+ */
+void loadComplete(const Source& source, qsizetype begin, qsizetype end, Panel& panel)
+{
+    const qsizetype len = end - begin;
+    char* valid = panel.valid.data();
+    std::fill(valid, valid + len, 1);
+
+    for (int c = 0; c < panel.columns; ++c) {
+        double* x = panel.column(c);
+        source.reader(c, begin, end, x);
+        for (qsizetype r = 0; r < len; ++r) {
+            valid[r] &= static_cast<char>(std::isfinite(x[r]));
+        }
+    }
+
+    qsizetype kept = 0;
+    for (int c = 0; c < panel.columns; ++c) {
+        double* x = panel.column(c);
+        kept = 0;
+        for (qsizetype r = 0; r < len; ++r) {
+            if (valid[r]) {
+                x[kept++] = x[r];
+            }
+        }
+    }
+    kept = 0;
+    for (qsizetype r = 0; r < len; ++r) {
+        if (valid[r]) {
+            panel.sourceRows[kept++] = static_cast<int>(begin + r);
+        }
+    }
+    panel.rows = kept;
+}
+
+int panelCount(const Source& source)
+{
+    return static_cast<int>((source.rows + PANEL_ROWS - 1) / PANEL_ROWS);
+}
+
+/**
+ * @brief 并行扫描时的分段数（各段独立累加，按段顺序合并）
+ */
+int splitCount(const Source& source)
+{
+    return Parallel::chunkCount(panelCount(source), 1);
+}
+
+/**
+ * @brief 把数据按行块切成若干段并行扫描，body(段号, 行块) 依次处理本段的各行块
+ */
+template<typename Body>
+void forEachPanel(const Source& source, Body body)
+{
+    const int panels = panelCount(source);
+    const int splits = splitCount(source);
+
+    Parallel::forEach(splits, [&](int split) {
+        Panel panel;
+        panel.reserve(source.variables);
+        qsizetype splitBegin = Parallel::chunkBegin(panels, splits, split) * PANEL_ROWS;
+        qsizetype splitEnd = std::min(source.rows, Parallel::chunkBegin(panels, splits, split + 1) * PANEL_ROWS);
+        for (qsizetype begin = splitBegin; begin < splitEnd; begin += PANEL_ROWS) {
+            loadComplete(source, begin, std::min(splitEnd, begin + PANEL_ROWS), panel);
+            if (panel.rows > 0) {
+                body(split, panel);
+            }
+        }
+    });
+}
+
+/**
+ * @brief 各列的行数、均值与离差平方和
+ */
+struct ColumnMoments
+{
+    qint64 count = 0;
+    QVector<double> mean;
+    QVector<double> m2;
+
+    void init(int p)
+    {
+        count = 0;
+        mean.fill(0.0, p);
+        m2.fill(0.0, p);
+    }
+
+    /**
+     * @brief Chan 合并公式（两部分的均值之差修正离差平方和）
+     */
+    void merge(const ColumnMoments& other)
+    {
+        if (other.count == 0) {
+            return;
+        }
+        if (count == 0) {
+            *this = other;
+            return;
+        }
+        const double n = static_cast<double>(count + other.count);
+        const double weight = static_cast<double>(count) * other.count / n;
+        for (int j = 0; j < mean.size(); ++j) {
+            const double delta = other.mean[j] - mean[j];
+            mean[j] += delta * other.count / n;
+            m2[j] += other.m2[j] + delta * delta * weight;
+        }
+        count += other.count;
+    }
+};
+
+struct Scan
+{
+    ColumnMoments moments;
+    QVector<int> completeRows;          // 完整行的行号（升序）
+};
+
+Scan scanColumns(const Source& source)
+{
+    const int p = source.variables;
+    QVector<Scan> partials(splitCount(source));
+    for (Scan& partial : partials) {
+        partial.moments.init(p);
+    }
+
+    forEachPanel(source, [&](int split, Panel& panel) {
+        ColumnMoments local;
+        local.init(p);
+        local.count = panel.rows;
+        for (int c = 0; c < p; ++c) {
+            const double* x = panel.column(c);
+            double sum = 0.0;
+            for (qsizetype r = 0; r < panel.rows; ++r) {
+                sum += x[r];
+            }
+            const double mean = sum / panel.rows;
+            double m2 = 0.0;
+            for (qsizetype r = 0; r < panel.rows; ++r) {
+                m2 += (x[r] - mean) * (x[r] - mean);
+            }
+            local.mean[c] = mean;
+            local.m2[c] = m2;
+        }
+        partials[split].moments.merge(local);
+        for (qsizetype r = 0; r < panel.rows; ++r) {
+            partials[split].completeRows.append(panel.sourceRows[r]);
+        }
+    });
+
+    for (int split = 1; split < partials.size(); ++split) {
+        partials[0].moments.merge(partials[split].moments);
+        partials[0].completeRows += partials[split].completeRows;
+    }
+    return partials[0];
+}
+
+/**
+ * @brief 行块原地中心化（标准化）
+ */
+void standardize(Panel& panel, const QVector<double>& means, const QVector<double>& scales)
+{
+    for (int c = 0; c < panel.columns; ++c) {
+        double* x = panel.column(c);
+        const double mean = means[c];
+        const double inverse = 1.0 / scales[c];
+        for (qsizetype r = 0; r < panel.rows; ++r) {
+            x[r] = (x[r] - mean) * inverse;
+        }
+    }
+}
+
+/**
+ * @brief 标准化后的数据矩阵 Z（完整行×变量）的各种乘积，每次调用扫描一遍数据
+ */
+struct DataMatrix
+{
+    const Source& source;
+    const QVector<double>& means;
+    const QVector<double>& scales;
+    const QVector<int>& completeRows;
+
+    qsizetype rows() const { return completeRows.size(); }
+    int cols() const { return source.variables; }
+
+    qsizetype offsetOf(const Panel& panel) const
+    {
+        return std::lower_bound(completeRows.constBegin(), completeRows.constEnd(), panel.sourceRows[0])
+               - completeRows.constBegin();
+    }
+
+    /**
+     * @brief ZᵀZ（各段分别累加，按段顺序合并）
+     */
+    DenseMatrix gram() const
+    {
+        const int p = cols();
+        QVector<DenseMatrix> partials(splitCount(source));
+        for (DenseMatrix& partial : partials) {
+            partial = DenseMatrix(p, p, 0.0, MatrixLayout::ColumnMajor);
+        }
+        forEachPanel(source, [&](int split, Panel& panel) {
+            standardize(panel, means, scales);
+            const MatrixView z = panel.view();
+            Gemm::multiply(1.0, z.transposed(), z, 1.0, partials[split].view());
+        });
+        for (int split = 1; split < partials.size(); ++split) {
+            partials[0] += partials[split];
+        }
+        return std::move(partials[0]);
+    }
+
+    /**
+     * @brief Z·W（W 为变量数×l，结果为完整行数×l）
+     */
+    DenseMatrix multiply(const ConstMatrixView& W) const
+    {
+        DenseMatrix result(rows(), W.cols(), 0.0, MatrixLayout::ColumnMajor);
+        forEachPanel(source, [&](int, Panel& panel) {
+            standardize(panel, means, scales);
+            Gemm::multiply(1.0, panel.view(), W, 0.0, result.block(offsetOf(panel), 0, panel.rows, W.cols()));
+        });
+        return result;
+    }
+
+    /**
+     * @brief Zᵀ·Q（Q 为完整行数×l，结果为变量数×l）
+     */
+    DenseMatrix multiplyTransposed(const ConstMatrixView& Q) const
+    {
+        const int p = cols();
+        QVector<DenseMatrix> partials(splitCount(source));
+        for (DenseMatrix& partial : partials) {
+            partial = DenseMatrix(p, Q.cols(), 0.0, MatrixLayout::ColumnMajor);
+        }
+        forEachPanel(source, [&](int split, Panel& panel) {
+            standardize(panel, means, scales);
+            Gemm::multiply(1.0, panel.view().transposed(), Q.block(offsetOf(panel), 0, panel.rows, Q.cols()),
+                           1.0, partials[split].view());
+        });
+        for (int split = 1; split < partials.size(); ++split) {
+            partials[0] += partials[split];
+        }
+        return std::move(partials[0]);
+    }
+};
+
+/**
+ * @brief 列正交基（Householder QR 的显式 Q）
+ */
+DenseMatrix orthonormalBasis(const DenseMatrix& Y)
+{
+    return QRDecomposition(Y).thinQ();
+}
+
+/**
+ * @brief 随机化截断 SVD：返回 Z 的前 k 个右奇异向量（变量数×k）与奇异值的平方
+ */
+bool randomizedSvd(const DataMatrix& Z, int k, const PcaOptions& options, DenseMatrix& vectors,
+                   QVector<double>& squaredValues)
+{
+    const int p = Z.cols();
+    const int l = static_cast<int>(std::min<qsizetype>({static_cast<qsizetype>(k) + std::max(0, options.oversampling),
+                                                        p, Z.rows()}));
+
+    DenseMatrix omega(p, l, MatrixLayout::ColumnMajor);
+    RandomStream rng(options.seed, 0);
+    std::normal_distribution<double> normal;
+    for (qsizetype i = 0; i < omega.size(); ++i) {
+        omega.data()[i] = normal(rng);
+    }
+
+    // 值域的正交基 Q ≈ range(Z)，每次乘积后重新正交化以免舍入误差淹没小奇异值
+    DenseMatrix Q = orthonormalBasis(Z.multiply(omega));
+    for (int iteration = 0; iteration < options.powerIterations; ++iteration) {
+        DenseMatrix W = orthonormalBasis(Z.multiplyTransposed(Q));
+        Q = orthonormalBasis(Z.multiply(W));
+    }
+    if (Q.isEmpty()) {
+        return false;
+    }
+
+    // B = QᵀZ = Wᵀ；BBᵀ = WᵀW 的特征分解给出 B 的左奇异向量 U 与奇异值平方
+    const DenseMatrix W = Z.multiplyTransposed(Q);
+    DenseMatrix small(l, l, 0.0, MatrixLayout::ColumnMajor);
+    Gemm::multiply(1.0, W.transposed(), W, 0.0, small.view());
+    SymmetricEigenDecomposition eigen(small);
+    if (!eigen.isValid()) {
+        return false;
+    }
+
+    // 右奇异向量 V = W·U·Σ⁻¹（奇异值为 0 的方向保持为 0 向量）
+    DenseMatrix WU(p, k, 0.0, MatrixLayout::ColumnMajor);
+    Gemm::multiply(1.0, W, eigen.eigenvectors().block(0, 0, l, k), 0.0, WU.view());
+    squaredValues.resize(k);
+    for (int c = 0; c < k; ++c) {
+        const double value = std::max(0.0, eigen.eigenvalues()[c]);
+        squaredValues[c] = value;
+        const double inverse = value > 0.0 ? 1.0 / std::sqrt(value) : 0.0;
+        for (int j = 0; j < p; ++j) {
+            WU(j, c) *= inverse;
+        }
+    }
+    vectors = std::move(WU);
+    return true;
+}
+
+PcaResult computeSource(const Source& source, const PcaOptions& options)
+{
+    const int p = source.variables;
+    if (p < 1) {
+        return invalidResult("至少需要一个数值列");
+    }
+    if (options.components < 0 || options.scoreComponents < 0) {
+        return invalidResult("主成分个数不能为负");
+    }
+
+    // === 第一遍：均值、标准差与完整行 ===
+    Scan scan = scanColumns(source);
+    const qint64 n = scan.moments.count;
+    if (n < 2) {
+        return invalidResult(QString("有效行数不足：至少需要 2 行，实际 %1 行").arg(n));
+    }
+
+    PcaResult result;
+    result.observations = n;
+    result.means = scan.moments.mean;
+    result.scales.fill(1.0, p);
+    for (int j = 0; j < p; ++j) {
+        const double variance = scan.moments.m2[j] / (n - 1);
+        if (options.standardize) {
+            // 常数列无法标准化，保留其（为 0 的）方差
+            result.scales[j] = variance > 0.0 ? std::sqrt(variance) : 1.0;
+            result.totalVariance += variance > 0.0 ? 1.0 : 0.0;
+        } else {
+            result.totalVariance += variance;
+        }
+    }
+
+    int k = options.components > 0 ? std::min(options.components, p) : p;
+    PcaMethod method = options.method;
+    if (method == PcaMethod::Auto) {
+        method = options.components > 0 && p >= RANDOMIZED_MIN_COLUMNS && k * RANDOMIZED_MAX_FRACTION <= p
+                     ? PcaMethod::Randomized
+                     : PcaMethod::Eigen;
+    }
+    if (method == PcaMethod::Randomized) {
+        if (options.components == 0) {
+            return invalidResult("随机化 SVD 需要指定主成分个数");
+        }
+        k = static_cast<int>(std::min<qint64>(k, n));
+    }
+    result.method = method;
+
+    DataMatrix Z{source, result.means, result.scales, scan.completeRows};
+
+    // === 主成分方向 ===
+    QVector<double> variances;
+    if (method == PcaMethod::Eigen) {
+        DenseMatrix covariance = Z.gram();
+        SymmetricEigenDecomposition eigen(covariance);
+        if (!eigen.isValid()) {
+            return invalidResult(eigen.errorMessage());
+        }
+        result.loadings = DenseMatrix::fromView(eigen.eigenvectors().block(0, 0, p, k), MatrixLayout::ColumnMajor);
+        for (int c = 0; c < k; ++c) {
+            variances.append(std::max(0.0, eigen.eigenvalues()[c]) / (n - 1));
+        }
+    } else {
+        QVector<double> squaredValues;
+        if (!randomizedSvd(Z, k, options, result.loadings, squaredValues)) {
+            return invalidResult("随机化 SVD 失败");
+        }
+        for (double value : squaredValues) {
+            variances.append(value / (n - 1));
+        }
+    }
+
+    // 特征向量的符号不唯一：约定绝对值最大的分量为正，结果可复现
+    for (int c = 0; c < k; ++c) {
+        double* column = result.loadings.data() + static_cast<qsizetype>(c) * p;
+        const double* largest = std::max_element(column, column + p, [](double a, double b) {
+            return std::abs(a) < std::abs(b);
+        });
+        if (*largest < 0.0) {
+            std::transform(column, column + p, column, [](double x) { return -x; });
+        }
+    }
+
+    double cumulative = 0.0;
+    for (double variance : variances) {
+        const double ratio = result.totalVariance > 0.0 ? variance / result.totalVariance : 0.0;
+        cumulative += ratio;
+        result.variances.append(variance);
+        result.explainedRatio.append(ratio);
+        result.cumulativeRatio.append(cumulative);
+    }
+
+    // === 得分（再扫描一遍数据）===
+    const int scoreCount = std::min(options.scoreComponents, k);
+    if (scoreCount > 0) {
+        const DenseMatrix scores = Z.multiply(result.loadings.block(0, 0, p, scoreCount));
+        for (int c = 0; c < scoreCount; ++c) {
+            QVector<double> column(source.rows, qQNaN());
+            for (qsizetype i = 0; i < scan.completeRows.size(); ++i) {
+                column[scan.completeRows[i]] = scores(i, c);
+            }
+            result.scores.append(column);
+        }
+    }
+
+    return result;
+}
+
+} // namespace
+
+PcaResult PrincipalComponents::compute(const Core::TableData& table, const QVector<int>& columns,
+                                       const PcaOptions& options)
+{
+    for (int column : columns) {
+        if (column < 0 || column >= table.columnCount()) {
+            return invalidResult(QString("列索引无效: %1").arg(column));
+        }
+    }
+
+    // 各遍扫描（随机化 SVD 还要多遍）都从一次性转换好的列优先矩阵读取
+    const DenseMatrix data = columns.isEmpty() ? DenseMatrix()
+                                               : DenseMatrix::fromTable(table, columns, MatrixLayout::ColumnMajor);
+
+    Source source;
+    source.variables = columns.size();
+    source.rows = table.rowCount();
+    source.reader = matrixColumnReader(data);
+
+    PcaResult result = computeSource(source, options);
+    if (result.isValid) {
+        result.columns = columns;
+        for (int column : columns) {
+            result.names.append(table.header(column));
+        }
+    }
+    return result;
+}
+
+PcaResult PrincipalComponents::compute(const QVector<QVector<double>>& columns, const QStringList& names,
+                                       const PcaOptions& options)
+{
+    const qsizetype n = columns.isEmpty() ? 0 : columns.first().size();
+    for (const auto& column : columns) {
+        if (column.size() != n) {
+            return invalidResult("各列数据长度不一致");
+        }
+    }
+
+    Source source;
+    source.variables = columns.size();
+    source.rows = n;
+    source.reader = vectorColumnReader(columns);
+
+    PcaResult result = computeSource(source, options);
+    if (result.isValid) {
+        for (int i = 0; i < columns.size(); ++i) {
+            result.columns.append(i);
+            result.names.append(i < names.size() ? names[i] : QString("x%1").arg(i + 1));
+        }
+    }
+    return result;
+}
+
+QString PrincipalComponents::methodName(PcaMethod method)
+{
+    switch (method) {
+    case PcaMethod::Auto:
+        return "自动";
+    case PcaMethod::Eigen:
+        return "特征分解";
+    case PcaMethod::Randomized:
+        return "随机化 SVD";
+    }
+    return QString();
+}
+
+} // namespace Statistics
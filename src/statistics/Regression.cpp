@@ -0,0 +1,1048 @@
+#include "Regression.h"
+#include "ColumnReader.h"
+#include "Distributions.h"
+#include "Factorizations.h"
+#include "ParallelUtils.h"
+#include "SparseMatrix.h"
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+
+namespace Statistics {
+
+namespace {
+
+// 每个行块读入的行数（50 列左右时约 3 MB，留在缓存中完成叉积/约化）
+const qsizetype PANEL_ROWS = 8192;
+
+// 自动模式下 Cholesky 可接受的条件数估计上限（正规方程的条件数为其平方）
+const double CHOLESKY_CONDITION_LIMIT = 1e4;
+
+// 缩放后 R 的对角元低于该值视为自变量共线
+const double RANK_TOLERANCE = 1e-11;
+
+// 稀疏设计矩阵：缩放后正规方程的倒数条件数低于该值视为共线
+const double SPARSE_RCOND_LIMIT = 1e-14;
+
+// 读取器的列 0..p-1 为自变量，列 p 为因变量
+struct Source
+{
+    int predictors = 0;
+    qsizetype rows = 0;
+    ColumnReader reader;
+};
+
+/**
+ * @brief 列优先的行块缓冲区（列间距 PANEL_ROWS）
+ */
+struct Panel
+{
+    int columns = 0;
+    qsizetype rows = 0;
+    QVector<double> values;
+    QVector<char> valid;
+
+    void reserve(int q)
+    {
+        columns = q;
+        values.resize(PANEL_ROWS * q);
+        valid.resize(PANEL_ROWS);
+    }
+
+    double* column(int c) { return values.data() + c * PANEL_ROWS; }
+    const double* column(int c) const { return values.constData() + c * PANEL_ROWS; }
+};
+
+/**
+ * @brief 读入 [begin, end) 行，只保留各列均有效的行（紧凑存放）
+ */
+void loadComplete(const Source& source, qsizetype begin, qsizetype end, Panel& panel)
+{
+    const qsizetype len = end - begin;
+    char* valid = panel.valid.data();
+    std::fill(valid, valid + len, 1);
+
+    for (int c = 0; c < panel.columns; ++c) {
+        double* x = panel.column(c);
+        source.reader(c, begin, end, x);
+        for (qsizetype r = 0; r < len; ++r) {
+            valid[r] &= static_cast<char>(std::isfinite(x[r]));
+        }
+    }
+
+    qsizetype kept = 0;
+    for (int c = 0; c < panel.columns; ++c) {
+        double* x = panel.column(c);
+        kept = 0;
+        for (qsizetype r = 0; r < len; ++r) {
+            if (valid[r]) {
+                x[kept++] = x[r];
+            }
+        }
+    }
+    panel.rows = kept;
+}
+
+double dot(const double* a, const double* b, qsizetype len)
+{
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    qsizetype r = 0;
+    for (; r + 4 <= len; r += 4) {
+        s0 += a[r] * b[r];
+        s1 += a[r + 1] * b[r + 1];
+        s2 += a[r + 2] * b[r + 2];
+        s3 += a[r + 3] * b[r + 3];
+    }
+    for (; r < len; ++r) {
+        s0 += a[r] * b[r];
+    }
+    return (s0 + s1) + (s2 + s3);
+}
+
+/**
+ * @brief 4×4 寄存器分块的列内积（16 个独立累加器）
+ */
+void kernel4x4(const double* const a[4], const double* const b[4], qsizetype len, double acc[4][4])
+{
+    double c[4][4] = {};
+    for (qsizetype r = 0; r < len; ++r) {
+        double av[4] = {a[0][r], a[1][r], a[2][r], a[3][r]};
+        double bv[4] = {b[0][r], b[1][r], b[2][r], b[3][r]};
+        for (int i = 0; i < 4; ++i) {
+            for (int j = 0; j < 4; ++j) {
+                c[i][j] += av[i] * bv[j];
+            }
+        }
+    }
+
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            acc[i][j] = c[i][j];
+        }
+    }
+}
+
+/**
+ * @brief 行数、均值与中心化叉积矩阵（q×q 行优先，仅上三角有效）
+ */
+struct Moments
+{
+    int q = 0;
+    qint64 n = 0;
+    QVector<double> mean;
+    QVector<double> comoment;
+
+    void init(int columns)
+    {
+        q = columns;
+        n = 0;
+        mean.fill(0.0, q);
+        comoment.fill(0.0, q * q);
+    }
+
+    /**
+     * @brief Chan 合并：C = Ca + Cb + δδᵀ·na·nb/n
+     */
+    void merge(const Moments& other)
+    {
+        if (other.n == 0) {
+            return;
+        }
+        if (n == 0) {
+            *this = other;
+            return;
+        }
+
+        const double total = static_cast<double>(n + other.n);
+        const double weight = static_cast<double>(n) * other.n / total;
+        QVector<double> delta(q);
+        for (int i = 0; i < q; ++i) {
+            delta[i] = other.mean[i] - mean[i];
+        }
+        for (int i = 0; i < q; ++i) {
+            for (int j = i; j < q; ++j) {
+                comoment[i * q + j] += other.comoment[i * q + j] + delta[i] * delta[j] * weight;
+            }
+            mean[i] += delta[i] * other.n / total;
+        }
+        n += other.n;
+    }
+};
+
+/**
+ * @brief 单个行块的矩（就地中心化后计算各列对的内积）
+ */
+Moments panelMoments(Panel& panel)
+{
+    const int q = panel.columns;
+    const qsizetype m = panel.rows;
+    Moments moments;
+    moments.init(q);
+    moments.n = m;
+    if (m == 0) {
+        return moments;
+    }
+
+    for (int c = 0; c < q; ++c) {
+        double* x = panel.column(c);
+        double sum = 0.0;
+        for (qsizetype r = 0; r < m; ++r) {
+            sum += x[r];
+        }
+        double mean = sum / m;
+        for (qsizetype r = 0; r < m; ++r) {
+            x[r] -= mean;
+        }
+        moments.mean[c] = mean;
+    }
+
+    double* C = moments.comoment.data();
+    for (int a = 0; a < q; a += 4) {
+        int aCount = std::min(4, q - a);
+        for (int b = a; b < q; b += 4) {
+            int bCount = std::min(4, q - b);
+
+            if (aCount == 4 && bCount == 4) {
+                const double* aPtr[4];
+                const double* bPtr[4];
+                for (int k = 0; k < 4; ++k) {
+                    aPtr[k] = panel.column(a + k);
+                    bPtr[k] = panel.column(b + k);
+                }
+                double acc[4][4];
+                kernel4x4(aPtr, bPtr, m, acc);
+                for (int i = 0; i < 4; ++i) {
+                    for (int j = 0; j < 4; ++j) {
+                        if (a + i <= b + j) {
+                            C[(a + i) * q + b + j] = acc[i][j];
+                        }
+                    }
+                }
+                continue;
+            }
+
+            for (int i = a; i < a + aCount; ++i) {
+                for (int j = std::max(b, i); j < b + bCount; ++j) {
+                    C[i * q + j] = dot(panel.column(i), panel.column(j), m);
+                }
+            }
+        }
+    }
+    return moments;
+}
+
+/**
+ * @brief 把行块叠放到上三角因子 R（q×q 行优先）之下并做 Householder 约化
+ *
+ * 第 j 步的反射向量只涉及 R 的第 j 行与行块的第 j 列，行块的第 j 列
+ * 就地存放反射向量（约化后不再需要）。
+ */
+void reduceInto(QVector<double>& R, Panel& panel)
+{
+    const int q = panel.columns;
+    const qsizetype m = panel.rows;
+    if (m == 0) {
+        return;
+    }
+
+    for (int j = 0; j < q; ++j) {
+        double* v = panel.column(j);
+        double normSq = dot(v, v, m);
+        if (normSq == 0.0) {
+            continue;
+        }
+
+        double alpha = R[j * q + j];
+        double norm = std::sqrt(alpha * alpha + normSq);
+        double beta = alpha > 0.0 ? -norm : norm;
+        double scale = 1.0 / (alpha - beta);
+        for (qsizetype r = 0; r < m; ++r) {
+            v[r] *= scale;
+        }
+        double tau = (beta - alpha) / beta;
+        R[j * q + j] = beta;
+
+        for (int k = j + 1; k < q; ++k) {
+            double* x = panel.column(k);
+            double s = tau * (R[j * q + k] + dot(v, x, m));
+            R[j * q + k] -= s;
+            for (qsizetype r = 0; r < m; ++r) {
+                x[r] -= s * v[r];
+            }
+        }
+    }
+}
+
+/**
+ * @brief 上三角因子：R b = z，残差平方和 sse
+ */
+struct Factor
+{
+    int p = 0;
+    QVector<double> R;          // p×p 行优先
+    QVector<double> z;
+    double sse = 0.0;
+    double condition = 0.0;     // 按列缩放后对角元的最大/最小比
+    bool isValid = false;
+    QString errorMessage;
+};
+
+/**
+ * @brief 对按列缩放的正规方程做 Cholesky 分解
+ * @param A 自变量叉积矩阵（p×p 上三角），b 为与因变量的叉积，yy 为因变量平方和
+ */
+Factor choleskyFactor(const QVector<double>& A, const QVector<double>& b, double yy, int p)
+{
+    Factor factor;
+    factor.p = p;
+
+    QVector<double> d(p);
+    for (int j = 0; j < p; ++j) {
+        d[j] = A[j * p + j];
+        if (!(d[j] > 0.0)) {
+            factor.errorMessage = "存在取值恒定的自变量";
+            return factor;
+        }
+        d[j] = std::sqrt(d[j]);
+    }
+
+    // U 为缩放矩阵 D⁻¹AD⁻¹ 的上三角因子
+    QVector<double> U(p * p, 0.0);
+    double minPivot = 1.0, maxPivot = 0.0;
+    for (int j = 0; j < p; ++j) {
+        double diag = A[j * p + j] / (d[j] * d[j]);
+        for (int k = 0; k < j; ++k) {
+            diag -= U[k * p + j] * U[k * p + j];
+        }
+        if (!(diag > RANK_TOLERANCE * RANK_TOLERANCE)) {
+            factor.errorMessage = "正规方程矩阵奇异或接近奇异";
+            return factor;
+        }
+        double pivot = std::sqrt(diag);
+        U[j * p + j] = pivot;
+        minPivot = std::min(minPivot, pivot);
+        maxPivot = std::max(maxPivot, pivot);
+
+        for (int i = j + 1; i < p; ++i) {
+            double value = A[j * p + i] / (d[j] * d[i]);
+            for (int k = 0; k < j; ++k) {
+                value -= U[k * p + j] * U[k * p + i];
+            }
+            U[j * p + i] = value / pivot;
+        }
+    }
+
+    // R = U·D，RᵀR = A
+    factor.R.fill(0.0, p * p);
+    for (int i = 0; i < p; ++i) {
+        for (int j = i; j < p; ++j) {
+            factor.R[i * p + j] = U[i * p + j] * d[j];
+        }
+    }
+
+    // 前代 Rᵀz = b
+    factor.z.resize(p);
+    double zz = 0.0;
+    for (int i = 0; i < p; ++i) {
+        double value = b[i];
+        for (int k = 0; k < i; ++k) {
+            value -= factor.R[k * p + i] * factor.z[k];
+        }
+        factor.z[i] = value / factor.R[i * p + i];
+        zz += factor.z[i] * factor.z[i];
+    }
+
+    factor.sse = std::max(0.0, yy - zz);
+    factor.condition = maxPivot / minPivot;
+    factor.isValid = true;
+    return factor;
+}
+
+/**
+ * @brief 从增广因子 [X y] 的 R（q×q）取出自变量部分并检查秩
+ */
+Factor qrFactor(const QVector<double>& augmented, int p)
+{
+    const int q = p + 1;
+    Factor factor;
+    factor.p = p;
+    factor.R.fill(0.0, p * p);
+    factor.z.resize(p);
+
+    double minRatio = 1.0, maxRatio = 0.0;
+    for (int j = 0; j < p; ++j) {
+        double columnNormSq = 0.0;
+        for (int i = 0; i <= j; ++i) {
+            factor.R[i * p + j] = augmented[i * q + j];
+            columnNormSq += augmented[i * q + j] * augmented[i * q + j];
+        }
+        factor.z[j] = augmented[j * q + p];
+
+        double ratio = columnNormSq > 0.0 ? std::fabs(augmented[j * q + j]) / std::sqrt(columnNormSq) : 0.0;
+        if (ratio < RANK_TOLERANCE) {
+            factor.errorMessage = columnNormSq > 0.0 ? "自变量之间存在完全共线性" : "存在取值恒定的自变量";
+            return factor;
+        }
+        minRatio = std::min(minRatio, ratio);
+        maxRatio = std::max(maxRatio, ratio);
+    }
+
+    double last = augmented[p * q + p];
+    factor.sse = last * last;
+    factor.condition = maxRatio / minRatio;
+    factor.isValid = true;
+    return factor;
+}
+
+/**
+ * @brief 行块的切分（各段独立累加，按段顺序合并）
+ */
+int panelCount(qsizetype rows)
+{
+    return static_cast<int>((rows + PANEL_ROWS - 1) / PANEL_ROWS);
+}
+
+Moments accumulateMoments(const Source& source)
+{
+    const int q = source.predictors + 1;
+    const int panels = panelCount(source.rows);
+    const int splits = Parallel::chunkCount(panels, 1);
+
+    QVector<Moments> partials(splits);
+    Parallel::forEach(splits, [&](int split) {
+        Moments& moments = partials[split];
+        moments.init(q);
+        Panel panel;
+        panel.reserve(q);
+
+        qsizetype splitBegin = Parallel::chunkBegin(panels, splits, split) * PANEL_ROWS;
+        qsizetype splitEnd = std::min(source.rows, Parallel::chunkBegin(panels, splits, split + 1) * PANEL_ROWS);
+        for (qsizetype begin = splitBegin; begin < splitEnd; begin += PANEL_ROWS) {
+            loadComplete(source, begin, std::min(splitEnd, begin + PANEL_ROWS), panel);
+            moments.merge(panelMoments(panel));
+        }
+    });
+
+    for (int split = 1; split < splits; ++split) {
+        partials[0].merge(partials[split]);
+    }
+    return partials[0];
+}
+
+/**
+ * @brief 分段 TSQR：各段把自己的行块约化为一个 R，再依次合并各段的 R
+ */
+QVector<double> accumulateQR(const Source& source, const QVector<double>& centers)
+{
+    const int q = source.predictors + 1;
+    const int panels = panelCount(source.rows);
+    const int splits = Parallel::chunkCount(panels, 1);
+
+    QVector<QVector<double>> partials(splits);
+    Parallel::forEach(splits, [&](int split) {
+        QVector<double>& R = partials[split];
+        R.fill(0.0, q * q);
+        Panel panel;
+        panel.reserve(q);
+
+        qsizetype splitBegin = Parallel::chunkBegin(panels, splits, split) * PANEL_ROWS;
+        qsizetype splitEnd = std::min(source.rows, Parallel::chunkBegin(panels, splits, split + 1) * PANEL_ROWS);
+        for (qsizetype begin = splitBegin; begin < splitEnd; begin += PANEL_ROWS) {
+            loadComplete(source, begin, std::min(splitEnd, begin + PANEL_ROWS), panel);
+            for (int c = 0; c < q; ++c) {
+                double* x = panel.column(c);
+                for (qsizetype r = 0; r < panel.rows; ++r) {
+                    x[r] -= centers[c];
+                }
+            }
+            reduceInto(R, panel);
+        }
+    });
+
+    Panel stacked;
+    stacked.reserve(q);
+    stacked.rows = q;
+    for (int split = 1; split < splits; ++split) {
+        for (int c = 0; c < q; ++c) {
+            double* x = stacked.column(c);
+            for (int r = 0; r < q; ++r) {
+                x[r] = partials[split][r * q + c];
+            }
+        }
+        reduceInto(partials[0], stacked);
+    }
+    return partials[0];
+}
+
+/**
+ * @brief 逐行残差（被剔除的行为 NaN），返回残差平方和
+ */
+double computeResiduals(const Source& source, const QVector<double>& slopes, double intercept,
+                        QVector<double>& residuals)
+{
+    const int p = source.predictors;
+    const int panels = panelCount(source.rows);
+    const int splits = Parallel::chunkCount(panels, 1);
+    residuals.resize(source.rows);
+
+    QVector<double> partialSse(splits, 0.0);
+    Parallel::forEach(splits, [&](int split) {
+        Panel panel;
+        panel.reserve(p + 1);
+        QVector<double> fitted(PANEL_ROWS);
+
+        qsizetype splitBegin = Parallel::chunkBegin(panels, splits, split) * PANEL_ROWS;
+        qsizetype splitEnd = std::min(source.rows, Parallel::chunkBegin(panels, splits, split + 1) * PANEL_ROWS);
+        for (qsizetype begin = splitBegin; begin < splitEnd; begin += PANEL_ROWS) {
+            qsizetype len = std::min(splitEnd, begin + PANEL_ROWS) - begin;
+            std::fill(fitted.begin(), fitted.begin() + len, intercept);
+            for (int c = 0; c < p; ++c) {
+                double* x = panel.column(c);
+                source.reader(c, begin, begin + len, x);
+                for (qsizetype r = 0; r < len; ++r) {
+                    fitted[r] += slopes[c] * x[r];
+                }
+            }
+
+            double* y = panel.column(p);
+            source.reader(p, begin, begin + len, y);
+            double* out = residuals.data() + begin;
+            for (qsizetype r = 0; r < len; ++r) {
+                double e = y[r] - fitted[r];
+                out[r] = std::isfinite(e) ? e : qQNaN();
+                if (std::isfinite(e)) {
+                    partialSse[split] += e * e;
+                }
+            }
+        }
+    });
+
+    double sse = 0.0;
+    for (double value : partialSse) {
+        sse += value;
+    }
+    return sse;
+}
+
+RegressionResult invalidResult(const QString& message)
+{
+    RegressionResult result;
+    result.isValid = false;
+    result.errorMessage = message;
+    return result;
+}
+
+/**
+ * @brief 由系数与标准误补全 t 值、p 值与拟合优度统计量
+ * @param slopes 除截距外的参数个数
+ * @param total 总平方和（有截距时为中心化的）
+ */
+void fillStatistics(RegressionResult& result, qint64 n, int slopes, double sse, double total)
+{
+    const int df = static_cast<int>(n - result.coefficients.size());
+    const double sigma2 = df > 0 ? sse / df : qQNaN();
+
+    for (int i = 0; i < result.coefficients.size(); ++i) {
+        double t = result.coefficients[i] / result.standardErrors[i];
+        result.tValues.append(t);
+        result.pValues.append(std::isfinite(t) ? 2.0 * Distributions::studentTCdf(-std::fabs(t), df)
+                                               : (std::isnan(t) ? qQNaN() : 0.0));
+    }
+
+    result.observations = n;
+    result.degreesOfFreedom = df;
+    result.sse = sse;
+    result.rSquared = total > 0.0 ? 1.0 - sse / total : 1.0;
+    result.adjustedRSquared = df > 0 ? 1.0 - (1.0 - result.rSquared) * (n - (result.intercept ? 1 : 0)) / df : qQNaN();
+    result.residualStdError = std::sqrt(sigma2);
+
+    double explained = std::max(0.0, total - sse);
+    if (df == 0) {
+        result.fStatistic = qQNaN();
+        result.fPValue = qQNaN();
+    } else if (sse > 0.0) {
+        result.fStatistic = (explained / slopes) / sigma2;
+        result.fPValue = Distributions::incompleteBeta(df / 2.0, slopes / 2.0, df / (df + slopes * result.fStatistic));
+    } else {
+        result.fStatistic = qInf();
+        result.fPValue = 0.0;
+    }
+}
+
+RegressionResult fitSource(const Source& source, const QStringList& predictorNames,
+                           const RegressionOptions& options)
+{
+    const int p = source.predictors;
+    const int q = p + 1;
+    const bool intercept = options.intercept;
+
+    if (p < 1) {
+        return invalidResult("至少需要一个自变量");
+    }
+
+    // === 第一遍：行数、均值与中心化叉积 ===
+    Moments moments = accumulateMoments(source);
+    const qint64 n = moments.n;
+    const int parameters = p + (intercept ? 1 : 0);
+    if (n < parameters) {
+        return invalidResult(QString("有效行数不足：至少需要 %1 行，实际 %2 行").arg(parameters).arg(n));
+    }
+
+    // 无截距时使用原点矩：XᵀX = C + n·x̄x̄ᵀ
+    QVector<double> A(p * p, 0.0);
+    QVector<double> b(p);
+    for (int i = 0; i < p; ++i) {
+        for (int j = i; j < p; ++j) {
+            A[i * p + j] = moments.comoment[i * q + j];
+            if (!intercept) {
+                A[i * p + j] += n * moments.mean[i] * moments.mean[j];
+            }
+        }
+        b[i] = moments.comoment[i * q + p] + (intercept ? 0.0 : n * moments.mean[i] * moments.mean[p]);
+    }
+    const double syy = moments.comoment[p * q + p];
+    const double total = intercept ? syy : syy + n * moments.mean[p] * moments.mean[p];
+
+    // === 分解 ===
+    RegressionResult result;
+    result.intercept = intercept;
+    Factor factor;
+    if (options.solver != RegressionSolver::QR) {
+        factor = choleskyFactor(A, b, total, p);
+        result.solver = RegressionSolver::Cholesky;
+        bool accept = factor.isValid && (options.solver == RegressionSolver::Cholesky ||
+                                         factor.condition <= CHOLESKY_CONDITION_LIMIT);
+        if (!accept && options.solver == RegressionSolver::Cholesky) {
+            return invalidResult(factor.errorMessage);
+        }
+        if (!accept) {
+            factor.isValid = false;
+        }
+    }
+    if (!factor.isValid) {
+        QVector<double> centers(q, 0.0);
+        if (intercept) {
+            centers = moments.mean;
+        }
+        factor = qrFactor(accumulateQR(source, centers), p);
+        result.solver = RegressionSolver::QR;
+        if (!factor.isValid) {
+            return invalidResult(factor.errorMessage);
+        }
+    }
+
+    // === 回代 R·β = z，并求 R⁻¹（标准误需要 (XᵀX)⁻¹ = R⁻¹R⁻ᵀ 的对角元） ===
+    const QVector<double>& R = factor.R;
+    QVector<double> slopes(p);
+    for (int i = p - 1; i >= 0; --i) {
+        double value = factor.z[i];
+        for (int k = i + 1; k < p; ++k) {
+            value -= R[i * p + k] * slopes[k];
+        }
+        slopes[i] = value / R[i * p + i];
+    }
+
+    QVector<double> Rinv(p * p, 0.0);
+    for (int j = 0; j < p; ++j) {
+        Rinv[j * p + j] = 1.0 / R[j * p + j];
+        for (int i = j - 1; i >= 0; --i) {
+            double value = 0.0;
+            for (int k = i + 1; k <= j; ++k) {
+                value -= R[i * p + k] * Rinv[k * p + j];
+            }
+            Rinv[i * p + j] = value / R[i * p + i];
+        }
+    }
+
+    double interceptValue = 0.0;
+    if (intercept) {
+        interceptValue = moments.mean[p];
+        for (int j = 0; j < p; ++j) {
+            interceptValue -= slopes[j] * moments.mean[j];
+        }
+    }
+
+    // === 残差（需要时再扫描一遍，直接累加的残差平方和也更精确） ===
+    double sse = factor.sse;
+    if (options.keepResiduals) {
+        sse = computeResiduals(source, slopes, interceptValue, result.residuals);
+    }
+
+    // === 统计量 ===
+    // 行数恰好等于参数个数时为精确拟合，残差自由度为 0，标准误等统计量为 NaN
+    const int df = static_cast<int>(n - parameters);
+    const double sigma2 = df > 0 ? sse / df : qQNaN();
+
+    if (intercept) {
+        result.names.append("截距");
+        result.coefficients.append(interceptValue);
+
+        // Var(b0) = σ²·(1/n + x̄ᵀ(XᵀX)⁻¹x̄)，其中 x̄ᵀ(XᵀX)⁻¹x̄ = |R⁻ᵀx̄|²
+        double quadratic = 0.0;
+        for (int k = 0; k < p; ++k) {
+            double w = 0.0;
+            for (int j = 0; j <= k; ++j) {
+                w += Rinv[j * p + k] * moments.mean[j];
+            }
+            quadratic += w * w;
+        }
+        result.standardErrors.append(std::sqrt(sigma2 * (1.0 / n + quadratic)));
+    }
+    for (int j = 0; j < p; ++j) {
+        result.names.append(j < predictorNames.size() ? predictorNames[j] : QString("x%1").arg(j + 1));
+        result.coefficients.append(slopes[j]);
+
+        double diag = 0.0;
+        for (int k = j; k < p; ++k) {
+            diag += Rinv[j * p + k] * Rinv[j * p + k];
+        }
+        result.standardErrors.append(std::sqrt(sigma2 * diag));
+    }
+
+    fillStatistics(result, n, p, sse, total);
+    result.conditionEstimate = factor.condition;
+
+    return result;
+}
+
+/**
+ * @brief 稀疏设计矩阵的正规方程求解
+ * @param centers 各列在构造时减去的中心值，用于恢复原始尺度下的截距
+ *
+ * XᵀX 由稀疏叉积得到，有截距时在其前面加上全 1 列对应的行列
+ * （Xᵀ1 与 n）；按对角元缩放后做稠密 Cholesky 分解，(XᵀX)⁻¹ 用于标准误。
+ * y 或 X 中含 NaN 的行以权重 0 剔除。
+ */
+RegressionResult fitSparseSystem(const SparseMatrix& X, const QVector<double>& y, const QStringList& names,
+                                 const QVector<double>& centers, const RegressionOptions& options)
+{
+    const qsizetype rows = X.rows();
+    const int p = static_cast<int>(X.cols());
+    const bool intercept = options.intercept;
+    const int offset = intercept ? 1 : 0;
+    const int q = p + offset;
+
+    if (y.size() != rows) {
+        return invalidResult("各列数据长度不一致");
+    }
+    if (p < 1) {
+        return invalidResult("至少需要一个自变量");
+    }
+
+    // === 有效行（权重为 1）===
+    const SparseMatrix csr = X.toFormat(SparseFormat::CSR);
+    QVector<double> weights(rows, 0.0);
+    qint64 n = 0;
+    double ySum = 0.0;
+    for (qsizetype row = 0; row < rows; ++row) {
+        bool complete = std::isfinite(y[row]);
+        for (qsizetype k = csr.outerIndex()[row]; complete && k < csr.outerIndex()[row + 1]; ++k) {
+            complete = std::isfinite(csr.values()[k]);
+        }
+        if (complete) {
+            weights[row] = 1.0;
+            ySum += y[row];
+            ++n;
+        }
+    }
+    if (n < q) {
+        return invalidResult(QString("有效行数不足：至少需要 %1 行，实际 %2 行").arg(q).arg(n));
+    }
+
+    // === 正规方程（截距在前）===
+    DenseMatrix G(q, q, 0.0, MatrixLayout::ColumnMajor);
+    QVector<double> rhs(q, 0.0);
+    const SparseMatrix XtX = csr.gram(weights);
+    for (qsizetype j = 0; j < p; ++j) {
+        for (qsizetype k = XtX.outerIndex()[j]; k < XtX.outerIndex()[j + 1]; ++k) {
+            G(offset + XtX.innerIndex()[k], offset + j) = XtX.values()[k];
+        }
+    }
+    // Xᵀy 与各列之和（即 Xᵀ1）直接按行累加，跳过剔除的行
+    QVector<double> columnSums(p, 0.0);
+    for (qsizetype row = 0; row < rows; ++row) {
+        if (weights[row] == 0.0) {
+            continue;
+        }
+        for (qsizetype k = csr.outerIndex()[row]; k < csr.outerIndex()[row + 1]; ++k) {
+            const int j = csr.innerIndex()[k];
+            rhs[offset + j] += csr.values()[k] * y[row];
+            columnSums[j] += csr.values()[k];
+        }
+    }
+    if (intercept) {
+        G(0, 0) = static_cast<double>(n);
+        for (int j = 0; j < p; ++j) {
+            G(0, offset + j) = columnSums[j];
+            G(offset + j, 0) = columnSums[j];
+        }
+        rhs[0] = ySum;
+    }
+
+    // 按对角元缩放，使各列的尺度一致
+    QVector<double> scale(q);
+    for (int j = 0; j < q; ++j) {
+        if (!(G(j, j) > 0.0)) {
+            return invalidResult(QString("自变量 %1 在有效行中全为 0").arg(names.value(j - offset, "截距")));
+        }
+        scale[j] = 1.0 / std::sqrt(G(j, j));
+    }
+    for (int j = 0; j < q; ++j) {
+        for (int i = 0; i < q; ++i) {
+            G(i, j) *= scale[i] * scale[j];
+        }
+        rhs[j] *= scale[j];
+    }
+
+    CholeskyDecomposition cholesky(G);
+    const double rcond = cholesky.isValid() ? cholesky.reciprocalCondition() : 0.0;
+    if (!cholesky.isValid() || rcond < SPARSE_RCOND_LIMIT) {
+        return invalidResult("自变量共线（设计矩阵列不满秩）");
+    }
+
+    QVector<double> beta = cholesky.solve(rhs);
+    for (int j = 0; j < q; ++j) {
+        beta[j] *= scale[j];
+    }
+    DenseMatrix inverse = *cholesky.inverse();
+
+    // === 残差（一次稀疏矩阵乘向量）===
+    const QVector<double> slopes(beta.constBegin() + offset, beta.constEnd());
+    const QVector<double> fitted = csr.multiply(slopes);
+    const double b0 = intercept ? beta[0] : 0.0;
+    const double yMean = ySum / n;
+
+    RegressionResult result;
+    result.intercept = intercept;
+    result.solver = RegressionSolver::Cholesky;
+
+    double sse = 0.0;
+    double total = 0.0;
+    if (options.keepResiduals) {
+        result.residuals.fill(qQNaN(), rows);
+    }
+    for (qsizetype row = 0; row < rows; ++row) {
+        if (weights[row] == 0.0) {
+            continue;
+        }
+        const double e = y[row] - b0 - fitted[row];
+        sse += e * e;
+        const double d = intercept ? y[row] - yMean : y[row];
+        total += d * d;
+        if (options.keepResiduals) {
+            result.residuals[row] = e;
+        }
+    }
+
+    // === 系数与标准误：Cov(β) = σ²·S·(SGS)⁻¹·S ===
+    const int df = static_cast<int>(n - q);
+    const double sigma2 = df > 0 ? sse / df : qQNaN();
+    auto covariance = [&](int i, int j) { return sigma2 * scale[i] * scale[j] * inverse(i, j); };
+
+    if (intercept) {
+        // 原始尺度的截距 b0 - Σ c_j·β_j，方差为 aᵀ·Cov·a，a = (1, -c)
+        QVector<double> a(q, 0.0);
+        a[0] = 1.0;
+        double value = b0;
+        for (int j = 0; j < p; ++j) {
+            const double center = centers.value(j, 0.0);
+            a[offset + j] = -center;
+            value -= center * slopes[j];
+        }
+        double variance = 0.0;
+        for (int i = 0; i < q; ++i) {
+            if (a[i] == 0.0) {
+                continue;
+            }
+            for (int j = 0; j < q; ++j) {
+                variance += a[i] * a[j] * covariance(i, j);
+            }
+        }
+        result.names.append("截距");
+        result.coefficients.append(value);
+        result.standardErrors.append(std::sqrt(variance));
+    }
+    for (int j = 0; j < p; ++j) {
+        result.names.append(j < names.size() ? names[j] : QString("x%1").arg(j + 1));
+        result.coefficients.append(slopes[j]);
+        result.standardErrors.append(std::sqrt(covariance(offset + j, offset + j)));
+    }
+
+    fillStatistics(result, n, p, sse, total);
+    result.conditionEstimate = 1.0 / std::sqrt(rcond);
+    return result;
+}
+
+} // namespace
+
+RegressionResult Regression::fit(const Core::TableData& table, int response, const QVector<int>& predictors,
+                                 const RegressionOptions& options)
+{
+    QVector<int> columns = predictors;
+    columns.append(response);
+    for (int column : columns) {
+        if (column < 0 || column >= table.columnCount()) {
+            return invalidResult(QString("列索引无效: %1").arg(column));
+        }
+    }
+    if (predictors.contains(response)) {
+        return invalidResult("因变量不能同时作为自变量");
+    }
+
+    Source source;
+    source.predictors = predictors.size();
+    source.rows = table.rowCount();
+    source.reader = tableColumnReader(table, columns);
+
+    QStringList names;
+    for (int column : predictors) {
+        names.append(table.header(column));
+    }
+    return fitSource(source, names, options);
+}
+
+RegressionResult Regression::fit(const QVector<double>& y, const QVector<QVector<double>>& predictors,
+                                 const QStringList& names, const RegressionOptions& options)
+{
+    for (const auto& column : predictors) {
+        if (column.size() != y.size()) {
+            return invalidResult("各列数据长度不一致");
+        }
+    }
+
+    Source source;
+    source.predictors = predictors.size();
+    source.rows = y.size();
+    source.reader = [&y, &predictors](int column, qsizetype begin, qsizetype end, double* out) {
+        const QVector<double>& data = column < predictors.size() ? predictors[column] : y;
+        std::copy(data.constBegin() + begin, data.constBegin() + end, out);
+    };
+    return fitSource(source, names, options);
+}
+
+RegressionResult Regression::fit(const Core::TableData& table, int response, const QVector<int>& predictors,
+                                 const QVector<int>& categoricalPredictors, const RegressionOptions& options)
+{
+    if (predictors.contains(response) || categoricalPredictors.contains(response)) {
+        return invalidResult("因变量不能同时作为自变量");
+    }
+
+    // 有截距时每个分类变量省略第一个类别，数值列中心化以改善条件数
+    SparseDesignOptions designOptions;
+    designOptions.responseColumn = response;
+    designOptions.dropFirstLevel = options.intercept;
+    designOptions.centerNumeric = options.intercept;
+
+    SparseDesign design = SparseDesign::build(table, predictors, categoricalPredictors, designOptions);
+    if (!design.isValid) {
+        return invalidResult(design.errorMessage);
+    }
+
+    RegressionResult result = fitSparseSystem(design.matrix, design.response, design.names, design.centers, options);
+    if (result.isValid && options.keepResiduals) {
+        QVector<double> residuals(table.rowCount(), qQNaN());
+        for (qsizetype i = 0; i < design.sourceRows.size(); ++i) {
+            residuals[design.sourceRows[i]] = result.residuals[i];
+        }
+        result.residuals = residuals;
+    }
+    return result;
+}
+
+RegressionResult Regression::fitSparse(const SparseMatrix& X, const QVector<double>& y, const QStringList& names,
+                                       const RegressionOptions& options)
+{
+    return fitSparseSystem(X, y, names, QVector<double>(X.cols(), 0.0), options);
+}
+
+RegressionResult Regression::polynomial(const QVector<double>& x, const QVector<double>& y, int degree,
+                                        const RegressionOptions& options)
+{
+    if (x.size() != y.size()) {
+        return invalidResult("各列数据长度不一致");
+    }
+    if (degree < 1) {
+        return invalidResult("多项式阶数至少为 1");
+    }
+
+    // 第 k 列为 x^(k+1)，按需计算，不保存各次幂的副本
+    Source source;
+    source.predictors = degree;
+    source.rows = x.size();
+    source.reader = [&x, &y, degree](int column, qsizetype begin, qsizetype end, double* out) {
+        if (column == degree) {
+            std::copy(y.constBegin() + begin, y.constBegin() + end, out);
+            return;
+        }
+        for (qsizetype i = begin; i < end; ++i) {
+            double value = x[i];
+            double power = value;
+            for (int k = 0; k < column; ++k) {
+                power *= value;
+            }
+            *out++ = power;
+        }
+    };
+
+    QStringList names;
+    for (int k = 1; k <= degree; ++k) {
+        names.append(k == 1 ? QString("x") : QString("x^%1").arg(k));
+    }
+    return fitSource(source, names, options);
+}
+
+RegressionResult Regression::polynomial(const Core::TableData& table, int xColumn, int yColumn, int degree,
+                                        const RegressionOptions& options)
+{
+    if (xColumn < 0 || xColumn >= table.columnCount() || yColumn < 0 || yColumn >= table.columnCount()) {
+        return invalidResult("列索引无效");
+    }
+
+    QVector<double> x(table.rowCount());
+    QVector<double> y(table.rowCount());
+    Parallel::forChunks(table.rowCount(), Parallel::chunkCount(table.rowCount(), PANEL_ROWS),
+                        [&](int, qsizetype begin, qsizetype end) {
+        for (qsizetype row = begin; row < end; ++row) {
+            x[row] = cellToDouble(table.at(static_cast<int>(row), xColumn));
+            y[row] = cellToDouble(table.at(static_cast<int>(row), yColumn));
+        }
+    });
+
+    RegressionResult result = polynomial(x, y, degree, options);
+    const QString name = table.header(xColumn);
+    const int offset = result.intercept ? 1 : 0;
+    for (int k = 1; k <= degree && offset + k - 1 < result.names.size(); ++k) {
+        result.names[offset + k - 1] = k == 1 ? name : QString("%1^%2").arg(name).arg(k);
+    }
+    return result;
+}
+
+double Regression::predict(const RegressionResult& result, const QVector<double>& values)
+{
+    if (!result.isValid) {
+        return qQNaN();
+    }
+
+    const int offset = result.intercept ? 1 : 0;
+    if (values.size() != result.coefficients.size() - offset) {
+        return qQNaN();
+    }
+
+    double value = result.intercept ? result.coefficients[0] : 0.0;
+    for (int j = 0; j < values.size(); ++j) {
+        value += result.coefficients[offset + j] * values[j];
+    }
+    return value;
+}
+
+QString Regression::solverName(RegressionSolver solver)
+{
+    switch (solver) {
+    case RegressionSolver::Auto:     return "自动";
+    case RegressionSolver::Cholesky: return "Cholesky（正规方程）";
+    case RegressionSolver::QR:       return "Householder QR";
+    }
+    return QString();
+}
+
+} // namespace Statistics
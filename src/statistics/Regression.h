@@ -0,0 +1,135 @@
+#ifndef REGRESSION_H
+#define REGRESSION_H
+
+#include "core/TableData.h"
+#include <QVector>
+#include <QString>
+#include <QStringList>
+
+namespace Statistics {
+
+class SparseMatrix;
+
+/**
+ * @brief 最小二乘求解方式
+ */
+enum class RegressionSolver
+{
+    Auto,           // 先用 Cholesky，矩阵病态或奇异时改用 QR
+    Cholesky,       // 正规方程 + Cholesky 分解（只需一遍扫描）
+    QR              // Householder QR（分块 TSQR，数值更稳定）
+};
+
+/**
+ * @brief 回归参数
+ */
+struct RegressionOptions
+{
+    bool intercept = true;                          // 是否包含截距项
+    RegressionSolver solver = RegressionSolver::Auto;
+    bool keepResiduals = true;                      // 是否输出逐行残差（额外扫描一遍数据）
+};
+
+/**
+ * @brief 回归结果
+ *
+ * 系数、标准误、t 值与 p 值按 names 的顺序排列（有截距时第一项为截距）。
+ */
+struct RegressionResult
+{
+    QStringList names;
+    QVector<double> coefficients;
+    QVector<double> standardErrors;
+    QVector<double> tValues;
+    QVector<double> pValues;
+
+    qint64 observations = 0;            // 参与拟合的行数（含 NaN 的行整行剔除）
+    int degreesOfFreedom = 0;           // 残差自由度
+    double sse = 0.0;                   // 残差平方和
+    double rSquared = 0.0;
+    double adjustedRSquared = 0.0;
+    double residualStdError = 0.0;
+    double fStatistic = 0.0;            // 整体显著性检验（除截距外的系数全为 0）
+    double fPValue = 1.0;
+    double conditionEstimate = 0.0;     // 按列缩放后的条件数估计（R 对角元之比）
+
+    QVector<double> residuals;          // 与输入行一一对应，被剔除的行为 NaN
+    bool intercept = true;
+    RegressionSolver solver = RegressionSolver::Auto;   // 实际使用的求解方式
+
+    bool isValid = true;
+    QString errorMessage;
+};
+
+/**
+ * @brief 多元线性回归与多项式回归
+ *
+ * 数据按行块流式读入列优先的连续缓冲区，不需要把整个设计矩阵放进内存：
+ * - Cholesky：各行块并行计算中心化的叉积矩阵 [X y]ᵀ[X y]，按块合并
+ *   （Chan 合并公式，避免原点矩相减的抵消误差），再对按列缩放后的
+ *   正规方程做 Cholesky 分解
+ * - QR：各行块依次与当前的上三角因子 R 叠放做 Householder 约化（TSQR），
+ *   各段的 R 最后再合并；不形成 XᵀX，条件数不会被平方
+ * 自动模式下若 Cholesky 失败或条件数估计过大，改用 QR 重新扫描。
+ *
+ * 有截距时在中心化数据上求解，截距由均值恢复。
+ */
+class Regression
+{
+public:
+    /**
+     * @brief 对表格中的若干列做多元线性回归
+     * @param response 因变量列
+     * @param predictors 自变量列
+     */
+    static RegressionResult fit(const Core::TableData& table, int response, const QVector<int>& predictors,
+                                const RegressionOptions& options = RegressionOptions());
+
+    /**
+     * @brief 对数据列做多元线性回归（各列长度须相同，NaN 表示缺失）
+     */
+    static RegressionResult fit(const QVector<double>& y, const QVector<QVector<double>>& predictors,
+                                const QStringList& names, const RegressionOptions& options = RegressionOptions());
+
+    /**
+     * @brief 含分类自变量的多元回归
+     * @param predictors 数值自变量列
+     * @param categoricalPredictors 分类自变量列（独热编码；有截距时第一个类别为参照水平）
+     *
+     * 设计矩阵以稀疏格式构造（SparseDesign），数千个哑变量、数百万行也只需
+     * 按非零元个数占用内存。正规方程由稀疏叉积 XᵀX 得到后做稠密 Cholesky
+     * 分解，solver 选项被忽略。哑变量系数的名称为“列名=取值”。
+     */
+    static RegressionResult fit(const Core::TableData& table, int response, const QVector<int>& predictors,
+                                const QVector<int>& categoricalPredictors,
+                                const RegressionOptions& options = RegressionOptions());
+
+    /**
+     * @brief 以稀疏设计矩阵回归（X 的行与 y 一一对应，y 或 X 中含 NaN 的行剔除）
+     */
+    static RegressionResult fitSparse(const SparseMatrix& X, const QVector<double>& y, const QStringList& names,
+                                      const RegressionOptions& options = RegressionOptions());
+
+    /**
+     * @brief 多项式回归 y = b0 + b1·x + ... + bd·x^d
+     */
+    static RegressionResult polynomial(const QVector<double>& x, const QVector<double>& y, int degree,
+                                       const RegressionOptions& options = RegressionOptions());
+
+    /**
+     * @brief 表格两列之间的多项式回归
+     */
+    static RegressionResult polynomial(const Core::TableData& table, int xColumn, int yColumn, int degree,
+                                       const RegressionOptions& options = RegressionOptions());
+
+    /**
+     * @brief 用回归系数计算预测值（values 为各自变量的取值，不含截距）
+     */
+    static double predict(const RegressionResult& result, const QVector<double>& values);
+
+    static QString solverName(RegressionSolver solver);
+};
+
+} // namespace Statistics
+
+#endif // REGRESSION_H
@@ -0,0 +1,374 @@
+#include "RollingWindow.h"
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+namespace Statistics {
+
+namespace {
+
+const double NaN = std::numeric_limits<double>::quiet_NaN();
+
+/**
+ * 通用滑动驱动：第 i 步加入 data[i]、移出 data[i - window]，
+ * 居中时结果写到 i - window/2。累加器只接触有效值（非 NaN）。
+ */
+template<typename Accumulator>
+QVector<double> slide(const QVector<double>& data, const RollingOptions& options, Accumulator& acc)
+{
+    const qsizetype n = data.size();
+    const qsizetype window = options.window;
+    QVector<double> result(n, NaN);
+
+    if (window <= 0 || n == 0) {
+        return result;
+    }
+
+    const qsizetype minPeriods = options.minPeriods <= 0
+                                     ? window
+                                     : std::min<qsizetype>(options.minPeriods, window);
+    const qsizetype offset = options.center ? window / 2 : 0;
+    const double* values = data.constData();
+    qsizetype valid = 0;
+
+    for (qsizetype i = 0; i < n + offset; ++i) {
+        if (i < n && !std::isnan(values[i])) {
+            acc.add(i, values[i]);
+            ++valid;
+        }
+
+        qsizetype leaving = i - window;
+        if (leaving >= 0 && leaving < n && !std::isnan(values[leaving])) {
+            --valid;
+            if (valid == 0) {
+                acc.reset();
+            } else {
+                acc.remove(leaving, values[leaving]);
+            }
+        }
+
+        qsizetype out = i - offset;
+        if (out >= 0 && valid >= minPeriods) {
+            result[out] = acc.value(valid);
+        }
+    }
+
+    return result;
+}
+
+// === 求和（Neumaier 补偿，移出即加上相反数） ===
+
+struct SumAccumulator
+{
+    double sum = 0.0;
+    double compensation = 0.0;
+
+    void add(qsizetype, double x) { accumulate(x); }
+    void remove(qsizetype, double x) { accumulate(-x); }
+    void reset() { sum = 0.0; compensation = 0.0; }
+    double value(qsizetype) const { return sum + compensation; }
+
+    void accumulate(double x)
+    {
+        double t = sum + x;
+        if (std::fabs(sum) >= std::fabs(x)) {
+            compensation += (sum - t) + x;
+        } else {
+            compensation += (x - t) + sum;
+        }
+        sum = t;
+    }
+};
+
+struct MeanAccumulator : SumAccumulator
+{
+    double value(qsizetype count) const { return (sum + compensation) / count; }
+};
+
+struct CountAccumulator
+{
+    void add(qsizetype, double) {}
+    void remove(qsizetype, double) {}
+    void reset() {}
+    double value(qsizetype count) const { return static_cast<double>(count); }
+};
+
+// === 方差（Welford 增删） ===
+
+struct VarianceAccumulator
+{
+    qsizetype n = 0;
+    double mean = 0.0;
+    double m2 = 0.0;
+    double lastValue = 0.0;
+    qsizetype sameCount = 0;    // 末尾连续相同值的个数
+    bool takeRoot = false;
+
+    void add(qsizetype, double x)
+    {
+        ++n;
+        sameCount = (sameCount > 0 && x == lastValue) ? sameCount + 1 : 1;
+        lastValue = x;
+
+        if (sameCount >= n) {
+            // 窗口内全为同一值：直接重置，消除增删累积的舍入误差
+            mean = x;
+            m2 = 0.0;
+            return;
+        }
+
+        double delta = x - mean;
+        mean += delta / n;
+        m2 += delta * (x - mean);
+    }
+
+    void remove(qsizetype, double x)
+    {
+        --n;
+        double delta = x - mean;
+        mean -= delta / n;
+        m2 -= delta * (x - mean);
+    }
+
+    void reset() { n = 0; mean = 0.0; m2 = 0.0; sameCount = 0; }
+
+    double value(qsizetype) const
+    {
+        if (n < 2) {
+            return NaN;
+        }
+        if (sameCount >= n) {
+            return 0.0;
+        }
+        // 增删交替会累积微小的负误差
+        double var = std::max(0.0, m2) / (n - 1);
+        return takeRoot ? std::sqrt(var) : var;
+    }
+};
+
+// === 最小/最大值（单调双端队列，环形缓冲存放下标） ===
+
+template<typename Compare>
+struct MonotonicAccumulator
+{
+    const double* values;
+    QVector<qsizetype> ring;    // 先加入后移出，容量需为窗口大小 + 1
+    qsizetype head = 0;
+    qsizetype size = 0;
+    Compare keep;               // keep(a, b)：队尾 a 在 b 入队后仍需保留
+
+    MonotonicAccumulator(const double* data, int window) : values(data), ring(window + 1) {}
+
+    qsizetype& at(qsizetype k) { return ring[(head + k) % ring.size()]; }
+
+    void add(qsizetype i, double x)
+    {
+        while (size > 0 && !keep(values[at(size - 1)], x)) {
+            --size;
+        }
+        at(size) = i;
+        ++size;
+    }
+
+    void remove(qsizetype i, double)
+    {
+        if (size > 0 && at(0) == i) {
+            head = (head + 1) % ring.size();
+            --size;
+        }
+    }
+
+    void reset() { head = 0; size = 0; }
+
+    double value(qsizetype) { return values[at(0)]; }
+};
+
+// === 中位数（双堆 + 延迟删除） ===
+
+struct MedianAccumulator
+{
+    std::priority_queue<double> low;                                             // 较小一半（大顶堆）
+    std::priority_queue<double, std::vector<double>, std::greater<double>> high; // 较大一半（小顶堆）
+    std::unordered_map<double, int> delayed;                                     // 待删除值 -> 次数
+    qsizetype lowSize = 0;                                                       // 堆中有效元素个数
+    qsizetype highSize = 0;
+
+    template<typename Heap>
+    void prune(Heap& heap)
+    {
+        while (!heap.empty()) {
+            auto it = delayed.find(heap.top());
+            if (it == delayed.end()) {
+                break;
+            }
+            if (--it->second == 0) {
+                delayed.erase(it);
+            }
+            heap.pop();
+        }
+    }
+
+    void rebalance()
+    {
+        if (lowSize > highSize + 1) {
+            high.push(low.top());
+            low.pop();
+            --lowSize;
+            ++highSize;
+            prune(low);
+        } else if (lowSize < highSize) {
+            low.push(high.top());
+            high.pop();
+            ++lowSize;
+            --highSize;
+            prune(high);
+        }
+    }
+
+    void add(qsizetype, double x)
+    {
+        x += 0.0;   // 统一 -0.0 与 0.0，保证延迟删除按值匹配
+        if (low.empty() || x <= low.top()) {
+            low.push(x);
+            ++lowSize;
+        } else {
+            high.push(x);
+            ++highSize;
+        }
+        rebalance();
+    }
+
+    void remove(qsizetype, double x)
+    {
+        x += 0.0;
+        ++delayed[x];
+        if (x <= low.top()) {
+            --lowSize;
+            if (x == low.top()) {
+                prune(low);
+            }
+        } else {
+            --highSize;
+            if (x == high.top()) {
+                prune(high);
+            }
+        }
+        rebalance();
+    }
+
+    void reset()
+    {
+        low = decltype(low)();
+        high = decltype(high)();
+        delayed.clear();
+        lowSize = 0;
+        highSize = 0;
+    }
+
+    double value(qsizetype) const
+    {
+        if (lowSize > highSize) {
+            return low.top();
+        }
+        return 0.5 * (low.top() + high.top());
+    }
+};
+
+} // namespace
+
+QVector<double> RollingWindow::mean(const QVector<double>& data, const RollingOptions& options)
+{
+    MeanAccumulator acc;
+    return slide(data, options, acc);
+}
+
+QVector<double> RollingWindow::sum(const QVector<double>& data, const RollingOptions& options)
+{
+    SumAccumulator acc;
+    return slide(data, options, acc);
+}
+
+QVector<double> RollingWindow::variance(const QVector<double>& data, const RollingOptions& options)
+{
+    VarianceAccumulator acc;
+    return slide(data, options, acc);
+}
+
+QVector<double> RollingWindow::stdDev(const QVector<double>& data, const RollingOptions& options)
+{
+    VarianceAccumulator acc;
+    acc.takeRoot = true;
+    return slide(data, options, acc);
+}
+
+QVector<double> RollingWindow::min(const QVector<double>& data, const RollingOptions& options)
+{
+    if (options.window <= 0) {
+        return QVector<double>(data.size(), NaN);
+    }
+    MonotonicAccumulator<std::less<double>> acc(data.constData(), options.window);
+    return slide(data, options, acc);
+}
+
+QVector<double> RollingWindow::max(const QVector<double>& data, const RollingOptions& options)
+{
+    if (options.window <= 0) {
+        return QVector<double>(data.size(), NaN);
+    }
+    MonotonicAccumulator<std::greater<double>> acc(data.constData(), options.window);
+    return slide(data, options, acc);
+}
+
+QVector<double> RollingWindow::median(const QVector<double>& data, const RollingOptions& options)
+{
+    MedianAccumulator acc;
+    return slide(data, options, acc);
+}
+
+QVector<double> RollingWindow::count(const QVector<double>& data, const RollingOptions& options)
+{
+    CountAccumulator acc;
+    return slide(data, options, acc);
+}
+
+QVector<double> RollingWindow::compute(const QVector<double>& data, RollingStatistic statistic,
+                                       const RollingOptions& options)
+{
+    if (options.window <= 0) {
+        return QVector<double>();
+    }
+
+    switch (statistic) {
+    case RollingStatistic::Mean:     return mean(data, options);
+    case RollingStatistic::Sum:      return sum(data, options);
+    case RollingStatistic::Variance: return variance(data, options);
+    case RollingStatistic::StdDev:   return stdDev(data, options);
+    case RollingStatistic::Min:      return min(data, options);
+    case RollingStatistic::Max:      return max(data, options);
+    case RollingStatistic::Median:   return median(data, options);
+    case RollingStatistic::Count:    return count(data, options);
+    }
+    return QVector<double>();
+}
+
+QString RollingWindow::statisticName(RollingStatistic statistic)
+{
+    switch (statistic) {
+    case RollingStatistic::Mean:     return "滚动均值";
+    case RollingStatistic::Sum:      return "滚动求和";
+    case RollingStatistic::Variance: return "滚动方差";
+    case RollingStatistic::StdDev:   return "滚动标准差";
+    case RollingStatistic::Min:      return "滚动最小值";
+    case RollingStatistic::Max:      return "滚动最大值";
+    case RollingStatistic::Median:   return "滚动中位数";
+    case RollingStatistic::Count:    return "滚动计数";
+    }
+    return QString();
+}
+
+} // namespace Statistics
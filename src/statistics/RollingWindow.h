@@ -0,0 +1,73 @@
+#ifndef ROLLINGWINDOW_H
+#define ROLLINGWINDOW_H
+
+#include <QVector>
+#include <QString>
+
+namespace Statistics {
+
+/**
+ * @brief 滚动统计量
+ */
+enum class RollingStatistic
+{
+    Mean,       // 均值
+    Sum,        // 求和
+    Variance,   // 样本方差
+    StdDev,     // 样本标准差
+    Min,        // 最小值
+    Max,        // 最大值
+    Median,     // 中位数
+    Count       // 有效值个数
+};
+
+/**
+ * @brief 滚动窗口参数
+ */
+struct RollingOptions
+{
+    int window = 3;         // 窗口大小（行数）
+    int minPeriods = 0;     // 窗口内至少需要的有效值个数（0 表示等于 window）
+    bool center = false;    // 是否居中对齐（默认窗口以当前行为右端点）
+};
+
+/**
+ * @brief 滚动窗口统计
+ *
+ * 所有算法对每个元素只做常数次（中位数为对数次）增删，整体复杂度与
+ * 窗口大小无关：
+ * - 均值/求和：带补偿的滑动求和
+ * - 方差/标准差：Welford 增删更新
+ * - 最小/最大值：单调双端队列
+ * - 中位数：双堆 + 延迟删除
+ *
+ * 输出与输入等长；NaN 视为缺失值，窗口内有效值不足 minPeriods 时输出 NaN。
+ */
+class RollingWindow
+{
+public:
+    static QVector<double> mean(const QVector<double>& data, const RollingOptions& options);
+    static QVector<double> sum(const QVector<double>& data, const RollingOptions& options);
+    static QVector<double> variance(const QVector<double>& data, const RollingOptions& options);
+    static QVector<double> stdDev(const QVector<double>& data, const RollingOptions& options);
+    static QVector<double> min(const QVector<double>& data, const RollingOptions& options);
+    static QVector<double> max(const QVector<double>& data, const RollingOptions& options);
+    static QVector<double> median(const QVector<double>& data, const RollingOptions& options);
+    static QVector<double> count(const QVector<double>& data, const RollingOptions& options);
+
+    /**
+     * @brief 按统计量类型计算
+     * @return 参数无效（window <= 0）时返回空数组
+     */
+    static QVector<double> compute(const QVector<double>& data, RollingStatistic statistic,
+                                   const RollingOptions& options);
+
+    /**
+     * @brief 统计量的中文名称
+     */
+    static QString statisticName(RollingStatistic statistic);
+};
+
+} // namespace Statistics
+
+#endif // ROLLINGWINDOW_H
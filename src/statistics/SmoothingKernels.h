@@ -0,0 +1,210 @@
+#ifndef SMOOTHINGKERNELS_H
+#define SMOOTHINGKERNELS_H
+
+#include "StatisticTypes.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Statistics {
+
+/**
+ * @brief 指数平滑递推内核
+ *
+ * Forecasting、SmoothingOptimizer 与 BatchForecaster 共用的状态初始化、
+ * 一步预测误差累计和外推公式，保证参数优化的目标函数与实际预测一致。
+ * 季节项由调用方提供存储（长度为季节周期），便于批量预测时把所有
+ * 序列的状态连续存放。
+ */
+namespace SmoothingKernels {
+
+/**
+ * @brief 平滑状态（季节项另行存放）
+ */
+struct State
+{
+    double level = 0.0;
+    double trend = 0.0;
+    int phase = 0;          // 下一期对应的季节项下标
+};
+
+struct SquaredLoss
+{
+    static double apply(double e) { return e * e; }
+};
+
+struct AbsoluteLoss
+{
+    static double apply(double e) { return std::fabs(e); }
+};
+
+// 每累计这么多期检查一次是否超过阈值
+const qsizetype ABANDON_BLOCK = 512;
+
+inline bool isSeasonal(SmoothingModel model)
+{
+    return model == SmoothingModel::HoltWintersAdditive ||
+           model == SmoothingModel::HoltWintersMultiplicative;
+}
+
+/**
+ * @brief 模型所需的最少数据个数
+ */
+inline qsizetype minimumLength(SmoothingModel model, int seasonLength)
+{
+    switch (model) {
+    case SmoothingModel::Simple:                    return 2;
+    case SmoothingModel::Holt:                      return 3;
+    case SmoothingModel::HoltWintersAdditive:
+    case SmoothingModel::HoltWintersMultiplicative: return 2 * static_cast<qsizetype>(std::max(2, seasonLength)) + 1;
+    }
+    return 2;
+}
+
+/**
+ * @brief 初始化状态
+ *
+ * 简单/Holt 模型以首个观测为水平（Holt 趋势取前两期之差）；季节模型以首个
+ * 周期均值为水平、前两个周期均值之差除以周期为趋势，季节项取首个周期
+ * 相对水平的偏差（加法）或比值（乘法）。
+ *
+ * @param seasonal 季节项存储（季节模型需至少 seasonLength 个元素）
+ * @return 第一个参与误差计算的下标
+ */
+inline qsizetype initialize(const double* y, SmoothingModel model, int seasonLength,
+                            State& state, double* seasonal)
+{
+    state = State();
+
+    if (!isSeasonal(model)) {
+        state.level = y[0];
+        state.trend = model == SmoothingModel::Holt ? y[1] - y[0] : 0.0;
+        return 1;
+    }
+
+    const int m = seasonLength;
+    double first = 0.0;
+    double second = 0.0;
+    for (int j = 0; j < m; ++j) {
+        first += y[j];
+        second += y[m + j];
+    }
+    first /= m;
+    second /= m;
+
+    state.level = first;
+    state.trend = (second - first) / m;
+    for (int j = 0; j < m; ++j) {
+        seasonal[j] = model == SmoothingModel::HoltWintersMultiplicative ? y[j] / first : y[j] - first;
+    }
+    return m;
+}
+
+/**
+ * @brief 对 y[begin, end) 执行递推并累计一步预测误差
+ * @param bound 误差阈值，累计值超过时提前返回无穷大（状态此时无意义）
+ * @return 误差总和
+ */
+template<typename Loss>
+double run(const double* y, qsizetype begin, qsizetype end, SmoothingModel model,
+           const SmoothingParameters& p, int seasonLength, State& state, double* seasonal,
+           double bound = std::numeric_limits<double>::infinity())
+{
+    const double inf = std::numeric_limits<double>::infinity();
+    const double alpha = p.alpha;
+    const double beta = p.beta;
+    const double gamma = p.gamma;
+    double level = state.level;
+    double trend = state.trend;
+    int phase = state.phase;
+    double acc = 0.0;
+
+    for (qsizetype i = begin; i < end;) {
+        qsizetype blockEnd = std::min(end, i + ABANDON_BLOCK);
+
+        switch (model) {
+        case SmoothingModel::Simple:
+            for (; i < blockEnd; ++i) {
+                double e = y[i] - level;
+                acc += Loss::apply(e);
+                level += alpha * e;
+            }
+            break;
+
+        case SmoothingModel::Holt:
+            for (; i < blockEnd; ++i) {
+                double forecast = level + trend;
+                double e = y[i] - forecast;
+                acc += Loss::apply(e);
+                double newLevel = forecast + alpha * e;
+                trend = beta * (newLevel - level) + (1.0 - beta) * trend;
+                level = newLevel;
+            }
+            break;
+
+        case SmoothingModel::HoltWintersAdditive:
+            for (; i < blockEnd; ++i) {
+                double s = seasonal[phase];
+                double e = y[i] - (level + trend + s);
+                acc += Loss::apply(e);
+                double newLevel = alpha * (y[i] - s) + (1.0 - alpha) * (level + trend);
+                trend = beta * (newLevel - level) + (1.0 - beta) * trend;
+                seasonal[phase] = gamma * (y[i] - newLevel) + (1.0 - gamma) * s;
+                level = newLevel;
+                if (++phase == seasonLength) {
+                    phase = 0;
+                }
+            }
+            break;
+
+        case SmoothingModel::HoltWintersMultiplicative:
+            for (; i < blockEnd; ++i) {
+                double s = seasonal[phase];
+                double e = y[i] - (level + trend) * s;
+                acc += Loss::apply(e);
+                double newLevel = alpha * (y[i] / s) + (1.0 - alpha) * (level + trend);
+                trend = beta * (newLevel - level) + (1.0 - beta) * trend;
+                seasonal[phase] = gamma * (y[i] / newLevel) + (1.0 - gamma) * s;
+                level = newLevel;
+                if (++phase == seasonLength) {
+                    phase = 0;
+                }
+            }
+            break;
+        }
+
+        if (!(acc <= bound)) {
+            return inf;     // 超过阈值或出现 NaN（乘法模型水平趋近 0 时）
+        }
+    }
+
+    state.level = level;
+    state.trend = trend;
+    state.phase = phase;
+    return acc;
+}
+
+/**
+ * @brief 从当前状态外推第 h 期（h ≥ 1）
+ */
+inline double forecast(SmoothingModel model, const State& state, const double* seasonal,
+                       int seasonLength, int h)
+{
+    switch (model) {
+    case SmoothingModel::Simple:
+        return state.level;
+    case SmoothingModel::Holt:
+        return state.level + h * state.trend;
+    case SmoothingModel::HoltWintersAdditive:
+        return state.level + h * state.trend + seasonal[(state.phase + h - 1) % seasonLength];
+    case SmoothingModel::HoltWintersMultiplicative:
+        return (state.level + h * state.trend) * seasonal[(state.phase + h - 1) % seasonLength];
+    }
+    return state.level;
+}
+
+} // namespace SmoothingKernels
+
+} // namespace Statistics
+
+#endif // SMOOTHINGKERNELS_H
@@ -0,0 +1,342 @@
+#include "SmoothingOptimizer.h"
+#include "ParallelUtils.h"
+#include "SmoothingKernels.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace Statistics {
+
+namespace {
+
+const double PARAM_MIN = 0.001;
+const double PARAM_MAX = 0.999;
+const double INF = std::numeric_limits<double>::infinity();
+
+const int MAX_DIMENSIONS = 3;
+const int MAX_RESTARTS = 3;
+using Point = std::array<double, MAX_DIMENSIONS>;
+
+int dimensionOf(SmoothingModel model)
+{
+    switch (model) {
+    case SmoothingModel::Simple:                    return 1;
+    case SmoothingModel::Holt:                      return 2;
+    case SmoothingModel::HoltWintersAdditive:
+    case SmoothingModel::HoltWintersMultiplicative: return 3;
+    }
+    return 1;
+}
+
+int defaultGridSteps(SmoothingModel model)
+{
+    switch (model) {
+    case SmoothingModel::Simple:                    return 32;
+    case SmoothingModel::Holt:                      return 12;
+    case SmoothingModel::HoltWintersAdditive:
+    case SmoothingModel::HoltWintersMultiplicative: return 7;
+    }
+    return 10;
+}
+
+double clampParameter(double value)
+{
+    return std::clamp(value, PARAM_MIN, PARAM_MAX);
+}
+
+SmoothingParameters toParameters(const Point& point, int dimensions)
+{
+    SmoothingParameters parameters;
+    parameters.alpha = point[0];
+    if (dimensions > 1) parameters.beta = point[1];
+    if (dimensions > 2) parameters.gamma = point[2];
+    return parameters;
+}
+
+/**
+ * 目标函数：按块累计一步预测误差，超过 bound 时返回无穷大
+ */
+struct Objective
+{
+    const double* y = nullptr;
+    qsizetype n = 0;
+    SmoothingModel model = SmoothingModel::Simple;
+    int seasonLength = 0;
+    FitCriterion criterion = FitCriterion::MSE;
+
+    // 参与误差计算的预测步数
+    qsizetype steps() const
+    {
+        return SmoothingKernels::isSeasonal(model) ? n - seasonLength : n - 1;
+    }
+
+    double total(const Point& p, double bound) const
+    {
+        SmoothingParameters parameters{p[0], p[1], p[2]};
+        SmoothingKernels::State state;
+        std::vector<double> seasonal(std::max(1, seasonLength));
+        qsizetype begin = SmoothingKernels::initialize(y, model, seasonLength, state, seasonal.data());
+
+        if (criterion == FitCriterion::MAE) {
+            return SmoothingKernels::run<SmoothingKernels::AbsoluteLoss>(
+                y, begin, n, model, parameters, seasonLength, state, seasonal.data(), bound);
+        }
+        return SmoothingKernels::run<SmoothingKernels::SquaredLoss>(
+            y, begin, n, model, parameters, seasonLength, state, seasonal.data(), bound);
+    }
+};
+
+QVector<double> finiteValues(const QVector<double>& data)
+{
+    QVector<double> values;
+    values.reserve(data.size());
+    for (double value : data) {
+        if (std::isfinite(value)) {
+            values.append(value);
+        }
+    }
+    return values;
+}
+
+} // namespace
+
+int SmoothingOptimizer::minimumLength(const SmoothingFitOptions& options)
+{
+    return static_cast<int>(SmoothingKernels::minimumLength(options.model, options.seasonLength));
+}
+
+double SmoothingOptimizer::error(const QVector<double>& data, const SmoothingParameters& parameters,
+                                 const SmoothingFitOptions& options)
+{
+    QVector<double> values = finiteValues(data);
+    if (values.size() < minimumLength(options) ||
+        (SmoothingKernels::isSeasonal(options.model) && options.seasonLength < 2)) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    Objective objective{values.constData(), values.size(), options.model,
+                        options.seasonLength, options.criterion};
+    Point point{parameters.alpha, parameters.beta, parameters.gamma};
+    return objective.total(point, INF) / objective.steps();
+}
+
+SmoothingFitResult SmoothingOptimizer::optimize(const QVector<double>& data, const SmoothingFitOptions& options)
+{
+    SmoothingFitResult result;
+
+    if (SmoothingKernels::isSeasonal(options.model) && options.seasonLength < 2) {
+        result.errorMessage = "季节周期至少为 2";
+        return result;
+    }
+
+    QVector<double> values = finiteValues(data);
+    if (values.size() < minimumLength(options)) {
+        result.errorMessage = QString("有效数据不足（至少需要 %1 个）").arg(minimumLength(options));
+        return result;
+    }
+
+    if (options.model == SmoothingModel::HoltWintersMultiplicative &&
+        *std::min_element(values.cbegin(), values.cend()) <= 0.0) {
+        result.errorMessage = "乘法季节模型要求数据全部为正";
+        return result;
+    }
+
+    const Objective objective{values.constData(), values.size(), options.model,
+                              options.seasonLength, options.criterion};
+    const int dimensions = dimensionOf(options.model);
+    std::atomic<int> evaluations{0};
+    std::atomic<int> abandoned{0};
+
+    auto evaluate = [&](const Point& point, double bound) {
+        double value = objective.total(point, bound);
+        ++evaluations;
+        if (std::isinf(value) && bound < INF) {
+            ++abandoned;
+        }
+        return value;
+    };
+
+    // === 粗网格（并行）：共享当前最优值作为提前放弃的阈值 ===
+    const int steps = options.gridSteps > 0 ? options.gridSteps : defaultGridSteps(options.model);
+    int gridSize = 1;
+    for (int d = 0; d < dimensions; ++d) {
+        gridSize *= steps;
+    }
+
+    auto gridPoint = [&](int index) {
+        Point point{PARAM_MIN, PARAM_MIN, PARAM_MIN};
+        for (int d = 0; d < dimensions; ++d) {
+            point[d] = clampParameter((index % steps + 0.5) / steps);
+            index /= steps;
+        }
+        return point;
+    };
+
+    std::vector<double> gridValues(gridSize, INF);
+    std::atomic<double> gridBest{INF};
+
+    auto evaluateGrid = [&](int index) {
+        double value = evaluate(gridPoint(index), gridBest.load(std::memory_order_relaxed));
+        gridValues[index] = value;
+
+        double current = gridBest.load(std::memory_order_relaxed);
+        while (value < current && !gridBest.compare_exchange_weak(current, value)) {
+        }
+    };
+
+    if (options.parallel) {
+        Parallel::forEach(gridSize, evaluateGrid);
+    } else {
+        for (int index = 0; index < gridSize; ++index) {
+            evaluateGrid(index);
+        }
+    }
+
+    int bestIndex = static_cast<int>(std::min_element(gridValues.begin(), gridValues.end()) - gridValues.begin());
+    if (!std::isfinite(gridValues[bestIndex])) {
+        result.errorMessage = "目标函数无有限值（数据可能溢出）";
+        return result;
+    }
+
+    // === Nelder–Mead 细化 ===
+    const int vertexCount = dimensions + 1;
+    std::vector<Point> simplex(vertexCount);
+    std::vector<double> f(vertexCount);
+
+    auto combine = [&](const Point& centroid, const Point& point, double coefficient) {
+        Point out = centroid;
+        for (int d = 0; d < dimensions; ++d) {
+            out[d] = clampParameter(centroid[d] + coefficient * (point[d] - centroid[d]));
+        }
+        return out;
+    };
+
+    // 以 start 为顶点、step 为边长构造初始单纯形并迭代至收敛
+    std::vector<int> order(vertexCount);
+    auto refine = [&](const Point& start, double fStart, double step) {
+        simplex[0] = start;
+        f[0] = fStart;
+        for (int v = 1; v < vertexCount; ++v) {
+            Point point = start;
+            int d = v - 1;
+            point[d] = point[d] + step <= PARAM_MAX ? point[d] + step : point[d] - step;
+            simplex[v] = point;
+            f[v] = evaluate(point, INF);
+        }
+
+        for (int iteration = 0; iteration < options.maxIterations; ++iteration) {
+            for (int v = 0; v < vertexCount; ++v) {
+                order[v] = v;
+            }
+            std::sort(order.begin(), order.end(), [&](int a, int b) { return f[a] < f[b]; });
+
+            const int best = order.front();
+            const int worst = order.back();
+            const int secondWorst = order[vertexCount - 2];
+
+            // 收敛：顶点误差接近且单纯形足够小
+            double spread = f[worst] - f[best];
+            double size = 0.0;
+            for (int v = 0; v < vertexCount; ++v) {
+                for (int d = 0; d < dimensions; ++d) {
+                    size = std::max(size, std::fabs(simplex[v][d] - simplex[best][d]));
+                }
+            }
+            if (spread <= options.tolerance * (std::fabs(f[best]) + 1e-300) && size < 1e-4) {
+                break;
+            }
+
+            Point centroid{0.0, 0.0, 0.0};
+            for (int v = 0; v < vertexCount; ++v) {
+                if (v == worst) continue;
+                for (int d = 0; d < dimensions; ++d) {
+                    centroid[d] += simplex[v][d] / dimensions;
+                }
+            }
+
+            // 只需知道候选是否优于最差顶点，故以 f[worst] 为阈值提前放弃
+            Point reflected = combine(centroid, simplex[worst], -1.0);
+            double fr = evaluate(reflected, f[worst]);
+
+            if (fr < f[best]) {
+                Point expanded = combine(centroid, simplex[worst], -2.0);
+                double fe = evaluate(expanded, fr);
+                if (fe < fr) {
+                    simplex[worst] = expanded;
+                    f[worst] = fe;
+                } else {
+                    simplex[worst] = reflected;
+                    f[worst] = fr;
+                }
+                continue;
+            }
+
+            if (fr < f[secondWorst]) {
+                simplex[worst] = reflected;
+                f[worst] = fr;
+                continue;
+            }
+
+            // 收缩：反射点优于最差点时向外收缩，否则向内收缩
+            bool outside = fr < f[worst];
+            Point contracted = combine(centroid, outside ? reflected : simplex[worst], 0.5);
+            double threshold = outside ? fr : f[worst];
+            double fc = evaluate(contracted, threshold);
+
+            if (fc < threshold) {
+                simplex[worst] = contracted;
+                f[worst] = fc;
+                continue;
+            }
+
+            // 整体向最优顶点缩小
+            for (int v = 0; v < vertexCount; ++v) {
+                if (v == best) continue;
+                simplex[v] = combine(simplex[best], simplex[v], 0.5);
+                f[v] = evaluate(simplex[v], INF);
+            }
+        }
+
+        int best = static_cast<int>(std::min_element(f.begin(), f.end()) - f.begin());
+        return std::make_pair(simplex[best], f[best]);
+    };
+
+    // 单纯形贴近边界时容易过早塌缩，从当前最优点以较小步长重启直到不再改进
+    auto [bestPoint, bestValue] = refine(gridPoint(bestIndex), gridValues[bestIndex], 1.0 / steps);
+    double step = 0.25 / steps;
+    for (int restart = 0; restart < MAX_RESTARTS; ++restart, step *= 0.25) {
+        auto [point, value] = refine(bestPoint, bestValue, step);
+        bool improved = value < bestValue - options.tolerance * std::fabs(bestValue);
+        if (value < bestValue) {
+            bestPoint = point;
+            bestValue = value;
+        }
+        if (!improved) {
+            break;
+        }
+    }
+
+    result.parameters = toParameters(bestPoint, dimensions);
+    result.error = bestValue / objective.steps();
+    result.evaluations = evaluations.load();
+    result.abandoned = abandoned.load();
+    result.isValid = true;
+    return result;
+}
+
+QString SmoothingOptimizer::modelName(SmoothingModel model)
+{
+    switch (model) {
+    case SmoothingModel::Simple:                    return "简单指数平滑";
+    case SmoothingModel::Holt:                      return "Holt 线性趋势";
+    case SmoothingModel::HoltWintersAdditive:       return "Holt-Winters（加法季节）";
+    case SmoothingModel::HoltWintersMultiplicative: return "Holt-Winters（乘法季节）";
+    }
+    return QString();
+}
+
+} // namespace Statistics
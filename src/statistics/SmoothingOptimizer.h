@@ -0,0 +1,85 @@
+#ifndef SMOOTHINGOPTIMIZER_H
+#define SMOOTHINGOPTIMIZER_H
+
+#include "StatisticTypes.h"
+#include <QVector>
+#include <QString>
+
+namespace Statistics {
+
+/**
+ * @brief 参数优化的误差准则（一步预测误差）
+ */
+enum class FitCriterion
+{
+    MSE,    // 均方误差
+    MAE     // 平均绝对误差
+};
+
+/**
+ * @brief 参数优化选项
+ */
+struct SmoothingFitOptions
+{
+    SmoothingModel model = SmoothingModel::Simple;
+    int seasonLength = 12;                      // 季节周期（仅季节模型）
+    FitCriterion criterion = FitCriterion::MSE;
+    int gridSteps = 0;                          // 粗网格每维的点数（0 表示按模型自动选择）
+    int maxIterations = 200;                    // Nelder–Mead 最大迭代次数
+    double tolerance = 1e-7;                    // 单纯形顶点误差的相对收敛阈值
+    bool parallel = true;                       // 粗网格是否并行求值（批量调用时由外层并行）
+};
+
+/**
+ * @brief 参数优化结果
+ */
+struct SmoothingFitResult
+{
+    SmoothingParameters parameters;
+    double error = 0.0;         // 最优参数下的 MSE 或 MAE
+    int evaluations = 0;        // 目标函数求值次数
+    int abandoned = 0;          // 因部分误差已超过当前最优而提前终止的次数
+    bool isValid = false;
+    QString errorMessage;
+};
+
+/**
+ * @brief 指数平滑参数自动优化
+ *
+ * 以样本内一步预测误差为目标：先在参数空间的粗网格上并行求值，
+ * 再从最优网格点出发用 Nelder–Mead 单纯形法细化。求值时一旦累计
+ * 误差超过当前需要比较的阈值即提前放弃，大部分较差的候选只需扫描
+ * 序列的一小段。
+ *
+ * 递推公式与 Forecasting 中对应方法一致（见 SmoothingKernels.h），
+ * 优化得到的参数可直接传入。输入中的 NaN 会被跳过。
+ */
+class SmoothingOptimizer
+{
+public:
+    /**
+     * @brief 搜索使误差最小的平滑系数
+     */
+    static SmoothingFitResult optimize(const QVector<double>& data, const SmoothingFitOptions& options);
+
+    /**
+     * @brief 给定参数下的一步预测误差（MSE 或 MAE）
+     * @return 数据不足时返回 NaN
+     */
+    static double error(const QVector<double>& data, const SmoothingParameters& parameters,
+                        const SmoothingFitOptions& options);
+
+    /**
+     * @brief 模型所需的最少数据个数
+     */
+    static int minimumLength(const SmoothingFitOptions& options);
+
+    /**
+     * @brief 模型的中文名称
+     */
+    static QString modelName(SmoothingModel model);
+};
+
+} // namespace Statistics
+
+#endif // SMOOTHINGOPTIMIZER_H
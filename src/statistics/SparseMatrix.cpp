@@ -0,0 +1,607 @@
+#include "SparseMatrix.h"
+#include "ColumnReader.h"
+#include "ParallelUtils.h"
+#include <QDebug>
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace Statistics {
+
+namespace {
+
+// 读取表格时每块的最少行数
+const qsizetype MIN_ROWS_PER_CHUNK = 4096;
+
+// 稀疏乘法每块的最少外维元素数
+const qsizetype MIN_OUTER_PER_CHUNK = 2048;
+
+// 叉积矩阵每块的最少列数
+const qsizetype MIN_GRAM_COLUMNS_PER_CHUNK = 16;
+
+bool indexFits(qsizetype size)
+{
+    return size >= 0 && size <= std::numeric_limits<int>::max();
+}
+
+SparseDesign invalidDesign(const QString& message)
+{
+    SparseDesign design;
+    design.isValid = false;
+    design.errorMessage = message;
+    return design;
+}
+
+} // namespace
+
+// === 构造 ===
+
+SparseMatrix::SparseMatrix(qsizetype rows, qsizetype cols, SparseFormat format)
+    : m_rows(std::max<qsizetype>(0, rows))
+    , m_cols(std::max<qsizetype>(0, cols))
+    , m_format(format)
+    , m_outer(outerSize() + 1, 0)
+{
+}
+
+SparseMatrix SparseMatrix::fromEntries(qsizetype rows, qsizetype cols, const QVector<SparseEntry>& entries,
+                                       SparseFormat format)
+{
+    if (!indexFits(rows) || !indexFits(cols)) {
+        qWarning() << "稀疏矩阵维度超出范围";
+        return SparseMatrix();
+    }
+    for (const SparseEntry& entry : entries) {
+        if (entry.row < 0 || entry.row >= rows || entry.col < 0 || entry.col >= cols) {
+            qWarning() << "稀疏矩阵下标越界:" << entry.row << entry.col;
+            return SparseMatrix();
+        }
+    }
+
+    SparseMatrix result(rows, cols, format);
+    const bool byRow = format == SparseFormat::CSR;
+    const qsizetype outer = result.outerSize();
+
+    // 按外维计数、分桶
+    QVector<qsizetype> start(outer + 1, 0);
+    for (const SparseEntry& entry : entries) {
+        ++start[(byRow ? entry.row : entry.col) + 1];
+    }
+    for (qsizetype k = 0; k < outer; ++k) {
+        start[k + 1] += start[k];
+    }
+
+    QVector<std::pair<int, double>> buckets(entries.size());
+    QVector<qsizetype> cursor = start;
+    for (const SparseEntry& entry : entries) {
+        const int key = byRow ? entry.row : entry.col;
+        buckets[cursor[key]++] = {byRow ? entry.col : entry.row, entry.value};
+    }
+
+    // 各外维内按内维排序，合并重复位置
+    result.m_inner.reserve(entries.size());
+    result.m_values.reserve(entries.size());
+    for (qsizetype k = 0; k < outer; ++k) {
+        auto begin = buckets.begin() + start[k];
+        auto end = buckets.begin() + start[k + 1];
+        std::sort(begin, end, [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (auto it = begin; it != end; ++it) {
+            if (result.m_inner.size() > result.m_outer[k] && result.m_inner.last() == it->first) {
+                result.m_values.last() += it->second;
+            } else {
+                result.m_inner.append(it->first);
+                result.m_values.append(it->second);
+            }
+        }
+        result.m_outer[k + 1] = result.m_inner.size();
+    }
+    return result;
+}
+
+SparseMatrix SparseMatrix::fromCompressed(qsizetype rows, qsizetype cols, SparseFormat format,
+                                          const QVector<qsizetype>& outerIndex, const QVector<int>& innerIndex,
+                                          const QVector<double>& values)
+{
+    SparseMatrix result(rows, cols, format);
+    const qsizetype outer = result.outerSize();
+    const qsizetype inner = result.innerSize();
+
+    bool valid = indexFits(rows) && indexFits(cols) && outerIndex.size() == outer + 1 &&
+                 innerIndex.size() == values.size() && outerIndex.first() == 0 &&
+                 outerIndex.last() == values.size();
+    for (qsizetype k = 0; valid && k < outer; ++k) {
+        if (outerIndex[k + 1] < outerIndex[k]) {
+            valid = false;
+            break;
+        }
+        for (qsizetype p = outerIndex[k]; p < outerIndex[k + 1]; ++p) {
+            if (innerIndex[p] < 0 || innerIndex[p] >= inner || (p > outerIndex[k] && innerIndex[p] <= innerIndex[p - 1])) {
+                valid = false;
+                break;
+            }
+        }
+    }
+    if (!valid) {
+        qWarning() << "压缩数组格式无效";
+        return SparseMatrix();
+    }
+
+    result.m_outer = outerIndex;
+    result.m_inner = innerIndex;
+    result.m_values = values;
+    return result;
+}
+
+SparseMatrix SparseMatrix::fromDense(const ConstMatrixView& dense, SparseFormat format, double tolerance)
+{
+    SparseMatrix result(dense.rows(), dense.cols(), format);
+    const bool byRow = format == SparseFormat::CSR;
+    const qsizetype outer = result.outerSize();
+    const qsizetype inner = result.innerSize();
+
+    for (qsizetype k = 0; k < outer; ++k) {
+        for (qsizetype p = 0; p < inner; ++p) {
+            const double value = byRow ? dense(k, p) : dense(p, k);
+            if (std::fabs(value) > tolerance) {
+                result.m_inner.append(static_cast<int>(p));
+                result.m_values.append(value);
+            }
+        }
+        result.m_outer[k + 1] = result.m_inner.size();
+    }
+    return result;
+}
+
+SparseMatrix SparseMatrix::oneHot(const Core::ColumnDictionary& dictionary, bool dropFirst)
+{
+    const int offset = dropFirst ? 1 : 0;
+    const qsizetype rows = dictionary.codes.size();
+    SparseMatrix result(rows, std::max(0, dictionary.categoryCount() - offset), SparseFormat::CSR);
+
+    for (qsizetype row = 0; row < rows; ++row) {
+        const int code = dictionary.codes[row];
+        if (code != Core::ColumnDictionary::NULL_CODE && code >= offset) {
+            result.m_inner.append(code - offset);
+        }
+        result.m_outer[row + 1] = result.m_inner.size();
+    }
+    result.m_values.fill(1.0, result.m_inner.size());
+    return result;
+}
+
+SparseMatrix SparseMatrix::horizontalConcat(const QVector<SparseMatrix>& blocks)
+{
+    if (blocks.isEmpty()) {
+        return SparseMatrix();
+    }
+
+    const qsizetype rows = blocks.first().rows();
+    qsizetype cols = 0;
+    QVector<SparseMatrix> csr;
+    QVector<int> offsets;
+    for (const SparseMatrix& block : blocks) {
+        if (block.rows() != rows) {
+            qWarning() << "拼接的矩阵行数不一致";
+            return SparseMatrix();
+        }
+        offsets.append(static_cast<int>(cols));
+        cols += block.cols();
+        csr.append(block.toFormat(SparseFormat::CSR));
+    }
+    if (!indexFits(cols)) {
+        qWarning() << "稀疏矩阵维度超出范围";
+        return SparseMatrix();
+    }
+
+    SparseMatrix result(rows, cols, SparseFormat::CSR);
+    for (qsizetype row = 0; row < rows; ++row) {
+        qsizetype count = 0;
+        for (const SparseMatrix& block : csr) {
+            count += block.m_outer[row + 1] - block.m_outer[row];
+        }
+        result.m_outer[row + 1] = result.m_outer[row] + count;
+    }
+
+    const qsizetype nnz = result.m_outer[rows];
+    result.m_inner.resize(nnz);
+    result.m_values.resize(nnz);
+    Parallel::forChunks(rows, Parallel::chunkCount(rows, MIN_OUTER_PER_CHUNK), [&](int, qsizetype begin, qsizetype end) {
+        for (qsizetype row = begin; row < end; ++row) {
+            qsizetype out = result.m_outer[row];
+            for (qsizetype b = 0; b < csr.size(); ++b) {
+                const SparseMatrix& block = csr[b];
+                for (qsizetype p = block.m_outer[row]; p < block.m_outer[row + 1]; ++p) {
+                    result.m_inner[out] = block.m_inner[p] + offsets[b];
+                    result.m_values[out] = block.m_values[p];
+                    ++out;
+                }
+            }
+        }
+    });
+    return result;
+}
+
+// === 转换 ===
+
+SparseMatrix SparseMatrix::toFormat(SparseFormat format) const
+{
+    if (format == m_format) {
+        return *this;
+    }
+
+    // 按内维计数后分桶：按外维顺序扫描，新的内维下标自然升序
+    SparseMatrix result(m_rows, m_cols, format);
+    const qsizetype newOuter = result.outerSize();
+    for (int index : m_inner) {
+        ++result.m_outer[index + 1];
+    }
+    for (qsizetype k = 0; k < newOuter; ++k) {
+        result.m_outer[k + 1] += result.m_outer[k];
+    }
+
+    result.m_inner.resize(nonZeros());
+    result.m_values.resize(nonZeros());
+    QVector<qsizetype> cursor = result.m_outer;
+    for (qsizetype k = 0; k < outerSize(); ++k) {
+        for (qsizetype p = m_outer[k]; p < m_outer[k + 1]; ++p) {
+            const qsizetype target = cursor[m_inner[p]]++;
+            result.m_inner[target] = static_cast<int>(k);
+            result.m_values[target] = m_values[p];
+        }
+    }
+    return result;
+}
+
+SparseMatrix SparseMatrix::transposed() const
+{
+    SparseMatrix result = *this;
+    std::swap(result.m_rows, result.m_cols);
+    result.m_format = m_format == SparseFormat::CSR ? SparseFormat::CSC : SparseFormat::CSR;
+    return result;
+}
+
+DenseMatrix SparseMatrix::toDense(MatrixLayout layout) const
+{
+    DenseMatrix result(m_rows, m_cols, 0.0, layout);
+    const bool byRow = m_format == SparseFormat::CSR;
+    for (qsizetype k = 0; k < outerSize(); ++k) {
+        for (qsizetype p = m_outer[k]; p < m_outer[k + 1]; ++p) {
+            if (byRow) {
+                result(k, m_inner[p]) = m_values[p];
+            } else {
+                result(m_inner[p], k) = m_values[p];
+            }
+        }
+    }
+    return result;
+}
+
+// === 访问 ===
+
+double SparseMatrix::density() const
+{
+    return isEmpty() ? 0.0 : static_cast<double>(nonZeros()) / (static_cast<double>(m_rows) * m_cols);
+}
+
+qint64 SparseMatrix::memoryCost() const
+{
+    return m_outer.size() * static_cast<qint64>(sizeof(qsizetype)) +
+           m_inner.size() * static_cast<qint64>(sizeof(int)) +
+           m_values.size() * static_cast<qint64>(sizeof(double));
+}
+
+double SparseMatrix::coeff(qsizetype i, qsizetype j) const
+{
+    if (i < 0 || i >= m_rows || j < 0 || j >= m_cols) {
+        return qQNaN();
+    }
+
+    const qsizetype outer = m_format == SparseFormat::CSR ? i : j;
+    const int inner = static_cast<int>(m_format == SparseFormat::CSR ? j : i);
+    auto begin = m_inner.constBegin() + m_outer[outer];
+    auto end = m_inner.constBegin() + m_outer[outer + 1];
+    auto it = std::lower_bound(begin, end, inner);
+    return it != end && *it == inner ? m_values[it - m_inner.constBegin()] : 0.0;
+}
+
+// === 运算 ===
+
+QVector<double> SparseMatrix::multiply(const QVector<double>& x) const
+{
+    if (x.size() != m_cols) {
+        qWarning() << "矩阵维度不匹配";
+        return QVector<double>();
+    }
+
+    QVector<double> y(m_rows, 0.0);
+    const qsizetype outer = outerSize();
+    const qsizetype* pointers = m_outer.constData();
+    const int* indices = m_inner.constData();
+    const double* values = m_values.constData();
+    const double* input = x.constData();
+
+    if (m_format == SparseFormat::CSR) {
+        double* output = y.data();
+        Parallel::forChunks(outer, Parallel::chunkCount(outer, MIN_OUTER_PER_CHUNK),
+                            [&](int, qsizetype begin, qsizetype end) {
+            for (qsizetype row = begin; row < end; ++row) {
+                double sum = 0.0;
+                for (qsizetype p = pointers[row]; p < pointers[row + 1]; ++p) {
+                    sum += values[p] * input[indices[p]];
+                }
+                output[row] = sum;
+            }
+        });
+        return y;
+    }
+
+    // CSC：各列块散射到自己的局部结果，最后按块顺序合并（结果可复现）
+    const int chunks = std::min(Parallel::threadCount(), Parallel::chunkCount(outer, MIN_OUTER_PER_CHUNK));
+    QVector<QVector<double>> partial(chunks);
+    Parallel::forChunks(outer, chunks, [&](int chunk, qsizetype begin, qsizetype end) {
+        QVector<double>& local = partial[chunk];
+        local.fill(0.0, m_rows);
+        double* output = local.data();
+        for (qsizetype col = begin; col < end; ++col) {
+            const double scale = input[col];
+            if (scale == 0.0) {
+                continue;
+            }
+            for (qsizetype p = pointers[col]; p < pointers[col + 1]; ++p) {
+                output[indices[p]] += values[p] * scale;
+            }
+        }
+    });
+
+    for (const QVector<double>& local : partial) {
+        if (local.isEmpty()) {
+            continue;
+        }
+        for (qsizetype i = 0; i < m_rows; ++i) {
+            y[i] += local[i];
+        }
+    }
+    return y;
+}
+
+QVector<double> SparseMatrix::multiplyTransposed(const QVector<double>& x) const
+{
+    return transposed().multiply(x);
+}
+
+DenseMatrix SparseMatrix::multiply(const ConstMatrixView& B) const
+{
+    if (B.rows() != m_cols) {
+        qWarning() << "矩阵维度不匹配，无法相乘";
+        return DenseMatrix();
+    }
+
+    // 按行计算：C 的第 i 行为 B 各行的线性组合，B 与 C 的行都连续读写
+    const SparseMatrix csr = toFormat(SparseFormat::CSR);
+    const DenseMatrix rowMajor = B.isRowContiguous() ? DenseMatrix() : DenseMatrix::fromView(B);
+    const ConstMatrixView right = B.isRowContiguous() ? B : rowMajor.view();
+    const qsizetype width = B.cols();
+
+    DenseMatrix result(m_rows, width, 0.0);
+    Parallel::forChunks(m_rows, Parallel::chunkCount(m_rows, MIN_OUTER_PER_CHUNK),
+                        [&](int, qsizetype begin, qsizetype end) {
+        for (qsizetype row = begin; row < end; ++row) {
+            double* out = &result(row, 0);
+            for (qsizetype p = csr.m_outer[row]; p < csr.m_outer[row + 1]; ++p) {
+                const double value = csr.m_values[p];
+                const double* in = right.ptr(csr.m_inner[p], 0);
+                for (qsizetype k = 0; k < width; ++k) {
+                    out[k] += value * in[k];
+                }
+            }
+        }
+    });
+    return result;
+}
+
+SparseMatrix SparseMatrix::gram(const QVector<double>& weights) const
+{
+    if (!weights.isEmpty() && weights.size() != m_rows) {
+        qWarning() << "权重个数与行数不一致";
+        return SparseMatrix();
+    }
+
+    const SparseMatrix csc = toFormat(SparseFormat::CSC);
+    const SparseMatrix csr = toFormat(SparseFormat::CSR);
+    const qsizetype n = m_cols;
+    const bool weighted = !weights.isEmpty();
+
+    struct Chunk
+    {
+        QVector<qsizetype> counts;
+        QVector<int> inner;
+        QVector<double> values;
+    };
+
+    const int chunks = Parallel::chunkCount(n, MIN_GRAM_COLUMNS_PER_CHUNK);
+    QVector<Chunk> parts(chunks);
+    Parallel::forChunks(n, chunks, [&](int chunk, qsizetype begin, qsizetype end) {
+        Chunk& part = parts[chunk];
+        part.counts.resize(end - begin);
+        QVector<double> accumulator(n, 0.0);
+        QVector<qsizetype> marker(n, -1);
+        QVector<int> touched;
+
+        for (qsizetype j = begin; j < end; ++j) {
+            touched.clear();
+            for (qsizetype p = csc.m_outer[j]; p < csc.m_outer[j + 1]; ++p) {
+                const int row = csc.m_inner[p];
+                if (weighted && weights[row] == 0.0) {
+                    continue;   // 剔除的行可能含 NaN，不能靠乘 0 消去
+                }
+                const double scale = csc.m_values[p] * (weighted ? weights[row] : 1.0);
+                if (scale == 0.0) {
+                    continue;
+                }
+                for (qsizetype q = csr.m_outer[row]; q < csr.m_outer[row + 1]; ++q) {
+                    const int k = csr.m_inner[q];
+                    if (marker[k] != j) {
+                        marker[k] = j;
+                        accumulator[k] = 0.0;
+                        touched.append(k);
+                    }
+                    accumulator[k] += scale * csr.m_values[q];
+                }
+            }
+
+            std::sort(touched.begin(), touched.end());
+            for (int k : touched) {
+                part.inner.append(k);
+                part.values.append(accumulator[k]);
+            }
+            part.counts[j - begin] = touched.size();
+        }
+    });
+
+    SparseMatrix result(n, n, SparseFormat::CSC);
+    qsizetype column = 0;
+    for (const Chunk& part : parts) {
+        for (qsizetype count : part.counts) {
+            result.m_outer[column + 1] = result.m_outer[column] + count;
+            ++column;
+        }
+        result.m_inner.append(part.inner);
+        result.m_values.append(part.values);
+    }
+    return result;
+}
+
+// === 设计矩阵 ===
+
+SparseDesign SparseDesign::build(const Core::TableData& table, const QVector<int>& numericColumns,
+                                 const QVector<int>& categoricalColumns, const SparseDesignOptions& options)
+{
+    QVector<int> all = numericColumns + categoricalColumns;
+    if (options.responseColumn >= 0) {
+        all.append(options.responseColumn);
+    }
+    for (int column : all) {
+        if (column < 0 || column >= table.columnCount()) {
+            return invalidDesign(QString("列索引无效: %1").arg(column));
+        }
+    }
+    if (numericColumns.isEmpty() && categoricalColumns.isEmpty()) {
+        return invalidDesign("至少需要一个自变量");
+    }
+
+    const qsizetype rows = table.rowCount();
+    const int numeric = numericColumns.size();
+    const bool hasResponse = options.responseColumn >= 0;
+
+    // === 读取数值列与因变量（各列连续存放） ===
+    QVector<QVector<double>> values(numeric + (hasResponse ? 1 : 0), QVector<double>(rows));
+    Parallel::forChunks(rows, Parallel::chunkCount(rows, MIN_ROWS_PER_CHUNK), [&](int, qsizetype begin, qsizetype end) {
+        for (int c = 0; c < values.size(); ++c) {
+            const int source = c < numeric ? numericColumns[c] : options.responseColumn;
+            double* out = values[c].data();
+            for (qsizetype row = begin; row < end; ++row) {
+                out[row] = cellToDouble(table.at(static_cast<int>(row), source));
+            }
+        }
+    });
+
+    QVector<QSharedPointer<const Core::ColumnDictionary>> dictionaries;
+    for (int column : categoricalColumns) {
+        dictionaries.append(Core::ColumnDictionary::cached(table, column));
+    }
+
+    // === 完整的行 ===
+    SparseDesign design;
+    design.numericColumns = numeric;
+    for (qsizetype row = 0; row < rows; ++row) {
+        bool complete = true;
+        for (int c = 0; c < values.size() && complete; ++c) {
+            complete = std::isfinite(values[c][row]);
+        }
+        for (int c = 0; c < dictionaries.size() && complete; ++c) {
+            complete = dictionaries[c]->codes[row] != Core::ColumnDictionary::NULL_CODE;
+        }
+        if (complete) {
+            design.sourceRows.append(static_cast<int>(row));
+        }
+    }
+    if (design.sourceRows.isEmpty()) {
+        return invalidDesign("没有完整的数据行");
+    }
+    const qsizetype n = design.sourceRows.size();
+
+    // === 列：数值列在前，之后是各分类变量的哑变量 ===
+    const int drop = options.dropFirstLevel ? 1 : 0;
+    QVector<int> offsets;
+    qsizetype cols = numeric;
+    for (int c = 0; c < numeric; ++c) {
+        design.names.append(table.header(numericColumns[c]));
+    }
+    for (int c = 0; c < dictionaries.size(); ++c) {
+        offsets.append(static_cast<int>(cols));
+        const QString name = table.header(categoricalColumns[c]);
+        for (int code = drop; code < dictionaries[c]->categoryCount(); ++code) {
+            design.names.append(QString("%1=%2").arg(name, dictionaries[c]->labels[code]));
+        }
+        cols += std::max(0, dictionaries[c]->categoryCount() - drop);
+    }
+    if (!indexFits(cols)) {
+        return invalidDesign("哑变量个数超出范围");
+    }
+
+    design.centers.fill(0.0, cols);
+    if (options.centerNumeric) {
+        for (int c = 0; c < numeric; ++c) {
+            double sum = 0.0;
+            for (int row : design.sourceRows) {
+                sum += values[c][row];
+            }
+            design.centers[c] = sum / n;
+        }
+    }
+    if (hasResponse) {
+        design.response.resize(n);
+        for (qsizetype i = 0; i < n; ++i) {
+            design.response[i] = values[numeric][design.sourceRows[i]];
+        }
+    }
+
+    // === 压缩数组：先数每行的非零元，再并行填充 ===
+    QVector<qsizetype> outer(n + 1, 0);
+    for (qsizetype i = 0; i < n; ++i) {
+        qsizetype count = numeric;
+        for (const auto& dictionary : dictionaries) {
+            count += dictionary->codes[design.sourceRows[i]] >= drop ? 1 : 0;
+        }
+        outer[i + 1] = outer[i] + count;
+    }
+
+    QVector<int> inner(outer[n]);
+    QVector<double> entries(outer[n]);
+    Parallel::forChunks(n, Parallel::chunkCount(n, MIN_ROWS_PER_CHUNK), [&](int, qsizetype begin, qsizetype end) {
+        for (qsizetype i = begin; i < end; ++i) {
+            const int row = design.sourceRows[i];
+            qsizetype out = outer[i];
+            for (int c = 0; c < numeric; ++c) {
+                inner[out] = c;
+                entries[out] = values[c][row] - design.centers[c];
+                ++out;
+            }
+            for (int c = 0; c < dictionaries.size(); ++c) {
+                const int code = dictionaries[c]->codes[row];
+                if (code >= drop) {
+                    inner[out] = offsets[c] + code - drop;
+                    entries[out] = 1.0;
+                    ++out;
+                }
+            }
+        }
+    });
+
+    design.matrix = SparseMatrix::fromCompressed(n, cols, SparseFormat::CSR, outer, inner, entries);
+    return design;
+}
+
+} // namespace Statistics
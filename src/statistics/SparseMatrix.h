@@ -0,0 +1,207 @@
+#ifndef SPARSEMATRIX_H
+#define SPARSEMATRIX_H
+
+#include "DenseMatrix.h"
+#include "core/ColumnDictionary.h"
+#include "core/TableData.h"
+#include <QVector>
+#include <QString>
+#include <QStringList>
+
+namespace Statistics {
+
+/**
+ * @brief 稀疏矩阵的压缩格式
+ */
+enum class SparseFormat
+{
+    CSR,        // 按行压缩：outer 为行，inner 为列下标
+    CSC         // 按列压缩：outer 为列，inner 为行下标
+};
+
+/**
+ * @brief 稀疏矩阵的一个元素（三元组）
+ */
+struct SparseEntry
+{
+    int row = 0;
+    int col = 0;
+    double value = 0.0;
+};
+
+/**
+ * @brief 压缩存储的稀疏矩阵（CSR / CSC）
+ *
+ * 只保存非零元：outerIndex 长度为外维 + 1，第 k 个外维元素的非零元位于
+ * [outerIndex[k], outerIndex[k+1])，innerIndex 为其内维下标（升序），values
+ * 为对应数值。行、列下标用 int 存放（与 TableData 的行号一致），每个非零元
+ * 占 12 字节。
+ *
+ * 三个数组都是隐式共享的 QVector，因此 transposed() 只交换维度与格式，
+ * 不复制数据；需要另一种格式时用 toFormat() 做一次 O(nnz) 的转换。
+ */
+class SparseMatrix
+{
+public:
+    SparseMatrix() = default;
+
+    /**
+     * @brief rows×cols 的零矩阵
+     */
+    SparseMatrix(qsizetype rows, qsizetype cols, SparseFormat format = SparseFormat::CSR);
+
+    // === 构造 ===
+
+    /**
+     * @brief 由三元组构造（顺序任意，重复位置的值相加）
+     * @return 下标越界时输出警告并返回空矩阵
+     */
+    static SparseMatrix fromEntries(qsizetype rows, qsizetype cols, const QVector<SparseEntry>& entries,
+                                    SparseFormat format = SparseFormat::CSR);
+
+    /**
+     * @brief 直接采用压缩数组（检查长度、单调性与下标范围）
+     */
+    static SparseMatrix fromCompressed(qsizetype rows, qsizetype cols, SparseFormat format,
+                                       const QVector<qsizetype>& outerIndex, const QVector<int>& innerIndex,
+                                       const QVector<double>& values);
+
+    /**
+     * @brief 从稠密矩阵构造，绝对值不超过 tolerance 的元素视为 0
+     */
+    static SparseMatrix fromDense(const ConstMatrixView& dense, SparseFormat format = SparseFormat::CSR,
+                                  double tolerance = 0.0);
+
+    /**
+     * @brief 字典编码列的独热编码（CSR，每行至多一个 1）
+     * @param dropFirst 省略编码 0 对应的类别（作为参照水平，避免与截距共线）
+     *
+     * 空单元格所在的行为全 0 行。
+     */
+    static SparseMatrix oneHot(const Core::ColumnDictionary& dictionary, bool dropFirst = false);
+
+    /**
+     * @brief 左右拼接行数相同的若干矩阵（结果为 CSR）
+     */
+    static SparseMatrix horizontalConcat(const QVector<SparseMatrix>& blocks);
+
+    // === 转换 ===
+
+    SparseMatrix toFormat(SparseFormat format) const;
+
+    /**
+     * @brief 转置（CSR 的转置即同一组数组解释为 CSC，不复制数据）
+     */
+    SparseMatrix transposed() const;
+
+    DenseMatrix toDense(MatrixLayout layout = MatrixLayout::RowMajor) const;
+
+    // === 访问 ===
+
+    qsizetype rows() const { return m_rows; }
+    qsizetype cols() const { return m_cols; }
+    qsizetype nonZeros() const { return m_values.size(); }
+    bool isEmpty() const { return m_rows == 0 || m_cols == 0; }
+    SparseFormat format() const { return m_format; }
+
+    /**
+     * @brief 非零元占全部元素的比例
+     */
+    double density() const;
+
+    /**
+     * @brief 占用的内存（字节）
+     */
+    qint64 memoryCost() const;
+
+    /**
+     * @brief 元素 (i, j)（在外维内二分查找，未存储时为 0）
+     */
+    double coeff(qsizetype i, qsizetype j) const;
+
+    const QVector<qsizetype>& outerIndex() const { return m_outer; }
+    const QVector<int>& innerIndex() const { return m_inner; }
+    const QVector<double>& values() const { return m_values; }
+
+    // === 运算 ===
+
+    /**
+     * @brief 稀疏矩阵乘向量 y = A·x
+     *
+     * CSR 按行块并行（每行一次点积）；CSC 按列块并行累加到各块的局部结果后合并。
+     * 维度不匹配时输出警告并返回空向量。
+     */
+    QVector<double> multiply(const QVector<double>& x) const;
+
+    /**
+     * @brief y = Aᵀ·x（等价于 transposed().multiply(x)）
+     */
+    QVector<double> multiplyTransposed(const QVector<double>& x) const;
+
+    /**
+     * @brief 稀疏乘稠密 C = A·B（结果为行优先的稠密矩阵）
+     */
+    DenseMatrix multiply(const ConstMatrixView& B) const;
+
+    /**
+     * @brief 加权叉积矩阵 XᵀWX（W 为对角阵，weights 为空时取单位阵，结果为 CSC）
+     *
+     * 按列的 Gustavson 算法：第 j 列为 Σ_i w_i·X_ij·X_i·，每列用稠密累加器
+     * 与标记数组收集非零位置。总运算量为 Σ_i nnz(第 i 行)²，独热编码的
+     * 设计矩阵每行只有少数非零元，百万行也只需很少的时间；各列块并行计算。
+     * 权重为 0 的行不参与（可用于剔除缺失行）。
+     */
+    SparseMatrix gram(const QVector<double>& weights = QVector<double>()) const;
+
+private:
+    qsizetype outerSize() const { return m_format == SparseFormat::CSR ? m_rows : m_cols; }
+    qsizetype innerSize() const { return m_format == SparseFormat::CSR ? m_cols : m_rows; }
+
+    qsizetype m_rows = 0;
+    qsizetype m_cols = 0;
+    SparseFormat m_format = SparseFormat::CSR;
+    QVector<qsizetype> m_outer;
+    QVector<int> m_inner;
+    QVector<double> m_values;
+};
+
+/**
+ * @brief 设计矩阵构造参数
+ */
+struct SparseDesignOptions
+{
+    int responseColumn = -1;        // 因变量列（-1 表示不读取）
+    bool dropFirstLevel = true;     // 每个分类变量省略第一个类别（参照水平）
+    bool centerNumeric = false;     // 数值列减去有效行的均值（改善正规方程的条件数）
+};
+
+/**
+ * @brief 由表格构造的稀疏设计矩阵
+ *
+ * 列依次为数值列与各分类列的哑变量（按字典编码顺序）。任一数值列、
+ * 因变量为 NaN 或分类列为空的行整行剔除，sourceRows 记录矩阵各行
+ * 对应的表格行。
+ */
+struct SparseDesign
+{
+    SparseMatrix matrix;                // CSR
+    QVector<double> response;           // 与 matrix 各行对应的因变量
+    QStringList names;                  // 各列名称（哑变量为“列名=取值”）
+    QVector<double> centers;            // 各列减去的中心值（未中心化的列为 0）
+    QVector<int> sourceRows;
+    int numericColumns = 0;             // 前 numericColumns 列为数值列
+
+    bool isValid = true;
+    QString errorMessage;
+
+    /**
+     * @brief 读取数值列与分类列（分类列使用缓存的字典编码）
+     */
+    static SparseDesign build(const Core::TableData& table, const QVector<int>& numericColumns,
+                              const QVector<int>& categoricalColumns,
+                              const SparseDesignOptions& options = SparseDesignOptions());
+};
+
+} // namespace Statistics
+
+#endif // SPARSEMATRIX_H
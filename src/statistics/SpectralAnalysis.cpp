@@ -0,0 +1,350 @@
+#include "SpectralAnalysis.h"
+#include "ColumnReader.h"
+#include "FFT.h"
+#include "Distributions.h"
+#include "ParallelUtils.h"
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+
+namespace Statistics {
+
+namespace {
+
+// 读取表格列时每块的最少行数
+const qsizetype MIN_ROWS_PER_CHUNK = 16384;
+
+// 自相关图给出的候选周期个数
+const int MAX_SUGGESTED_PERIODS = 3;
+
+/**
+ * @brief 去均值后的序列（mask 为假或非有限值的位置写 0）
+ * @return 参与计算的有效值个数
+ */
+qint64 centered(const QVector<double>& values, const QVector<bool>& mask, QVector<double>* out, double* mean)
+{
+    const qsizetype n = values.size();
+    qint64 count = 0;
+    double sum = 0.0;
+    for (qsizetype i = 0; i < n; ++i) {
+        if (mask[i]) {
+            sum += values[i];
+            ++count;
+        }
+    }
+
+    *mean = count > 0 ? sum / static_cast<double>(count) : 0.0;
+    out->resize(n);
+    double* x = out->data();
+    for (qsizetype i = 0; i < n; ++i) {
+        x[i] = mask[i] ? values[i] - *mean : 0.0;
+    }
+    return count;
+}
+
+QVector<bool> finiteMask(const QVector<double>& values)
+{
+    QVector<bool> mask(values.size());
+    for (qsizetype i = 0; i < values.size(); ++i) {
+        mask[i] = std::isfinite(values[i]);
+    }
+    return mask;
+}
+
+int defaultMaxLag(qsizetype n, int maxLag)
+{
+    if (maxLag <= 0) {
+        maxLag = static_cast<int>(std::floor(10.0 * std::log10(static_cast<double>(n))));
+    }
+    return static_cast<int>(std::clamp<qsizetype>(maxLag, 1, n - 1));
+}
+
+double confidenceBound(double confidence, qint64 count)
+{
+    return Distributions::normalQuantile(0.5 * (1.0 + confidence)) / std::sqrt(static_cast<double>(count));
+}
+
+/**
+ * @brief Durbin–Levinson 递推由自相关系数求偏自相关系数
+ */
+QVector<double> partialAutocorrelation(const QVector<double>& acf)
+{
+    const int maxLag = static_cast<int>(acf.size()) - 1;
+    QVector<double> pacf(maxLag + 1, qQNaN());
+    pacf[0] = 1.0;
+    if (maxLag < 1) {
+        return pacf;
+    }
+
+    QVector<double> phi(maxLag + 1, 0.0);
+    QVector<double> previous(maxLag + 1, 0.0);
+    phi[1] = acf[1];
+    pacf[1] = acf[1];
+    double variance = 1.0 - acf[1] * acf[1];
+
+    for (int k = 2; k <= maxLag; ++k) {
+        if (variance <= 0.0) {
+            break;      // 序列可被完全预测，更高阶无定义
+        }
+
+        double numerator = acf[k];
+        for (int j = 1; j < k; ++j) {
+            numerator -= phi[j] * acf[k - j];
+        }
+        const double phiKK = numerator / variance;
+
+        previous = phi;
+        for (int j = 1; j < k; ++j) {
+            phi[j] = previous[j] - phiKK * previous[k - j];
+        }
+        phi[k] = phiKK;
+        pacf[k] = phiKK;
+        variance *= 1.0 - phiKK * phiKK;
+    }
+
+    return pacf;
+}
+
+} // namespace
+
+// === 自相关 ===
+
+CorrelogramResult SpectralAnalysis::autocorrelation(const QVector<double>& values, int maxLag, double confidence)
+{
+    CorrelogramResult result;
+    result.confidenceLevel = confidence;
+
+    QVector<double> x;
+    result.observations = centered(values, finiteMask(values), &x, &result.mean);
+    if (result.observations < 3) {
+        result.isValid = false;
+        result.errorMessage = "有效数据不足（至少需要 3 个）";
+        return result;
+    }
+
+    result.maxLag = defaultMaxLag(values.size(), maxLag);
+    QVector<double> sums = FFT::autocorrelation(x.constData(), x.size(), result.maxLag);
+    if (!(sums[0] > 0.0)) {
+        result.isValid = false;
+        result.errorMessage = "序列为常数，无法计算自相关";
+        return result;
+    }
+
+    result.variance = sums[0] / static_cast<double>(result.observations);
+    result.acf.resize(result.maxLag + 1);
+    for (int k = 0; k <= result.maxLag; ++k) {
+        result.acf[k] = sums[k] / sums[0];
+    }
+    result.acf[0] = 1.0;
+    result.pacf = partialAutocorrelation(result.acf);
+    result.confidenceBound = confidenceBound(confidence, result.observations);
+
+    // 显著的局部峰值作为候选季节周期
+    QVector<int> peaks;
+    for (int k = 2; k < result.maxLag; ++k) {
+        if (result.acf[k] > result.confidenceBound &&
+            result.acf[k] > result.acf[k - 1] && result.acf[k] >= result.acf[k + 1]) {
+            peaks.append(k);
+        }
+    }
+    std::stable_sort(peaks.begin(), peaks.end(), [&](int a, int b) {
+        return result.acf[a] > result.acf[b];
+    });
+    result.suggestedPeriods = peaks.mid(0, MAX_SUGGESTED_PERIODS);
+
+    return result;
+}
+
+CorrelogramResult SpectralAnalysis::autocorrelation(const Core::TableData& table, int column, int maxLag,
+                                                    double confidence)
+{
+    if (column < 0 || column >= table.columnCount()) {
+        CorrelogramResult result;
+        result.isValid = false;
+        result.errorMessage = "列索引无效";
+        return result;
+    }
+    return autocorrelation(columnSeries(table, column), maxLag, confidence);
+}
+
+// === 互相关 ===
+
+CrossCorrelationResult SpectralAnalysis::crossCorrelation(const QVector<double>& x, const QVector<double>& y,
+                                                          int maxLag, double confidence)
+{
+    CrossCorrelationResult result;
+    result.confidenceLevel = confidence;
+
+    if (x.size() != y.size()) {
+        result.isValid = false;
+        result.errorMessage = "两个序列长度不一致";
+        return result;
+    }
+
+    QVector<bool> mask(x.size());
+    for (qsizetype i = 0; i < x.size(); ++i) {
+        mask[i] = std::isfinite(x[i]) && std::isfinite(y[i]);
+    }
+
+    QVector<double> cx;
+    QVector<double> cy;
+    double meanX = 0.0;
+    double meanY = 0.0;
+    result.observations = centered(x, mask, &cx, &meanX);
+    centered(y, mask, &cy, &meanY);
+    if (result.observations < 3) {
+        result.isValid = false;
+        result.errorMessage = "两列同时有效的数据不足（至少需要 3 个）";
+        return result;
+    }
+
+    double sxx = 0.0;
+    double syy = 0.0;
+    for (qsizetype i = 0; i < cx.size(); ++i) {
+        sxx += cx[i] * cx[i];
+        syy += cy[i] * cy[i];
+    }
+    if (!(sxx > 0.0) || !(syy > 0.0)) {
+        result.isValid = false;
+        result.errorMessage = "序列为常数，无法计算互相关";
+        return result;
+    }
+
+    result.maxLag = defaultMaxLag(x.size(), maxLag);
+    result.values = FFT::crossCorrelation(cx.constData(), cy.constData(), cx.size(), result.maxLag);
+    const double scale = 1.0 / std::sqrt(sxx * syy);
+    for (double& value : result.values) {
+        value *= scale;
+    }
+    result.confidenceBound = confidenceBound(confidence, result.observations);
+
+    for (int k = -result.maxLag; k <= result.maxLag; ++k) {
+        double value = result.values[k + result.maxLag];
+        if (std::abs(value) > std::abs(result.peakValue)) {
+            result.peakValue = value;
+            result.peakLag = k;
+        }
+    }
+
+    return result;
+}
+
+CrossCorrelationResult SpectralAnalysis::crossCorrelation(const Core::TableData& table, int xColumn, int yColumn,
+                                                          int maxLag, double confidence)
+{
+    if (xColumn < 0 || xColumn >= table.columnCount() || yColumn < 0 || yColumn >= table.columnCount()) {
+        CrossCorrelationResult result;
+        result.isValid = false;
+        result.errorMessage = "列索引无效";
+        return result;
+    }
+    return crossCorrelation(columnSeries(table, xColumn), columnSeries(table, yColumn), maxLag, confidence);
+}
+
+// === 周期图 ===
+
+PeriodogramResult SpectralAnalysis::periodogram(const QVector<double>& values, bool detrend, int peakCount)
+{
+    PeriodogramResult result;
+
+    QVector<bool> mask = finiteMask(values);
+    QVector<double> x;
+    double mean = 0.0;
+    result.observations = centered(values, mask, &x, &mean);
+    if (result.observations < 4) {
+        result.isValid = false;
+        result.errorMessage = "有效数据不足（至少需要 4 个）";
+        return result;
+    }
+
+    if (detrend) {
+        // 对有效位置做 x ~ t 的最小二乘，x 已去均值，只需中心化 t
+        double sumT = 0.0;
+        for (qsizetype t = 0; t < x.size(); ++t) {
+            if (mask[t]) {
+                sumT += static_cast<double>(t);
+            }
+        }
+        const double meanT = sumT / static_cast<double>(result.observations);
+        double stt = 0.0;
+        double stx = 0.0;
+        for (qsizetype t = 0; t < x.size(); ++t) {
+            if (mask[t]) {
+                double dt = static_cast<double>(t) - meanT;
+                stt += dt * dt;
+                stx += dt * x[t];
+            }
+        }
+        const double slope = stx / stt;
+        for (qsizetype t = 0; t < x.size(); ++t) {
+            if (mask[t]) {
+                x[t] -= slope * (static_cast<double>(t) - meanT);
+            }
+        }
+    }
+
+    result.transformSize = FFT::paddedSize(x.size());
+    QVector<Complex> spectrum = FFT::realForward(x, result.transformSize);
+
+    const qsizetype bins = result.transformSize / 2;
+    const double n = static_cast<double>(result.observations);
+    result.frequencies.resize(bins);
+    result.power.resize(bins);
+    for (qsizetype k = 1; k <= bins; ++k) {
+        result.frequencies[k - 1] = static_cast<double>(k) / static_cast<double>(result.transformSize);
+        result.power[k - 1] = std::norm(spectrum[k]) / n;
+    }
+
+    QVector<qsizetype> peaks;
+    for (qsizetype i = 0; i < bins; ++i) {
+        bool left = i == 0 || result.power[i] > result.power[i - 1];
+        bool right = i + 1 == bins || result.power[i] >= result.power[i + 1];
+        if (left && right && result.power[i] > 0.0) {
+            peaks.append(i);
+        }
+    }
+    std::stable_sort(peaks.begin(), peaks.end(), [&](qsizetype a, qsizetype b) {
+        return result.power[a] > result.power[b];
+    });
+    for (qsizetype i = 0; i < std::min<qsizetype>(peaks.size(), std::max(0, peakCount)); ++i) {
+        SpectralPeak peak;
+        peak.frequency = result.frequencies[peaks[i]];
+        peak.period = 1.0 / peak.frequency;
+        peak.power = result.power[peaks[i]];
+        result.peaks.append(peak);
+    }
+
+    return result;
+}
+
+PeriodogramResult SpectralAnalysis::periodogram(const Core::TableData& table, int column, bool detrend,
+                                                int peakCount)
+{
+    if (column < 0 || column >= table.columnCount()) {
+        PeriodogramResult result;
+        result.isValid = false;
+        result.errorMessage = "列索引无效";
+        return result;
+    }
+    return periodogram(columnSeries(table, column), detrend, peakCount);
+}
+
+// === 数据读取 ===
+
+QVector<double> SpectralAnalysis::columnSeries(const Core::TableData& table, int column)
+{
+    const qsizetype rows = table.rowCount();
+    QVector<double> series(rows);
+    double* out = series.data();
+
+    Parallel::forChunks(rows, Parallel::chunkCount(rows, MIN_ROWS_PER_CHUNK),
+                        [&](int, qsizetype begin, qsizetype end) {
+        for (qsizetype row = begin; row < end; ++row) {
+            out[row] = cellToDouble(table.at(static_cast<int>(row), column));
+        }
+    });
+
+    return series;
+}
+
+} // namespace Statistics
@@ -0,0 +1,137 @@
+#ifndef SPECTRALANALYSIS_H
+#define SPECTRALANALYSIS_H
+
+#include "core/TableData.h"
+#include <QVector>
+#include <QString>
+
+namespace Statistics {
+
+/**
+ * @brief 自相关图结果（ACF 与 PACF）
+ */
+struct CorrelogramResult
+{
+    qint64 observations = 0;            // 有效值个数（缺失值按 0 偏差参与，不计入）
+    double mean = 0.0;
+    double variance = 0.0;              // 滞后 0 的自协方差（除以 n）
+    int maxLag = 0;
+
+    QVector<double> acf;                // 滞后 0..maxLag 的自相关系数，acf[0] = 1
+    QVector<double> pacf;               // 滞后 0..maxLag 的偏自相关系数，pacf[0] = 1
+    double confidenceLevel = 0.95;
+    double confidenceBound = 0.0;       // 白噪声假设下的置信界 ±z/√n
+
+    QVector<int> suggestedPeriods;      // ACF 中超出置信界的局部峰值所在滞后，按相关系数降序
+
+    bool isValid = true;
+    QString errorMessage;
+};
+
+/**
+ * @brief 互相关结果
+ *
+ * values[k + maxLag] 为 x_(t+k) 与 y_t 的相关系数（k = -maxLag..maxLag），
+ * k > 0 表示 y 领先 x k 期。
+ */
+struct CrossCorrelationResult
+{
+    qint64 observations = 0;            // 两列同时有效的行数
+    int maxLag = 0;
+    QVector<double> values;
+    double confidenceLevel = 0.95;
+    double confidenceBound = 0.0;
+
+    int peakLag = 0;                    // 绝对值最大的相关系数所在滞后
+    double peakValue = 0.0;
+
+    bool isValid = true;
+    QString errorMessage;
+};
+
+/**
+ * @brief 周期图峰值
+ */
+struct SpectralPeak
+{
+    double frequency = 0.0;             // 每期周期数
+    double period = 0.0;                // 1 / frequency
+    double power = 0.0;
+};
+
+/**
+ * @brief 周期图结果
+ *
+ * 序列去均值（可选去线性趋势）后补零到 2 的幂 N，
+ * I(k/N) = |Σ x_t·e^(-2πitk/N)|² / n，k = 1..N/2。
+ */
+struct PeriodogramResult
+{
+    qint64 observations = 0;
+    qsizetype transformSize = 0;
+    QVector<double> frequencies;
+    QVector<double> power;
+    QVector<SpectralPeak> peaks;        // 功率最大的局部峰值，按功率降序
+
+    bool isValid = true;
+    QString errorMessage;
+};
+
+/**
+ * @brief 基于 FFT 的时间序列诊断：自相关、偏自相关、互相关与周期图
+ *
+ * 自相关与互相关通过补零后的功率谱/互谱的逆变换一次得到全部滞后，
+ * 复杂度 O(n log n)，与最大滞后无关。缺失值（NaN）在去均值后按 0 处理，
+ * 各滞后统一除以有效值个数，即相关系数仍落在 [-1, 1] 内。
+ */
+class SpectralAnalysis
+{
+public:
+    /**
+     * @brief 自相关与偏自相关
+     * @param maxLag 最大滞后（0 表示自动取 min(n-1, 10·log10(n))）
+     * @param confidence 置信界的置信水平
+     */
+    static CorrelogramResult autocorrelation(const QVector<double>& values, int maxLag = 0,
+                                             double confidence = 0.95);
+
+    /**
+     * @brief 表格列（按行顺序，非数值单元格视为缺失）的自相关与偏自相关
+     */
+    static CorrelogramResult autocorrelation(const Core::TableData& table, int column, int maxLag = 0,
+                                             double confidence = 0.95);
+
+    /**
+     * @brief 两个等长序列的互相关（只使用两者同时有效的位置）
+     */
+    static CrossCorrelationResult crossCorrelation(const QVector<double>& x, const QVector<double>& y,
+                                                   int maxLag = 0, double confidence = 0.95);
+
+    /**
+     * @brief 表格两列的互相关
+     */
+    static CrossCorrelationResult crossCorrelation(const Core::TableData& table, int xColumn, int yColumn,
+                                                   int maxLag = 0, double confidence = 0.95);
+
+    /**
+     * @brief 周期图
+     * @param detrend 是否先去除线性趋势
+     * @param peakCount 返回的峰值个数
+     */
+    static PeriodogramResult periodogram(const QVector<double>& values, bool detrend = true, int peakCount = 5);
+
+    /**
+     * @brief 表格列的周期图
+     */
+    static PeriodogramResult periodogram(const Core::TableData& table, int column, bool detrend = true,
+                                         int peakCount = 5);
+
+    /**
+     * @brief 按行顺序读取表格列（非数值单元格为 NaN）
+     */
+    static QVector<double> columnSeries(const Core::TableData& table, int column);
+};
+
+} // namespace Statistics
+
+#endif // SPECTRALANALYSIS_H
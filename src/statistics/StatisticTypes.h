@@ -21,6 +21,27 @@ struct StatisticResult
     static StatisticResult error(const QString& message);
 };
 
+/**
+ * @brief 频数统计条目
+ */
+struct FrequencyItem
+{
+    QString label;           // 取值（文本形式）
+    double value = 0.0;      // 取值（数值列有效）
+    qint64 count = 0;        // 出现次数（近似算法中为上界）
+    qint64 error = 0;        // 计数的最大高估量（精确计数时为 0）
+};
+
+/**
+ * @brief 高频值（Top-K）结果
+ */
+struct TopKResult
+{
+    QVector<FrequencyItem> items;  // 按出现次数降序排列
+    qint64 total = 0;              // 参与统计的有效值个数
+    bool exact = true;             // 是否为精确计数
+};
+
 /**
  * @brief 描述性统计汇总
  */
@@ -42,6 +63,8 @@ struct DescriptiveSummary
     double skewness = 0.0;   // 偏度
     double kurtosis = 0.0;   // 峰度
 
+    QVector<FrequencyItem> topValues;  // 高频值
+
     // 计算所有统计量
     void calculate(const QVector<double>& data);
 };
@@ -54,7 +77,31 @@ enum class ForecastMethod
     SimpleMovingAverage,    // 简单移动平均
     WeightedMovingAverage,  // 加权移动平均
     ExponentialSmoothing,   // 指数平滑
-    LinearRegression        // 线性回归
+    LinearRegression,       // 线性回归
+    HoltLinear,             // Holt 线性趋势（双指数平滑）
+    HoltWintersAdditive,    // Holt-Winters 加法季节
+    HoltWintersMultiplicative // Holt-Winters 乘法季节
+};
+
+/**
+ * @brief 指数平滑模型
+ */
+enum class SmoothingModel
+{
+    Simple,                     // 简单指数平滑（α）
+    Holt,                       // Holt 线性趋势（α, β）
+    HoltWintersAdditive,        // 加法季节 Holt-Winters（α, β, γ）
+    HoltWintersMultiplicative   // 乘法季节 Holt-Winters（α, β, γ）
+};
+
+/**
+ * @brief 平滑系数
+ */
+struct SmoothingParameters
+{
+    double alpha = 0.3;     // 水平
+    double beta = 0.1;      // 趋势
+    double gamma = 0.1;     // 季节
 };
 
 /**
@@ -0,0 +1,267 @@
+#include "SymmetricEigen.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace Statistics {
+
+namespace {
+
+// 单个特征值的 QL 迭代次数上限（通常 1～2 次即收敛）
+const int MAX_QL_ITERATIONS = 60;
+
+/**
+ * @brief Householder 三对角化（由最后一行向前逐行约化）
+ * @param V 输入为对称矩阵（列优先），输出为累积的正交矩阵 Q
+ * @param d 输出三对角矩阵的对角元
+ * @param e 输出次对角元（e[i] 位于 (i, i-1)，e[0] = 0）
+ */
+void tridiagonalize(DenseMatrix& V, QVector<double>& d, QVector<double>& e)
+{
+    const qsizetype n = V.rows();
+
+    for (qsizetype j = 0; j < n; ++j) {
+        d[j] = V(n - 1, j);
+    }
+
+    for (qsizetype i = n - 1; i > 0; --i) {
+        // 按行 i 左侧元素的 1-范数缩放，避免平方和溢出
+        double scale = 0.0;
+        double h = 0.0;
+        for (qsizetype k = 0; k < i; ++k) {
+            scale += std::abs(d[k]);
+        }
+
+        if (scale == 0.0) {
+            e[i] = d[i - 1];
+            for (qsizetype j = 0; j < i; ++j) {
+                d[j] = V(i - 1, j);
+                V(i, j) = 0.0;
+                V(j, i) = 0.0;
+            }
+        } else {
+            // 生成反射向量 u（存放在 d 中）
+            for (qsizetype k = 0; k < i; ++k) {
+                d[k] /= scale;
+                h += d[k] * d[k];
+            }
+            double f = d[i - 1];
+            double g = std::sqrt(h);
+            if (f > 0.0) {
+                g = -g;
+            }
+            e[i] = scale * g;
+            h -= f * g;
+            d[i - 1] = f - g;
+            for (qsizetype j = 0; j < i; ++j) {
+                e[j] = 0.0;
+            }
+
+            // p = A·u / h（只使用下三角）
+            for (qsizetype j = 0; j < i; ++j) {
+                f = d[j];
+                V(j, i) = f;
+                g = e[j] + V(j, j) * f;
+                const double* column = V.data() + j * n;
+                for (qsizetype k = j + 1; k < i; ++k) {
+                    g += column[k] * d[k];
+                    e[k] += column[k] * f;
+                }
+                e[j] = g;
+            }
+
+            // q = p - (uᵀp / 2h)·u
+            f = 0.0;
+            for (qsizetype j = 0; j < i; ++j) {
+                e[j] /= h;
+                f += e[j] * d[j];
+            }
+            const double hh = f / (h + h);
+            for (qsizetype j = 0; j < i; ++j) {
+                e[j] -= hh * d[j];
+            }
+
+            // A = A - u·qᵀ - q·uᵀ（下三角）
+            for (qsizetype j = 0; j < i; ++j) {
+                f = d[j];
+                g = e[j];
+                double* column = V.data() + j * n;
+                for (qsizetype k = j; k < i; ++k) {
+                    column[k] -= f * e[k] + g * d[k];
+                }
+                d[j] = V(i - 1, j);
+                V(i, j) = 0.0;
+            }
+        }
+        d[i] = h;
+    }
+
+    // 累积变换得到 Q
+    for (qsizetype i = 0; i < n - 1; ++i) {
+        V(n - 1, i) = V(i, i);
+        V(i, i) = 1.0;
+        const double h = d[i + 1];
+        double* next = V.data() + (i + 1) * n;
+        if (h != 0.0) {
+            for (qsizetype k = 0; k <= i; ++k) {
+                d[k] = next[k] / h;
+            }
+            for (qsizetype j = 0; j <= i; ++j) {
+                double* column = V.data() + j * n;
+                double g = 0.0;
+                for (qsizetype k = 0; k <= i; ++k) {
+                    g += next[k] * column[k];
+                }
+                for (qsizetype k = 0; k <= i; ++k) {
+                    column[k] -= g * d[k];
+                }
+            }
+        }
+        for (qsizetype k = 0; k <= i; ++k) {
+            next[k] = 0.0;
+        }
+    }
+    for (qsizetype j = 0; j < n; ++j) {
+        d[j] = V(n - 1, j);
+        V(n - 1, j) = 0.0;
+    }
+    V(n - 1, n - 1) = 1.0;
+    e[0] = 0.0;
+}
+
+/**
+ * @brief 三对角矩阵的隐式位移 QL 迭代，旋转同时作用到 V 的列上
+ * @return 某个特征值超过迭代次数上限仍未收敛时返回 false
+ */
+bool implicitQL(DenseMatrix& V, QVector<double>& d, QVector<double>& e)
+{
+    const qsizetype n = V.rows();
+    const double eps = std::numeric_limits<double>::epsilon();
+
+    for (qsizetype i = 1; i < n; ++i) {
+        e[i - 1] = e[i];
+    }
+    e[n - 1] = 0.0;
+
+    double f = 0.0;
+    double tst1 = 0.0;
+    for (qsizetype l = 0; l < n; ++l) {
+        // 找到第一个可忽略的次对角元，分裂出未约化的子块 [l, m]
+        tst1 = std::max(tst1, std::abs(d[l]) + std::abs(e[l]));
+        qsizetype m = l;
+        while (m < n - 1 && std::abs(e[m]) > eps * tst1) {
+            ++m;
+        }
+
+        if (m > l) {
+            int iterations = 0;
+            do {
+                if (++iterations > MAX_QL_ITERATIONS) {
+                    return false;
+                }
+
+                // Wilkinson 位移
+                double g = d[l];
+                double p = (d[l + 1] - g) / (2.0 * e[l]);
+                double r = std::hypot(p, 1.0);
+                if (p < 0.0) {
+                    r = -r;
+                }
+                d[l] = e[l] / (p + r);
+                d[l + 1] = e[l] * (p + r);
+                const double dl1 = d[l + 1];
+                double h = g - d[l];
+                for (qsizetype i = l + 2; i < n; ++i) {
+                    d[i] -= h;
+                }
+                f += h;
+
+                // 从 m 向上追赶凸起
+                p = d[m];
+                double c = 1.0;
+                double c2 = c;
+                double c3 = c;
+                const double el1 = e[l + 1];
+                double s = 0.0;
+                double s2 = 0.0;
+                for (qsizetype i = m - 1; i >= l; --i) {
+                    c3 = c2;
+                    c2 = c;
+                    s2 = s;
+                    g = c * e[i];
+                    h = c * p;
+                    r = std::hypot(p, e[i]);
+                    e[i + 1] = s * r;
+                    s = e[i] / r;
+                    c = p / r;
+                    p = c * d[i] - s * g;
+                    d[i + 1] = h + s * (c * g + s * d[i]);
+
+                    double* left = V.data() + i * n;
+                    double* right = left + n;
+                    for (qsizetype k = 0; k < n; ++k) {
+                        const double x = right[k];
+                        right[k] = s * left[k] + c * x;
+                        left[k] = c * left[k] - s * x;
+                    }
+                }
+                p = -s * s2 * c3 * el1 * e[l] / dl1;
+                e[l] = s * p;
+                d[l] = c * p;
+            } while (std::abs(e[l]) > eps * tst1);
+        }
+        d[l] += f;
+        e[l] = 0.0;
+    }
+    return true;
+}
+
+} // namespace
+
+SymmetricEigenDecomposition::SymmetricEigenDecomposition(const ConstMatrixView& A)
+{
+    if (A.rows() != A.cols()) {
+        m_errorMessage = "矩阵不是方阵";
+        return;
+    }
+
+    const qsizetype n = A.rows();
+    DenseMatrix V(n, n, MatrixLayout::ColumnMajor);
+    for (qsizetype j = 0; j < n; ++j) {
+        for (qsizetype i = j; i < n; ++i) {
+            const double value = A(i, j);
+            if (!std::isfinite(value)) {
+                m_errorMessage = "矩阵含有非有限值";
+                return;
+            }
+            V(i, j) = value;
+            V(j, i) = value;
+        }
+    }
+
+    QVector<double> d(n, 0.0);
+    QVector<double> e(n, 0.0);
+    if (n > 0) {
+        tridiagonalize(V, d, e);
+        if (!implicitQL(V, d, e)) {
+            m_errorMessage = "特征值迭代未收敛";
+            return;
+        }
+    }
+
+    // 按特征值降序重排
+    QVector<qsizetype> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&d](qsizetype a, qsizetype b) { return d[a] > d[b]; });
+
+    m_values.resize(n);
+    m_vectors = DenseMatrix(n, n, MatrixLayout::ColumnMajor);
+    for (qsizetype k = 0; k < n; ++k) {
+        m_values[k] = d[order[k]];
+        std::copy(V.data() + order[k] * n, V.data() + (order[k] + 1) * n, m_vectors.data() + k * n);
+    }
+    m_errorMessage.clear();
+}
+
+} // namespace Statistics
@@ -0,0 +1,50 @@
+#ifndef SYMMETRICEIGEN_H
+#define SYMMETRICEIGEN_H
+
+#include "DenseMatrix.h"
+#include <QVector>
+#include <QString>
+
+namespace Statistics {
+
+/**
+ * @brief 实对称矩阵的特征分解 A = V·Λ·Vᵀ
+ *
+ * 两步完成：
+ * - Householder 变换把 A 约化为三对角矩阵 T = QᵀAQ，同时累积正交矩阵 Q
+ * - 带隐式位移的 QL 迭代求 T 的特征值，每次 Givens 旋转同步作用到 Q 的列上
+ * 总运算量约 9n³，500 阶矩阵不到一秒。Q 按列优先存储，旋转与变换都沿
+ * 连续的列进行。
+ *
+ * 只读取 A 的下三角。特征值按降序排列，eigenvectors() 的第 k 列为第 k 个
+ * 特征值对应的单位特征向量。
+ */
+class SymmetricEigenDecomposition
+{
+public:
+    SymmetricEigenDecomposition() = default;
+    explicit SymmetricEigenDecomposition(const ConstMatrixView& A);
+
+    bool isValid() const { return m_errorMessage.isEmpty(); }
+    QString errorMessage() const { return m_errorMessage; }
+    qsizetype size() const { return m_values.size(); }
+
+    /**
+     * @brief 特征值（降序）
+     */
+    const QVector<double>& eigenvalues() const { return m_values; }
+
+    /**
+     * @brief 特征向量（列优先，n×n，各列正交且为单位长度）
+     */
+    const DenseMatrix& eigenvectors() const { return m_vectors; }
+
+private:
+    QVector<double> m_values;
+    DenseMatrix m_vectors;
+    QString m_errorMessage = "未分解";
+};
+
+} // namespace Statistics
+
+#endif // SYMMETRICEIGEN_H
@@ -1,21 +1,42 @@
 #include "CalcColumnDialog.h"
+#include "DataTableView.h"
+#include "statistics/CachedStatistics.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
-#include <QGroupBox>
 #include <QFormLayout>
 #include <QHeaderView>
 #include <QMessageBox>
 #include <QStandardItemModel>
+#include <QApplication>
+#include <limits>
+
+using namespace Statistics;
+
+namespace {
+
+const RollingStatistic ROLLING_STATISTICS[] = {
+    RollingStatistic::Mean,
+    RollingStatistic::Sum,
+    RollingStatistic::Variance,
+    RollingStatistic::StdDev,
+    RollingStatistic::Min,
+    RollingStatistic::Max,
+    RollingStatistic::Median,
+    RollingStatistic::Count
+};
+
+} // namespace
 
 CalcColumnDialog::CalcColumnDialog(QTableView* tableView, QWidget* parent)
     : QDialog(parent)
     , m_tableView(tableView)
 {
     setWindowTitle("计算列");
-    resize(500, 400);
+    resize(520, 560);
 
-    updateAvailableColumns();
     setupUI();
+    updateAvailableColumns();
+    onOperationChanged(m_operationCombo->currentIndex());
 }
 
 CalcColumnDialog::~CalcColumnDialog() = default;
@@ -24,11 +45,14 @@ void CalcColumnDialog::setupUI()
 {
     auto* layout = new QVBoxLayout(this);
 
-    // 源列选择
+    // 源列选择：两列运算的左右操作数分开选择，减法、除法等不会颠倒
     auto* sourceGroup = new QGroupBox("源列");
-    auto* sourceLayout = new QVBoxLayout();
-    m_sourceColumnsList = new QListWidget();
-    sourceLayout->addWidget(m_sourceColumnsList);
+    auto* sourceLayout = new QFormLayout();
+    m_sourceACombo = new QComboBox();
+    m_sourceBCombo = new QComboBox();
+    m_sourceBLabel = new QLabel("列 B:");
+    sourceLayout->addRow("列 A:", m_sourceACombo);
+    sourceLayout->addRow(m_sourceBLabel, m_sourceBCombo);
     sourceGroup->setLayout(sourceLayout);
     layout->addWidget(sourceGroup);
 
@@ -37,19 +61,24 @@ void CalcColumnDialog::setupUI()
     auto* calcLayout = new QFormLayout();
 
     m_operationCombo = new QComboBox();
-    m_operationCombo->addItem("加法");
-    m_operationCombo->addItem("减法");
-    m_operationCombo->addItem("乘法");
-    m_operationCombo->addItem("除法");
-    m_operationCombo->addItem("百分比");
-    m_operationCombo->addItem("差分");
-    m_operationCombo->addItem("增长率");
+    m_operationCombo->addItem("加法", static_cast<int>(Add));
+    m_operationCombo->addItem("减法", static_cast<int>(Subtract));
+    m_operationCombo->addItem("乘法", static_cast<int>(Multiply));
+    m_operationCombo->addItem("除法", static_cast<int>(Divide));
+    m_operationCombo->addItem("百分比", static_cast<int>(Percentage));
+    m_operationCombo->addItem("差分", static_cast<int>(Difference));
+    m_operationCombo->addItem("增长率", static_cast<int>(GrowthRate));
+    m_operationCombo->insertSeparator(m_operationCombo->count());
+    for (RollingStatistic statistic : ROLLING_STATISTICS) {
+        m_operationCombo->addItem(RollingWindow::statisticName(statistic),
+                                  static_cast<int>(Rolling) + static_cast<int>(statistic));
+    }
 
     connect(m_operationCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
             this, &CalcColumnDialog::onOperationChanged);
 
     m_columnNameEdit = new QLineEdit();
-    m_columnNameEdit->setPlaceholderText("新列名称");
+    m_columnNameEdit->setPlaceholderText("新列名称（留空自动生成）");
 
     calcLayout->addRow("计算类型:", m_operationCombo);
     calcLayout->addRow("新列名称:", m_columnNameEdit);
@@ -57,6 +86,36 @@ void CalcColumnDialog::setupUI()
     calcGroup->setLayout(calcLayout);
     layout->addWidget(calcGroup);
 
+    // 滚动窗口参数
+    m_rollingGroup = new QGroupBox("滚动窗口");
+    auto* rollingLayout = new QFormLayout();
+
+    m_windowSpinBox = new QSpinBox();
+    m_windowSpinBox->setRange(1, std::numeric_limits<int>::max());
+    m_windowSpinBox->setValue(7);
+
+    m_minPeriodsSpinBox = new QSpinBox();
+    m_minPeriodsSpinBox->setRange(0, std::numeric_limits<int>::max());
+    m_minPeriodsSpinBox->setSpecialValueText("同窗口大小");
+    m_minPeriodsSpinBox->setToolTip("窗口内有效值少于该数量时结果为空");
+
+    m_centerCheckBox = new QCheckBox("窗口居中对齐");
+
+    rollingLayout->addRow("窗口大小:", m_windowSpinBox);
+    rollingLayout->addRow("最少有效值:", m_minPeriodsSpinBox);
+    rollingLayout->addRow("", m_centerCheckBox);
+
+    m_rollingGroup->setLayout(rollingLayout);
+    layout->addWidget(m_rollingGroup);
+
+    // 待添加的计算列
+    auto* pendingGroup = new QGroupBox("待添加的列");
+    auto* pendingLayout = new QVBoxLayout();
+    m_calculatedColumnsList = new QListWidget();
+    pendingLayout->addWidget(m_calculatedColumnsList);
+    pendingGroup->setLayout(pendingLayout);
+    layout->addWidget(pendingGroup);
+
     // 按钮
     auto* buttonLayout = new QHBoxLayout();
     m_addButton = new QPushButton("添加列");
@@ -78,7 +137,8 @@ void CalcColumnDialog::setupUI()
 void CalcColumnDialog::updateAvailableColumns()
 {
     m_availableColumns.clear();
-    m_sourceColumnsList->clear();
+    m_sourceACombo->clear();
+    m_sourceBCombo->clear();
 
     if (!m_tableView) return;
 
@@ -88,43 +148,157 @@ void CalcColumnDialog::updateAvailableColumns()
     for (int col = 0; col < model->columnCount(); ++col) {
         QString header = model->headerData(col, Qt::Horizontal).toString();
         m_availableColumns.append(header);
-        m_sourceColumnsList->addItem(header);
+        m_sourceACombo->addItem(header);
+        m_sourceBCombo->addItem(header);
+    }
+
+    // 默认取前两列作为 A、B
+    if (m_sourceBCombo->count() > 1) {
+        m_sourceBCombo->setCurrentIndex(1);
     }
 }
 
+bool CalcColumnDialog::isBinary(int operation)
+{
+    return operation >= Add && operation <= Percentage;
+}
+
 void CalcColumnDialog::onOperationChanged(int index)
 {
-    Q_UNUSED(index);
+    int operation = m_operationCombo->itemData(index).toInt();
+    m_rollingGroup->setEnabled(operation >= Rolling);
+    m_sourceBLabel->setEnabled(isBinary(operation));
+    m_sourceBCombo->setEnabled(isBinary(operation));
 }
 
 void CalcColumnDialog::onAddColumn()
 {
-    QString columnName = m_columnNameEdit->text().trimmed();
+    int operation = m_operationCombo->currentData().toInt();
 
-    if (columnName.isEmpty()) {
-        QMessageBox::warning(this, "错误", "请输入新列名称");
-        return;
+    // 两列运算为 A op B
+    ColumnSpec spec;
+    spec.operation = operation;
+    int required = isBinary(operation) ? 2 : 1;
+    spec.sources.append(m_sourceACombo->currentIndex());
+    if (required == 2) {
+        spec.sources.append(m_sourceBCombo->currentIndex());
+    }
+
+    for (int source : spec.sources) {
+        if (source < 0) {
+            QMessageBox::warning(this, "错误", "请先选择源列");
+            return;
+        }
+    }
+
+    if (operation >= Rolling) {
+        spec.rolling.window = m_windowSpinBox->value();
+        spec.rolling.minPeriods = m_minPeriodsSpinBox->value();
+        spec.rolling.center = m_centerCheckBox->isChecked();
+    }
+
+    QString operationName = m_operationCombo->currentText();
+    QString sourceNames = m_availableColumns[spec.sources[0]];
+    if (required == 2) {
+        sourceNames += ", " + m_availableColumns[spec.sources[1]];
+    }
+
+    spec.name = m_columnNameEdit->text().trimmed();
+    if (spec.name.isEmpty()) {
+        spec.name = operation >= Rolling
+                         ? QString("%1(%2, %3)").arg(operationName, sourceNames).arg(spec.rolling.window)
+                         : QString("%1(%2)").arg(operationName, sourceNames);
     }
 
-    QString operation = m_operationCombo->currentText();
-    QString itemText = QString("%1: %2").arg(columnName, operation);
+    QString itemText = QString("%1: %2 [%3]").arg(spec.name, operationName, sourceNames);
+    if (operation >= Rolling) {
+        itemText += QString(" 窗口 %1").arg(spec.rolling.window);
+    }
 
+    m_pendingColumns.append(spec);
     m_calculatedColumnsList->addItem(itemText);
+    m_columnNameEdit->clear();
 }
 
 void CalcColumnDialog::onRemoveColumn()
 {
-    auto* selectedItem = m_calculatedColumnsList->currentItem();
-    if (!selectedItem) {
+    int row = m_calculatedColumnsList->currentRow();
+    if (row < 0) {
         QMessageBox::information(this, "提示", "请先选择一个计算列");
         return;
     }
 
-    delete selectedItem;
+    m_pendingColumns.remove(row);
+    delete m_calculatedColumnsList->takeItem(row);
 }
 
 void CalcColumnDialog::onApply()
 {
-    QMessageBox::information(this, "提示", "计算列功能将在下一个版本中完整实现");
+    if (m_pendingColumns.isEmpty()) {
+        QMessageBox::information(this, "提示", "请先添加计算列");
+        return;
+    }
+
+    performCalculation();
     accept();
 }
+
+void CalcColumnDialog::performCalculation()
+{
+    auto* view = qobject_cast<DataTableView*>(m_tableView);
+    if (!view || !view->tableData()) {
+        QMessageBox::warning(this, "错误", "无法访问表格数据");
+        return;
+    }
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    for (const ColumnSpec& spec : m_pendingColumns) {
+        view->appendColumn(spec.name, calculate(spec));
+    }
+    QApplication::restoreOverrideCursor();
+}
+
+QVector<double> CalcColumnDialog::calculate(const ColumnSpec& spec) const
+{
+    auto* view = qobject_cast<DataTableView*>(m_tableView);
+    const Core::TableData& table = *view->tableData();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
+    const auto a = CachedStatistics::values(table, spec.sources[0]);
+    const qsizetype n = a->size();
+
+    if (spec.operation >= Rolling) {
+        auto statistic = static_cast<RollingStatistic>(spec.operation - Rolling);
+        return RollingWindow::compute(*a, statistic, spec.rolling);
+    }
+
+    QVector<double> result(n, nan);
+
+    if (spec.operation == Difference || spec.operation == GrowthRate) {
+        for (qsizetype i = 1; i < n; ++i) {
+            double previous = (*a)[i - 1];
+            double change = (*a)[i] - previous;
+            if (spec.operation == Difference) {
+                result[i] = change;
+            } else if (previous != 0.0) {
+                result[i] = change / previous * 100.0;
+            }
+        }
+        return result;
+    }
+
+    const auto b = CachedStatistics::values(table, spec.sources[1]);
+    for (qsizetype i = 0; i < n; ++i) {
+        double x = (*a)[i];
+        double y = (*b)[i];
+        switch (spec.operation) {
+        case Add:        result[i] = x + y; break;
+        case Subtract:   result[i] = x - y; break;
+        case Multiply:   result[i] = x * y; break;
+        case Divide:     result[i] = y != 0.0 ? x / y : nan; break;
+        case Percentage: result[i] = y != 0.0 ? x / y * 100.0 : nan; break;
+        default: break;
+        }
+    }
+    return result;
+}
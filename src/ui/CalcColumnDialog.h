@@ -6,13 +6,19 @@
 #include <QComboBox>
 #include <QLineEdit>
 #include <QListWidget>
+#include <QLabel>
 #include <QPushButton>
+#include <QSpinBox>
+#include <QCheckBox>
+#include <QGroupBox>
 #include <QVector>
+#include "statistics/RollingWindow.h"
 
 /**
  * @brief 计算列对话框
  *
- * 用于基于现有列计算新列
+ * 用于基于现有列计算新列：两列间的四则运算、差分/增长率，
+ * 以及滚动窗口统计（均值、方差、最值、中位数等）
  */
 class CalcColumnDialog : public QDialog
 {
@@ -29,31 +35,50 @@ private slots:
     void onOperationChanged(int index);
 
 private:
+    // 计算类型
+    enum CalculationType {
+        Add,            // 加法
+        Subtract,       // 减法
+        Multiply,       // 乘法
+        Divide,         // 除法
+        Percentage,     // 百分比
+        Difference,     // 差分
+        GrowthRate,     // 增长率
+        Rolling         // 滚动统计（其后依次为各 RollingStatistic）
+    };
+
+    // 待添加的计算列
+    struct ColumnSpec {
+        QString name;
+        int operation = Add;
+        QVector<int> sources;
+        Statistics::RollingOptions rolling;
+    };
+
     void setupUI();
     void updateAvailableColumns();
     void performCalculation();
+    QVector<double> calculate(const ColumnSpec& spec) const;
+    static bool isBinary(int operation);
 
     QTableView* m_tableView;
     QVector<QString> m_availableColumns;
+    QVector<ColumnSpec> m_pendingColumns;
 
     // 界面组件
-    QListWidget* m_sourceColumnsList;
+    QComboBox* m_sourceACombo;          // 单列运算的源列，两列运算的左操作数
+    QComboBox* m_sourceBCombo;          // 两列运算的右操作数
+    QLabel* m_sourceBLabel;
     QListWidget* m_calculatedColumnsList;
     QComboBox* m_operationCombo;
     QLineEdit* m_columnNameEdit;
+    QGroupBox* m_rollingGroup;
+    QSpinBox* m_windowSpinBox;
+    QSpinBox* m_minPeriodsSpinBox;
+    QCheckBox* m_centerCheckBox;
     QPushButton* m_addButton;
     QPushButton* m_removeButton;
     QPushButton* m_applyButton;
-
-    // 计算类型
-    enum CalculationType {
-        Add,            // 加法
-        Subtract,       // 减法
-        Multiply,       // 乘法
-        Percentage,     // 百分比
-        Difference,      // 差分
-        GrowthRate      // 增长率
-    };
 };
 
 #endif // CALCCOLUMNDIALOG_H
@@ -1,9 +1,14 @@
 #include "ChartView.h"
 #include "visualization/ChartHelper.h"
+#include "statistics/CachedStatistics.h"
+#include "core/ResultCache.h"
+#include "visualization/CategoryAggregator.h"
+#include "visualization/Decimation.h"
 #include <QtCharts/QChartView>
 #include <QtCharts/QBarSeries>
 #include <QtCharts/QBarSet>
 #include <QtCharts/QBarCategoryAxis>
+#include <QtCharts/QAbstractBarSeries>
 #include <QtCharts/QValueAxis>
 #include <QtCharts/QPieSeries>
 #include <QtCharts/QPieSlice>
@@ -19,12 +24,22 @@
 #include <QPageSize>
 #include <QDir>
 #include <QImage>
+#include <QWheelEvent>
+#include <QtConcurrent/QtConcurrent>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 ChartView::ChartView(QWidget *parent)
     : QWidget(parent)
     , m_chartView(new QChartView(this))
     , m_currentChart(nullptr)
     , m_tableData(nullptr)
+    , m_column(-1)
+    , m_categoryOffset(0)
+    , m_lodSeries(nullptr)
+    , m_lodAxisX(nullptr)
+    , m_lodAxisY(nullptr)
 {
     auto *mainLayout = new QVBoxLayout(this);
 
@@ -33,13 +48,24 @@ ChartView::ChartView(QWidget *parent)
 
     // 设置图表视图
     m_chartView->setRenderHint(QPainter::Antialiasing);
+    m_chartView->viewport()->installEventFilter(this);
     mainLayout->addWidget(m_chartView);
 
+    connect(&m_pyramidWatcher, &QFutureWatcher<QSharedPointer<const Charts::LodPyramid>>::finished,
+            this, &ChartView::onPyramidReady);
+
+    m_rebuildTimer.setSingleShot(true);
+    m_rebuildTimer.setInterval(100);
+    connect(&m_rebuildTimer, &QTimer::timeout, this, &ChartView::updateChart);
+
     // 创建示例图表
     createSampleChart();
 }
 
-ChartView::~ChartView() = default;
+ChartView::~ChartView()
+{
+    m_pyramidWatcher.waitForFinished();
+}
 
 void ChartView::setupToolbar()
 {
@@ -58,6 +84,7 @@ void ChartView::setupToolbar()
     m_chartTypeCombo->addItem("散点图");
     m_chartTypeCombo->addItem("箱型图");
     m_chartTypeCombo->addItem("水平柱状图");
+    m_chartTypeCombo->addItem("直方图");
     toolbarLayout->addWidget(m_chartTypeCombo);
 
     // 标题编辑
@@ -72,6 +99,12 @@ void ChartView::setupToolbar()
     m_refreshButton = new QPushButton("刷新");
     toolbarLayout->addWidget(m_refreshButton);
 
+    // 逐层查看"其他"后返回
+    m_drillUpButton = new QPushButton("返回上一级");
+    m_drillUpButton->setToolTip("点击柱状图或饼图中的“其他”可查看其中的类别");
+    m_drillUpButton->setEnabled(false);
+    toolbarLayout->addWidget(m_drillUpButton);
+
     // 分辨率设置
     auto *resLabel = new QLabel("分辨率:");
     toolbarLayout->addWidget(resLabel);
@@ -109,6 +142,8 @@ void ChartView::setupToolbar()
             this, &ChartView::onTitleChanged);
     connect(m_refreshButton, &QPushButton::clicked,
             this, &ChartView::refreshChart);
+    connect(m_drillUpButton, &QPushButton::clicked,
+            this, &ChartView::onDrillUp);
     connect(m_saveButton, &QPushButton::clicked,
             this, &ChartView::onSaveImage);
 }
@@ -145,8 +180,20 @@ void ChartView::createSampleChart()
     chart->legend()->setVisible(true);
     chart->legend()->setAlignment(Qt::AlignBottom);
 
+    showChart(chart, QString());
+}
+
+void ChartView::showChart(QChart *chart, const QString &chartType)
+{
+    // QChartView 不负责删除被替换的图表
+    QChart *previous = m_chartView->chart();
     m_chartView->setChart(chart);
     m_currentChart = chart;
+    attachLevelOfDetail(chart, chartType);
+    attachDrillDown(chart);
+    if (previous != chart) {
+        delete previous;
+    }
 }
 
 void ChartView::setChartType(const QString &typeName)
@@ -170,6 +217,11 @@ void ChartView::updateChart()
     style.titleFontSize = 14;
     style.animationEnabled = true;
     style.showLegend = true;
+    // 折线/散点等按视图宽度抽稀，百万行的列也只绘制约 2 倍像素数的点
+    style.plotWidth = m_chartView->viewport()->width();
+    // 柱状图/饼图只显示合计最大的若干类别，其余并入"其他"
+    style.categoryOffset = m_categoryOffset;
+    m_drillUpButton->setEnabled(m_categoryOffset > 0);
 
     QChart* chart = nullptr;
 
@@ -177,6 +229,10 @@ void ChartView::updateChart()
         // 使用真实数据
         m_chartData.title = m_titleEdit->text().isEmpty() ? m_chartData.title : m_titleEdit->text();
 
+        if (chartType == "柱状图" || chartType == "饼图" || chartType == "水平柱状图") {
+            ensureCategories();
+        }
+
         if (chartType == "柱状图") {
             chart = Charts::ChartHelper::createBarChart(m_chartData, style);
         } else if (chartType == "折线图") {
@@ -189,6 +245,8 @@ void ChartView::updateChart()
             chart = Charts::ChartHelper::createBoxPlotChart(m_chartData, style);
         } else if (chartType == "水平柱状图") {
             chart = Charts::ChartHelper::createHorizontalBarChart(m_chartData, style);
+        } else if (chartType == "直方图") {
+            chart = createHistogram(style);
         } else {
             // 未实现的图表类型
             createSampleChart();
@@ -201,14 +259,30 @@ void ChartView::updateChart()
     }
 
     if (chart) {
-        m_chartView->setChart(chart);
-        m_currentChart = chart;
+        showChart(chart, chartType);
     }
 }
 
+QChart* ChartView::createHistogram(const Charts::ChartStyle &style)
+{
+    if (!m_tableData || m_column < 0 || m_column >= m_tableData->columnCount()) {
+        return Charts::ChartHelper::createHistogramChart(m_chartData, style);
+    }
+
+    Statistics::HistogramOptions options;
+    options.method = Statistics::BinningMethod::FreedmanDiaconis;
+    options.computeDensity = true;
+
+    // 列未修改时直接复用缓存的直方图
+    auto histogram = Statistics::CachedStatistics::histogram(*m_tableData, m_column, options);
+    return Charts::ChartHelper::createHistogramChart(*histogram, m_chartData.title,
+                                                     m_chartData.yAxisTitle, style);
+}
+
 void ChartView::onChartTypeChanged(int index)
 {
     Q_UNUSED(index);
+    m_categoryOffset = 0;
     updateChart();
 }
 
@@ -315,42 +389,355 @@ void ChartView::onSaveImage()
 
 void ChartView::setChartData(const Charts::ChartData &data)
 {
+    // 外部直接提供的数据与表格列无关
+    m_column = -1;
+    m_source = Charts::TableColumnAdapter();
     m_chartData = data;
     updateChart();
 }
 
+void ChartView::ensureCategories()
+{
+    if (!m_source.isValid() || !m_chartData.categories.isEmpty()) {
+        return;
+    }
+
+    // 使用第一列作为X轴类别（通常是名称/日期列）
+    m_chartData.categories.reserve(m_source.size());
+    for (int row = 0; row < m_source.size(); ++row) {
+        m_chartData.categories.append(m_source.category(row));
+    }
+}
+
 void ChartView::setTableData(Core::TableData *data, int column)
 {
+    // 再次选中同一列时只同步表格的修改
+    if (data && data == m_tableData && column == m_column && m_source.isValid()) {
+        syncTableData();
+        return;
+    }
+
     m_tableData = data;
+    m_column = column;
+    m_source = Charts::TableColumnAdapter(data, column);
+    loadColumn();
+}
+
+void ChartView::clearTableData()
+{
+    // 类别标签与直方图都按需从表格读取，表格删除后不能再保留指向它的数据源
+    m_tableData = nullptr;
+    m_column = -1;
+    m_source = Charts::TableColumnAdapter();
+    m_chartData = Charts::ChartData();
+    m_categoryOffset = 0;
+
+    // 之后到达的编辑通知因没有数据源而被忽略；等待中的重建与旧金字塔一并丢弃
+    m_rebuildTimer.stop();
+    m_pyramid.reset();
+    updateChart();
+}
 
-    if (!m_tableData || column < 0 || column >= m_tableData->columnCount()) {
+void ChartView::loadColumn()
+{
+    if (!m_source.isValid()) {
         return;
     }
 
     // 从TableData创建ChartData
-    m_chartData.title = m_tableData->header(column);
-    m_chartData.xAxisTitle = m_tableData->header(0);  // 使用第一列的表头（如"月份"）
-    m_chartData.yAxisTitle = m_tableData->header(column);
+    const Core::TableData *table = m_source.table();
+    m_chartData.title = m_source.name();
+    m_chartData.xAxisTitle = table->header(0);  // 使用第一列的表头（如"月份"）
+    m_chartData.yAxisTitle = m_source.name();
 
-    // 使用第一列作为X轴类别（通常是名称/日期列）
+    // X 轴类别只有柱状图/饼图需要，切换到这些图表时再生成
     m_chartData.categories.clear();
-    if (m_tableData->columnCount() > 0) {
-        for (int row = 0; row < m_tableData->rowCount(); ++row) {
-            // 直接读取原始字符串，不做任何转换
-            QVariant categoryValue = m_tableData->at(row, 0);
-            QString categoryText = categoryValue.typeId() == QMetaType::QString
-                ? categoryValue.toString()
-                : QString::number(categoryValue.toDouble());
-            m_chartData.categories.append(categoryText);
-        }
-    }
+    m_categoryOffset = 0;
 
-    QVector<double> values = m_tableData->toDoubleVector(column);
-    Charts::DataSeries series(m_tableData->header(column), values);
+    // 数值与缓存共享，不复制
+    Charts::DataSeries series(m_source.name(), m_source.values());
     series.color = Charts::ChartHelper::getDefaultColor(0);
 
     m_chartData.series.clear();
     m_chartData.series.append(series);
 
+    buildPyramid();
+    if (!reuseChart()) {
+        updateChart();
+    }
+}
+
+bool ChartView::reuseChart()
+{
+    if (!m_lodSeries || !m_currentChart) {
+        return false;
+    }
+
+    // 折线图/散点图只换数据：沿用图表、坐标轴与系列
+    m_currentChart->setTitle(m_titleEdit->text().isEmpty() ? m_chartData.title : m_titleEdit->text());
+    m_lodSeries->setName(m_chartData.series.first().name);
+    m_lodAxisX->setTitleText(m_chartData.xAxisTitle);
+    m_lodAxisY->setTitleText(m_chartData.yAxisTitle);
+    m_currentChart->zoomReset();
+    resetVisibleRange();
+    return true;
+}
+
+void ChartView::updateCell(const Core::TableData *table, int row, int column)
+{
+    if (!table || table != m_source.table() || !m_source.isValid()) {
+        return;
+    }
+
+    if (column == 0 && row < m_chartData.categories.size()) {
+        // 类别标签只影响分类图表
+        m_chartData.categories[row] = m_source.category(row);
+        if (!m_lodSeries) {
+            m_rebuildTimer.start();
+        }
+        return;
+    }
+
+    if (column == m_column) {
+        releaseValues();
+        applyChange(m_source.updateRows(row, row + 1));
+    }
+}
+
+void ChartView::syncTableData()
+{
+    releaseValues();
+    applyChange(m_source.sync());
+}
+
+void ChartView::releaseValues()
+{
+    // 图表数据先放开对列数值的引用，适配器修补时不必复制整列；applyChange 中重新共享
+    if (m_source.isValid() && !m_chartData.series.isEmpty()) {
+        m_chartData.series.first().values = QVector<double>();
+    }
+}
+
+void ChartView::applyChange(const Charts::TableColumnAdapter::Change &change)
+{
+    using Change = Charts::TableColumnAdapter::Change;
+    if (change.kind == Change::Reset) {
+        loadColumn();
+        return;
+    }
+    if (m_source.isValid() && !m_chartData.series.isEmpty()) {
+        m_chartData.series.first().values = m_source.values();
+    }
+    if (change.kind == Change::None) {
+        return;
+    }
+    if (change.lastRow > m_chartData.categories.size()) {
+        // 追加了行：类别在需要时重新生成
+        m_chartData.categories.clear();
+    }
+
+    // 金字塔只重新汇总受影响的块；仍在后台构建时按新数据重新构建
+    if (m_pyramid && !m_pyramidWatcher.isRunning()) {
+        QSharedPointer<const Charts::LodPyramid> pyramid(
+            new Charts::LodPyramid(m_pyramid->updated(m_source.values(), change.firstRow, change.lastRow)));
+        Core::ResultCache::instance().insert(
+            Core::ResultCache::makeKey(*m_source.table(), m_column, "lod"), pyramid, pyramid->memoryCost());
+        m_pyramid = pyramid;
+    } else {
+        buildPyramid();
+    }
+
+    if (m_lodSeries) {
+        // 未缩放时横轴跟随新增的行
+        if (m_currentChart->isZoomed()) {
+            updateLevelOfDetail();
+        } else {
+            resetVisibleRange();
+        }
+    } else {
+        // 柱状图、饼图与统计图表取决于整列数据，合并短时间内的修改后重建一次
+        m_rebuildTimer.start();
+    }
+}
+
+// === 分类图表的"其他" ===
+
+void ChartView::attachDrillDown(QChart *chart)
+{
+    if (!chart) {
+        return;
+    }
+
+    for (QAbstractSeries *series : chart->series()) {
+        if (auto *barSeries = qobject_cast<QAbstractBarSeries*>(series)) {
+            connect(barSeries, &QAbstractBarSeries::clicked, this, [this, chart](int index) {
+                for (QAbstractAxis *axis : chart->axes()) {
+                    if (auto *categoryAxis = qobject_cast<QBarCategoryAxis*>(axis)) {
+                        if (Charts::CategoryAggregator::isOtherLabel(categoryAxis->categories().value(index))) {
+                            drillDown();
+                        }
+                        return;
+                    }
+                }
+            });
+        } else if (auto *pieSeries = qobject_cast<QPieSeries*>(series)) {
+            connect(pieSeries, &QPieSeries::clicked, this, [this](QPieSlice *slice) {
+                if (Charts::CategoryAggregator::isOtherLabel(slice->label())) {
+                    drillDown();
+                }
+            });
+        }
+    }
+}
+
+void ChartView::drillDown()
+{
+    m_categoryOffset += Charts::ChartStyle().maxCategories;
+    // 在点击信号处理中不能删除发出信号的图表，稍后重建
+    QTimer::singleShot(0, this, &ChartView::updateChart);
+}
+
+void ChartView::onDrillUp()
+{
+    m_categoryOffset = qMax(0, m_categoryOffset - Charts::ChartStyle().maxCategories);
     updateChart();
 }
+
+// === 缩放与平移 ===
+
+void ChartView::buildPyramid()
+{
+    m_pyramid.reset();
+    if (!m_source.isValid()) {
+        return;
+    }
+
+    // 缓存键与数据都在 GUI 线程取好，后台任务不访问表格
+    const QString key = Core::ResultCache::makeKey(*m_source.table(), m_column, "lod");
+    const QVector<double> values = m_source.values();
+    m_pyramidWatcher.setFuture(QtConcurrent::run([key, values]() {
+        return Charts::LodPyramid::cached(key, values);
+    }));
+}
+
+void ChartView::onPyramidReady()
+{
+    m_pyramid = m_pyramidWatcher.result();
+    updateLevelOfDetail();
+}
+
+void ChartView::attachLevelOfDetail(QChart *chart, const QString &chartType)
+{
+    m_lodSeries = nullptr;
+    m_lodAxisX = nullptr;
+    m_lodAxisY = nullptr;
+
+    if (chart && m_column >= 0 && (chartType == "折线图" || chartType == "散点图")
+        && chart->series().size() == 1) {
+        m_lodSeries = qobject_cast<QXYSeries*>(chart->series().first());
+        const auto horizontal = chart->axes(Qt::Horizontal);
+        const auto vertical = chart->axes(Qt::Vertical);
+        m_lodAxisX = horizontal.isEmpty() ? nullptr : qobject_cast<QValueAxis*>(horizontal.first());
+        m_lodAxisY = vertical.isEmpty() ? nullptr : qobject_cast<QValueAxis*>(vertical.first());
+    }
+
+    if (!m_lodSeries || !m_lodAxisX || !m_lodAxisY) {
+        m_lodSeries = nullptr;
+        m_chartView->setRubberBand(QChartView::NoRubberBand);
+        return;
+    }
+
+    // 缩放时逐帧取点，动画只会拖慢重绘
+    chart->setAnimationOptions(QChart::NoAnimation);
+    m_chartView->setRubberBand(QChartView::HorizontalRubberBand);
+    connect(m_lodAxisX, &QValueAxis::rangeChanged, this, &ChartView::onVisibleRangeChanged);
+    updateLevelOfDetail();
+}
+
+void ChartView::onVisibleRangeChanged()
+{
+    updateLevelOfDetail();
+}
+
+void ChartView::resetVisibleRange()
+{
+    const double last = qMax<double>(1.0, static_cast<double>(m_source.size() - 1));
+    if (m_lodAxisX->min() != 0.0 || m_lodAxisX->max() != last) {
+        // 触发 rangeChanged，随之重新取点
+        m_lodAxisX->setRange(0.0, last);
+    } else {
+        updateLevelOfDetail();
+    }
+}
+
+void ChartView::updateLevelOfDetail()
+{
+    if (!m_lodSeries || !m_currentChart || !m_source.isValid()) {
+        return;
+    }
+
+    // 只取可见范围内的点，点数与序列长度无关
+    // 图表尚未布局时绘图区为空，按视图宽度估算
+    const QRectF plot = m_currentChart->plotArea();
+    const int width = qMax(1, plot.isEmpty() ? m_chartView->viewport()->width() : static_cast<int>(plot.width()));
+    const double xBegin = m_lodAxisX->min();
+    const double xEnd = m_lodAxisX->max();
+
+    // 金字塔尚未建好（或仍是修改前的行数）时直接扫描可见范围
+    const QList<QPointF> points = m_pyramid && m_pyramid->size() == m_source.size()
+        ? m_pyramid->query(m_source.values(), xBegin, xEnd, width)
+        : Charts::Decimation::minMax(m_source.values(), static_cast<qsizetype>(std::floor(xBegin)) - 1,
+                                     static_cast<qsizetype>(std::ceil(xEnd)) + 2, width);
+    m_lodSeries->replace(points);
+
+    // 纵轴跟随可见数据
+    double minValue = std::numeric_limits<double>::infinity();
+    double maxValue = -std::numeric_limits<double>::infinity();
+    for (const QPointF &point : points) {
+        minValue = std::min(minValue, point.y());
+        maxValue = std::max(maxValue, point.y());
+    }
+    if (minValue <= maxValue) {
+        const double padding = minValue < maxValue ? (maxValue - minValue) * 0.05 : 1.0;
+        m_lodAxisY->setRange(minValue - padding, maxValue + padding);
+    }
+}
+
+bool ChartView::eventFilter(QObject *watched, QEvent *event)
+{
+    if (watched != m_chartView->viewport() || !m_lodSeries || !m_currentChart) {
+        return QWidget::eventFilter(watched, event);
+    }
+
+    if (event->type() == QEvent::MouseButtonDblClick) {
+        m_currentChart->zoomReset();
+        return true;
+    }
+
+    if (event->type() == QEvent::Wheel) {
+        auto *wheel = static_cast<QWheelEvent*>(event);
+        const int delta = wheel->angleDelta().y();
+        if (delta == 0) {
+            return false;
+        }
+
+        const QRectF plot = m_currentChart->plotArea();
+        if (wheel->modifiers() & Qt::ControlModifier) {
+            // Ctrl+滚轮：以光标为中心缩放横轴
+            const QPointF position = m_currentChart->mapFromScene(
+                m_chartView->mapToScene(wheel->position().toPoint()));
+            const qreal factor = delta > 0 ? 0.8 : 1.25;
+            const qreal anchor = std::clamp(position.x(), plot.left(), plot.right());
+            QRectF rect = plot;
+            rect.setWidth(plot.width() * factor);
+            rect.moveLeft(anchor - (anchor - plot.left()) * factor);
+            m_currentChart->zoomIn(rect);
+        } else {
+            // 滚轮：横向平移十分之一绘图区
+            m_currentChart->scroll(delta > 0 ? -plot.width() / 10.0 : plot.width() / 10.0, 0);
+        }
+        return true;
+    }
+
+    return QWidget::eventFilter(watched, event);
+}
@@ -11,14 +11,29 @@
 #include <QLineEdit>
 #include <QLabel>
 #include <QSpinBox>
+#include <QFutureWatcher>
+#include <QSharedPointer>
+#include <QTimer>
+#include <QtCharts/QXYSeries>
+#include <QtCharts/QValueAxis>
 
 #include "core/TableData.h"
 #include "visualization/ChartTypes.h"
+#include "visualization/LodPyramid.h"
+#include "visualization/TableColumnAdapter.h"
 
 /**
  * @brief 图表视图
  *
- * 显示和操作图表
+ * 显示和操作图表。折线图与散点图可缩放平移（框选放大、右键缩小、滚轮
+ * 平移、Ctrl+滚轮缩放、双击复原），每次可见范围变化都从后台构建的
+ * 多分辨率金字塔按绘图区宽度重新取点。
+ *
+ * 数据经 TableColumnAdapter 读取表格列；切换数据列或单元格被编辑时，
+ * 折线图与散点图沿用现有的图表、坐标轴与系列，只更新受影响的点。
+ *
+ * 柱状图与饼图只显示合计最大的若干类别，其余并入"其他"；点击"其他"
+ * 查看其中排名靠前的类别
  */
 class ChartView : public QWidget
 {
@@ -34,26 +49,68 @@ public:
     void setChartData(const Charts::ChartData &data);
     void setTableData(Core::TableData *data, int column);
 
+    /**
+     * @brief 表格的单元格被编辑后调用（table 不是当前表格时忽略）
+     */
+    void updateCell(const Core::TableData *table, int row, int column);
+
+    /**
+     * @brief 当前表格即将被删除时调用：丢弃表格数据源并显示示例图表
+     */
+    void clearTableData();
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
 private slots:
     void onChartTypeChanged(int index);
     void onTitleChanged(const QString &title);
     void onSaveImage();
+    void onPyramidReady();
+    void onVisibleRangeChanged();
+    void onDrillUp();
 
 private:
     void setupToolbar();
     void updateChart();
     void createSampleChart();
+    void showChart(QChart *chart, const QString &chartType);
+    void attachDrillDown(QChart *chart);
+    void drillDown();
+    void loadColumn();
+    bool reuseChart();
+    void syncTableData();
+    void releaseValues();
+    void applyChange(const Charts::TableColumnAdapter::Change &change);
+    void ensureCategories();
+    QChart *createHistogram(const Charts::ChartStyle &style);
+    void buildPyramid();
+    void attachLevelOfDetail(QChart *chart, const QString &chartType);
+    void updateLevelOfDetail();
+    void resetVisibleRange();
 
     QChartView *m_chartView;
     QChart *m_currentChart;
     Charts::ChartData m_chartData;
     Core::TableData *m_tableData;
+    int m_column;
+    Charts::TableColumnAdapter m_source;
+    QTimer m_rebuildTimer;          // 合并短时间内的多次修改，只重建一次
+    int m_categoryOffset;           // 分类图表跳过的排名靠前的类别数（逐层查看"其他"）
+
+    // 缩放时重新取点
+    QSharedPointer<const Charts::LodPyramid> m_pyramid;
+    QFutureWatcher<QSharedPointer<const Charts::LodPyramid>> m_pyramidWatcher;
+    QXYSeries *m_lodSeries;         // 当前图表不支持缩放时为空
+    QValueAxis *m_lodAxisX;
+    QValueAxis *m_lodAxisY;
 
     // 工具栏
     QComboBox *m_chartTypeCombo;
     QLineEdit *m_titleEdit;
     QPushButton *m_saveButton;
     QPushButton *m_refreshButton;
+    QPushButton *m_drillUpButton;
     QSpinBox *m_widthSpinBox;
     QSpinBox *m_heightSpinBox;
 };
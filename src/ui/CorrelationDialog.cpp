@@ -0,0 +1,132 @@
+#include "CorrelationDialog.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QtConcurrent/QtConcurrent>
+
+CorrelationDialog::CorrelationDialog(Core::TableData *data, QWidget *parent)
+    : QDialog(parent)
+    , m_tableData(data)
+{
+    setWindowTitle("相关性分析");
+    resize(900, 700);
+
+    setupUI();
+
+    connect(&m_watcher, &QFutureWatcher<Statistics::CorrelationResult>::finished,
+            this, &CorrelationDialog::onCalculationFinished);
+
+    onCalculateClicked();
+}
+
+CorrelationDialog::~CorrelationDialog()
+{
+    // 后台任务引用了 m_tableData，必须等待其结束
+    m_watcher.waitForFinished();
+}
+
+void CorrelationDialog::setupUI()
+{
+    auto *mainLayout = new QVBoxLayout(this);
+
+    auto *toolbarLayout = new QHBoxLayout();
+    toolbarLayout->addWidget(new QLabel("度量:"));
+
+    m_methodCombo = new QComboBox();
+    m_methodCombo->addItem("皮尔逊相关", static_cast<int>(Statistics::CorrelationMethod::Pearson));
+    m_methodCombo->addItem("斯皮尔曼秩相关", static_cast<int>(Statistics::CorrelationMethod::Spearman));
+    m_methodCombo->addItem("协方差", static_cast<int>(Statistics::CorrelationMethod::Covariance));
+    toolbarLayout->addWidget(m_methodCombo);
+
+    m_calculateButton = new QPushButton("计算");
+    toolbarLayout->addWidget(m_calculateButton);
+
+    m_statusLabel = new QLabel();
+    toolbarLayout->addWidget(m_statusLabel, 1);
+    mainLayout->addLayout(toolbarLayout);
+
+    m_tabWidget = new QTabWidget(this);
+
+    m_heatmap = new Charts::HeatmapWidget();
+    m_tabWidget->addTab(m_heatmap, "热力图");
+
+    m_matrixTable = new QTableWidget();
+    m_matrixTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_matrixTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    m_tabWidget->addTab(m_matrixTable, "矩阵");
+
+    mainLayout->addWidget(m_tabWidget);
+
+    auto *buttonLayout = new QHBoxLayout();
+    buttonLayout->addStretch();
+    auto *closeButton = new QPushButton("关闭");
+    buttonLayout->addWidget(closeButton);
+    mainLayout->addLayout(buttonLayout);
+
+    connect(m_calculateButton, &QPushButton::clicked, this, &CorrelationDialog::onCalculateClicked);
+    connect(closeButton, &QPushButton::clicked, this, &QDialog::accept);
+}
+
+void CorrelationDialog::onCalculateClicked()
+{
+    if (!m_tableData || m_watcher.isRunning()) {
+        return;
+    }
+
+    auto method = static_cast<Statistics::CorrelationMethod>(m_methodCombo->currentData().toInt());
+    const Core::TableData *table = m_tableData;
+
+    m_calculateButton->setEnabled(false);
+    m_statusLabel->setText(QString("正在计算%1...").arg(Statistics::Correlation::methodName(method)));
+    m_timer.start();
+
+    m_watcher.setFuture(QtConcurrent::run([table, method]() {
+        return Statistics::Correlation::compute(*table, method);
+    }));
+}
+
+void CorrelationDialog::onCalculationFinished()
+{
+    m_calculateButton->setEnabled(true);
+
+    Statistics::CorrelationResult result = m_watcher.result();
+    if (!result.isValid) {
+        m_statusLabel->setText(QString("计算失败: %1").arg(result.errorMessage));
+        m_heatmap->clear();
+        m_matrixTable->clear();
+        return;
+    }
+
+    m_statusLabel->setText(QString("%1：%2 列 × %3 行，耗时 %4 秒")
+                               .arg(Statistics::Correlation::methodName(result.method))
+                               .arg(result.columns.size())
+                               .arg(m_tableData->rowCount())
+                               .arg(m_timer.elapsed() / 1000.0, 0, 'f', 2));
+    displayResult(result);
+}
+
+void CorrelationDialog::displayResult(const Statistics::CorrelationResult &result)
+{
+    bool covariance = result.method == Statistics::CorrelationMethod::Covariance;
+    m_heatmap->setMatrix(result.matrix, result.names, covariance ? 0.0 : 1.0);
+
+    int p = result.matrix.size();
+    m_matrixTable->clear();
+    m_matrixTable->setRowCount(p);
+    m_matrixTable->setColumnCount(p);
+    m_matrixTable->setHorizontalHeaderLabels(result.names);
+    m_matrixTable->setVerticalHeaderLabels(result.names);
+
+    for (int i = 0; i < p; ++i) {
+        for (int j = 0; j < p; ++j) {
+            double value = result.matrix[i][j];
+            auto *item = new QTableWidgetItem(qIsFinite(value) ? QString::number(value, 'g', 4) : "-");
+            item->setTextAlignment(Qt::AlignCenter);
+            item->setToolTip(QString("有效行数: %1").arg(result.pairCounts[i][j]));
+            if (!covariance) {
+                item->setBackground(Charts::HeatmapWidget::colorFor(value, 1.0));
+            }
+            m_matrixTable->setItem(i, j, item);
+        }
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef CORRELATIONDIALOG_H
+#define CORRELATIONDIALOG_H
+
+#include <QDialog>
+#include <QComboBox>
+#include <QPushButton>
+#include <QLabel>
+#include <QTabWidget>
+#include <QTableWidget>
+#include <QFutureWatcher>
+#include <QElapsedTimer>
+
+#include "core/TableData.h"
+#include "statistics/Correlation.h"
+#include "visualization/HeatmapWidget.h"
+
+/**
+ * @brief 相关性分析对话框
+ *
+ * 在后台计算所有数值列的相关/协方差矩阵，以热力图和表格显示
+ */
+class CorrelationDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit CorrelationDialog(Core::TableData *data, QWidget *parent = nullptr);
+    ~CorrelationDialog() override;
+
+private slots:
+    void onCalculateClicked();
+    void onCalculationFinished();
+
+private:
+    void setupUI();
+    void displayResult(const Statistics::CorrelationResult &result);
+
+    Core::TableData *m_tableData;
+    QFutureWatcher<Statistics::CorrelationResult> m_watcher;
+    QElapsedTimer m_timer;
+
+    QComboBox *m_methodCombo;
+    QPushButton *m_calculateButton;
+    QLabel *m_statusLabel;
+    QTabWidget *m_tabWidget;
+    Charts::HeatmapWidget *m_heatmap;
+    QTableWidget *m_matrixTable;
+};
+
+#endif // CORRELATIONDIALOG_H
@@ -74,6 +74,10 @@ DataTableView::DataTableView(QWidget *parent)
     verticalHeader()->setDefaultSectionSize(30);
     verticalHeader()->setMinimumWidth(80);
 
+    // 单元格编辑写回 TableData
+    connect(m_model, &QStandardItemModel::itemChanged,
+            this, &DataTableView::onItemChanged);
+
     // 连接表头点击信号
     connect(horizontalHeader(), &QHeaderView::sectionClicked,
             this, &DataTableView::onHeaderClicked);
@@ -115,12 +119,14 @@ void DataTableView::setupContextMenu()
     m_contextMenu->addAction("插入行", this, [this]() {
         QModelIndex current = currentIndex();
         m_model->insertRow(current.row());
+        m_rowsInSync = false;
         emit dataChanged();
     });
 
     m_contextMenu->addAction("删除行", this, [this]() {
         QModelIndex current = currentIndex();
         m_model->removeRow(current.row());
+        m_rowsInSync = false;
         emit dataChanged();
     });
 
@@ -161,10 +167,10 @@ bool DataTableView::loadFile(const QString &filePath)
         }
 
         // 更新 TableData
-        delete m_tableData;
-        m_tableData = result.data;
+        replaceTableData(result.data);
 
         // 更新 QStandardItemModel
+        m_updatingModel = true;
         m_model->clear();
         m_model->setRowCount(m_tableData->rowCount());
         m_model->setColumnCount(m_tableData->columnCount());
@@ -179,9 +185,15 @@ bool DataTableView::loadFile(const QString &filePath)
             for (int col = 0; col < m_tableData->columnCount(); ++col) {
                 QVariant value = m_tableData->at(row, col);
                 QStandardItem *item = new QStandardItem(value.toString());
+                if (col == 0) {
+                    // 记录 TableData 行号，排序或插入/删除行后仍能找到对应的行
+                    item->setData(row, SourceRowRole);
+                }
                 m_model->setItem(row, col, item);
             }
         }
+        m_updatingModel = false;
+        m_rowsInSync = true;
 
         // 自动调整列宽
         autoResizeColumns();
@@ -200,10 +212,10 @@ bool DataTableView::loadFile(const QString &filePath)
         }
 
         // 更新 TableData
-        delete m_tableData;
-        m_tableData = result.data;
+        replaceTableData(result.data);
 
         // 更新 QStandardItemModel
+        m_updatingModel = true;
         m_model->clear();
         m_model->setRowCount(m_tableData->rowCount());
         m_model->setColumnCount(m_tableData->columnCount());
@@ -218,9 +230,15 @@ bool DataTableView::loadFile(const QString &filePath)
             for (int col = 0; col < m_tableData->columnCount(); ++col) {
                 QVariant value = m_tableData->at(row, col);
                 QStandardItem *item = new QStandardItem(value.toString());
+                if (col == 0) {
+                    // 记录 TableData 行号，排序或插入/删除行后仍能找到对应的行
+                    item->setData(row, SourceRowRole);
+                }
                 m_model->setItem(row, col, item);
             }
         }
+        m_updatingModel = false;
+        m_rowsInSync = true;
 
         // 自动调整列宽
         autoResizeColumns();
@@ -272,8 +290,112 @@ bool DataTableView::saveFile(const QString &filePath)
 void DataTableView::clearData()
 {
     m_model->clear();
+    replaceTableData(new Core::TableData());
+    m_rowsInSync = true;
+}
+
+void DataTableView::replaceTableData(Core::TableData *data)
+{
+    // 先通知持有旧指针的对象，再删除
+    emit tableAboutToBeReplaced();
     delete m_tableData;
-    m_tableData = new Core::TableData();
+    m_tableData = data;
+}
+
+int DataTableView::appendColumn(const QString &header, const QVector<double> &values)
+{
+    QVector<QVariant> cells;
+    cells.reserve(values.size());
+    for (double value : values) {
+        cells.append(qIsNaN(value) ? QVariant() : QVariant(value));
+    }
+
+    int column = m_tableData->appendColumn(header, cells);
+    if (column < 0) {
+        return -1;
+    }
+
+    const QList<QStandardItem *> items = columnItems(cells);
+    m_updatingModel = true;
+    m_model->appendColumn(items);
+    m_model->setHeaderData(m_model->columnCount() - 1, Qt::Horizontal, header);
+    m_updatingModel = false;
+
+    emit columnAppended(column);
+    emit dataChanged();
+    return column;
+}
+
+int DataTableView::appendCategoryColumn(const QString &header, const Core::ColumnDictionary &dictionary)
+{
+    QVector<QVariant> cells;
+    cells.reserve(dictionary.codes.size());
+    for (int code : dictionary.codes) {
+        cells.append(code == Core::ColumnDictionary::NULL_CODE ? QVariant() : QVariant(dictionary.labels[code]));
+    }
+
+    int column = m_tableData->appendColumn(header, cells);
+    if (column < 0) {
+        return -1;
+    }
+
+    // 新列的编码已知，直接放入缓存，分组统计时不必再扫描一遍
+    Core::ColumnDictionary::store(*m_tableData, column, dictionary);
+
+    const QList<QStandardItem *> items = columnItems(cells);
+    m_updatingModel = true;
+    m_model->appendColumn(items);
+    m_model->setHeaderData(m_model->columnCount() - 1, Qt::Horizontal, header);
+    m_updatingModel = false;
+
+    emit columnAppended(column);
+    emit dataChanged();
+    return column;
+}
+
+QList<QStandardItem *> DataTableView::columnItems(const QVector<QVariant> &cells) const
+{
+    // 按模型行放置：排序后模型行与 TableData 行不再一一对应，插入的空行没有对应的行
+    QList<QStandardItem *> items;
+    const int rows = m_model->rowCount();
+    items.reserve(rows);
+    for (int row = 0; row < rows; ++row) {
+        const int source = sourceRow(row);
+        const QVariant cell = source >= 0 && source < cells.size() ? cells[source] : QVariant();
+        items.append(new QStandardItem(cell.toString()));
+    }
+    return items;
+}
+
+int DataTableView::sourceRow(int modelRow) const
+{
+    const QStandardItem *item = m_model->item(modelRow, 0);
+    const QVariant source = item ? item->data(SourceRowRole) : QVariant();
+    return source.isValid() ? source.toInt() : -1;
+}
+
+void DataTableView::applyRowMask(const QBitArray &mask)
+{
+    const int rows = m_model->rowCount();
+    for (int row = 0; row < rows; ++row) {
+        // mask 按 TableData 行编号，排序或插入行后按原始行映射；
+        // 只改动状态发生变化的行，避免反复触发布局更新
+        const int source = sourceRow(row);
+        const bool hide = source < 0 || source >= mask.size() || !mask.testBit(source);
+        if (isRowHidden(row) != hide) {
+            setRowHidden(row, hide);
+        }
+    }
+}
+
+void DataTableView::clearRowMask()
+{
+    const int rows = m_model->rowCount();
+    for (int row = 0; row < rows; ++row) {
+        if (isRowHidden(row)) {
+            setRowHidden(row, false);
+        }
+    }
 }
 
 Core::TableData *DataTableView::tableData() const
@@ -440,6 +562,7 @@ void DataTableView::sortColumn(int column, Qt::SortOrder order)
 
     // 如果是数值列，需要设置正确的数据类型以便数值排序
     if (numeric) {
+        m_updatingModel = true;
         for (int row = 0; row < m_model->rowCount(); ++row) {
             QStandardItem* item = m_model->item(row, column);
             if (item) {
@@ -453,11 +576,32 @@ void DataTableView::sortColumn(int column, Qt::SortOrder order)
                 }
             }
         }
+        m_updatingModel = false;
     }
 
     // 使用 QStandardItemModel 的内置排序功能
     m_model->sort(column, order);
+    m_rowsInSync = false;
+
+    emit dataChanged();
+}
+
+void DataTableView::onItemChanged(QStandardItem *item)
+{
+    if (m_updatingModel || !m_rowsInSync || !item) {
+        return;
+    }
+
+    const int row = item->row();
+    const int column = item->column();
+    if (row < 0 || row >= m_tableData->rowCount() || column < 0 || column >= m_tableData->columnCount()) {
+        return;
+    }
+
+    // 与加载时一样按字符串存储
+    m_tableData->set(row, column, QVariant(item->text()));
 
+    emit cellEdited(row, column);
     emit dataChanged();
 }
 
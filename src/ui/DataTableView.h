@@ -2,9 +2,11 @@
 #define DATATABLEVIEW_H
 
 #include <QTableView>
+#include <QBitArray>
 #include <QStandardItemModel>
 #include <QMenu>
 #include <QStyledItemDelegate>
+#include "../core/ColumnDictionary.h"
 #include "../core/TableData.h"
 
 /**
@@ -47,6 +49,34 @@ public:
     bool saveFile(const QString &filePath);
     void clearData();
 
+    /**
+     * @brief 在末尾追加一个数值列（NaN 显示为空单元格）
+     *
+     * values 按 TableData 行排列；表格排序或插入/删除行后，各值仍显示在原来的行上。
+     * @return 新列的索引，长度与行数不符时返回 -1
+     */
+    int appendColumn(const QString &header, const QVector<double> &values);
+
+    /**
+     * @brief 在末尾追加一个分类列，单元格为字典的标签，字典同时存入结果缓存
+     * @return 新列的索引，长度与行数不符时返回 -1
+     */
+    int appendCategoryColumn(const QString &header, const Core::ColumnDictionary &dictionary);
+
+    // 行筛选
+    /**
+     * @brief 只显示 mask 中置位的行（与筛选对话框一样按行隐藏，不复制数据）
+     *
+     * mask 按 TableData 的行编号；视图排序后仍隐藏对应的原始行，
+     * 插入的新行（不在 TableData 中）一并隐藏。
+     */
+    void applyRowMask(const QBitArray &mask);
+
+    /**
+     * @brief 取消行筛选，显示全部行
+     */
+    void clearRowMask();
+
     // 数据获取
     Core::TableData *tableData() const;
     QString selectedRangeInfo() const;
@@ -73,12 +103,44 @@ signals:
     void selectionChanged();
     void fileLoaded(const QString &filePath);
 
+    /**
+     * @brief 单元格被编辑（已写入 TableData）
+     */
+    void cellEdited(int row, int column);
+
+    /**
+     * @brief 在末尾追加了一列
+     */
+    void columnAppended(int column);
+
+    /**
+     * @brief 当前 TableData 即将被删除（加载文件或新建时）
+     *
+     * 持有 tableData() 指针的对象在此之后不得再访问它
+     */
+    void tableAboutToBeReplaced();
+
 private slots:
     void onContextMenuRequested(const QPoint &pos);
     void onHeaderClicked(int column);
+    void onItemChanged(QStandardItem *item);
 
 private:
     void setupContextMenu();
+    void replaceTableData(Core::TableData *data);
+
+    /**
+     * @brief 模型第 modelRow 行对应的 TableData 行（插入的空行返回 -1）
+     */
+    int sourceRow(int modelRow) const;
+
+    /**
+     * @brief 按 TableData 行排列的新列单元格，转换为按模型行排列的单元格
+     */
+    QList<QStandardItem *> columnItems(const QVector<QVariant> &cells) const;
+
+    // 第一列单元格中保存 TableData 行号的数据角色
+    static constexpr int SourceRowRole = Qt::UserRole + 1;
 
     // 排序辅助函数
     void sortColumn(int column, Qt::SortOrder order = Qt::AscendingOrder);
@@ -88,6 +150,10 @@ private:
     Core::TableData *m_tableData;
     QMenu *m_contextMenu;
 
+    // 编辑同步：填充模型时不回写；排序或插入/删除行后模型行号与 TableData 不再对应
+    bool m_updatingModel = false;
+    bool m_rowsInSync = true;
+
     // 排序状态跟踪
     int m_sortColumn = -1;
     Qt::SortOrder m_sortOrder = Qt::AscendingOrder;
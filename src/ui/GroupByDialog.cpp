@@ -1,4 +1,5 @@
 #include "GroupByDialog.h"
+#include "statistics/FrequencyCounter.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QFormLayout>
@@ -8,6 +9,7 @@
 #include <QDebug>
 #include <QStandardItemModel>
 #include <QTableWidgetItem>
+#include <QHash>
 #include <algorithm>
 #include <numeric>
 #include <map>
@@ -43,9 +45,21 @@ void GroupByDialog::setupUI()
     m_aggregateCombo->addItem("最小值", static_cast<int>(3));
     m_aggregateCombo->addItem("最大值", static_cast<int>(4));
     m_aggregateCombo->addItem("标准差", static_cast<int>(5));
+    m_aggregateCombo->addItem("高频值 (Top-N)", static_cast<int>(6));
+
+    m_valueColumnCombo = new QComboBox();
+    m_topNSpinBox = new QSpinBox();
+    m_topNSpinBox->setRange(1, 100);
+    m_topNSpinBox->setValue(5);
 
     paramLayout->addRow("分组列:", m_groupByCombo);
     paramLayout->addRow("汇总方式:", m_aggregateCombo);
+    paramLayout->addRow("统计列:", m_valueColumnCombo);
+    paramLayout->addRow("前 N 个:", m_topNSpinBox);
+
+    connect(m_aggregateCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &GroupByDialog::onAggregateChanged);
+    onAggregateChanged(m_aggregateCombo->currentIndex());
 
     paramGroup->setLayout(paramLayout);
     mainLayout->addWidget(paramGroup);
@@ -55,6 +69,8 @@ void GroupByDialog::setupUI()
     auto* resultLayout = new QVBoxLayout();
 
     m_groupTreeWidget = new QTreeWidget();
+    m_groupTreeWidget->setColumnCount(2);
+    m_groupTreeWidget->setHeaderLabels({"分组", "值"});
     m_resultsTable = new QTableWidget();
     m_resultsTable->setEditTriggers(QTableView::NoEditTriggers);
     m_resultsTable->setSelectionMode(QAbstractItemView::ContiguousSelection);
@@ -95,13 +111,27 @@ void GroupByDialog::populateColumns()
     if (!model) return;
 
     m_groupByCombo->clear();
+    m_valueColumnCombo->clear();
 
     for (int col = 0; col < model->columnCount(); ++col) {
         QString header = model->headerData(col, Qt::Horizontal).toString();
         m_groupByCombo->addItem(header, col);
+        m_valueColumnCombo->addItem(header, col);
+    }
+
+    if (m_valueColumnCombo->count() > 1) {
+        m_valueColumnCombo->setCurrentIndex(1);
     }
 }
 
+void GroupByDialog::onAggregateChanged(int index)
+{
+    Q_UNUSED(index);
+    bool topN = m_aggregateCombo->currentData().toInt() == 6;
+    m_valueColumnCombo->setEnabled(topN);
+    m_topNSpinBox->setEnabled(topN);
+}
+
 void GroupByDialog::onGroupByClicked()
 {
     m_groupTreeWidget->clear();
@@ -115,6 +145,11 @@ void GroupByDialog::onGroupByClicked()
 
     int groupColumn = m_groupByCombo->currentData().toInt();
 
+    if (m_aggregateCombo->currentData().toInt() == 6) {
+        showTopValues(model, groupColumn);
+        return;
+    }
+
     // 分组数据收集
     QMap<QString, QList<QList<double>>> groupedData;
 
@@ -225,6 +260,61 @@ void GroupByDialog::onGroupByClicked()
     m_exportButton->setEnabled(true);
 }
 
+void GroupByDialog::showTopValues(QStandardItemModel* model, int groupColumn)
+{
+    int valueColumn = m_valueColumnCombo->currentData().toInt();
+    int topN = m_topNSpinBox->value();
+
+    // 单遍哈希分组，收集每组的目标列取值
+    QHash<QString, QVector<QString>> groups;
+    for (int row = 0; row < model->rowCount(); ++row) {
+        QString groupKey = model->data(model->index(row, groupColumn)).toString();
+        QString value = model->data(model->index(row, valueColumn)).toString().trimmed();
+        groups[groupKey].append(value);
+    }
+
+    QStringList groupKeys = groups.keys();
+    std::sort(groupKeys.begin(), groupKeys.end());
+
+    m_resultsTable->setColumnCount(4);
+    m_resultsTable->setHorizontalHeaderLabels({"分组", "排名", m_valueColumnCombo->currentText(), "出现次数"});
+
+    int row = 0;
+    for (const QString& groupKey : groupKeys) {
+        Statistics::TopKResult top = Statistics::FrequencyCounter::topK(groups[groupKey], topN);
+
+        auto* groupItem = new QTreeWidgetItem();
+        groupItem->setText(0, groupKey);
+        groupItem->setText(1, QString("共 %1 条").arg(top.total));
+
+        m_resultsTable->setRowCount(row + top.items.size());
+
+        for (int rank = 0; rank < top.items.size(); ++rank) {
+            const auto& item = top.items[rank];
+            QString countText = top.exact
+                ? QString::number(item.count)
+                : QString("≈%1").arg(item.count);
+
+            auto* valueItem = new QTreeWidgetItem();
+            valueItem->setText(0, QString("%1. %2").arg(rank + 1).arg(item.label));
+            valueItem->setText(1, countText);
+            groupItem->addChild(valueItem);
+
+            m_resultsTable->setItem(row, 0, new QTableWidgetItem(groupKey));
+            m_resultsTable->setItem(row, 1, new QTableWidgetItem(QString::number(rank + 1)));
+            m_resultsTable->setItem(row, 2, new QTableWidgetItem(item.label));
+            m_resultsTable->setItem(row, 3, new QTableWidgetItem(countText));
+            ++row;
+        }
+
+        m_groupTreeWidget->addTopLevelItem(groupItem);
+        groupItem->setExpanded(true);
+    }
+
+    m_clearButton->setEnabled(true);
+    m_exportButton->setEnabled(true);
+}
+
 QMap<QString, QMap<QString, double>> GroupByDialog::calculateStatistics(const QMap<QString, QList<QList<double>>>& groupedData)
 {
     QMap<QString, QMap<QString, double>> results;
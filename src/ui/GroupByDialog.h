@@ -8,6 +8,8 @@
 #include <QPushButton>
 #include <QTableWidget>
 #include <QLabel>
+#include <QSpinBox>
+#include <QStandardItemModel>
 
 /**
  * @brief 数据分组对话框
@@ -26,10 +28,12 @@ private slots:
     void onGroupByClicked();
     void onClearGrouping();
     void onExportResults();
+    void onAggregateChanged(int index);
 
 private:
     void setupUI();
     void populateColumns();
+    void showTopValues(QStandardItemModel* model, int groupColumn);
     QMap<QString, QMap<QString, double>> calculateStatistics(const QMap<QString, QList<QList<double>>>& groupedData);
 
     QTableView* m_tableView;
@@ -37,6 +41,8 @@ private:
     // UI组件
     QComboBox* m_groupByCombo;        // 分组列
     QComboBox* m_aggregateCombo;      // 汇总方式
+    QComboBox* m_valueColumnCombo;    // 高频值统计的目标列
+    QSpinBox* m_topNSpinBox;          // 高频值个数
     QTreeWidget* m_groupTreeWidget;   // 分组树形结构
     QTableWidget* m_resultsTable;      // 结果表格
     QPushButton *m_groupByButton;
@@ -0,0 +1,215 @@
+#include "KMeansDialog.h"
+#include "DataTableView.h"
+#include "statistics/Correlation.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QFormLayout>
+#include <QGroupBox>
+#include <QHeaderView>
+#include <QMessageBox>
+#include <QtConcurrent/QtConcurrent>
+
+KMeansDialog::KMeansDialog(DataTableView *tableView, QWidget *parent)
+    : QDialog(parent)
+    , m_tableView(tableView)
+{
+    setWindowTitle("K-means 聚类");
+    resize(900, 650);
+
+    setupUI();
+
+    connect(&m_watcher, &QFutureWatcher<Statistics::KMeansResult>::finished,
+            this, &KMeansDialog::onCalculationFinished);
+}
+
+KMeansDialog::~KMeansDialog()
+{
+    // 后台任务引用了表格数据，必须等待其结束
+    m_watcher.waitForFinished();
+}
+
+void KMeansDialog::setupUI()
+{
+    auto *mainLayout = new QVBoxLayout(this);
+
+    // === 聚类设置 ===
+    auto *settingsGroup = new QGroupBox("设置");
+    auto *settingsLayout = new QHBoxLayout(settingsGroup);
+
+    auto *columnLayout = new QVBoxLayout();
+    columnLayout->addWidget(new QLabel("特征:"));
+    m_columnList = new QListWidget();
+    columnLayout->addWidget(m_columnList);
+    settingsLayout->addLayout(columnLayout, 1);
+
+    auto *formLayout = new QFormLayout();
+    m_clusterSpinBox = new QSpinBox();
+    m_clusterSpinBox->setRange(1, 1000);
+    m_clusterSpinBox->setValue(3);
+    formLayout->addRow("簇数:", m_clusterSpinBox);
+
+    m_algorithmCombo = new QComboBox();
+    for (auto algorithm : {Statistics::KMeansAlgorithm::Lloyd, Statistics::KMeansAlgorithm::MiniBatch}) {
+        m_algorithmCombo->addItem(Statistics::KMeans::algorithmName(algorithm), static_cast<int>(algorithm));
+    }
+    m_algorithmCombo->setToolTip("Mini-batch 每轮只用一小批随机抽取的点更新质心，适合行数很多的表格");
+    formLayout->addRow("算法:", m_algorithmCombo);
+
+    m_standardizeCheckBox = new QCheckBox("标准化各特征");
+    m_standardizeCheckBox->setChecked(true);
+    formLayout->addRow("", m_standardizeCheckBox);
+
+    m_iterationSpinBox = new QSpinBox();
+    m_iterationSpinBox->setRange(1, 100000);
+    m_iterationSpinBox->setValue(Statistics::KMeansOptions().maxIterations);
+    formLayout->addRow("最大迭代次数:", m_iterationSpinBox);
+
+    m_batchSpinBox = new QSpinBox();
+    m_batchSpinBox->setRange(16, 1000000);
+    m_batchSpinBox->setSingleStep(1024);
+    m_batchSpinBox->setValue(Statistics::KMeansOptions().batchSize);
+    formLayout->addRow("批大小:", m_batchSpinBox);
+
+    m_appendCheckBox = new QCheckBox("追加簇标签列");
+    m_appendCheckBox->setChecked(true);
+    m_appendCheckBox->setToolTip("把每行所属的簇（簇1、簇2...）作为分类列追加到表格末尾");
+    formLayout->addRow("", m_appendCheckBox);
+    settingsLayout->addLayout(formLayout, 1);
+
+    mainLayout->addWidget(settingsGroup);
+
+    // 数值列（默认全选）
+    if (m_tableView && m_tableView->tableData()) {
+        const Core::TableData &table = *m_tableView->tableData();
+        for (int column : Statistics::Correlation::numericColumns(table)) {
+            auto *item = new QListWidgetItem(table.header(column), m_columnList);
+            item->setData(Qt::UserRole, column);
+            item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+            item->setCheckState(Qt::Checked);
+        }
+    }
+
+    auto *toolbarLayout = new QHBoxLayout();
+    m_calculateButton = new QPushButton("计算");
+    toolbarLayout->addWidget(m_calculateButton);
+    m_statusLabel = new QLabel();
+    toolbarLayout->addWidget(m_statusLabel, 1);
+    mainLayout->addLayout(toolbarLayout);
+
+    // === 结果：各簇的点数、簇内平方和与质心 ===
+    m_clusterTable = new QTableWidget();
+    m_clusterTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    mainLayout->addWidget(m_clusterTable, 1);
+
+    auto *buttonLayout = new QHBoxLayout();
+    buttonLayout->addStretch();
+    auto *closeButton = new QPushButton("关闭");
+    buttonLayout->addWidget(closeButton);
+    mainLayout->addLayout(buttonLayout);
+
+    connect(m_algorithmCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &KMeansDialog::onAlgorithmChanged);
+    connect(m_calculateButton, &QPushButton::clicked, this, &KMeansDialog::onCalculateClicked);
+    connect(closeButton, &QPushButton::clicked, this, &QDialog::accept);
+
+    onAlgorithmChanged();
+}
+
+void KMeansDialog::onAlgorithmChanged()
+{
+    const auto algorithm = static_cast<Statistics::KMeansAlgorithm>(m_algorithmCombo->currentData().toInt());
+    m_batchSpinBox->setEnabled(algorithm == Statistics::KMeansAlgorithm::MiniBatch);
+}
+
+void KMeansDialog::onCalculateClicked()
+{
+    if (!m_tableView || !m_tableView->tableData() || m_watcher.isRunning()) {
+        return;
+    }
+
+    QVector<int> columns;
+    for (int i = 0; i < m_columnList->count(); ++i) {
+        QListWidgetItem *item = m_columnList->item(i);
+        if (item->checkState() == Qt::Checked) {
+            columns.append(item->data(Qt::UserRole).toInt());
+        }
+    }
+
+    if (columns.isEmpty()) {
+        QMessageBox::warning(this, "错误", "请至少选择一个数值列");
+        return;
+    }
+
+    Statistics::KMeansOptions options;
+    options.clusters = m_clusterSpinBox->value();
+    options.algorithm = static_cast<Statistics::KMeansAlgorithm>(m_algorithmCombo->currentData().toInt());
+    options.standardize = m_standardizeCheckBox->isChecked();
+    options.maxIterations = m_iterationSpinBox->value();
+    options.batchSize = m_batchSpinBox->value();
+
+    const Core::TableData *table = m_tableView->tableData();
+    m_calculateButton->setEnabled(false);
+    m_statusLabel->setText("正在计算...");
+    m_timer.start();
+
+    m_watcher.setFuture(QtConcurrent::run([table, columns, options]() {
+        return Statistics::KMeans::compute(*table, columns, options);
+    }));
+}
+
+void KMeansDialog::onCalculationFinished()
+{
+    m_calculateButton->setEnabled(true);
+
+    Statistics::KMeansResult result = m_watcher.result();
+    if (!result.isValid) {
+        m_statusLabel->setText(QString("计算失败: %1").arg(result.errorMessage));
+        m_clusterTable->clear();
+        m_clusterTable->setRowCount(0);
+        return;
+    }
+
+    QString status = QString("%1 行，%2（%3），迭代 %4 次%5，耗时 %6 秒")
+                         .arg(result.observations)
+                         .arg(Statistics::KMeans::algorithmName(result.algorithm))
+                         .arg(Statistics::KMeans::kernelName())
+                         .arg(result.iterations)
+                         .arg(result.converged ? "" : "（未收敛）")
+                         .arg(m_timer.elapsed() / 1000.0, 0, 'f', 2);
+
+    // 簇标签列追加到表格末尾，字典编码随之缓存，可直接用于分组统计
+    if (m_appendCheckBox->isChecked()) {
+        const int column = m_tableView->appendCategoryColumn("聚类", Statistics::KMeans::labelDictionary(result));
+        if (column >= 0) {
+            status += "，已追加“聚类”列";
+        }
+    }
+    m_statusLabel->setText(status);
+    displayResult(result);
+}
+
+void KMeansDialog::displayResult(const Statistics::KMeansResult &result)
+{
+    QStringList headers = {"点数", "簇内平方和"};
+    headers += result.names;
+
+    const int clusters = result.centroids.size();
+    QStringList rowLabels;
+    for (int c = 0; c < clusters; ++c) {
+        rowLabels << QString("簇%1").arg(c + 1);
+    }
+
+    m_clusterTable->clear();
+    m_clusterTable->setRowCount(clusters);
+    m_clusterTable->setColumnCount(headers.size());
+    m_clusterTable->setHorizontalHeaderLabels(headers);
+    m_clusterTable->setVerticalHeaderLabels(rowLabels);
+    for (int c = 0; c < clusters; ++c) {
+        m_clusterTable->setItem(c, 0, new QTableWidgetItem(QString::number(result.sizes[c])));
+        m_clusterTable->setItem(c, 1, new QTableWidgetItem(QString::number(result.withinSS[c], 'g', 6)));
+        for (int f = 0; f < result.centroids[c].size(); ++f) {
+            m_clusterTable->setItem(c, f + 2, new QTableWidgetItem(QString::number(result.centroids[c][f], 'g', 6)));
+        }
+    }
+    m_clusterTable->horizontalHeader()->resizeSections(QHeaderView::ResizeToContents);
+}
@@ -0,0 +1,58 @@
+#ifndef KMEANSDIALOG_H
+#define KMEANSDIALOG_H
+
+#include <QDialog>
+#include <QComboBox>
+#include <QListWidget>
+#include <QSpinBox>
+#include <QCheckBox>
+#include <QPushButton>
+#include <QLabel>
+#include <QTableWidget>
+#include <QFutureWatcher>
+#include <QElapsedTimer>
+
+#include "statistics/KMeans.h"
+
+class DataTableView;
+
+/**
+ * @brief K-means 聚类对话框
+ *
+ * 选择若干数值列，在后台聚类，显示各簇的点数与质心，
+ * 并可把每行所属的簇作为分类列追加到表格末尾
+ */
+class KMeansDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit KMeansDialog(DataTableView *tableView, QWidget *parent = nullptr);
+    ~KMeansDialog() override;
+
+private slots:
+    void onCalculateClicked();
+    void onCalculationFinished();
+    void onAlgorithmChanged();
+
+private:
+    void setupUI();
+    void displayResult(const Statistics::KMeansResult &result);
+
+    DataTableView *m_tableView;
+    QFutureWatcher<Statistics::KMeansResult> m_watcher;
+    QElapsedTimer m_timer;
+
+    QListWidget *m_columnList;
+    QSpinBox *m_clusterSpinBox;
+    QComboBox *m_algorithmCombo;
+    QCheckBox *m_standardizeCheckBox;
+    QSpinBox *m_iterationSpinBox;
+    QSpinBox *m_batchSpinBox;
+    QCheckBox *m_appendCheckBox;
+    QPushButton *m_calculateButton;
+    QLabel *m_statusLabel;
+    QTableWidget *m_clusterTable;
+};
+
+#endif // KMEANSDIALOG_H
@@ -4,7 +4,14 @@
 #include "StatisticsDialog.h"
 #include "SettingsDialog.h"
 #include "FilterDialog.h"
+#include "GroupByDialog.h"
 #include "CalcColumnDialog.h"
+#include "ProfileDialog.h"
+#include "CorrelationDialog.h"
+#include "RegressionDialog.h"
+#include "PCADialog.h"
+#include "KMeansDialog.h"
+#include "OutlierDialog.h"
 #include "../core/ExcelExporter.h"
 #include "../core/TableData.h"
 #include <QApplication>
@@ -102,6 +109,8 @@ void MainWindow::createMenuBar()
     auto* dataMenu = menuBar()->addMenu("数据(&D)");
     dataMenu->addAction("筛选(&F)...", QKeySequence("Ctrl+F"), this, &MainWindow::onFilterData);
     dataMenu->addAction("计算列(&C)...", QKeySequence("Ctrl+Shift+C"), this, &MainWindow::onCalcColumn);
+    dataMenu->addAction("分组汇总(&G)...", this, &MainWindow::onGroupBy);
+    dataMenu->addAction("异常值检测(&O)...", this, &MainWindow::onDetectOutliers);
     dataMenu->addSeparator();
     dataMenu->addAction("清除格式", this, []() {
         // TODO: 实现清除格式
@@ -119,6 +128,11 @@ void MainWindow::createMenuBar()
     // 工具菜单
     auto *toolsMenu = menuBar()->addMenu("工具(&T)");
     toolsMenu->addAction("统计分析(&S)...", this, &MainWindow::onStatistics);
+    toolsMenu->addAction("数据概览(&O)...", this, &MainWindow::onProfileData);
+    toolsMenu->addAction("相关性分析(&R)...", this, &MainWindow::onCorrelation);
+    toolsMenu->addAction("回归分析(&G)...", this, &MainWindow::onRegression);
+    toolsMenu->addAction("主成分分析(&C)...", this, &MainWindow::onPrincipalComponents);
+    toolsMenu->addAction("K-means 聚类(&K)...", this, &MainWindow::onKMeans);
     toolsMenu->addSeparator();
     toolsMenu->addAction("设置(&P)...", this, &MainWindow::onSettings);
 
@@ -240,6 +254,15 @@ void MainWindow::connectSignals()
     connect(m_dataTableView, &DataTableView::fileLoaded,
             this, &MainWindow::onFileLoaded);
 
+    connect(m_dataTableView, &DataTableView::cellEdited,
+            this, &MainWindow::onCellEdited);
+
+    connect(m_dataTableView, &DataTableView::columnAppended,
+            this, &MainWindow::onColumnAppended);
+
+    connect(m_dataTableView, &DataTableView::tableAboutToBeReplaced,
+            m_chartView, &ChartView::clearTableData);
+
     connect(m_tabWidget, &QTabWidget::currentChanged,
             this, &MainWindow::onCurrentTabChanged);
 
@@ -513,6 +536,61 @@ void MainWindow::onStatistics()
     m_statisticsDialog->exec();
 }
 
+void MainWindow::onProfileData()
+{
+    if (!m_dataTableView->tableData() || m_dataTableView->tableData()->isEmpty()) {
+        QMessageBox::information(this, "提示", "请先打开数据文件");
+        return;
+    }
+
+    ProfileDialog dialog(m_dataTableView->tableData(), this);
+    dialog.exec();
+}
+
+void MainWindow::onCorrelation()
+{
+    if (!m_dataTableView->tableData() || m_dataTableView->tableData()->isEmpty()) {
+        QMessageBox::information(this, "提示", "请先打开数据文件");
+        return;
+    }
+
+    CorrelationDialog dialog(m_dataTableView->tableData(), this);
+    dialog.exec();
+}
+
+void MainWindow::onRegression()
+{
+    if (!m_dataTableView->tableData() || m_dataTableView->tableData()->isEmpty()) {
+        QMessageBox::information(this, "提示", "请先打开数据文件");
+        return;
+    }
+
+    RegressionDialog dialog(m_dataTableView->tableData(), this);
+    dialog.exec();
+}
+
+void MainWindow::onPrincipalComponents()
+{
+    if (!m_dataTableView->tableData() || m_dataTableView->tableData()->isEmpty()) {
+        QMessageBox::information(this, "提示", "请先打开数据文件");
+        return;
+    }
+
+    PCADialog dialog(m_dataTableView, this);
+    dialog.exec();
+}
+
+void MainWindow::onKMeans()
+{
+    if (!m_dataTableView->tableData() || m_dataTableView->tableData()->isEmpty()) {
+        QMessageBox::information(this, "提示", "请先打开数据文件");
+        return;
+    }
+
+    KMeansDialog dialog(m_dataTableView, this);
+    dialog.exec();
+}
+
 void MainWindow::onFilterData()
 {
     if (!m_dataTableView->tableData() || m_dataTableView->tableData()->isEmpty()) {
@@ -524,6 +602,28 @@ void MainWindow::onFilterData()
     dialog.exec();
 }
 
+void MainWindow::onGroupBy()
+{
+    if (!m_dataTableView->tableData() || m_dataTableView->tableData()->isEmpty()) {
+        QMessageBox::information(this, "提示", "请先打开数据文件");
+        return;
+    }
+
+    GroupByDialog dialog(m_dataTableView, this);
+    dialog.exec();
+}
+
+void MainWindow::onDetectOutliers()
+{
+    if (!m_dataTableView->tableData() || m_dataTableView->tableData()->isEmpty()) {
+        QMessageBox::information(this, "提示", "请先打开数据文件");
+        return;
+    }
+
+    OutlierDialog dialog(m_dataTableView, this);
+    dialog.exec();
+}
+
 void MainWindow::onCalcColumn()
 {
     if (!m_dataTableView->tableData() || m_dataTableView->tableData()->isEmpty()) {
@@ -613,6 +713,21 @@ void MainWindow::onFileLoaded(const QString &filePath)
     }
 }
 
+void MainWindow::onCellEdited(int row, int column)
+{
+    // 图表只更新受影响的点，不重建
+    m_chartView->updateCell(m_dataTableView->tableData(), row, column);
+}
+
+void MainWindow::onColumnAppended(int column)
+{
+    // 新列加入图表数据列列表（第一列不在列表中）
+    Core::TableData* tableData = m_dataTableView->tableData();
+    if (tableData && column >= 1 && column < tableData->columnCount()) {
+        m_chartTypeWidget->addItem(tableData->header(column));
+    }
+}
+
 void MainWindow::onChartColumnChanged(int row)
 {
     Core::TableData* tableData = m_dataTableView->tableData();
@@ -94,6 +94,8 @@ private slots:
     // 数据菜单
     void onFilterData();
     void onCalcColumn();
+    void onGroupBy();
+    void onDetectOutliers();
 
     // 视图菜单
     void onToggleSidebar();
@@ -106,6 +108,11 @@ private slots:
 
     // 工具菜单
     void onStatistics();
+    void onProfileData();
+    void onCorrelation();
+    void onRegression();
+    void onPrincipalComponents();
+    void onKMeans();
     void onSettings();
 
     // 界面更新
@@ -113,6 +120,8 @@ private slots:
     void onDataChanged();
     void onSelectionChanged();
     void onFileLoaded(const QString &filePath);
+    void onCellEdited(int row, int column);
+    void onColumnAppended(int column);
     void onChartColumnChanged(int row);
     void onCurrentTabChanged(int index);
 
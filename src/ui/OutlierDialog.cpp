@@ -0,0 +1,249 @@
+#include "OutlierDialog.h"
+#include "DataTableView.h"
+#include "statistics/Correlation.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QFormLayout>
+#include <QGroupBox>
+#include <QHeaderView>
+#include <QMessageBox>
+#include <QtConcurrent/QtConcurrent>
+#include <cmath>
+
+OutlierDialog::OutlierDialog(DataTableView *tableView, QWidget *parent)
+    : QDialog(parent)
+    , m_tableView(tableView)
+{
+    setWindowTitle("异常值检测");
+    resize(800, 600);
+
+    setupUI();
+
+    connect(&m_watcher, &QFutureWatcher<Statistics::OutlierScanResult>::finished,
+            this, &OutlierDialog::onScanFinished);
+}
+
+OutlierDialog::~OutlierDialog()
+{
+    // 后台任务引用了表格数据，必须等待其结束
+    m_watcher.waitForFinished();
+}
+
+void OutlierDialog::setupUI()
+{
+    auto *mainLayout = new QVBoxLayout(this);
+
+    // === 检测设置 ===
+    auto *settingsGroup = new QGroupBox("设置");
+    auto *settingsLayout = new QHBoxLayout(settingsGroup);
+
+    auto *columnLayout = new QVBoxLayout();
+    columnLayout->addWidget(new QLabel("检测列:"));
+    m_columnList = new QListWidget();
+    columnLayout->addWidget(m_columnList);
+    settingsLayout->addLayout(columnLayout, 1);
+
+    const Statistics::OutlierOptions defaults;
+    auto *formLayout = new QFormLayout();
+    m_methodCombo = new QComboBox();
+    for (auto method : {Statistics::OutlierMethod::ZScore, Statistics::OutlierMethod::Iqr,
+                        Statistics::OutlierMethod::Mad, Statistics::OutlierMethod::Rolling}) {
+        m_methodCombo->addItem(Statistics::OutlierDetector::methodName(method), static_cast<int>(method));
+    }
+    formLayout->addRow("方法:", m_methodCombo);
+
+    m_thresholdSpinBox = new QDoubleSpinBox();
+    m_thresholdSpinBox->setRange(0.1, 100.0);
+    m_thresholdSpinBox->setSingleStep(0.5);
+    m_thresholdSpinBox->setValue(defaults.threshold);
+    m_thresholdSpinBox->setToolTip("偏离中心超过该倍数的标准差（MAD 换算的标准差）即视为异常");
+    formLayout->addRow("阈值（倍标准差）:", m_thresholdSpinBox);
+
+    m_iqrSpinBox = new QDoubleSpinBox();
+    m_iqrSpinBox->setRange(0.0, 100.0);
+    m_iqrSpinBox->setSingleStep(0.5);
+    m_iqrSpinBox->setValue(defaults.iqrFactor);
+    formLayout->addRow("IQR 倍数:", m_iqrSpinBox);
+
+    m_windowSpinBox = new QSpinBox();
+    m_windowSpinBox->setRange(2, 100000);
+    m_windowSpinBox->setValue(defaults.window);
+    m_windowSpinBox->setToolTip("与前若干行的均值和标准差比较");
+    formLayout->addRow("窗口大小:", m_windowSpinBox);
+    settingsLayout->addLayout(formLayout, 1);
+
+    mainLayout->addWidget(settingsGroup);
+
+    // 数值列（默认全选）
+    if (m_tableView && m_tableView->tableData()) {
+        const Core::TableData &table = *m_tableView->tableData();
+        for (int column : Statistics::Correlation::numericColumns(table)) {
+            auto *item = new QListWidgetItem(table.header(column), m_columnList);
+            item->setData(Qt::UserRole, column);
+            item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+            item->setCheckState(Qt::Checked);
+        }
+    }
+
+    auto *toolbarLayout = new QHBoxLayout();
+    m_scanButton = new QPushButton("检测");
+    toolbarLayout->addWidget(m_scanButton);
+    m_statusLabel = new QLabel();
+    toolbarLayout->addWidget(m_statusLabel, 1);
+    mainLayout->addLayout(toolbarLayout);
+
+    // === 结果 ===
+    m_resultTable = new QTableWidget();
+    m_resultTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_resultTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_resultTable->setSelectionMode(QAbstractItemView::SingleSelection);
+    m_resultTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    mainLayout->addWidget(m_resultTable, 1);
+
+    auto *buttonLayout = new QHBoxLayout();
+    m_showFlaggedButton = new QPushButton("只显示异常行");
+    m_showFlaggedButton->setEnabled(false);
+    buttonLayout->addWidget(m_showFlaggedButton);
+    m_showColumnButton = new QPushButton("只显示所选列的异常行");
+    m_showColumnButton->setEnabled(false);
+    buttonLayout->addWidget(m_showColumnButton);
+    m_showAllButton = new QPushButton("显示全部行");
+    buttonLayout->addWidget(m_showAllButton);
+    buttonLayout->addStretch();
+    auto *closeButton = new QPushButton("关闭");
+    buttonLayout->addWidget(closeButton);
+    mainLayout->addLayout(buttonLayout);
+
+    connect(m_methodCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &OutlierDialog::onMethodChanged);
+    connect(m_scanButton, &QPushButton::clicked, this, &OutlierDialog::onScanClicked);
+    connect(m_showFlaggedButton, &QPushButton::clicked, this, &OutlierDialog::onShowFlaggedRows);
+    connect(m_showColumnButton, &QPushButton::clicked, this, &OutlierDialog::onShowColumnRows);
+    connect(m_showAllButton, &QPushButton::clicked, this, &OutlierDialog::onShowAllRows);
+    connect(closeButton, &QPushButton::clicked, this, &QDialog::accept);
+
+    onMethodChanged();
+}
+
+void OutlierDialog::onMethodChanged()
+{
+    const auto method = static_cast<Statistics::OutlierMethod>(m_methodCombo->currentData().toInt());
+    m_thresholdSpinBox->setEnabled(method != Statistics::OutlierMethod::Iqr);
+    m_iqrSpinBox->setEnabled(method == Statistics::OutlierMethod::Iqr);
+    m_windowSpinBox->setEnabled(method == Statistics::OutlierMethod::Rolling);
+}
+
+void OutlierDialog::onScanClicked()
+{
+    if (!m_tableView || !m_tableView->tableData() || m_watcher.isRunning()) {
+        return;
+    }
+
+    QVector<int> columns;
+    for (int i = 0; i < m_columnList->count(); ++i) {
+        QListWidgetItem *item = m_columnList->item(i);
+        if (item->checkState() == Qt::Checked) {
+            columns.append(item->data(Qt::UserRole).toInt());
+        }
+    }
+
+    if (columns.isEmpty()) {
+        QMessageBox::warning(this, "错误", "请至少选择一个数值列");
+        return;
+    }
+
+    Statistics::OutlierOptions options;
+    options.method = static_cast<Statistics::OutlierMethod>(m_methodCombo->currentData().toInt());
+    options.threshold = m_thresholdSpinBox->value();
+    options.iqrFactor = m_iqrSpinBox->value();
+    options.window = m_windowSpinBox->value();
+
+    const Core::TableData *table = m_tableView->tableData();
+    m_scanButton->setEnabled(false);
+    m_showFlaggedButton->setEnabled(false);
+    m_showColumnButton->setEnabled(false);
+    m_statusLabel->setText("正在检测...");
+    m_timer.start();
+
+    m_watcher.setFuture(QtConcurrent::run([table, columns, options]() {
+        return Statistics::OutlierDetector::scan(*table, columns, options);
+    }));
+}
+
+void OutlierDialog::onScanFinished()
+{
+    m_scanButton->setEnabled(true);
+
+    m_result = m_watcher.result();
+    if (!m_result.isValid) {
+        m_statusLabel->setText(QString("检测失败: %1").arg(m_result.errorMessage));
+        m_resultTable->clear();
+        m_resultTable->setRowCount(0);
+        return;
+    }
+
+    m_statusLabel->setText(QString("%1，%2 行含异常值，耗时 %3 秒")
+                               .arg(Statistics::OutlierDetector::methodName(m_result.method))
+                               .arg(m_result.flaggedRows)
+                               .arg(m_timer.elapsed() / 1000.0, 0, 'f', 2));
+    m_showFlaggedButton->setEnabled(m_result.flaggedRows > 0);
+    m_showColumnButton->setEnabled(m_result.flaggedRows > 0);
+    displayResult(m_result);
+}
+
+void OutlierDialog::onShowFlaggedRows()
+{
+    if (m_tableView && !m_result.rows.isEmpty()) {
+        m_tableView->applyRowMask(m_result.rows);
+    }
+}
+
+void OutlierDialog::onShowColumnRows()
+{
+    const int selected = m_resultTable->currentRow();
+    if (!m_tableView || selected < 0 || selected >= m_result.columns.size()) {
+        QMessageBox::information(this, "提示", "请先在结果中选择一列");
+        return;
+    }
+
+    const Statistics::ColumnOutliers &column = m_result.columns[selected];
+    if (column.isValid) {
+        m_tableView->applyRowMask(column.flags);
+    }
+}
+
+void OutlierDialog::onShowAllRows()
+{
+    if (m_tableView) {
+        m_tableView->clearRowMask();
+    }
+}
+
+void OutlierDialog::displayResult(const Statistics::OutlierScanResult &result)
+{
+    auto format = [](double value) {
+        return std::isfinite(value) ? QString::number(value, 'g', 6) : QString("-");
+    };
+
+    const QStringList headers = {"列", "有效值", "异常值", "比例", "下界", "上界"};
+    m_resultTable->clear();
+    m_resultTable->setRowCount(result.columns.size());
+    m_resultTable->setColumnCount(headers.size());
+    m_resultTable->setHorizontalHeaderLabels(headers);
+
+    for (int i = 0; i < result.columns.size(); ++i) {
+        const Statistics::ColumnOutliers &column = result.columns[i];
+        m_resultTable->setItem(i, 0, new QTableWidgetItem(column.name));
+        if (!column.isValid) {
+            m_resultTable->setItem(i, 1, new QTableWidgetItem(column.errorMessage));
+            continue;
+        }
+
+        const double ratio = column.validCount > 0 ? 100.0 * column.count / column.validCount : 0.0;
+        m_resultTable->setItem(i, 1, new QTableWidgetItem(QString::number(column.validCount)));
+        m_resultTable->setItem(i, 2, new QTableWidgetItem(QString::number(column.count)));
+        m_resultTable->setItem(i, 3, new QTableWidgetItem(QString::number(ratio, 'f', 2) + "%"));
+        m_resultTable->setItem(i, 4, new QTableWidgetItem(format(column.lower)));
+        m_resultTable->setItem(i, 5, new QTableWidgetItem(format(column.upper)));
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef OUTLIERDIALOG_H
+#define OUTLIERDIALOG_H
+
+#include <QDialog>
+#include <QComboBox>
+#include <QListWidget>
+#include <QSpinBox>
+#include <QDoubleSpinBox>
+#include <QPushButton>
+#include <QLabel>
+#include <QTableWidget>
+#include <QFutureWatcher>
+#include <QElapsedTimer>
+
+#include "statistics/OutlierDetector.h"
+
+class DataTableView;
+
+/**
+ * @brief 异常值检测对话框
+ *
+ * 选择若干数值列和判定方法，在后台逐列检测异常值，显示各列的异常值
+ * 个数与判定区间；可在表格中只显示含异常值的行（全部列或选中的一列）
+ */
+class OutlierDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit OutlierDialog(DataTableView *tableView, QWidget *parent = nullptr);
+    ~OutlierDialog() override;
+
+private slots:
+    void onScanClicked();
+    void onScanFinished();
+    void onMethodChanged();
+    void onShowFlaggedRows();
+    void onShowColumnRows();
+    void onShowAllRows();
+
+private:
+    void setupUI();
+    void displayResult(const Statistics::OutlierScanResult &result);
+
+    DataTableView *m_tableView;
+    QFutureWatcher<Statistics::OutlierScanResult> m_watcher;
+    QElapsedTimer m_timer;
+    Statistics::OutlierScanResult m_result;
+
+    QListWidget *m_columnList;
+    QComboBox *m_methodCombo;
+    QDoubleSpinBox *m_thresholdSpinBox;
+    QDoubleSpinBox *m_iqrSpinBox;
+    QSpinBox *m_windowSpinBox;
+    QPushButton *m_scanButton;
+    QPushButton *m_showFlaggedButton;
+    QPushButton *m_showColumnButton;
+    QPushButton *m_showAllButton;
+    QLabel *m_statusLabel;
+    QTableWidget *m_resultTable;
+};
+
+#endif // OUTLIERDIALOG_H
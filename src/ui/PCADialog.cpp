@@ -0,0 +1,233 @@
+#include "PCADialog.h"
+#include "DataTableView.h"
+#include "statistics/Correlation.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QFormLayout>
+#include <QGroupBox>
+#include <QHeaderView>
+#include <QMessageBox>
+#include <QSplitter>
+#include <QtConcurrent/QtConcurrent>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// 载荷表最多显示的主成分个数
+const int MAX_LOADING_COLUMNS = 10;
+
+} // namespace
+
+PCADialog::PCADialog(DataTableView *tableView, QWidget *parent)
+    : QDialog(parent)
+    , m_tableView(tableView)
+{
+    setWindowTitle("主成分分析");
+    resize(900, 700);
+
+    setupUI();
+
+    connect(&m_watcher, &QFutureWatcher<Statistics::PcaResult>::finished,
+            this, &PCADialog::onCalculationFinished);
+}
+
+PCADialog::~PCADialog()
+{
+    // 后台任务引用了表格数据，必须等待其结束
+    m_watcher.waitForFinished();
+}
+
+void PCADialog::setupUI()
+{
+    auto *mainLayout = new QVBoxLayout(this);
+
+    // === 分析设置 ===
+    auto *settingsGroup = new QGroupBox("设置");
+    auto *settingsLayout = new QHBoxLayout(settingsGroup);
+
+    auto *columnLayout = new QVBoxLayout();
+    columnLayout->addWidget(new QLabel("变量:"));
+    m_columnList = new QListWidget();
+    columnLayout->addWidget(m_columnList);
+    settingsLayout->addLayout(columnLayout, 1);
+
+    auto *formLayout = new QFormLayout();
+    m_standardizeCheckBox = new QCheckBox("标准化（分析相关矩阵）");
+    m_standardizeCheckBox->setChecked(true);
+    formLayout->addRow("", m_standardizeCheckBox);
+
+    m_methodCombo = new QComboBox();
+    for (auto method : {Statistics::PcaMethod::Auto, Statistics::PcaMethod::Eigen,
+                        Statistics::PcaMethod::Randomized}) {
+        m_methodCombo->addItem(Statistics::PrincipalComponents::methodName(method), static_cast<int>(method));
+    }
+    m_methodCombo->setToolTip("随机化 SVD 只求前若干个主成分，适合列数很多的数据");
+    formLayout->addRow("计算方式:", m_methodCombo);
+
+    m_componentSpinBox = new QSpinBox();
+    m_componentSpinBox->setRange(0, 100000);
+    m_componentSpinBox->setSpecialValueText("全部");
+    formLayout->addRow("主成分个数:", m_componentSpinBox);
+
+    m_scoreSpinBox = new QSpinBox();
+    m_scoreSpinBox->setRange(0, 100);
+    m_scoreSpinBox->setSpecialValueText("不追加");
+    m_scoreSpinBox->setToolTip("把前若干个主成分的得分追加为表格的新列（PC1、PC2...）");
+    formLayout->addRow("追加得分列:", m_scoreSpinBox);
+    settingsLayout->addLayout(formLayout, 1);
+
+    mainLayout->addWidget(settingsGroup);
+
+    // 数值列（默认全选）
+    if (m_tableView && m_tableView->tableData()) {
+        const Core::TableData &table = *m_tableView->tableData();
+        for (int column : Statistics::Correlation::numericColumns(table)) {
+            auto *item = new QListWidgetItem(table.header(column), m_columnList);
+            item->setData(Qt::UserRole, column);
+            item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+            item->setCheckState(Qt::Checked);
+        }
+    }
+
+    auto *toolbarLayout = new QHBoxLayout();
+    m_calculateButton = new QPushButton("计算");
+    toolbarLayout->addWidget(m_calculateButton);
+    m_statusLabel = new QLabel();
+    toolbarLayout->addWidget(m_statusLabel, 1);
+    mainLayout->addLayout(toolbarLayout);
+
+    // === 结果 ===
+    auto *splitter = new QSplitter(Qt::Vertical);
+
+    m_varianceTable = new QTableWidget();
+    m_varianceTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_varianceTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    splitter->addWidget(m_varianceTable);
+
+    m_loadingTable = new QTableWidget();
+    m_loadingTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    splitter->addWidget(m_loadingTable);
+
+    mainLayout->addWidget(splitter, 1);
+
+    auto *buttonLayout = new QHBoxLayout();
+    buttonLayout->addStretch();
+    auto *closeButton = new QPushButton("关闭");
+    buttonLayout->addWidget(closeButton);
+    mainLayout->addLayout(buttonLayout);
+
+    connect(m_calculateButton, &QPushButton::clicked, this, &PCADialog::onCalculateClicked);
+    connect(closeButton, &QPushButton::clicked, this, &QDialog::accept);
+}
+
+void PCADialog::onCalculateClicked()
+{
+    if (!m_tableView || !m_tableView->tableData() || m_watcher.isRunning()) {
+        return;
+    }
+
+    QVector<int> columns;
+    for (int i = 0; i < m_columnList->count(); ++i) {
+        QListWidgetItem *item = m_columnList->item(i);
+        if (item->checkState() == Qt::Checked) {
+            columns.append(item->data(Qt::UserRole).toInt());
+        }
+    }
+
+    if (columns.size() < 2) {
+        QMessageBox::warning(this, "错误", "请至少选择两个数值列");
+        return;
+    }
+
+    Statistics::PcaOptions options;
+    options.standardize = m_standardizeCheckBox->isChecked();
+    options.method = static_cast<Statistics::PcaMethod>(m_methodCombo->currentData().toInt());
+    options.components = m_componentSpinBox->value();
+    options.scoreComponents = m_scoreSpinBox->value();
+
+    if (options.method == Statistics::PcaMethod::Randomized && options.components == 0) {
+        QMessageBox::warning(this, "错误", "随机化 SVD 需要指定主成分个数");
+        return;
+    }
+
+    const Core::TableData *table = m_tableView->tableData();
+    m_calculateButton->setEnabled(false);
+    m_statusLabel->setText("正在计算...");
+    m_timer.start();
+
+    m_watcher.setFuture(QtConcurrent::run([table, columns, options]() {
+        return Statistics::PrincipalComponents::compute(*table, columns, options);
+    }));
+}
+
+void PCADialog::onCalculationFinished()
+{
+    m_calculateButton->setEnabled(true);
+
+    Statistics::PcaResult result = m_watcher.result();
+    if (!result.isValid) {
+        m_statusLabel->setText(QString("计算失败: %1").arg(result.errorMessage));
+        m_varianceTable->clear();
+        m_varianceTable->setRowCount(0);
+        m_loadingTable->clear();
+        m_loadingTable->setRowCount(0);
+        return;
+    }
+
+    // 得分列追加到表格末尾（变量列的索引不受影响，可继续分析）
+    for (int c = 0; c < result.scores.size(); ++c) {
+        m_tableView->appendColumn(QString("PC%1").arg(c + 1), result.scores[c]);
+    }
+
+    QString status = QString("%1 行，%2，耗时 %3 秒")
+                         .arg(result.observations)
+                         .arg(Statistics::PrincipalComponents::methodName(result.method))
+                         .arg(m_timer.elapsed() / 1000.0, 0, 'f', 2);
+    if (!result.scores.isEmpty()) {
+        status += QString("，已追加 %1 个得分列").arg(result.scores.size());
+    }
+    m_statusLabel->setText(status);
+    displayResult(result);
+}
+
+void PCADialog::displayResult(const Statistics::PcaResult &result)
+{
+    auto format = [](double value) {
+        return std::isfinite(value) ? QString::number(value, 'g', 6) : QString("-");
+    };
+    auto percent = [](double ratio) {
+        return QString::number(ratio * 100.0, 'f', 2) + "%";
+    };
+
+    // === 方差贡献 ===
+    const QStringList headers = {"主成分", "方差", "贡献率", "累计贡献率"};
+    const int components = result.variances.size();
+    m_varianceTable->clear();
+    m_varianceTable->setRowCount(components);
+    m_varianceTable->setColumnCount(headers.size());
+    m_varianceTable->setHorizontalHeaderLabels(headers);
+    for (int c = 0; c < components; ++c) {
+        m_varianceTable->setItem(c, 0, new QTableWidgetItem(QString("PC%1").arg(c + 1)));
+        m_varianceTable->setItem(c, 1, new QTableWidgetItem(format(result.variances[c])));
+        m_varianceTable->setItem(c, 2, new QTableWidgetItem(percent(result.explainedRatio[c])));
+        m_varianceTable->setItem(c, 3, new QTableWidgetItem(percent(result.cumulativeRatio[c])));
+    }
+
+    // === 载荷（变量 × 前几个主成分）===
+    const int shown = std::min(components, MAX_LOADING_COLUMNS);
+    QStringList loadingHeaders;
+    for (int c = 0; c < shown; ++c) {
+        loadingHeaders << QString("PC%1").arg(c + 1);
+    }
+    m_loadingTable->clear();
+    m_loadingTable->setRowCount(result.names.size());
+    m_loadingTable->setColumnCount(shown);
+    m_loadingTable->setHorizontalHeaderLabels(loadingHeaders);
+    m_loadingTable->setVerticalHeaderLabels(result.names);
+    for (int j = 0; j < result.names.size(); ++j) {
+        for (int c = 0; c < shown; ++c) {
+            m_loadingTable->setItem(j, c, new QTableWidgetItem(QString::number(result.loadings(j, c), 'f', 4)));
+        }
+    }
+}
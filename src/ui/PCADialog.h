@@ -0,0 +1,56 @@
+#ifndef PCADIALOG_H
+#define PCADIALOG_H
+
+#include <QDialog>
+#include <QComboBox>
+#include <QListWidget>
+#include <QSpinBox>
+#include <QCheckBox>
+#include <QPushButton>
+#include <QLabel>
+#include <QTableWidget>
+#include <QFutureWatcher>
+#include <QElapsedTimer>
+
+#include "statistics/PrincipalComponents.h"
+
+class DataTableView;
+
+/**
+ * @brief 主成分分析对话框
+ *
+ * 选择若干数值列，在后台计算主成分，显示各主成分的方差贡献与载荷，
+ * 并可把前几个主成分的得分作为新列追加到表格末尾
+ */
+class PCADialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit PCADialog(DataTableView *tableView, QWidget *parent = nullptr);
+    ~PCADialog() override;
+
+private slots:
+    void onCalculateClicked();
+    void onCalculationFinished();
+
+private:
+    void setupUI();
+    void displayResult(const Statistics::PcaResult &result);
+
+    DataTableView *m_tableView;
+    QFutureWatcher<Statistics::PcaResult> m_watcher;
+    QElapsedTimer m_timer;
+
+    QListWidget *m_columnList;
+    QCheckBox *m_standardizeCheckBox;
+    QComboBox *m_methodCombo;
+    QSpinBox *m_componentSpinBox;
+    QSpinBox *m_scoreSpinBox;
+    QPushButton *m_calculateButton;
+    QLabel *m_statusLabel;
+    QTableWidget *m_varianceTable;
+    QTableWidget *m_loadingTable;
+};
+
+#endif // PCADIALOG_H
@@ -0,0 +1,171 @@
+#include "ProfileDialog.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QMetaObject>
+#include <QStringList>
+#include <QtConcurrent/QtConcurrent>
+
+namespace {
+
+enum ProfileColumn {
+    NameColumn,
+    TypeColumn,
+    CountColumn,
+    NullColumn,
+    DistinctColumn,
+    MinColumn,
+    MaxColumn,
+    MeanColumn,
+    StdDevColumn,
+    Q1Column,
+    MedianColumn,
+    Q3Column,
+    TopValuesColumn,
+    ProfileColumnCount
+};
+
+QString formatNumber(double value)
+{
+    return QString::number(value, 'g', 6);
+}
+
+} // namespace
+
+ProfileDialog::ProfileDialog(Core::TableData *data, QWidget *parent)
+    : QDialog(parent)
+    , m_tableData(data)
+{
+    setWindowTitle("数据概览");
+    resize(1100, 600);
+
+    setupUI();
+    onStartProfiling();
+}
+
+ProfileDialog::~ProfileDialog()
+{
+    // 后台任务引用了 m_tableData 和本对话框，必须等待其结束；
+    // 先置取消标志，未开始的行块直接跳过，只需等待正在扫描的行块
+    m_cancelled = true;
+    m_future.waitForFinished();
+}
+
+void ProfileDialog::setupUI()
+{
+    auto *mainLayout = new QVBoxLayout(this);
+
+    m_profileTable = new QTableWidget(this);
+    m_profileTable->setColumnCount(ProfileColumnCount);
+    m_profileTable->setHorizontalHeaderLabels({
+        "列名", "类型", "非空", "空值", "不同值(估计)",
+        "最小值", "最大值", "均值", "标准差",
+        "Q1", "中位数", "Q3", "高频值"
+    });
+    m_profileTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_profileTable->setAlternatingRowColors(true);
+    m_profileTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    m_profileTable->horizontalHeader()->setStretchLastSection(true);
+    mainLayout->addWidget(m_profileTable);
+
+    auto *bottomLayout = new QHBoxLayout();
+    m_statusLabel = new QLabel();
+    m_progressBar = new QProgressBar();
+    m_progressBar->setMaximumWidth(250);
+    m_refreshButton = new QPushButton("重新分析");
+    auto *closeButton = new QPushButton("关闭");
+
+    bottomLayout->addWidget(m_statusLabel, 1);
+    bottomLayout->addWidget(m_progressBar);
+    bottomLayout->addWidget(m_refreshButton);
+    bottomLayout->addWidget(closeButton);
+    mainLayout->addLayout(bottomLayout);
+
+    connect(m_refreshButton, &QPushButton::clicked, this, &ProfileDialog::onStartProfiling);
+    connect(closeButton, &QPushButton::clicked, this, &QDialog::accept);
+}
+
+void ProfileDialog::onStartProfiling()
+{
+    if (!m_tableData || m_future.isRunning()) {
+        return;
+    }
+
+    int columns = m_tableData->columnCount();
+
+    m_profileTable->setRowCount(columns);
+    for (int col = 0; col < columns; ++col) {
+        m_profileTable->setItem(col, NameColumn, new QTableWidgetItem(m_tableData->header(col)));
+        m_profileTable->setItem(col, TypeColumn, new QTableWidgetItem("计算中..."));
+        for (int i = CountColumn; i < ProfileColumnCount; ++i) {
+            m_profileTable->setItem(col, i, new QTableWidgetItem());
+        }
+    }
+
+    m_finishedColumns = 0;
+    m_progressBar->setRange(0, columns);
+    m_progressBar->setValue(0);
+    m_statusLabel->setText(QString("正在分析 %1 列 × %2 行...")
+                               .arg(columns)
+                               .arg(m_tableData->rowCount()));
+    m_refreshButton->setEnabled(false);
+
+    const Core::TableData *table = m_tableData;
+
+    // 析构函数会等待后台任务结束；投递到本对象的事件在对象销毁时自动丢弃
+    m_cancelled = false;
+    m_future = QtConcurrent::run([this, table]() {
+        Statistics::ColumnProfiler::profile(*table, [this](const Statistics::ColumnProfile &profile) {
+            // 回调运行在工作线程中，通过队列连接把结果送回界面线程
+            QMetaObject::invokeMethod(this, [this, profile]() {
+                onColumnProfiled(profile);
+            }, Qt::QueuedConnection);
+        }, 5, &m_cancelled);
+    });
+}
+
+void ProfileDialog::onColumnProfiled(const Statistics::ColumnProfile &profile)
+{
+    fillRow(profile);
+
+    ++m_finishedColumns;
+    m_progressBar->setValue(m_finishedColumns);
+
+    if (m_finishedColumns >= m_profileTable->rowCount()) {
+        m_statusLabel->setText(QString("分析完成：共 %1 列").arg(m_finishedColumns));
+        m_refreshButton->setEnabled(true);
+    }
+}
+
+void ProfileDialog::fillRow(const Statistics::ColumnProfile &profile)
+{
+    int row = profile.column;
+    if (row < 0 || row >= m_profileTable->rowCount()) {
+        return;
+    }
+
+    auto setText = [this, row](int column, const QString &text) {
+        m_profileTable->item(row, column)->setText(text);
+    };
+
+    setText(TypeColumn, Statistics::ColumnProfile::typeName(profile.type));
+    setText(CountColumn, QString::number(profile.rowCount - profile.nullCount));
+    setText(NullColumn, QString::number(profile.nullCount));
+    setText(DistinctColumn, QString::number(profile.distinctEstimate));
+
+    if (profile.numericCount > 0) {
+        setText(MinColumn, formatNumber(profile.min));
+        setText(MaxColumn, formatNumber(profile.max));
+        setText(MeanColumn, formatNumber(profile.mean));
+        setText(StdDevColumn, formatNumber(profile.stdDev));
+        setText(Q1Column, formatNumber(profile.q1));
+        setText(MedianColumn, formatNumber(profile.median));
+        setText(Q3Column, formatNumber(profile.q3));
+    }
+
+    QStringList topValues;
+    for (const auto &entry : profile.topValues) {
+        topValues << QString("%1 (%2)").arg(entry.first).arg(entry.second);
+    }
+    setText(TopValuesColumn, topValues.join(", "));
+}
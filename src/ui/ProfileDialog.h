@@ -0,0 +1,48 @@
+#ifndef PROFILEDIALOG_H
+#define PROFILEDIALOG_H
+
+#include <QDialog>
+#include <QTableWidget>
+#include <QProgressBar>
+#include <QLabel>
+#include <QPushButton>
+#include <QFuture>
+#include <atomic>
+
+#include "core/TableData.h"
+#include "statistics/ColumnProfiler.h"
+
+/**
+ * @brief 数据概览对话框
+ *
+ * 后台并行计算所有列的概览（类型、空值、不同值、数值统计、高频值），
+ * 每列计算完成后立即显示
+ */
+class ProfileDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit ProfileDialog(Core::TableData *data, QWidget *parent = nullptr);
+    ~ProfileDialog() override;
+
+private slots:
+    void onStartProfiling();
+
+private:
+    void setupUI();
+    void onColumnProfiled(const Statistics::ColumnProfile &profile);
+    void fillRow(const Statistics::ColumnProfile &profile);
+
+    Core::TableData *m_tableData;
+    QFuture<void> m_future;
+    std::atomic_bool m_cancelled{false};
+    int m_finishedColumns = 0;
+
+    QTableWidget *m_profileTable;
+    QProgressBar *m_progressBar;
+    QLabel *m_statusLabel;
+    QPushButton *m_refreshButton;
+};
+
+#endif // PROFILEDIALOG_H
@@ -0,0 +1,258 @@
+#include "RegressionDialog.h"
+#include "statistics/Bootstrap.h"
+#include "statistics/Correlation.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QFormLayout>
+#include <QGroupBox>
+#include <QHeaderView>
+#include <QMessageBox>
+#include <QSplitter>
+#include <QtConcurrent/QtConcurrent>
+#include <algorithm>
+#include <cmath>
+
+RegressionDialog::RegressionDialog(Core::TableData *data, QWidget *parent)
+    : QDialog(parent)
+    , m_tableData(data)
+{
+    setWindowTitle("回归分析");
+    resize(900, 700);
+
+    setupUI();
+
+    connect(&m_watcher, &QFutureWatcher<Statistics::RegressionResult>::finished,
+            this, &RegressionDialog::onCalculationFinished);
+}
+
+RegressionDialog::~RegressionDialog()
+{
+    // 后台任务引用了 m_tableData，必须等待其结束
+    m_watcher.waitForFinished();
+}
+
+void RegressionDialog::setupUI()
+{
+    auto *mainLayout = new QVBoxLayout(this);
+
+    // === 模型设置 ===
+    auto *modelGroup = new QGroupBox("模型");
+    auto *modelLayout = new QHBoxLayout(modelGroup);
+
+    auto *formLayout = new QFormLayout();
+    m_responseCombo = new QComboBox();
+    formLayout->addRow("因变量:", m_responseCombo);
+
+    m_degreeSpinBox = new QSpinBox();
+    m_degreeSpinBox->setRange(1, 12);
+    m_degreeSpinBox->setValue(1);
+    m_degreeSpinBox->setToolTip("大于 1 时只能选择一个自变量，拟合其多项式");
+    formLayout->addRow("多项式阶数:", m_degreeSpinBox);
+
+    m_solverCombo = new QComboBox();
+    for (auto solver : {Statistics::RegressionSolver::Auto, Statistics::RegressionSolver::Cholesky,
+                        Statistics::RegressionSolver::QR}) {
+        m_solverCombo->addItem(Statistics::Regression::solverName(solver), static_cast<int>(solver));
+    }
+    formLayout->addRow("求解方式:", m_solverCombo);
+
+    m_interceptCheckBox = new QCheckBox("包含截距项");
+    m_interceptCheckBox->setChecked(true);
+    formLayout->addRow("", m_interceptCheckBox);
+    modelLayout->addLayout(formLayout, 1);
+
+    auto *predictorLayout = new QVBoxLayout();
+    predictorLayout->addWidget(new QLabel("自变量:"));
+    m_predictorList = new QListWidget();
+    predictorLayout->addWidget(m_predictorList);
+    modelLayout->addLayout(predictorLayout, 1);
+
+    auto *factorLayout = new QVBoxLayout();
+    factorLayout->addWidget(new QLabel("分类自变量:"));
+    m_factorList = new QListWidget();
+    m_factorList->setToolTip("按取值展开为哑变量（有截距时第一个类别为参照水平），以稀疏设计矩阵拟合");
+    factorLayout->addWidget(m_factorList);
+    modelLayout->addLayout(factorLayout, 1);
+
+    mainLayout->addWidget(modelGroup);
+
+    // 数值列
+    if (m_tableData) {
+        for (int column : Statistics::Correlation::numericColumns(*m_tableData)) {
+            QString header = m_tableData->header(column);
+            m_responseCombo->addItem(header, column);
+
+            auto *item = new QListWidgetItem(header, m_predictorList);
+            item->setData(Qt::UserRole, column);
+            item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+            item->setCheckState(Qt::Unchecked);
+        }
+
+        // 任意列都可作为分类变量
+        for (int column = 0; column < m_tableData->columnCount(); ++column) {
+            auto *item = new QListWidgetItem(m_tableData->header(column), m_factorList);
+            item->setData(Qt::UserRole, column);
+            item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+            item->setCheckState(Qt::Unchecked);
+        }
+    }
+
+    auto *toolbarLayout = new QHBoxLayout();
+    m_calculateButton = new QPushButton("拟合");
+    toolbarLayout->addWidget(m_calculateButton);
+    m_statusLabel = new QLabel();
+    toolbarLayout->addWidget(m_statusLabel, 1);
+    mainLayout->addLayout(toolbarLayout);
+
+    // === 结果 ===
+    auto *splitter = new QSplitter(Qt::Vertical);
+
+    m_coefficientTable = new QTableWidget();
+    m_coefficientTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_coefficientTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    splitter->addWidget(m_coefficientTable);
+
+    m_summaryTextEdit = new QTextEdit();
+    m_summaryTextEdit->setReadOnly(true);
+    m_summaryTextEdit->setFont(QFont("Courier", 10));
+    splitter->addWidget(m_summaryTextEdit);
+
+    mainLayout->addWidget(splitter, 1);
+
+    auto *buttonLayout = new QHBoxLayout();
+    buttonLayout->addStretch();
+    auto *closeButton = new QPushButton("关闭");
+    buttonLayout->addWidget(closeButton);
+    mainLayout->addLayout(buttonLayout);
+
+    connect(m_calculateButton, &QPushButton::clicked, this, &RegressionDialog::onCalculateClicked);
+    connect(closeButton, &QPushButton::clicked, this, &QDialog::accept);
+}
+
+void RegressionDialog::onCalculateClicked()
+{
+    if (!m_tableData || m_watcher.isRunning()) {
+        return;
+    }
+
+    const int response = m_responseCombo->currentData().toInt();
+    QVector<int> predictors;
+    for (int i = 0; i < m_predictorList->count(); ++i) {
+        QListWidgetItem *item = m_predictorList->item(i);
+        int column = item->data(Qt::UserRole).toInt();
+        if (item->checkState() == Qt::Checked && column != response) {
+            predictors.append(column);
+        }
+    }
+
+    QVector<int> factors;
+    for (int i = 0; i < m_factorList->count(); ++i) {
+        QListWidgetItem *item = m_factorList->item(i);
+        int column = item->data(Qt::UserRole).toInt();
+        if (item->checkState() == Qt::Checked && column != response && !predictors.contains(column)) {
+            factors.append(column);
+        }
+    }
+
+    if (predictors.isEmpty() && factors.isEmpty()) {
+        QMessageBox::warning(this, "错误", "请至少选择一个与因变量不同的自变量");
+        return;
+    }
+
+    const int degree = m_degreeSpinBox->value();
+    if (degree > 1 && (predictors.size() != 1 || !factors.isEmpty())) {
+        QMessageBox::warning(this, "错误", "多项式回归只能选择一个数值自变量");
+        return;
+    }
+
+    Statistics::RegressionOptions options;
+    options.intercept = m_interceptCheckBox->isChecked();
+    options.solver = static_cast<Statistics::RegressionSolver>(m_solverCombo->currentData().toInt());
+
+    const Core::TableData *table = m_tableData;
+    m_calculateButton->setEnabled(false);
+    m_statusLabel->setText("正在拟合...");
+    m_timer.start();
+
+    m_watcher.setFuture(QtConcurrent::run([table, response, predictors, factors, degree, options]() {
+        if (degree > 1) {
+            return Statistics::Regression::polynomial(*table, predictors.first(), response, degree, options);
+        }
+        if (!factors.isEmpty()) {
+            return Statistics::Regression::fit(*table, response, predictors, factors, options);
+        }
+        return Statistics::Regression::fit(*table, response, predictors, options);
+    }));
+}
+
+void RegressionDialog::onCalculationFinished()
+{
+    m_calculateButton->setEnabled(true);
+
+    Statistics::RegressionResult result = m_watcher.result();
+    if (!result.isValid) {
+        m_statusLabel->setText(QString("拟合失败: %1").arg(result.errorMessage));
+        m_coefficientTable->clear();
+        m_coefficientTable->setRowCount(0);
+        m_summaryTextEdit->clear();
+        return;
+    }
+
+    m_statusLabel->setText(QString("%1 行，%2，耗时 %3 秒")
+                               .arg(result.observations)
+                               .arg(Statistics::Regression::solverName(result.solver))
+                               .arg(m_timer.elapsed() / 1000.0, 0, 'f', 2));
+    displayResult(result);
+}
+
+void RegressionDialog::displayResult(const Statistics::RegressionResult &result)
+{
+    // === 系数表 ===
+    const QStringList headers = {"项", "系数", "标准误", "t 值", "p 值"};
+    m_coefficientTable->clear();
+    m_coefficientTable->setRowCount(result.coefficients.size());
+    m_coefficientTable->setColumnCount(headers.size());
+    m_coefficientTable->setHorizontalHeaderLabels(headers);
+
+    auto format = [](double value) {
+        return std::isfinite(value) ? QString::number(value, 'g', 6) : QString("-");
+    };
+
+    for (int i = 0; i < result.coefficients.size(); ++i) {
+        m_coefficientTable->setItem(i, 0, new QTableWidgetItem(result.names.value(i)));
+        m_coefficientTable->setItem(i, 1, new QTableWidgetItem(format(result.coefficients[i])));
+        m_coefficientTable->setItem(i, 2, new QTableWidgetItem(format(result.standardErrors[i])));
+        m_coefficientTable->setItem(i, 3, new QTableWidgetItem(format(result.tValues[i])));
+        m_coefficientTable->setItem(i, 4, new QTableWidgetItem(result.pValues[i] < 1e-16 ? QString("< 1e-16")
+                                                                                       : format(result.pValues[i])));
+    }
+
+    // === 拟合优度 ===
+    QString summary;
+    summary += QString("有效行数: %1（残差自由度 %2）\n").arg(result.observations).arg(result.degreesOfFreedom);
+    summary += QString("R²: %1    调整 R²: %2\n").arg(format(result.rSquared)).arg(format(result.adjustedRSquared));
+    summary += QString("残差标准误: %1\n").arg(format(result.residualStdError));
+    summary += QString("F 统计量: %1    p 值: %2\n").arg(format(result.fStatistic)).arg(format(result.fPValue));
+    summary += QString("条件数估计: %1\n").arg(format(result.conditionEstimate));
+
+    // === 残差分布 ===
+    QVector<double> residuals;
+    residuals.reserve(result.observations);
+    for (double e : result.residuals) {
+        if (std::isfinite(e)) {
+            residuals.append(e);
+        }
+    }
+    if (!residuals.isEmpty()) {
+        std::sort(residuals.begin(), residuals.end());
+        summary += "\n残差分布:\n";
+        const char *labels[] = {"最小值", "下四分位数", "中位数", "上四分位数", "最大值"};
+        const double levels[] = {0.0, 0.25, 0.5, 0.75, 1.0};
+        for (int i = 0; i < 5; ++i) {
+            double value = Statistics::Bootstrap::sortedQuantile(residuals.constData(), residuals.size(), levels[i]);
+            summary += QString("  %1: %2\n").arg(labels[i]).arg(format(value));
+        }
+    }
+
+    m_summaryTextEdit->setText(summary);
+}
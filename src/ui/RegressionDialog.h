@@ -0,0 +1,57 @@
+#ifndef REGRESSIONDIALOG_H
+#define REGRESSIONDIALOG_H
+
+#include <QDialog>
+#include <QComboBox>
+#include <QListWidget>
+#include <QSpinBox>
+#include <QCheckBox>
+#include <QPushButton>
+#include <QLabel>
+#include <QTableWidget>
+#include <QTextEdit>
+#include <QFutureWatcher>
+#include <QElapsedTimer>
+
+#include "core/TableData.h"
+#include "statistics/Regression.h"
+
+/**
+ * @brief 回归分析对话框
+ *
+ * 选择因变量与若干自变量（或单个自变量的多项式），在后台拟合并显示
+ * 系数表、拟合优度与残差分布；选择分类自变量时以稀疏哑变量设计矩阵拟合
+ */
+class RegressionDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit RegressionDialog(Core::TableData *data, QWidget *parent = nullptr);
+    ~RegressionDialog() override;
+
+private slots:
+    void onCalculateClicked();
+    void onCalculationFinished();
+
+private:
+    void setupUI();
+    void displayResult(const Statistics::RegressionResult &result);
+
+    Core::TableData *m_tableData;
+    QFutureWatcher<Statistics::RegressionResult> m_watcher;
+    QElapsedTimer m_timer;
+
+    QComboBox *m_responseCombo;
+    QListWidget *m_predictorList;
+    QListWidget *m_factorList;
+    QSpinBox *m_degreeSpinBox;
+    QComboBox *m_solverCombo;
+    QCheckBox *m_interceptCheckBox;
+    QPushButton *m_calculateButton;
+    QLabel *m_statusLabel;
+    QTableWidget *m_coefficientTable;
+    QTextEdit *m_summaryTextEdit;
+};
+
+#endif // REGRESSIONDIALOG_H
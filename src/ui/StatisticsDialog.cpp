@@ -13,6 +13,77 @@
 #include <QPushButton>
 #include <QSpinBox>
 #include <QDoubleSpinBox>
+#include <QCheckBox>
+#include <QApplication>
+#include <QFileDialog>
+#include "core/DataExporter.h"
+#include "statistics/BatchForecaster.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+namespace {
+
+// 预测方法名称对应的指数平滑模型
+bool smoothingModelFor(const QString &method, Statistics::SmoothingModel *model)
+{
+    if (method == "指数平滑") {
+        *model = Statistics::SmoothingModel::Simple;
+    } else if (method == "Holt 线性趋势") {
+        *model = Statistics::SmoothingModel::Holt;
+    } else if (method == "Holt-Winters（加法季节）") {
+        *model = Statistics::SmoothingModel::HoltWintersAdditive;
+    } else if (method == "Holt-Winters（乘法季节）") {
+        *model = Statistics::SmoothingModel::HoltWintersMultiplicative;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// 批量预测结果预览的最大行数（完整结果通过导出获取）
+const int BATCH_PREVIEW_ROWS = 5000;
+
+// 描述性统计中自助法置信区间的重抽样次数
+const int BOOTSTRAP_RESAMPLES = 2000;
+
+// 回测参数网格
+const double GRID_ALPHAS[] = {0.1, 0.3, 0.5, 0.7, 0.9};
+const double GRID_BETAS[] = {0.05, 0.15, 0.3};
+const double GRID_GAMMAS[] = {0.05, 0.15, 0.3};
+const int GRID_WINDOWS[] = {3, 5, 7, 12};
+
+// 加权移动平均的线性权重（越近的值权重越大）
+QVector<double> linearWeights(int window)
+{
+    QVector<double> weights(window);
+    for (int i = 0; i < window; ++i) {
+        weights[i] = i + 1;
+    }
+    return weights;
+}
+
+// 序列诊断文本中最多列出的滞后数
+const int DIAGNOSTIC_PREVIEW_LAGS = 200;
+
+// 相关系数的文本条形图：半宽 20 个字符，超出置信界的滞后以 * 标记
+QString correlationBar(double value, double bound)
+{
+    const int halfWidth = 20;
+    int length = std::isfinite(value) ? qRound(std::min(1.0, std::abs(value)) * halfWidth) : 0;
+    QString left(halfWidth, QLatin1Char(' '));
+    QString right(halfWidth, QLatin1Char(' '));
+    for (int i = 0; i < length; ++i) {
+        if (value < 0) {
+            left[halfWidth - 1 - i] = QLatin1Char('#');
+        } else {
+            right[i] = QLatin1Char('#');
+        }
+    }
+    return left + "|" + right + (std::abs(value) > bound ? " *" : "");
+}
+
+} // namespace
 
 StatisticsDialog::StatisticsDialog(QWidget *parent)
     : QDialog(parent)
@@ -44,6 +115,10 @@ void StatisticsDialog::setupUI()
     columnLayout->addWidget(m_columnCombo);
     descriptiveLayout->addLayout(columnLayout);
 
+    m_bootstrapCheckBox = new QCheckBox("计算均值、中位数与标准差的 95% 自助法置信区间");
+    m_bootstrapCheckBox->setChecked(false);
+    descriptiveLayout->addWidget(m_bootstrapCheckBox);
+
     // 计算按钮
     m_calculateButton = new QPushButton("计算统计量");
     descriptiveLayout->addWidget(m_calculateButton);
@@ -71,6 +146,9 @@ void StatisticsDialog::setupUI()
     m_forecastMethodCombo->addItem("简单移动平均");
     m_forecastMethodCombo->addItem("加权移动平均");
     m_forecastMethodCombo->addItem("指数平滑");
+    m_forecastMethodCombo->addItem("Holt 线性趋势");
+    m_forecastMethodCombo->addItem("Holt-Winters（加法季节）");
+    m_forecastMethodCombo->addItem("Holt-Winters（乘法季节）");
     m_forecastMethodCombo->addItem("线性回归");
     paramLayout->addRow("预测方法:", m_forecastMethodCombo);
 
@@ -80,16 +158,52 @@ void StatisticsDialog::setupUI()
     paramLayout->addRow("窗口大小:", m_windowSpinBox);
 
     m_alphaSpinBox = new QDoubleSpinBox();
-    m_alphaSpinBox->setRange(0.01, 0.99);
+    m_alphaSpinBox->setRange(0.001, 0.999);
+    m_alphaSpinBox->setDecimals(4);
     m_alphaSpinBox->setSingleStep(0.1);
     m_alphaSpinBox->setValue(0.3);
     paramLayout->addRow("平滑系数(α):", m_alphaSpinBox);
 
+    m_betaSpinBox = new QDoubleSpinBox();
+    m_betaSpinBox->setRange(0.001, 0.999);
+    m_betaSpinBox->setDecimals(4);
+    m_betaSpinBox->setSingleStep(0.05);
+    m_betaSpinBox->setValue(0.1);
+    paramLayout->addRow("趋势系数(β):", m_betaSpinBox);
+
+    m_gammaSpinBox = new QDoubleSpinBox();
+    m_gammaSpinBox->setRange(0.001, 0.999);
+    m_gammaSpinBox->setDecimals(4);
+    m_gammaSpinBox->setSingleStep(0.05);
+    m_gammaSpinBox->setValue(0.1);
+    paramLayout->addRow("季节系数(γ):", m_gammaSpinBox);
+
+    m_seasonLengthSpinBox = new QSpinBox();
+    m_seasonLengthSpinBox->setRange(2, 366);
+    m_seasonLengthSpinBox->setValue(12);
+    paramLayout->addRow("季节周期:", m_seasonLengthSpinBox);
+
+    m_autoTuneCheckBox = new QCheckBox("自动优化平滑系数");
+    m_autoTuneCheckBox->setToolTip("搜索使样本内一步预测误差最小的系数（网格搜索 + Nelder–Mead）");
+    paramLayout->addRow("", m_autoTuneCheckBox);
+
+    m_criterionCombo = new QComboBox();
+    m_criterionCombo->addItem("均方误差 (MSE)", static_cast<int>(Statistics::FitCriterion::MSE));
+    m_criterionCombo->addItem("平均绝对误差 (MAE)", static_cast<int>(Statistics::FitCriterion::MAE));
+    paramLayout->addRow("优化准则:", m_criterionCombo);
+
     m_forecastPeriodsSpinBox = new QSpinBox();
     m_forecastPeriodsSpinBox->setRange(1, 100);
     m_forecastPeriodsSpinBox->setValue(5);
     paramLayout->addRow("预测期数:", m_forecastPeriodsSpinBox);
 
+    m_confidenceSpinBox = new QDoubleSpinBox();
+    m_confidenceSpinBox->setRange(50.0, 99.9);
+    m_confidenceSpinBox->setDecimals(1);
+    m_confidenceSpinBox->setSuffix(" %");
+    m_confidenceSpinBox->setValue(95.0);
+    paramLayout->addRow("预测区间置信水平:", m_confidenceSpinBox);
+
     paramGroup->setLayout(paramLayout);
     forecastingLayout->addWidget(paramGroup);
 
@@ -97,6 +211,38 @@ void StatisticsDialog::setupUI()
     m_forecastButton = new QPushButton("执行预测");
     forecastingLayout->addWidget(m_forecastButton);
 
+    // 分组批量预测（仅指数平滑类方法）
+    auto *batchLayout = new QHBoxLayout();
+    batchLayout->addWidget(new QLabel("分组列:"));
+    m_groupColumnCombo = new QComboBox();
+    batchLayout->addWidget(m_groupColumnCombo, 1);
+    m_batchForecastButton = new QPushButton("按分组批量预测...");
+    m_batchForecastButton->setToolTip("按分组列拆分所选列，对每组分别拟合当前指数平滑模型");
+    batchLayout->addWidget(m_batchForecastButton);
+    forecastingLayout->addLayout(batchLayout);
+
+    // 序列诊断：自相关、互相关与周期图（基于 FFT）
+    auto *diagnosticsGroup = new QGroupBox("序列诊断");
+    auto *diagnosticsLayout = new QHBoxLayout();
+    diagnosticsLayout->addWidget(new QLabel("最大滞后:"));
+    m_maxLagSpinBox = new QSpinBox();
+    m_maxLagSpinBox->setRange(0, 100000);
+    m_maxLagSpinBox->setSpecialValueText("自动");
+    m_maxLagSpinBox->setValue(0);
+    diagnosticsLayout->addWidget(m_maxLagSpinBox);
+    m_acfButton = new QPushButton("自相关 (ACF/PACF)");
+    diagnosticsLayout->addWidget(m_acfButton);
+    m_periodogramButton = new QPushButton("周期图");
+    m_periodogramButton->setToolTip("去除线性趋势后计算周期图，列出功率最大的周期");
+    diagnosticsLayout->addWidget(m_periodogramButton);
+    diagnosticsLayout->addWidget(new QLabel("与列:"));
+    m_crossColumnCombo = new QComboBox();
+    diagnosticsLayout->addWidget(m_crossColumnCombo, 1);
+    m_ccfButton = new QPushButton("互相关");
+    diagnosticsLayout->addWidget(m_ccfButton);
+    diagnosticsGroup->setLayout(diagnosticsLayout);
+    forecastingLayout->addWidget(diagnosticsGroup);
+
     // 预测结果
     m_forecastResultsTextEdit = new QTextEdit();
     m_forecastResultsTextEdit->setReadOnly(true);
@@ -105,6 +251,56 @@ void StatisticsDialog::setupUI()
 
     m_tabWidget->addTab(m_forecastingTab, "预测分析");
 
+    // === 模型回测标签页 ===
+    m_backtestTab = new QWidget();
+    auto *backtestLayout = new QVBoxLayout(m_backtestTab);
+
+    auto *backtestGroup = new QGroupBox("回测参数");
+    auto *backtestForm = new QFormLayout();
+
+    m_backtestColumnCombo = new QComboBox();
+    backtestForm->addRow("选择列:", m_backtestColumnCombo);
+
+    m_backtestWindowCombo = new QComboBox();
+    m_backtestWindowCombo->addItem("扩展窗口", static_cast<int>(Statistics::BacktestWindow::Expanding));
+    m_backtestWindowCombo->addItem("滑动窗口", static_cast<int>(Statistics::BacktestWindow::Sliding));
+    backtestForm->addRow("训练窗口:", m_backtestWindowCombo);
+
+    m_trainingSizeSpinBox = new QSpinBox();
+    m_trainingSizeSpinBox->setRange(0, 1000000);
+    m_trainingSizeSpinBox->setSpecialValueText("自动（数据量的一半）");
+    m_trainingSizeSpinBox->setValue(0);
+    backtestForm->addRow("训练长度:", m_trainingSizeSpinBox);
+
+    m_horizonSpinBox = new QSpinBox();
+    m_horizonSpinBox->setRange(1, 100);
+    m_horizonSpinBox->setValue(1);
+    backtestForm->addRow("预测期数:", m_horizonSpinBox);
+
+    m_stepSpinBox = new QSpinBox();
+    m_stepSpinBox->setRange(1, 10000);
+    m_stepSpinBox->setValue(1);
+    backtestForm->addRow("起点间隔:", m_stepSpinBox);
+
+    m_parameterGridCheckBox = new QCheckBox("遍历参数网格（否则使用预测分析页的参数）");
+    backtestForm->addRow("", m_parameterGridCheckBox);
+
+    backtestGroup->setLayout(backtestForm);
+    backtestLayout->addWidget(backtestGroup);
+
+    m_backtestButton = new QPushButton("执行回测");
+    backtestLayout->addWidget(m_backtestButton);
+
+    m_backtestInfoLabel = new QLabel();
+    backtestLayout->addWidget(m_backtestInfoLabel);
+
+    m_backtestTable = new QTableWidget();
+    m_backtestTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_backtestTable->horizontalHeader()->setStretchLastSection(true);
+    backtestLayout->addWidget(m_backtestTable);
+
+    m_tabWidget->addTab(m_backtestTab, "模型回测");
+
     mainLayout->addWidget(m_tabWidget);
 
     // 连接信号
@@ -112,6 +308,16 @@ void StatisticsDialog::setupUI()
             this, &StatisticsDialog::onCalculateClicked);
     connect(m_forecastButton, &QPushButton::clicked,
             this, &StatisticsDialog::onCalculateClicked);
+    connect(m_batchForecastButton, &QPushButton::clicked,
+            this, &StatisticsDialog::onBatchForecastClicked);
+    connect(m_backtestButton, &QPushButton::clicked,
+            this, &StatisticsDialog::onBacktestClicked);
+    connect(m_acfButton, &QPushButton::clicked,
+            this, &StatisticsDialog::onAutocorrelationClicked);
+    connect(m_ccfButton, &QPushButton::clicked,
+            this, &StatisticsDialog::onCrossCorrelationClicked);
+    connect(m_periodogramButton, &QPushButton::clicked,
+            this, &StatisticsDialog::onPeriodogramClicked);
     connect(m_tabWidget, &QTabWidget::currentChanged,
             this, &StatisticsDialog::onTabChanged);
 }
@@ -125,11 +331,17 @@ void StatisticsDialog::setTableData(Core::TableData *data)
     // 更新列选择下拉框
     m_columnCombo->clear();
     m_forecastColumnCombo->clear();
+    m_groupColumnCombo->clear();
+    m_crossColumnCombo->clear();
+    m_backtestColumnCombo->clear();
 
     for (int col = 0; col < m_tableData->columnCount(); ++col) {
         QString header = m_tableData->header(col);
         m_columnCombo->addItem(header, col);
         m_forecastColumnCombo->addItem(header, col);
+        m_groupColumnCombo->addItem(header, col);
+        m_crossColumnCombo->addItem(header, col);
+        m_backtestColumnCombo->addItem(header, col);
     }
 }
 
@@ -158,27 +370,51 @@ void StatisticsDialog::onCalculateClicked()
         calculateDescriptiveStats();
     } else if (currentTab == 1) {
         calculateForecasting();
+    } else if (currentTab == 2) {
+        onBacktestClicked();
     }
 }
 
 void StatisticsDialog::calculateDescriptiveStats()
 {
     int column = m_columnCombo->currentData().toInt();
-    QVector<double> data = m_tableData->toDoubleVector(column);
-
-    if (data.isEmpty()) {
+    if (Statistics::CachedStatistics::values(*m_tableData, column)->isEmpty()) {
         QMessageBox::warning(this, "错误", "所选列没有有效数据");
         return;
     }
 
-    // 计算描述性统计
-    Statistics::DescriptiveSummary summary = Statistics::DescriptiveStats::summarize(data);
+    // 计算描述性统计（列未修改时直接取缓存结果）
+    auto summary = Statistics::CachedStatistics::summary(*m_tableData, column);
+
+    // 自助法置信区间（可选，结果按列版本缓存）
+    QString intervals;
+    if (m_bootstrapCheckBox->isChecked()) {
+        Statistics::BootstrapOptions options;
+        options.resamples = BOOTSTRAP_RESAMPLES;
+
+        QApplication::setOverrideCursor(Qt::WaitCursor);
+        for (auto statistic : {Statistics::BootstrapStatistic::Mean, Statistics::BootstrapStatistic::Median,
+                               Statistics::BootstrapStatistic::StandardDeviation}) {
+            auto interval = Statistics::CachedStatistics::bootstrapInterval(*m_tableData, column, statistic, options);
+            const Statistics::BootstrapInterval &ci = *interval;
+            if (!ci.isValid) {
+                continue;
+            }
+            intervals += QString("  %1: [%2, %3]  标准误 %4%5\n")
+                             .arg(Statistics::Bootstrap::statisticName(statistic))
+                             .arg(ci.lower, 0, 'f', 4)
+                             .arg(ci.upper, 0, 'f', 4)
+                             .arg(ci.standardError, 0, 'f', 4)
+                             .arg(ci.approximate ? "（分层近似）" : "");
+        }
+        QApplication::restoreOverrideCursor();
+    }
 
     // 显示结果
-    displaySummary(summary);
+    displaySummary(*summary, intervals);
 }
 
-void StatisticsDialog::displaySummary(const Statistics::DescriptiveSummary &summary)
+void StatisticsDialog::displaySummary(const Statistics::DescriptiveSummary &summary, const QString &intervals)
 {
     QString result;
 
@@ -204,6 +440,20 @@ void StatisticsDialog::displaySummary(const Statistics::DescriptiveSummary &summ
     result += QString("  偏度: %1\n").arg(summary.skewness, 0, 'f', 4);
     result += QString("  峰度: %1\n\n").arg(summary.kurtosis, 0, 'f', 4);
 
+    if (!intervals.isEmpty()) {
+        result += QString("【95% 置信区间（自助法，%1 次重抽样）】\n").arg(BOOTSTRAP_RESAMPLES);
+        result += intervals + "\n";
+    }
+
+    if (!summary.topValues.isEmpty()) {
+        result += "【高频值】\n";
+        for (int i = 0; i < summary.topValues.size(); ++i) {
+            const auto &item = summary.topValues[i];
+            result += QString("  %1. %2 (出现 %3 次)\n").arg(i + 1).arg(item.label).arg(item.count);
+        }
+        result += "\n";
+    }
+
     result += "========== 说明 ==========\n";
     result += "偏度 > 0: 右偏（正偏）\n";
     result += "偏度 < 0: 左偏（负偏）\n";
@@ -218,7 +468,7 @@ void StatisticsDialog::displaySummary(const Statistics::DescriptiveSummary &summ
 void StatisticsDialog::calculateForecasting()
 {
     int column = m_forecastColumnCombo->currentData().toInt();
-    QVector<double> data = m_tableData->toDoubleVector(column);
+    QVector<double> data = *Statistics::CachedStatistics::values(*m_tableData, column);
 
     if (data.isEmpty()) {
         QMessageBox::warning(this, "错误", "所选列没有有效数据");
@@ -226,21 +476,70 @@ void StatisticsDialog::calculateForecasting()
     }
 
     QString method = m_forecastMethodCombo->currentText();
+    const double confidence = m_confidenceSpinBox->value() / 100.0;
     Statistics::ForecastResult result;
 
+    // 自动优化平滑系数，结果回填到输入框
+    QString tuningInfo;
+    Statistics::SmoothingModel smoothingModel;
+    bool smoothing = smoothingModelFor(method, &smoothingModel);
+    if (smoothing && m_autoTuneCheckBox->isChecked()) {
+        Statistics::SmoothingFitOptions options;
+        options.model = smoothingModel;
+        options.seasonLength = m_seasonLengthSpinBox->value();
+        options.criterion = static_cast<Statistics::FitCriterion>(m_criterionCombo->currentData().toInt());
+
+        QApplication::setOverrideCursor(Qt::WaitCursor);
+        Statistics::SmoothingFitResult fit = Statistics::SmoothingOptimizer::optimize(data, options);
+        QApplication::restoreOverrideCursor();
+
+        if (!fit.isValid) {
+            QMessageBox::warning(this, "错误", fit.errorMessage);
+            return;
+        }
+
+        m_alphaSpinBox->setValue(fit.parameters.alpha);
+        if (smoothingModel != Statistics::SmoothingModel::Simple) {
+            m_betaSpinBox->setValue(fit.parameters.beta);
+        }
+        if (smoothingModel == Statistics::SmoothingModel::HoltWintersAdditive ||
+            smoothingModel == Statistics::SmoothingModel::HoltWintersMultiplicative) {
+            m_gammaSpinBox->setValue(fit.parameters.gamma);
+        }
+
+        tuningInfo += "参数优化:\n";
+        tuningInfo += QString("  %1: %2\n").arg(m_criterionCombo->currentText()).arg(fit.error, 0, 'f', 6);
+        tuningInfo += QString("  目标函数求值: %1 次（提前终止 %2 次）\n\n").arg(fit.evaluations).arg(fit.abandoned);
+    }
+
     if (method == "简单移动平均") {
         int window = m_windowSpinBox->value();
         int periods = m_forecastPeriodsSpinBox->value();
-        result = Statistics::Forecasting::simpleMovingAverage(data, window, periods);
+        result = Statistics::Forecasting::simpleMovingAverage(data, window, periods, confidence);
 
     } else if (method == "指数平滑") {
         double alpha = m_alphaSpinBox->value();
         int periods = m_forecastPeriodsSpinBox->value();
-        result = Statistics::Forecasting::exponentialSmoothing(data, alpha, periods);
+        result = Statistics::Forecasting::exponentialSmoothing(data, alpha, periods, confidence);
+
+    } else if (method == "Holt 线性趋势") {
+        double alpha = m_alphaSpinBox->value();
+        double beta = m_betaSpinBox->value();
+        int periods = m_forecastPeriodsSpinBox->value();
+        result = Statistics::Forecasting::doubleExponentialSmoothing(data, alpha, beta, periods, confidence);
+
+    } else if (smoothing && (smoothingModel == Statistics::SmoothingModel::HoltWintersAdditive ||
+                             smoothingModel == Statistics::SmoothingModel::HoltWintersMultiplicative)) {
+        int periods = m_forecastPeriodsSpinBox->value();
+        bool multiplicative = smoothingModel == Statistics::SmoothingModel::HoltWintersMultiplicative;
+        result = Statistics::Forecasting::holtWinters(data, m_seasonLengthSpinBox->value(),
+                                                      m_alphaSpinBox->value(), m_betaSpinBox->value(),
+                                                      m_gammaSpinBox->value(), multiplicative, periods,
+                                                      confidence);
 
     } else if (method == "线性回归") {
         int periods = m_forecastPeriodsSpinBox->value();
-        result = Statistics::Forecasting::linearRegression(data, periods);
+        result = Statistics::Forecasting::linearRegression(data, periods, confidence);
 
     } else {
         QMessageBox::information(this, "提示", "该方法待实现");
@@ -256,14 +555,377 @@ void StatisticsDialog::calculateForecasting()
     QString output;
     output += "========== 预测结果 ==========\n\n";
     output += QString("方法: %1\n").arg(method);
-    output += QString("预测期数: %1\n\n").arg(result.predicted.size());
+    output += QString("预测期数: %1\n").arg(result.predicted.size());
+    if (smoothing) {
+        output += QString("α = %1").arg(m_alphaSpinBox->value(), 0, 'f', 4);
+        if (smoothingModel != Statistics::SmoothingModel::Simple) {
+            output += QString(", β = %1").arg(m_betaSpinBox->value(), 0, 'f', 4);
+        }
+        if (smoothingModel == Statistics::SmoothingModel::HoltWintersAdditive ||
+            smoothingModel == Statistics::SmoothingModel::HoltWintersMultiplicative) {
+            output += QString(", γ = %1（周期 %2）").arg(m_gammaSpinBox->value(), 0, 'f', 4)
+                                                  .arg(m_seasonLengthSpinBox->value());
+        }
+        output += "\n";
+    }
+    output += "\n" + tuningInfo;
 
-    output += "预测值:\n";
+    const bool hasIntervals = result.lowerBound.size() == result.predicted.size() &&
+                              result.upperBound.size() == result.predicted.size();
+    output += hasIntervals ? QString("预测值（%1% 预测区间）:\n").arg(m_confidenceSpinBox->value(), 0, 'f', 1)
+                           : QString("预测值:\n");
     for (int i = 0; i < result.predicted.size(); ++i) {
-        output += QString("  期 %1: %2\n").arg(i + 1).arg(result.predicted[i], 0, 'f', 4);
+        output += QString("  期 %1: %2").arg(i + 1).arg(result.predicted[i], 0, 'f', 4);
+        if (hasIntervals) {
+            output += QString("  [%1, %2]").arg(result.lowerBound[i], 0, 'f', 4)
+                                            .arg(result.upperBound[i], 0, 'f', 4);
+        }
+        output += "\n";
     }
 
     output += QString("\n误差指标 (MSE): %1\n").arg(result.errorMetric, 0, 'f', 6);
 
     m_forecastResultsTextEdit->setText(output);
 }
+
+void StatisticsDialog::onBatchForecastClicked()
+{
+    if (!m_tableData) {
+        QMessageBox::warning(this, "错误", "没有数据");
+        return;
+    }
+
+    Statistics::BatchForecastOptions options;
+    if (!smoothingModelFor(m_forecastMethodCombo->currentText(), &options.model)) {
+        QMessageBox::information(this, "提示", "批量预测仅支持指数平滑类方法");
+        return;
+    }
+
+    int keyColumn = m_groupColumnCombo->currentData().toInt();
+    int valueColumn = m_forecastColumnCombo->currentData().toInt();
+    if (keyColumn == valueColumn) {
+        QMessageBox::warning(this, "错误", "分组列与预测列不能相同");
+        return;
+    }
+
+    options.seasonLength = m_seasonLengthSpinBox->value();
+    options.forecastPeriods = m_forecastPeriodsSpinBox->value();
+    options.parameters.alpha = m_alphaSpinBox->value();
+    options.parameters.beta = m_betaSpinBox->value();
+    options.parameters.gamma = m_gammaSpinBox->value();
+    options.autoTune = m_autoTuneCheckBox->isChecked();
+    options.criterion = static_cast<Statistics::FitCriterion>(m_criterionCombo->currentData().toInt());
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    Statistics::BatchForecastSummary summary;
+    std::unique_ptr<Core::TableData> forecasts(
+        Statistics::BatchForecaster::forecastByGroup(*m_tableData, keyColumn, valueColumn, options, &summary));
+    QApplication::restoreOverrideCursor();
+
+    if (!forecasts) {
+        QMessageBox::warning(this, "错误", "批量预测参数无效");
+        return;
+    }
+
+    // 结果预览
+    QDialog dialog(this);
+    dialog.setWindowTitle("分组批量预测结果");
+    dialog.resize(900, 600);
+    auto *layout = new QVBoxLayout(&dialog);
+
+    QString info = QString("分组数: %1，降级模型: %2，无有效数据: %3")
+                       .arg(summary.groupCount).arg(summary.fallbackCount).arg(summary.failedCount);
+    int previewRows = std::min(forecasts->rowCount(), BATCH_PREVIEW_ROWS);
+    if (previewRows < forecasts->rowCount()) {
+        info += QString("（仅显示前 %1 行，共 %2 行，完整结果请导出）").arg(previewRows).arg(forecasts->rowCount());
+    }
+    layout->addWidget(new QLabel(info));
+
+    auto *table = new QTableWidget(previewRows, forecasts->columnCount());
+    table->setHorizontalHeaderLabels(forecasts->headers());
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    for (int row = 0; row < previewRows; ++row) {
+        for (int col = 0; col < forecasts->columnCount(); ++col) {
+            QVariant value = forecasts->at(row, col);
+            QString text = value.typeId() == QMetaType::Double ? QString::number(value.toDouble(), 'f', 4)
+                                                               : value.toString();
+            table->setItem(row, col, new QTableWidgetItem(text));
+        }
+    }
+    layout->addWidget(table);
+
+    auto *buttonLayout = new QHBoxLayout();
+    auto *exportButton = new QPushButton("导出 CSV...");
+    auto *closeButton = new QPushButton("关闭");
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(exportButton);
+    buttonLayout->addWidget(closeButton);
+    layout->addLayout(buttonLayout);
+
+    connect(closeButton, &QPushButton::clicked, &dialog, &QDialog::accept);
+    connect(exportButton, &QPushButton::clicked, &dialog, [&]() {
+        QString filePath = QFileDialog::getSaveFileName(&dialog, "导出预测结果", "forecasts.csv", "CSV 文件 (*.csv)");
+        if (filePath.isEmpty()) {
+            return;
+        }
+        DataExporter exporter;
+        ExportResult exported = exporter.exportToCsv(forecasts.get(), filePath);
+        if (!exported.success) {
+            QMessageBox::warning(&dialog, "错误", "导出失败: " + exported.errorMessage);
+        }
+    });
+
+    dialog.exec();
+}
+
+QVector<Statistics::BacktestCandidate> StatisticsDialog::backtestCandidates() const
+{
+    using Statistics::ForecastMethod;
+
+    QVector<Statistics::BacktestCandidate> candidates;
+    const int seasonLength = m_seasonLengthSpinBox->value();
+
+    auto add = [&](ForecastMethod method, int window, double alpha, double beta, double gamma) {
+        Statistics::BacktestCandidate candidate;
+        candidate.method = method;
+        candidate.window = window;
+        if (method == ForecastMethod::WeightedMovingAverage) {
+            candidate.weights = linearWeights(window);
+        }
+        candidate.parameters.alpha = alpha;
+        candidate.parameters.beta = beta;
+        candidate.parameters.gamma = gamma;
+        candidate.seasonLength = seasonLength;
+        candidates.append(candidate);
+    };
+
+    if (!m_parameterGridCheckBox->isChecked()) {
+        const int window = m_windowSpinBox->value();
+        const double alpha = m_alphaSpinBox->value();
+        const double beta = m_betaSpinBox->value();
+        const double gamma = m_gammaSpinBox->value();
+        for (ForecastMethod method : {ForecastMethod::SimpleMovingAverage, ForecastMethod::WeightedMovingAverage,
+                                      ForecastMethod::ExponentialSmoothing, ForecastMethod::HoltLinear,
+                                      ForecastMethod::HoltWintersAdditive,
+                                      ForecastMethod::HoltWintersMultiplicative,
+                                      ForecastMethod::LinearRegression}) {
+            add(method, window, alpha, beta, gamma);
+        }
+        return candidates;
+    }
+
+    for (int window : GRID_WINDOWS) {
+        add(ForecastMethod::SimpleMovingAverage, window, 0.0, 0.0, 0.0);
+        add(ForecastMethod::WeightedMovingAverage, window, 0.0, 0.0, 0.0);
+    }
+    for (double alpha : GRID_ALPHAS) {
+        add(ForecastMethod::ExponentialSmoothing, 0, alpha, 0.0, 0.0);
+        for (double beta : GRID_BETAS) {
+            add(ForecastMethod::HoltLinear, 0, alpha, beta, 0.0);
+            for (double gamma : GRID_GAMMAS) {
+                add(ForecastMethod::HoltWintersAdditive, 0, alpha, beta, gamma);
+                add(ForecastMethod::HoltWintersMultiplicative, 0, alpha, beta, gamma);
+            }
+        }
+    }
+    add(ForecastMethod::LinearRegression, 0, 0.0, 0.0, 0.0);
+    return candidates;
+}
+
+void StatisticsDialog::onBacktestClicked()
+{
+    if (!m_tableData) {
+        QMessageBox::warning(this, "错误", "没有数据");
+        return;
+    }
+
+    int column = m_backtestColumnCombo->currentData().toInt();
+    auto data = Statistics::CachedStatistics::values(*m_tableData, column);
+    if (data->isEmpty()) {
+        QMessageBox::warning(this, "错误", "所选列没有有效数据");
+        return;
+    }
+
+    Statistics::BacktestOptions options;
+    options.windowType = static_cast<Statistics::BacktestWindow>(m_backtestWindowCombo->currentData().toInt());
+    options.trainingSize = m_trainingSizeSpinBox->value();
+    options.horizon = m_horizonSpinBox->value();
+    options.step = m_stepSpinBox->value();
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    Statistics::BacktestResult result = Statistics::Backtester::run(*data, backtestCandidates(), options);
+    QApplication::restoreOverrideCursor();
+
+    if (!result.isValid) {
+        QMessageBox::warning(this, "错误", result.errorMessage);
+        return;
+    }
+
+    std::unique_ptr<Core::TableData> scores(Statistics::Backtester::toTable(result));
+    m_backtestInfoLabel->setText(QString("预测起点: %1 个，候选模型: %2 个（按 RMSE 升序）")
+                                     .arg(result.folds).arg(result.scores.size()));
+
+    m_backtestTable->clear();
+    m_backtestTable->setRowCount(scores->rowCount());
+    m_backtestTable->setColumnCount(scores->columnCount());
+    m_backtestTable->setHorizontalHeaderLabels(scores->headers());
+    for (int row = 0; row < scores->rowCount(); ++row) {
+        for (int col = 0; col < scores->columnCount(); ++col) {
+            QVariant value = scores->at(row, col);
+            QString text = value.typeId() == QMetaType::Double ? QString::number(value.toDouble(), 'f', 4)
+                                                               : value.toString();
+            m_backtestTable->setItem(row, col, new QTableWidgetItem(text));
+        }
+    }
+    m_backtestTable->resizeColumnsToContents();
+}
+
+void StatisticsDialog::onAutocorrelationClicked()
+{
+    if (!m_tableData) {
+        QMessageBox::warning(this, "错误", "没有数据");
+        return;
+    }
+
+    int column = m_forecastColumnCombo->currentData().toInt();
+    const double confidence = m_confidenceSpinBox->value() / 100.0;
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    Statistics::CorrelogramResult result =
+        Statistics::SpectralAnalysis::autocorrelation(*m_tableData, column, m_maxLagSpinBox->value(), confidence);
+    QApplication::restoreOverrideCursor();
+
+    if (!result.isValid) {
+        QMessageBox::warning(this, "错误", result.errorMessage);
+        return;
+    }
+
+    QString output;
+    output += "========== 自相关分析 ==========\n\n";
+    output += QString("列: %1\n").arg(m_forecastColumnCombo->currentText());
+    output += QString("有效值: %1，均值: %2，方差: %3\n")
+                  .arg(result.observations).arg(result.mean, 0, 'f', 4).arg(result.variance, 0, 'f', 4);
+    output += QString("%1% 置信界: ±%2（* 表示超出）\n\n")
+                  .arg(m_confidenceSpinBox->value(), 0, 'f', 1).arg(result.confidenceBound, 0, 'f', 4);
+
+    if (!result.suggestedPeriods.isEmpty()) {
+        QStringList periods;
+        for (int period : result.suggestedPeriods) {
+            periods << QString::number(period);
+        }
+        output += QString("候选季节周期: %1").arg(periods.join(", "));
+        int period = result.suggestedPeriods.first();
+        if (period >= m_seasonLengthSpinBox->minimum() && period <= m_seasonLengthSpinBox->maximum()) {
+            m_seasonLengthSpinBox->setValue(period);
+            output += "（已填入季节周期）";
+        }
+        output += "\n\n";
+    }
+
+    const int lags = std::min(result.maxLag, DIAGNOSTIC_PREVIEW_LAGS);
+    output += QString("%1 %2 %3  ACF\n").arg("滞后", 6).arg("ACF", 9).arg("PACF", 9);
+    for (int k = 1; k <= lags; ++k) {
+        output += QString("%1 %2 %3  %4\n").arg(k, 6).arg(result.acf[k], 9, 'f', 4)
+                                           .arg(result.pacf[k], 9, 'f', 4)
+                                           .arg(correlationBar(result.acf[k], result.confidenceBound));
+    }
+    if (lags < result.maxLag) {
+        output += QString("...（仅显示前 %1 个滞后，共 %2 个）\n").arg(lags).arg(result.maxLag);
+    }
+
+    m_forecastResultsTextEdit->setText(output);
+}
+
+void StatisticsDialog::onCrossCorrelationClicked()
+{
+    if (!m_tableData) {
+        QMessageBox::warning(this, "错误", "没有数据");
+        return;
+    }
+
+    int xColumn = m_forecastColumnCombo->currentData().toInt();
+    int yColumn = m_crossColumnCombo->currentData().toInt();
+    if (xColumn == yColumn) {
+        QMessageBox::warning(this, "错误", "互相关需要选择两列不同的数据");
+        return;
+    }
+    const double confidence = m_confidenceSpinBox->value() / 100.0;
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    Statistics::CrossCorrelationResult result = Statistics::SpectralAnalysis::crossCorrelation(
+        *m_tableData, xColumn, yColumn, m_maxLagSpinBox->value(), confidence);
+    QApplication::restoreOverrideCursor();
+
+    if (!result.isValid) {
+        QMessageBox::warning(this, "错误", result.errorMessage);
+        return;
+    }
+
+    const QString xName = m_forecastColumnCombo->currentText();
+    const QString yName = m_crossColumnCombo->currentText();
+
+    QString output;
+    output += "========== 互相关分析 ==========\n\n";
+    output += QString("x = %1，y = %2（滞后 k 处为 x(t+k) 与 y(t) 的相关系数）\n").arg(xName, yName);
+    output += QString("同时有效的行数: %1\n").arg(result.observations);
+    output += QString("%1% 置信界: ±%2（* 表示超出）\n")
+                  .arg(m_confidenceSpinBox->value(), 0, 'f', 1).arg(result.confidenceBound, 0, 'f', 4);
+    output += QString("最强相关: 滞后 %1，r = %2").arg(result.peakLag).arg(result.peakValue, 0, 'f', 4);
+    if (result.peakLag > 0) {
+        output += QString("（%1 领先 %2 %3 期）").arg(yName, xName).arg(result.peakLag);
+    } else if (result.peakLag < 0) {
+        output += QString("（%1 领先 %2 %3 期）").arg(xName, yName).arg(-result.peakLag);
+    }
+    output += "\n\n";
+
+    const int lags = std::min(result.maxLag, DIAGNOSTIC_PREVIEW_LAGS);
+    output += QString("%1 %2\n").arg("滞后", 6).arg("CCF", 9);
+    for (int k = -lags; k <= lags; ++k) {
+        double value = result.values[k + result.maxLag];
+        output += QString("%1 %2  %3\n").arg(k, 6).arg(value, 9, 'f', 4)
+                                        .arg(correlationBar(value, result.confidenceBound));
+    }
+    if (lags < result.maxLag) {
+        output += QString("...（仅显示 ±%1 个滞后，共 ±%2 个）\n").arg(lags).arg(result.maxLag);
+    }
+
+    m_forecastResultsTextEdit->setText(output);
+}
+
+void StatisticsDialog::onPeriodogramClicked()
+{
+    if (!m_tableData) {
+        QMessageBox::warning(this, "错误", "没有数据");
+        return;
+    }
+
+    int column = m_forecastColumnCombo->currentData().toInt();
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    Statistics::PeriodogramResult result = Statistics::SpectralAnalysis::periodogram(*m_tableData, column);
+    QApplication::restoreOverrideCursor();
+
+    if (!result.isValid) {
+        QMessageBox::warning(this, "错误", result.errorMessage);
+        return;
+    }
+
+    QString output;
+    output += "========== 周期图 ==========\n\n";
+    output += QString("列: %1\n").arg(m_forecastColumnCombo->currentText());
+    output += QString("有效值: %1，变换长度: %2（补零），已去除线性趋势\n\n")
+                  .arg(result.observations).arg(result.transformSize);
+
+    output += "功率最大的周期:\n";
+    output += QString("%1 %2 %3\n").arg("周期", 12).arg("频率", 12).arg("功率", 14);
+    for (const Statistics::SpectralPeak &peak : result.peaks) {
+        output += QString("%1 %2 %3\n").arg(peak.period, 12, 'f', 2).arg(peak.frequency, 12, 'f', 6)
+                                       .arg(peak.power, 14, 'g', 6);
+    }
+    if (!result.peaks.isEmpty()) {
+        output += QString("\n主周期约为 %1 期").arg(qRound(result.peaks.first().period));
+        output += "（补零后频率分辨率有限，可结合自相关图确认）\n";
+    }
+
+    m_forecastResultsTextEdit->setText(output);
+}
@@ -10,15 +10,20 @@
 #include <QLabel>
 #include <QSpinBox>
 #include <QDoubleSpinBox>
+#include <QCheckBox>
 
 #include "core/TableData.h"
 #include "statistics/DescriptiveStats.h"
 #include "statistics/Forecasting.h"
+#include "statistics/CachedStatistics.h"
+#include "statistics/SmoothingOptimizer.h"
+#include "statistics/Backtester.h"
+#include "statistics/SpectralAnalysis.h"
 
 /**
  * @brief 统计计算对话框
  *
- * 提供描述性统计、预测分析等功能
+ * 提供描述性统计、预测分析（含自相关/周期图等序列诊断）与模型回测等功能
  */
 class StatisticsDialog : public QDialog
 {
@@ -34,18 +39,25 @@ private slots:
     void onCalculateClicked();
     void onColumnChanged(int index);
     void onTabChanged(int index);
+    void onBatchForecastClicked();
+    void onBacktestClicked();
+    void onAutocorrelationClicked();
+    void onCrossCorrelationClicked();
+    void onPeriodogramClicked();
 
 private:
     void setupUI();
     void calculateDescriptiveStats();
     void calculateForecasting();
-    void displaySummary(const Statistics::DescriptiveSummary &summary);
+    void displaySummary(const Statistics::DescriptiveSummary &summary, const QString &intervals);
+    QVector<Statistics::BacktestCandidate> backtestCandidates() const;
 
     QTabWidget *m_tabWidget;
 
     // 描述性统计标签页
     QWidget *m_descriptiveTab;
     QComboBox *m_columnCombo;
+    QCheckBox *m_bootstrapCheckBox;
     QPushButton *m_calculateButton;
     QTextEdit *m_resultsTextEdit;
 
@@ -55,10 +67,35 @@ private:
     QComboBox *m_forecastMethodCombo;
     QSpinBox *m_windowSpinBox;
     QDoubleSpinBox *m_alphaSpinBox;
+    QDoubleSpinBox *m_betaSpinBox;
+    QDoubleSpinBox *m_gammaSpinBox;
+    QSpinBox *m_seasonLengthSpinBox;
+    QCheckBox *m_autoTuneCheckBox;
+    QComboBox *m_criterionCombo;
     QSpinBox *m_forecastPeriodsSpinBox;
+    QDoubleSpinBox *m_confidenceSpinBox;
     QPushButton *m_forecastButton;
+    QComboBox *m_groupColumnCombo;
+    QPushButton *m_batchForecastButton;
+    QSpinBox *m_maxLagSpinBox;
+    QComboBox *m_crossColumnCombo;
+    QPushButton *m_acfButton;
+    QPushButton *m_ccfButton;
+    QPushButton *m_periodogramButton;
     QTextEdit *m_forecastResultsTextEdit;
 
+    // 模型回测标签页（预测方法参数取自预测分析标签页）
+    QWidget *m_backtestTab;
+    QComboBox *m_backtestColumnCombo;
+    QComboBox *m_backtestWindowCombo;
+    QSpinBox *m_trainingSizeSpinBox;
+    QSpinBox *m_horizonSpinBox;
+    QSpinBox *m_stepSpinBox;
+    QCheckBox *m_parameterGridCheckBox;
+    QPushButton *m_backtestButton;
+    QLabel *m_backtestInfoLabel;
+    QTableWidget *m_backtestTable;
+
     Core::TableData *m_tableData;
 };
 
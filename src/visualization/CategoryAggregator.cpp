@@ -0,0 +1,170 @@
+#include "CategoryAggregator.h"
+#include <QHash>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace Charts {
+
+namespace {
+
+// "其他"一项标签的前缀与后缀
+const QString OTHER_PREFIX = "其他（";
+const QString OTHER_SUFFIX = " 类）";
+
+/**
+ * @brief 用于排名的键：合计相同时先出现的类别排在前面
+ */
+using RankKey = std::pair<double, int>;
+
+RankKey rankKey(const CategoryGroups& groups, int group)
+{
+    const double value = groups.sums.isEmpty() ? 0.0 : groups.sums.first()[group];
+    return RankKey(value, -group);
+}
+
+/**
+ * @brief 合计最大的 count 个类别（降序）
+ *
+ * 维护大小为 count 的最小堆，堆顶是当前入选者中最小的一个，
+ * 耗时 O(G log count)。
+ */
+QVector<int> largestGroups(const CategoryGroups& groups, int count)
+{
+    std::priority_queue<RankKey, std::vector<RankKey>, std::greater<RankKey>> heap;
+    for (int group = 0; group < groups.groupCount(); ++group) {
+        const RankKey key = rankKey(groups, group);
+        if (static_cast<int>(heap.size()) < count) {
+            heap.push(key);
+        } else if (heap.top() < key) {
+            heap.pop();
+            heap.push(key);
+        }
+    }
+
+    QVector<int> selected(static_cast<int>(heap.size()));
+    for (int i = selected.size() - 1; i >= 0; --i) {
+        selected[i] = -heap.top().second;
+        heap.pop();
+    }
+    return selected;
+}
+
+} // namespace
+
+CategoryGroups CategoryAggregator::group(const ChartData& data)
+{
+    CategoryGroups groups;
+    groups.sums.resize(data.series.size());
+
+    const int rows = data.categories.size();
+    QVector<int> codes(rows);
+    QHash<QString, int> index;
+    index.reserve(std::min(rows, 1 << 16));
+    for (int row = 0; row < rows; ++row) {
+        const QString& label = data.categories[row];
+        int code = index.value(label, -1);
+        if (code < 0) {
+            code = groups.labels.size();
+            index.insert(label, code);
+            groups.labels.append(label);
+        }
+        codes[row] = code;
+    }
+
+    for (int s = 0; s < data.series.size(); ++s) {
+        const QVector<double>& values = data.series[s].values;
+        QVector<double>& sums = groups.sums[s];
+        sums.fill(0.0, groups.labels.size());
+        const int count = std::min(rows, static_cast<int>(values.size()));
+        for (int row = 0; row < count; ++row) {
+            if (!std::isnan(values[row])) {
+                sums[codes[row]] += values[row];
+            }
+        }
+    }
+    return groups;
+}
+
+ChartData CategoryAggregator::topN(const ChartData& data, const CategoryGroups& groups, int topN, int offset)
+{
+    ChartData result;
+    result.title = data.title;
+    result.xAxisTitle = data.xAxisTitle;
+    result.yAxisTitle = data.yAxisTitle;
+
+    const int groupCount = groups.groupCount();
+    topN = std::max(1, topN);
+    offset = std::clamp(offset, 0, std::max(0, groupCount - 1));
+
+    QVector<int> shown;
+    QVector<bool> selected(groupCount, false);
+    if (groupCount <= topN && offset == 0) {
+        // 类别不多：按首次出现的顺序全部保留
+        for (int group = 0; group < groupCount; ++group) {
+            shown.append(group);
+            selected[group] = true;
+        }
+    } else {
+        const QVector<int> largest = largestGroups(groups, std::min(groupCount, offset + topN));
+        for (int rank = 0; rank < largest.size(); ++rank) {
+            selected[largest[rank]] = true;
+            if (rank >= offset) {
+                shown.append(largest[rank]);
+            }
+        }
+    }
+
+    const int otherCount = groupCount - static_cast<int>(std::count(selected.begin(), selected.end(), true));
+    for (int group : shown) {
+        result.categories.append(groups.labels[group]);
+    }
+    if (otherCount > 0) {
+        result.categories.append(otherLabel(otherCount));
+    }
+
+    for (int s = 0; s < data.series.size(); ++s) {
+        DataSeries series = data.series[s];
+        const QVector<double>& sums = groups.sums[s];
+        series.labels.clear();
+        series.values.clear();
+        series.values.reserve(result.categories.size());
+        for (int group : shown) {
+            series.values.append(sums[group]);
+        }
+        if (otherCount > 0) {
+            double other = 0.0;
+            for (int group = 0; group < groupCount; ++group) {
+                if (!selected[group]) {
+                    other += sums[group];
+                }
+            }
+            series.values.append(other);
+        }
+        result.series.append(series);
+    }
+    return result;
+}
+
+ChartData CategoryAggregator::aggregate(const ChartData& data, int topN, int offset)
+{
+    if (topN <= 0 || (data.categories.size() <= topN && offset <= 0)) {
+        return data;
+    }
+    return CategoryAggregator::topN(data, group(data), topN, offset);
+}
+
+QString CategoryAggregator::otherLabel(int count)
+{
+    return OTHER_PREFIX + QString::number(count) + OTHER_SUFFIX;
+}
+
+bool CategoryAggregator::isOtherLabel(const QString& label)
+{
+    return label.startsWith(OTHER_PREFIX) && label.endsWith(OTHER_SUFFIX);
+}
+
+} // namespace Charts
@@ -0,0 +1,60 @@
+#ifndef CATEGORYAGGREGATOR_H
+#define CATEGORYAGGREGATOR_H
+
+#include "ChartTypes.h"
+#include <QString>
+#include <QVector>
+
+namespace Charts {
+
+/**
+ * @brief 按类别标签分组的合计
+ */
+struct CategoryGroups
+{
+    QVector<QString> labels;            // 类别（按首次出现的顺序）
+    QVector<QVector<double>> sums;      // sums[系列][类别]，NaN 不计入
+
+    int groupCount() const { return labels.size(); }
+};
+
+/**
+ * @brief 分类图表（柱状图、饼图）的类别汇总
+ *
+ * 每个类别一根柱子或一个扇区时，十万个类别会让类别轴和图例卡死界面。
+ * 先按类别标签哈希分组求和（相同标签合并为一项）；类别数不超过上限时
+ * 按首次出现的顺序全部保留，否则按第一个系列的合计用大小为
+ * offset + N 的最小堆选出排名 [offset, offset + N) 的类别（降序），其余
+ * 并入末尾的"其他"一项。逐层查看"其他"只需增大 offset 重新选取，不必
+ * 对全部类别排序；图表的类别数因此只取决于 N，与行数无关。
+ */
+class CategoryAggregator
+{
+public:
+    /**
+     * @brief 按类别标签分组求和
+     */
+    static CategoryGroups group(const ChartData& data);
+
+    /**
+     * @brief 选取排名 [offset, offset + topN) 的类别，其余并入"其他"
+     * @param data 原始图表数据（提供标题与系列样式）
+     * @return 类别数不超过 topN + 1 的图表数据
+     */
+    static ChartData topN(const ChartData& data, const CategoryGroups& groups, int topN, int offset = 0);
+
+    /**
+     * @brief 行数不超过 topN 且没有偏移时原样返回，否则分组后选取
+     */
+    static ChartData aggregate(const ChartData& data, int topN, int offset = 0);
+
+    /**
+     * @brief "其他"一项的标签（含被合并的类别数）
+     */
+    static QString otherLabel(int count);
+    static bool isOtherLabel(const QString& label);
+};
+
+} // namespace Charts
+
+#endif // CATEGORYAGGREGATOR_H
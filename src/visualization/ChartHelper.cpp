@@ -1,4 +1,6 @@
 #include "ChartHelper.h"
+#include "CategoryAggregator.h"
+#include "Decimation.h"
 #include "../core/TableData.h"
 #include "../statistics/DescriptiveStats.h"
 #include <QtCharts/QStackedBarSeries>
@@ -15,9 +17,17 @@
 #include <QtCharts/QBarCategoryAxis>
 #include <QDebug>
 #include <QFont>
+#include <algorithm>
 
 namespace Charts {
 
+namespace {
+
+// 点数超过此值的折线/散点系列不做动画（逐帧重绘大量点会明显拖慢首次显示）
+const int MAX_ANIMATED_POINTS = 1000;
+
+} // namespace
+
 QVector<QColor> g_defaultColors = {
     QColor(52, 152, 219),    // 蓝色
     QColor(46, 204, 113),    // 绿色
@@ -34,8 +44,10 @@ QColor ChartHelper::getDefaultColor(int index)
     return g_defaultColors[index % g_defaultColors.size()];
 }
 
-QChart* ChartHelper::createBarChart(const ChartData& data, const ChartStyle& style)
+QChart* ChartHelper::createBarChart(const ChartData& source, const ChartStyle& style)
 {
+    const ChartData data = limitCategories(source, style);
+
     auto* chart = new QChart();
     chart->setTitle(data.title);
     chart->setAnimationOptions(QChart::SeriesAnimations);
@@ -65,8 +77,10 @@ QChart* ChartHelper::createBarChart(const ChartData& data, const ChartStyle& sty
     return chart;
 }
 
-QChart* ChartHelper::createStackedBarChart(const ChartData& data, const ChartStyle& style)
+QChart* ChartHelper::createStackedBarChart(const ChartData& source, const ChartStyle& style)
 {
+    const ChartData data = limitCategories(source, style);
+
     auto* chart = new QChart();
     chart->setTitle(data.title);
     chart->setAnimationOptions(QChart::SeriesAnimations);
@@ -94,8 +108,10 @@ QChart* ChartHelper::createStackedBarChart(const ChartData& data, const ChartSty
     return chart;
 }
 
-QChart* ChartHelper::createPercentBarChart(const ChartData& data, const ChartStyle& style)
+QChart* ChartHelper::createPercentBarChart(const ChartData& source, const ChartStyle& style)
 {
+    const ChartData data = limitCategories(source, style);
+
     auto* chart = new QChart();
     chart->setTitle(data.title);
     chart->setAnimationOptions(QChart::SeriesAnimations);
@@ -140,9 +156,7 @@ QChart* ChartHelper::createLineChart(const ChartData& data, const ChartStyle& st
         pen.setWidth(dataSeries.lineWidth);
         series->setPen(pen);
 
-        for (int j = 0; j < dataSeries.values.size(); ++j) {
-            series->append(j, dataSeries.values[j]);
-        }
+        series->replace(seriesPoints(dataSeries, style, DecimationMethod::MinMax));
 
         chart->addSeries(series);
     }
@@ -185,9 +199,8 @@ QChart* ChartHelper::createSplineChart(const ChartData& data, const ChartStyle&
         pen.setWidth(dataSeries.lineWidth);
         series->setPen(pen);
 
-        for (int j = 0; j < dataSeries.values.size(); ++j) {
-            series->append(j, dataSeries.values[j]);
-        }
+        // 样条经过每个点，MinMax 的锯齿会被放大，因此默认用 LTTB
+        series->replace(seriesPoints(dataSeries, style, DecimationMethod::Lttb));
 
         chart->addSeries(series);
     }
@@ -225,9 +238,11 @@ QChart* ChartHelper::createAreaChart(const ChartData& data, const ChartStyle& st
     auto* topSeries = new QLineSeries();
     auto* bottomSeries = new QLineSeries();
 
-    for (int j = 0; j < dataSeries.values.size(); ++j) {
-        topSeries->append(j, dataSeries.values[j]);
-        bottomSeries->append(j, 0);
+    const QList<QPointF> points = seriesPoints(dataSeries, style, DecimationMethod::MinMax);
+    topSeries->replace(points);
+    if (!points.isEmpty()) {
+        bottomSeries->append(points.first().x(), 0.0);
+        bottomSeries->append(points.last().x(), 0.0);
     }
 
     QPen pen(dataSeries.color);
@@ -270,9 +285,7 @@ QChart* ChartHelper::createScatterChart(const ChartData& data, const ChartStyle&
         series->setColor(dataSeries.color);
         series->setMarkerSize(dataSeries.markerSize);
 
-        for (int j = 0; j < dataSeries.values.size(); ++j) {
-            series->append(j, dataSeries.values[j]);
-        }
+        series->replace(seriesPoints(dataSeries, style, DecimationMethod::Lttb));
 
         chart->addSeries(series);
     }
@@ -296,8 +309,10 @@ QChart* ChartHelper::createScatterChart(const ChartData& data, const ChartStyle&
     return chart;
 }
 
-QChart* ChartHelper::createPieChart(const ChartData& data, const ChartStyle& style)
+QChart* ChartHelper::createPieChart(const ChartData& source, const ChartStyle& style)
 {
+    const ChartData data = limitCategories(source, style);
+
     auto* chart = new QChart();
     chart->setTitle(data.title);
     chart->setAnimationOptions(QChart::SeriesAnimations);
@@ -332,6 +347,18 @@ QChart* ChartHelper::createDonutChart(const ChartData& data, const ChartStyle& s
     return chart;
 }
 
+ChartData ChartHelper::limitCategories(const ChartData& data, const ChartStyle& style)
+{
+    return CategoryAggregator::aggregate(data, style.maxCategories, style.categoryOffset);
+}
+
+QList<QPointF> ChartHelper::seriesPoints(const DataSeries& series, const ChartStyle& style,
+                                         DecimationMethod preferred)
+{
+    DecimationMethod method = style.decimation == DecimationMethod::Auto ? preferred : style.decimation;
+    return Decimation::decimate(series.values, style.plotWidth, method);
+}
+
 void ChartHelper::setupAxes(QChart* chart, const ChartData& data, const ChartStyle& style)
 {
     auto* categoryAxis = new QBarCategoryAxis();
@@ -363,6 +390,17 @@ void ChartHelper::applyStyle(QChart* chart, const ChartStyle& style)
     if (!style.animationEnabled) {
         chart->setAnimationOptions(QChart::NoAnimation);
     }
+
+    for (auto* series : chart->series()) {
+        auto* xySeries = qobject_cast<QXYSeries*>(series);
+        if (auto* areaSeries = qobject_cast<QAreaSeries*>(series)) {
+            xySeries = areaSeries->upperSeries();
+        }
+        if (xySeries && xySeries->count() > MAX_ANIMATED_POINTS) {
+            chart->setAnimationOptions(QChart::NoAnimation);
+            break;
+        }
+    }
 }
 
 QChart* ChartHelper::createBoxPlotChart(const ChartData& data, const ChartStyle& style)
@@ -416,8 +454,10 @@ QChart* ChartHelper::createBoxPlotChart(const ChartData& data, const ChartStyle&
     return chart;
 }
 
-QChart* ChartHelper::createHorizontalBarChart(const ChartData& data, const ChartStyle& style)
+QChart* ChartHelper::createHorizontalBarChart(const ChartData& source, const ChartStyle& style)
 {
+    const ChartData data = limitCategories(source, style);
+
     auto* chart = new QChart();
     chart->setTitle(data.title);
     chart->setAnimationOptions(QChart::SeriesAnimations);
@@ -464,6 +504,132 @@ QChart* ChartHelper::createHorizontalBarChart(const ChartData& data, const Chart
     return chart;
 }
 
+QChart* ChartHelper::createHistogramChart(const ChartData& data, const ChartStyle& style)
+{
+    if (data.series.isEmpty()) {
+        auto* chart = new QChart();
+        chart->setTitle(data.title);
+        applyStyle(chart, style);
+        return chart;
+    }
+
+    const auto& dataSeries = data.series[0];
+
+    Statistics::HistogramOptions options;
+    options.method = Statistics::BinningMethod::FreedmanDiaconis;
+    options.computeDensity = true;
+
+    auto histogram = Statistics::Histogram::compute(dataSeries.values, options);
+    if (!histogram.isValid) {
+        qWarning() << "直方图计算失败:" << histogram.errorMessage;
+    }
+
+    QString valueTitle = data.yAxisTitle.isEmpty() ? dataSeries.name : data.yAxisTitle;
+    return createHistogramChart(histogram, data.title, valueTitle, style);
+}
+
+QChart* ChartHelper::createHistogramChart(const Statistics::HistogramResult& histogram,
+                                          const QString& title,
+                                          const QString& valueTitle,
+                                          const ChartStyle& style)
+{
+    auto* chart = new QChart();
+    chart->setTitle(title);
+
+    // 点数只与箱数有关，不随数据量增长；关闭动画以保证大数据量时的响应
+    chart->setAnimationOptions(QChart::NoAnimation);
+
+    if (!histogram.isValid || histogram.binCount() == 0) {
+        applyStyle(chart, style);
+        return chart;
+    }
+
+    // 等宽分箱直接显示频数；不等宽分箱显示频率密度，使面积与频数成正比
+    bool showCounts = histogram.uniformWidth;
+    auto barHeight = [&](int bin) {
+        return showCounts ? static_cast<double>(histogram.counts[bin]) : histogram.density[bin];
+    };
+
+    // 用阶梯折线围成的面积表示各箱，比逐箱 QBarSet 渲染快得多
+    auto* topSeries = new QLineSeries();
+    auto* bottomSeries = new QLineSeries();
+
+    QList<QPointF> topPoints;
+    topPoints.reserve(histogram.binCount() * 2);
+    double maxHeight = 0.0;
+    for (int i = 0; i < histogram.binCount(); ++i) {
+        double height = barHeight(i);
+        topPoints.append(QPointF(histogram.edges[i], height));
+        topPoints.append(QPointF(histogram.edges[i + 1], height));
+        maxHeight = std::max(maxHeight, height);
+    }
+    topSeries->replace(topPoints);
+    bottomSeries->append(histogram.edges.first(), 0.0);
+    bottomSeries->append(histogram.edges.last(), 0.0);
+
+    QColor barColor = getDefaultColor(0);
+    auto* areaSeries = new QAreaSeries(topSeries, bottomSeries);
+    areaSeries->setName(QString("%1 (%2 箱)").arg(valueTitle).arg(histogram.binCount()));
+    QColor fillColor = barColor;
+    fillColor.setAlpha(160);
+    areaSeries->setBrush(fillColor);
+    areaSeries->setPen(QPen(barColor.darker(130), 1));
+    chart->addSeries(areaSeries);
+
+    // 核密度曲线按相同纵轴单位缩放后叠加
+    QLineSeries* densitySeries = nullptr;
+    if (!histogram.densityX.isEmpty()) {
+        double scale = 1.0;
+        if (showCounts) {
+            double binWidth = histogram.edges[1] - histogram.edges[0];
+            scale = histogram.total * binWidth;
+        }
+
+        QList<QPointF> densityPoints;
+        densityPoints.reserve(histogram.densityX.size());
+        for (int i = 0; i < histogram.densityX.size(); ++i) {
+            double y = histogram.densityY[i] * scale;
+            densityPoints.append(QPointF(histogram.densityX[i], y));
+            maxHeight = std::max(maxHeight, y);
+        }
+
+        densitySeries = new QLineSeries();
+        densitySeries->setName(QString("核密度 (带宽 %1)").arg(histogram.bandwidth, 0, 'g', 4));
+        QPen pen(getDefaultColor(5));
+        pen.setWidth(2);
+        densitySeries->setPen(pen);
+        densitySeries->replace(densityPoints);
+        chart->addSeries(densitySeries);
+    }
+
+    auto* axisX = new QValueAxis();
+    axisX->setTitleText(valueTitle);
+    axisX->setGridLineVisible(style.showXAxisGrid);
+    double minX = histogram.edges.first();
+    double maxX = histogram.edges.last();
+    if (!histogram.densityX.isEmpty()) {
+        minX = std::min(minX, histogram.densityX.first());
+        maxX = std::max(maxX, histogram.densityX.last());
+    }
+    axisX->setRange(minX, maxX);
+    chart->addAxis(axisX, Qt::AlignBottom);
+
+    auto* axisY = new QValueAxis();
+    axisY->setTitleText(showCounts ? "频数" : "频率密度");
+    axisY->setGridLineVisible(style.showYAxisGrid);
+    axisY->setRange(0.0, maxHeight > 0.0 ? maxHeight * 1.05 : 1.0);
+    chart->addAxis(axisY, Qt::AlignLeft);
+
+    for (auto* series : chart->series()) {
+        series->attachAxis(axisX);
+        series->attachAxis(axisY);
+    }
+
+    applyStyle(chart, style);
+
+    return chart;
+}
+
 ChartData ChartHelper::createChartDataFromColumn(Core::TableData* tableData, int column)
 {
     ChartData chartData;
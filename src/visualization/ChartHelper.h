@@ -3,6 +3,7 @@
 
 #include "ChartTypes.h"
 #include "../core/TableData.h"
+#include "../statistics/Histogram.h"
 #include <QtCharts/QChart>
 #include <QtCharts/QBarSeries>
 #include <QtCharts/QLineSeries>
@@ -51,6 +52,15 @@ public:
     // 创建箱型图
     static QChart* createBoxPlotChart(const ChartData& data, const ChartStyle& style = ChartStyle());
 
+    // 创建直方图（Freedman-Diaconis 分箱并叠加核密度曲线）
+    static QChart* createHistogramChart(const ChartData& data, const ChartStyle& style = ChartStyle());
+
+    // 由已计算的直方图结果创建直方图
+    static QChart* createHistogramChart(const Statistics::HistogramResult& histogram,
+                                        const QString& title,
+                                        const QString& valueTitle,
+                                        const ChartStyle& style = ChartStyle());
+
     // 创建水平柱状图
     static QChart* createHorizontalBarChart(const ChartData& data, const ChartStyle& style = ChartStyle());
 
@@ -61,6 +71,13 @@ public:
     static ChartData createChartDataFromColumn(Core::TableData* tableData, int column);
 
 private:
+    // 系列的绘制点（按 style.plotWidth 抽稀；Auto 时使用 preferred 方法）
+    static QList<QPointF> seriesPoints(const DataSeries& series, const ChartStyle& style,
+                                       DecimationMethod preferred);
+
+    // 分类图表的类别数超过 style.maxCategories 时按类别汇总
+    static ChartData limitCategories(const ChartData& data, const ChartStyle& style);
+
     // 设置坐标轴
     static void setupAxes(QChart* chart, const ChartData& data, const ChartStyle& style);
 
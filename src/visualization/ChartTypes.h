@@ -25,9 +25,21 @@ enum class ChartType
     PieChart,                // 饼图
     DonutChart,              // 环形图
     BoxPlotChart,            // 箱型图
+    HistogramChart,          // 直方图
     None
 };
 
+/**
+ * @brief 大数据量折线/散点图的抽稀方法
+ */
+enum class DecimationMethod
+{
+    Auto,       // 按图表类型选择：折线/面积图用 MinMax，平滑曲线/散点图用 LTTB
+    None,       // 不抽稀，逐点绘制
+    MinMax,     // 每个像素桶保留最小值与最大值
+    Lttb        // Largest-Triangle-Three-Buckets
+};
+
 /**
  * @brief 数据系列
  */
@@ -84,6 +96,14 @@ struct ChartStyle
     int animationDuration = 500;
 
     bool tooltipsEnabled = true;
+
+    // 折线/平滑曲线/面积/散点图按绘图区宽度抽稀（见 Decimation）
+    int plotWidth = 0;                                      // 绘图区宽度（像素），0 表示不抽稀
+    DecimationMethod decimation = DecimationMethod::Auto;
+
+    // 柱状图/饼图按类别汇总（见 CategoryAggregator）
+    int maxCategories = 20;                                 // 最多显示的类别数，其余并入"其他"；0 表示不合并
+    int categoryOffset = 0;                                 // 跳过排名最前的类别数（逐层查看"其他"）
 };
 
 } // namespace Charts
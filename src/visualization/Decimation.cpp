@@ -0,0 +1,233 @@
+#include "Decimation.h"
+#include "../statistics/ParallelUtils.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Charts {
+
+namespace {
+
+namespace Parallel = Statistics::Parallel;
+
+// 每块最少扫描的数据点数
+const qsizetype MIN_POINTS_PER_CHUNK = 65536;
+
+/**
+ * @brief 块数：按每块至少扫描 MIN_POINTS_PER_CHUNK 个数据点折算成桶数
+ */
+int bucketChunks(int buckets, qsizetype points)
+{
+    const qsizetype bucketSize = std::max<qsizetype>(1, points / std::max(1, buckets));
+    return Parallel::chunkCount(buckets, std::max<qsizetype>(1, MIN_POINTS_PER_CHUNK / bucketSize));
+}
+
+/**
+ * @brief 有效点的个数（并行计数）
+ */
+qsizetype validCount(const double* y, qsizetype begin, qsizetype end)
+{
+    const qsizetype n = end - begin;
+    const int chunks = Parallel::chunkCount(n, MIN_POINTS_PER_CHUNK);
+    QVector<qsizetype> counts(chunks, 0);
+    Parallel::forChunks(n, chunks, [&](int chunk, qsizetype first, qsizetype last) {
+        qsizetype count = 0;
+        for (qsizetype i = begin + first; i < begin + last; ++i) {
+            count += !std::isnan(y[i]);
+        }
+        counts[chunk] = count;
+    });
+
+    qsizetype total = 0;
+    for (qsizetype count : counts) {
+        total += count;
+    }
+    return total;
+}
+
+/**
+ * @brief LTTB 选点
+ * @param n 点数
+ * @param xAt、yAt 第 i 个点的坐标
+ * @return 选中点的序号（升序）
+ */
+template<typename XAt, typename YAt>
+QVector<qsizetype> lttbSelect(qsizetype n, int threshold, XAt xAt, YAt yAt)
+{
+    const int buckets = threshold - 2;
+    const double every = static_cast<double>(n - 2) / buckets;
+    auto bucketBegin = [every](int bucket) { return static_cast<qsizetype>(std::floor(bucket * every)) + 1; };
+
+    // 各桶的均值（作为前一个桶选点时的第三个顶点）
+    QVector<double> averageX(buckets);
+    QVector<double> averageY(buckets);
+    Parallel::forChunks(buckets, bucketChunks(buckets, n), [&](int, qsizetype first, qsizetype last) {
+        for (qsizetype bucket = first; bucket < last; ++bucket) {
+            const qsizetype begin = bucketBegin(static_cast<int>(bucket));
+            const qsizetype end = bucketBegin(static_cast<int>(bucket) + 1);
+            double sumX = 0.0;
+            double sumY = 0.0;
+            for (qsizetype i = begin; i < end; ++i) {
+                sumX += xAt(i);
+                sumY += yAt(i);
+            }
+            averageX[bucket] = sumX / (end - begin);
+            averageY[bucket] = sumY / (end - begin);
+        }
+    });
+
+    QVector<qsizetype> selected;
+    selected.reserve(threshold);
+    selected.append(0);
+
+    qsizetype a = 0;
+    for (int bucket = 0; bucket < buckets; ++bucket) {
+        const double cx = bucket + 1 < buckets ? averageX[bucket + 1] : xAt(n - 1);
+        const double cy = bucket + 1 < buckets ? averageY[bucket + 1] : yAt(n - 1);
+        const double ax = xAt(a);
+        const double ay = yAt(a);
+
+        // 三角形面积的两倍 |(ax - cx)(py - ay) - (ax - px)(cy - ay)|
+        double maxArea = -1.0;
+        qsizetype chosen = bucketBegin(bucket);
+        const qsizetype end = bucketBegin(bucket + 1);
+        for (qsizetype i = bucketBegin(bucket); i < end; ++i) {
+            const double area = std::fabs((ax - cx) * (yAt(i) - ay) - (ax - xAt(i)) * (cy - ay));
+            if (area > maxArea) {
+                maxArea = area;
+                chosen = i;
+            }
+        }
+        selected.append(chosen);
+        a = chosen;
+    }
+
+    selected.append(n - 1);
+    return selected;
+}
+
+} // namespace
+
+QList<QPointF> Decimation::allPoints(const QVector<double>& values, qsizetype begin, qsizetype end)
+{
+    begin = std::max<qsizetype>(0, begin);
+    end = std::min(end, values.size());
+
+    QList<QPointF> points;
+    points.reserve(std::max<qsizetype>(0, end - begin));
+    for (qsizetype i = begin; i < end; ++i) {
+        if (!std::isnan(values[i])) {
+            points.append(QPointF(static_cast<double>(i), values[i]));
+        }
+    }
+    return points;
+}
+
+QList<QPointF> Decimation::minMax(const QVector<double>& values, qsizetype begin, qsizetype end, int buckets)
+{
+    begin = std::max<qsizetype>(0, begin);
+    end = std::min(end, values.size());
+    const qsizetype n = end - begin;
+    if (buckets <= 0 || n <= 2 * static_cast<qsizetype>(buckets)) {
+        return allPoints(values, begin, end);
+    }
+
+    // 每桶至多两个点：先写入各桶自己的槽位，再按桶顺序压实
+    const double* y = values.constData();
+    QVector<qsizetype> slots(2 * buckets, -1);
+    Parallel::forChunks(buckets, bucketChunks(buckets, n), [&](int, qsizetype first, qsizetype last) {
+        for (qsizetype bucket = first; bucket < last; ++bucket) {
+            const qsizetype from = begin + bucket * n / buckets;
+            const qsizetype to = begin + (bucket + 1) * n / buckets;
+            double minValue = std::numeric_limits<double>::infinity();
+            double maxValue = -std::numeric_limits<double>::infinity();
+            qsizetype minIndex = -1;
+            qsizetype maxIndex = -1;
+            for (qsizetype i = from; i < to; ++i) {
+                // NaN 的比较均为假，自然被跳过
+                if (y[i] < minValue) {
+                    minValue = y[i];
+                    minIndex = i;
+                }
+                if (y[i] > maxValue) {
+                    maxValue = y[i];
+                    maxIndex = i;
+                }
+            }
+            if (minIndex < 0 && maxIndex < 0) {
+                continue;
+            }
+            if (minIndex < 0 || maxIndex < 0 || minIndex == maxIndex) {
+                slots[2 * bucket] = std::max(minIndex, maxIndex);
+            } else {
+                slots[2 * bucket] = std::min(minIndex, maxIndex);
+                slots[2 * bucket + 1] = std::max(minIndex, maxIndex);
+            }
+        }
+    });
+
+    QList<QPointF> points;
+    points.reserve(slots.size());
+    for (qsizetype index : slots) {
+        if (index >= 0) {
+            points.append(QPointF(static_cast<double>(index), y[index]));
+        }
+    }
+    return points;
+}
+
+QList<QPointF> Decimation::lttb(const QVector<double>& values, qsizetype begin, qsizetype end, int threshold)
+{
+    begin = std::max<qsizetype>(0, begin);
+    end = std::min(end, values.size());
+    const double* y = values.constData();
+
+    const qsizetype valid = end > begin ? validCount(y, begin, end) : 0;
+    if (threshold < 3 || valid <= threshold) {
+        return allPoints(values, begin, end);
+    }
+
+    QList<QPointF> points;
+    points.reserve(threshold);
+    if (valid == end - begin) {
+        // 没有缺失值：直接以下标为横坐标
+        const QVector<qsizetype> selected = lttbSelect(
+            valid, threshold, [begin](qsizetype i) { return static_cast<double>(begin + i); },
+            [y, begin](qsizetype i) { return y[begin + i]; });
+        for (qsizetype i : selected) {
+            points.append(QPointF(static_cast<double>(begin + i), y[begin + i]));
+        }
+        return points;
+    }
+
+    // 有缺失值：先收集有效点的下标
+    QVector<qsizetype> indexes;
+    indexes.reserve(valid);
+    for (qsizetype i = begin; i < end; ++i) {
+        if (!std::isnan(y[i])) {
+            indexes.append(i);
+        }
+    }
+    const qsizetype* index = indexes.constData();
+    const QVector<qsizetype> selected = lttbSelect(
+        valid, threshold, [index](qsizetype i) { return static_cast<double>(index[i]); },
+        [y, index](qsizetype i) { return y[index[i]]; });
+    for (qsizetype i : selected) {
+        points.append(QPointF(static_cast<double>(index[i]), y[index[i]]));
+    }
+    return points;
+}
+
+QList<QPointF> Decimation::decimate(const QVector<double>& values, int pixelWidth, DecimationMethod method)
+{
+    if (pixelWidth <= 0 || method == DecimationMethod::None) {
+        return allPoints(values, 0, values.size());
+    }
+
+    if (method == DecimationMethod::Lttb) {
+        return lttb(values, 0, values.size(), static_cast<int>(targetPoints(pixelWidth)));
+    }
+    return minMax(values, 0, values.size(), pixelWidth);
+}
+
+} // namespace Charts
@@ -0,0 +1,58 @@
+#ifndef DECIMATION_H
+#define DECIMATION_H
+
+#include "ChartTypes.h"
+#include <QList>
+#include <QPointF>
+#include <QVector>
+
+namespace Charts {
+
+/**
+ * @brief 折线/散点数据的抽稀
+ *
+ * 横坐标为数据下标，NaN 视为缺失值（不输出）。百万行的列逐点交给
+ * QtCharts 会卡住数分钟，而屏幕上每个像素列最多只能分辨出几个点，
+ * 因此按绘图区宽度把点数降到约 2 倍像素数：
+ * - MinMax：每个像素桶输出最小值与最大值两个点（按下标顺序），折线的
+ *   包络与尖峰完全保留；各桶独立，按桶并行扫描原始数据
+ * - LTTB（Largest-Triangle-Three-Buckets）：每个桶选出与前一个选中点、
+ *   后一个桶均值所成三角形面积最大的点，曲线形状更平滑；各桶均值并行
+ *   计算，选点是一遍顺序扫描
+ */
+class Decimation
+{
+public:
+    /**
+     * @brief [begin, end) 内的全部有效点
+     */
+    static QList<QPointF> allPoints(const QVector<double>& values, qsizetype begin, qsizetype end);
+
+    /**
+     * @brief 把 [begin, end) 等分为 buckets 个桶，每桶输出最小值与最大值
+     * @return 点数不超过 2 × buckets；数据本身不多于此时返回全部有效点
+     */
+    static QList<QPointF> minMax(const QVector<double>& values, qsizetype begin, qsizetype end, int buckets);
+
+    /**
+     * @brief LTTB 抽稀到 threshold 个点（首尾两点总是保留）
+     * @return 有效点不多于 threshold 时返回全部有效点
+     */
+    static QList<QPointF> lttb(const QVector<double>& values, qsizetype begin, qsizetype end, int threshold);
+
+    /**
+     * @brief 按绘图区宽度抽稀整列
+     * @param pixelWidth 绘图区宽度（像素），不大于 0 时不抽稀
+     * @param method Auto 按 MinMax 处理
+     */
+    static QList<QPointF> decimate(const QVector<double>& values, int pixelWidth, DecimationMethod method);
+
+    /**
+     * @brief 宽度为 pixelWidth 时抽稀后的最多点数
+     */
+    static qsizetype targetPoints(int pixelWidth) { return 2 * static_cast<qsizetype>(pixelWidth); }
+};
+
+} // namespace Charts
+
+#endif // DECIMATION_H
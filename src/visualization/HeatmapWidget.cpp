@@ -0,0 +1,230 @@
+#include "HeatmapWidget.h"
+#include <QPainter>
+#include <QMouseEvent>
+#include <QToolTip>
+#include <QFontMetrics>
+#include <QtMath>
+#include <algorithm>
+
+namespace Charts {
+
+namespace {
+
+// 色阶宽度与间距
+const int LEGEND_WIDTH = 16;
+const int LEGEND_SPACING = 40;
+
+// 单元格足够大时才绘制标签与数值
+const int MIN_LABEL_CELL = 10;
+const int MIN_VALUE_CELL = 36;
+
+QColor blend(const QColor &from, const QColor &to, double t)
+{
+    return QColor::fromRgbF(from.redF() + (to.redF() - from.redF()) * t,
+                            from.greenF() + (to.greenF() - from.greenF()) * t,
+                            from.blueF() + (to.blueF() - from.blueF()) * t);
+}
+
+} // namespace
+
+HeatmapWidget::HeatmapWidget(QWidget *parent)
+    : QWidget(parent)
+{
+    setMouseTracking(true);
+    setMinimumSize(300, 300);
+}
+
+void HeatmapWidget::setMatrix(const QVector<QVector<double>> &matrix,
+                              const QStringList &labels,
+                              double limit)
+{
+    m_matrix = matrix;
+    m_labels = labels;
+
+    if (limit <= 0.0) {
+        limit = 0.0;
+        for (const auto &row : matrix) {
+            for (double value : row) {
+                if (qIsFinite(value)) {
+                    limit = std::max(limit, std::abs(value));
+                }
+            }
+        }
+    }
+    m_limit = limit > 0.0 ? limit : 1.0;
+
+    // 每格一个像素，绘制时按单元格大小缩放
+    int n = m_matrix.size();
+    m_image = QImage(std::max(1, n), std::max(1, n), QImage::Format_RGB32);
+    m_image.fill(palette().color(QPalette::Window));
+    for (int i = 0; i < n; ++i) {
+        auto *line = reinterpret_cast<QRgb *>(m_image.scanLine(i));
+        for (int j = 0; j < n && j < m_matrix[i].size(); ++j) {
+            line[j] = colorFor(m_matrix[i][j], m_limit).rgb();
+        }
+    }
+
+    update();
+}
+
+void HeatmapWidget::clear()
+{
+    m_matrix.clear();
+    m_labels.clear();
+    m_image = QImage();
+    update();
+}
+
+QSize HeatmapWidget::sizeHint() const
+{
+    return QSize(640, 560);
+}
+
+QColor HeatmapWidget::colorFor(double value, double limit)
+{
+    if (!qIsFinite(value)) {
+        return QColor(200, 200, 200);
+    }
+
+    static const QColor negative(33, 102, 172);
+    static const QColor neutral(247, 247, 247);
+    static const QColor positive(178, 24, 43);
+
+    double t = std::clamp(value / limit, -1.0, 1.0);
+    return t < 0.0 ? blend(neutral, negative, -t) : blend(neutral, positive, t);
+}
+
+int HeatmapWidget::labelMargin() const
+{
+    int n = m_matrix.size();
+    if (n == 0) {
+        return 0;
+    }
+
+    // 标签放不下时不预留边距
+    int side = std::min(width(), height());
+    if (side / n < MIN_LABEL_CELL) {
+        return 4;
+    }
+
+    QFontMetrics metrics(font());
+    int widest = 0;
+    for (const QString &label : m_labels) {
+        widest = std::max(widest, metrics.horizontalAdvance(label));
+    }
+    return std::min(widest + 8, side / 4);
+}
+
+QRect HeatmapWidget::matrixRect() const
+{
+    int n = m_matrix.size();
+    if (n == 0) {
+        return QRect();
+    }
+
+    int margin = labelMargin();
+    int available = std::min(width() - margin - LEGEND_WIDTH - LEGEND_SPACING - 8,
+                             height() - margin - 8);
+    int cell = std::max(1, available / n);
+    return QRect(margin, margin, cell * n, cell * n);
+}
+
+void HeatmapWidget::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+
+    QPainter painter(this);
+    painter.fillRect(rect(), palette().color(QPalette::Base));
+
+    int n = m_matrix.size();
+    if (n == 0 || m_image.isNull()) {
+        painter.drawText(rect(), Qt::AlignCenter, "暂无数据");
+        return;
+    }
+
+    QRect area = matrixRect();
+    int cell = area.width() / n;
+
+    // 最近邻缩放，保持单元格边界清晰
+    painter.setRenderHint(QPainter::SmoothPixmapTransform, false);
+    painter.drawImage(area, m_image);
+
+    QFontMetrics metrics(font());
+
+    if (cell >= MIN_LABEL_CELL) {
+        int margin = area.left();
+        for (int i = 0; i < n && i < m_labels.size(); ++i) {
+            QString text = metrics.elidedText(m_labels[i], Qt::ElideRight, margin - 6);
+
+            // 行标签
+            painter.drawText(QRect(0, area.top() + i * cell, margin - 4, cell),
+                             Qt::AlignRight | Qt::AlignVCenter, text);
+
+            // 列标签（竖排）
+            painter.save();
+            painter.translate(area.left() + i * cell, margin - 4);
+            painter.rotate(-90);
+            painter.drawText(QRect(0, 0, margin - 6, cell), Qt::AlignLeft | Qt::AlignVCenter, text);
+            painter.restore();
+        }
+    }
+
+    if (cell >= MIN_VALUE_CELL) {
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n && j < m_matrix[i].size(); ++j) {
+                double value = m_matrix[i][j];
+                if (!qIsFinite(value)) {
+                    continue;
+                }
+                QColor background = colorFor(value, m_limit);
+                painter.setPen(background.lightness() < 128 ? Qt::white : Qt::black);
+                painter.drawText(QRect(area.left() + j * cell, area.top() + i * cell, cell, cell),
+                                 Qt::AlignCenter, QString::number(value, 'f', 2));
+            }
+        }
+        painter.setPen(palette().color(QPalette::Text));
+    }
+
+    // 色阶图例
+    QRect legend(area.right() + LEGEND_SPACING / 2, area.top(), LEGEND_WIDTH, area.height());
+    for (int y = 0; y < legend.height(); ++y) {
+        double value = m_limit * (1.0 - 2.0 * y / std::max(1, legend.height() - 1));
+        painter.setPen(colorFor(value, m_limit));
+        painter.drawLine(legend.left(), legend.top() + y, legend.right(), legend.top() + y);
+    }
+    painter.setPen(palette().color(QPalette::Text));
+    painter.drawRect(legend);
+    painter.drawText(legend.right() + 4, legend.top() + metrics.ascent(),
+                     QString::number(m_limit, 'g', 3));
+    painter.drawText(legend.right() + 4, legend.center().y() + metrics.ascent() / 2, "0");
+    painter.drawText(legend.right() + 4, legend.bottom(),
+                     QString::number(-m_limit, 'g', 3));
+}
+
+void HeatmapWidget::mouseMoveEvent(QMouseEvent *event)
+{
+    int n = m_matrix.size();
+    QRect area = matrixRect();
+    QPoint pos = event->position().toPoint();
+
+    if (n == 0 || !area.contains(pos)) {
+        QToolTip::hideText();
+        return;
+    }
+
+    int cell = area.width() / n;
+    int row = std::min(n - 1, (pos.y() - area.top()) / cell);
+    int column = std::min(n - 1, (pos.x() - area.left()) / cell);
+
+    QString rowName = row < m_labels.size() ? m_labels[row] : QString::number(row + 1);
+    QString columnName = column < m_labels.size() ? m_labels[column] : QString::number(column + 1);
+    double value = column < m_matrix[row].size() ? m_matrix[row][column] : qQNaN();
+
+    QToolTip::showText(event->globalPosition().toPoint(),
+                       QString("%1 × %2\n%3")
+                           .arg(rowName, columnName,
+                                qIsFinite(value) ? QString::number(value, 'g', 6) : QString("无有效数据")),
+                       this);
+}
+
+} // namespace Charts
@@ -0,0 +1,57 @@
+#ifndef HEATMAPWIDGET_H
+#define HEATMAPWIDGET_H
+
+#include <QWidget>
+#include <QImage>
+#include <QStringList>
+#include <QVector>
+
+namespace Charts {
+
+/**
+ * @brief 矩阵热力图控件
+ *
+ * 以发散色阶（蓝-白-红）显示方阵，适用于相关/协方差矩阵。
+ * 矩阵先渲染为每格一个像素的图像，绘制时整体缩放，
+ * 因此数百列的矩阵也能流畅重绘。鼠标悬停显示行列名和数值。
+ */
+class HeatmapWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit HeatmapWidget(QWidget *parent = nullptr);
+
+    /**
+     * @brief 设置矩阵数据
+     * @param matrix 方阵（NaN 显示为灰色）
+     * @param labels 行列标签
+     * @param limit 色阶的对称范围 [-limit, limit]（≤ 0 时取矩阵绝对值最大值）
+     */
+    void setMatrix(const QVector<QVector<double>> &matrix,
+                   const QStringList &labels,
+                   double limit = 1.0);
+
+    void clear();
+
+    QSize sizeHint() const override;
+
+    static QColor colorFor(double value, double limit);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+
+private:
+    QRect matrixRect() const;
+    int labelMargin() const;
+
+    QVector<QVector<double>> m_matrix;
+    QStringList m_labels;
+    double m_limit = 1.0;
+    QImage m_image;
+};
+
+} // namespace Charts
+
+#endif // HEATMAPWIDGET_H
@@ -0,0 +1,331 @@
+#include "LodPyramid.h"
+#include "Decimation.h"
+#include "../core/ResultCache.h"
+#include "../statistics/ParallelUtils.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace Charts {
+
+namespace {
+
+namespace Parallel = Statistics::Parallel;
+
+// 最细一层的块大小为 2^BASE_SHIFT
+const int BASE_SHIFT = 5;
+
+// 并行构建时每块最少处理的条目数
+const qsizetype MIN_ENTRIES_PER_CHUNK = 16384;
+
+/**
+ * @brief 合并若干相邻块时的累加器
+ */
+struct Summary
+{
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    double sum = 0.0;
+    qint64 count = 0;
+    qsizetype minAt = -1;       // 最小值所在的块
+    qsizetype maxAt = -1;       // 最大值所在的块
+    bool minFirst = true;
+
+    void add(qsizetype at, double blockMin, double blockMax, double blockSum, qint64 blockCount, bool blockMinFirst)
+    {
+        if (blockCount == 0) {
+            return;
+        }
+        if (blockMin < min) {
+            min = blockMin;
+            minAt = at;
+        }
+        if (blockMax > max) {
+            max = blockMax;
+            maxAt = at;
+        }
+        sum += blockSum;
+        count += blockCount;
+        // 最值落在不同块时按块的先后，否则沿用块内的顺序
+        minFirst = minAt != maxAt ? minAt < maxAt : (at == minAt ? blockMinFirst : minFirst);
+    }
+};
+
+/**
+ * @brief 输出一个桶 [x0, x1) 的绘制点
+ */
+void appendBucket(QList<QPointF>& points, const Summary& summary, double x0, double x1, LodPyramid::Mode mode)
+{
+    if (summary.count == 0) {
+        return;
+    }
+
+    const double width = x1 - x0;
+    if (mode == LodPyramid::Mode::Mean) {
+        points.append(QPointF(x0 + width / 2.0, summary.sum / summary.count));
+        return;
+    }
+
+    if (summary.min == summary.max) {
+        points.append(QPointF(x0 + width / 2.0, summary.min));
+        return;
+    }
+
+    // 两个点放在桶内四分之一与四分之三处，保持块内的先后顺序
+    const double first = summary.minFirst ? summary.min : summary.max;
+    const double second = summary.minFirst ? summary.max : summary.min;
+    points.append(QPointF(x0 + width / 4.0, first));
+    points.append(QPointF(x0 + width * 3.0 / 4.0, second));
+}
+
+} // namespace
+
+LodPyramid::LodPyramid(const QVector<double>& values)
+    : m_size(values.size())
+{
+    if (m_size > 0) {
+        refresh(values, 0, m_size);
+    }
+}
+
+LodPyramid LodPyramid::updated(const QVector<double>& values, qsizetype firstRow, qsizetype lastRow) const
+{
+    // 删除了行或原本为空时整体重建
+    if (values.size() < m_size || m_levels.isEmpty()) {
+        return LodPyramid(values);
+    }
+
+    LodPyramid result(*this);
+    result.m_size = values.size();
+    firstRow = std::clamp<qsizetype>(firstRow, 0, values.size());
+    lastRow = std::clamp<qsizetype>(lastRow, firstRow, values.size());
+    if (values.size() > m_size) {
+        // 追加的行同样需要汇总
+        firstRow = std::min(firstRow, m_size);
+        lastRow = values.size();
+    }
+    if (firstRow < lastRow) {
+        result.refresh(values, firstRow, lastRow);
+    }
+    return result;
+}
+
+void LodPyramid::Level::resize(qsizetype blocks)
+{
+    min.resize(blocks);
+    max.resize(blocks);
+    sum.resize(blocks);
+    count.resize(blocks);
+    minFirst.resize(blocks);
+}
+
+void LodPyramid::refresh(const QVector<double>& values, qsizetype firstRow, qsizetype lastRow)
+{
+    const qsizetype n = m_size;
+    const qsizetype blockSize = qsizetype(1) << BASE_SHIFT;
+
+    // === 最细一层：扫描原始数据 ===
+    if (m_levels.isEmpty()) {
+        Level base;
+        base.shift = BASE_SHIFT;
+        m_levels.append(std::move(base));
+    }
+    qsizetype blocks = (n + blockSize - 1) / blockSize;
+    qsizetype first = firstRow >> BASE_SHIFT;
+    qsizetype last = std::min(blocks, ((lastRow - 1) >> BASE_SHIFT) + 1);
+    if (m_levels[0].blocks() != blocks) {
+        m_levels[0].resize(blocks);
+    }
+    summariseBlocks(values, m_levels[0], first, last);
+
+    // === 逐层两两合并（只合并受影响块的上层块，新增的层整层合并）===
+    for (int k = 1; blocks > 1; ++k) {
+        blocks = (blocks + 1) / 2;
+        first >>= 1;
+        last = ((last - 1) >> 1) + 1;
+        if (k == m_levels.size()) {
+            Level upper;
+            upper.shift = m_levels[k - 1].shift + 1;
+            m_levels.append(std::move(upper));
+            first = 0;
+            last = blocks;
+        }
+        if (m_levels[k].blocks() != blocks) {
+            m_levels[k].resize(blocks);
+        }
+        mergeBlocks(m_levels[k - 1], m_levels[k], first, std::min(last, blocks));
+    }
+}
+
+void LodPyramid::summariseBlocks(const QVector<double>& values, Level& level, qsizetype firstBlock,
+                                 qsizetype lastBlock) const
+{
+    const qsizetype n = m_size;
+    const qsizetype blockSize = qsizetype(1) << level.shift;
+    const qsizetype blocks = lastBlock - firstBlock;
+    const double* y = values.constData();
+
+    // 与其他金字塔共享的层在这里（调用线程中）复制一次，并行写入不再触发复制
+    double* minOut = level.min.data();
+    double* maxOut = level.max.data();
+    double* sumOut = level.sum.data();
+    qint64* countOut = level.count.data();
+    quint8* minFirstOut = level.minFirst.data();
+    Parallel::forChunks(blocks, Parallel::chunkCount(blocks, MIN_ENTRIES_PER_CHUNK / blockSize + 1),
+                        [&](int, qsizetype first, qsizetype last) {
+        for (qsizetype block = firstBlock + first; block < firstBlock + last; ++block) {
+            const qsizetype from = block * blockSize;
+            const qsizetype to = std::min(n, from + blockSize);
+            double minValue = std::numeric_limits<double>::infinity();
+            double maxValue = -std::numeric_limits<double>::infinity();
+            double sum = 0.0;
+            qint64 count = 0;
+            qsizetype minIndex = from;
+            qsizetype maxIndex = from;
+            for (qsizetype i = from; i < to; ++i) {
+                // NaN 的比较均为假：不更新最值，也不计入和与个数（无分支）
+                const double value = y[i];
+                const bool valid = value == value;
+                const bool lower = value < minValue;
+                const bool higher = value > maxValue;
+                minValue = lower ? value : minValue;
+                minIndex = lower ? i : minIndex;
+                maxValue = higher ? value : maxValue;
+                maxIndex = higher ? i : maxIndex;
+                sum += valid ? value : 0.0;
+                count += valid;
+            }
+            minOut[block] = minValue;
+            maxOut[block] = maxValue;
+            sumOut[block] = sum;
+            countOut[block] = count;
+            minFirstOut[block] = minIndex <= maxIndex;
+        }
+    });
+}
+
+void LodPyramid::mergeBlocks(const Level& lower, Level& upper, qsizetype firstBlock, qsizetype lastBlock)
+{
+    const qsizetype lowerBlocks = lower.blocks();
+    const qsizetype blocks = lastBlock - firstBlock;
+    double* minOut = upper.min.data();
+    double* maxOut = upper.max.data();
+    double* sumOut = upper.sum.data();
+    qint64* countOut = upper.count.data();
+    quint8* minFirstOut = upper.minFirst.data();
+    Parallel::forChunks(blocks, Parallel::chunkCount(blocks, MIN_ENTRIES_PER_CHUNK),
+                        [&](int, qsizetype first, qsizetype last) {
+        for (qsizetype block = firstBlock + first; block < firstBlock + last; ++block) {
+            Summary summary;
+            for (qsizetype i = 2 * block; i < std::min(lowerBlocks, 2 * block + 2); ++i) {
+                summary.add(i, lower.min[i], lower.max[i], lower.sum[i], lower.count[i], lower.minFirst[i]);
+            }
+            minOut[block] = summary.min;
+            maxOut[block] = summary.max;
+            sumOut[block] = summary.sum;
+            countOut[block] = summary.count;
+            minFirstOut[block] = summary.minFirst;
+        }
+    });
+}
+
+qint64 LodPyramid::memoryCost() const
+{
+    qint64 bytes = 0;
+    for (const Level& level : m_levels) {
+        bytes += level.blocks() * static_cast<qint64>(3 * sizeof(double) + sizeof(qint64) + sizeof(quint8));
+    }
+    return bytes;
+}
+
+QList<QPointF> LodPyramid::query(const QVector<double>& values, double xBegin, double xEnd, int pixelWidth,
+                                  Mode mode) const
+{
+    const qsizetype n = m_size;
+    if (n == 0 || values.size() != n || !(xEnd >= xBegin)) {
+        return QList<QPointF>();
+    }
+
+    // 可见范围两侧各多取一个点，平移时折线不会在边缘断开
+    const qsizetype begin = static_cast<qsizetype>(std::clamp(std::floor(xBegin) - 1.0, 0.0, static_cast<double>(n)));
+    const qsizetype end = static_cast<qsizetype>(std::clamp(std::ceil(xEnd) + 2.0, 0.0, static_cast<double>(n)));
+    const qsizetype span = end - begin;
+    const int buckets = std::max(1, pixelWidth);
+    if (span <= 0) {
+        return QList<QPointF>();
+    }
+    if (span <= Decimation::targetPoints(buckets)) {
+        return Decimation::allPoints(values, begin, end);
+    }
+
+    // 块大小不超过一个桶的最粗一层；桶比最细的块还窄时直接扫描原始数据
+    const double bucketWidth = static_cast<double>(span) / buckets;
+    int levelIndex = -1;
+    for (int i = 0; i < m_levels.size(); ++i) {
+        if (static_cast<double>(qsizetype(1) << m_levels[i].shift) <= bucketWidth) {
+            levelIndex = i;
+        }
+    }
+    if (levelIndex < 0) {
+        return queryRaw(values, begin, end, buckets, mode);
+    }
+
+    // 对齐到块边界后，每个桶合并一到两个块
+    const Level& level = m_levels[levelIndex];
+    const qsizetype firstBlock = begin >> level.shift;
+    const qsizetype lastBlock = std::min(level.blocks(), ((end - 1) >> level.shift) + 1);
+    const qsizetype blocks = lastBlock - firstBlock;
+    const qsizetype bucketCount = std::min<qsizetype>(buckets, blocks);
+
+    QList<QPointF> points;
+    points.reserve(mode == Mode::Mean ? bucketCount : 2 * bucketCount);
+    for (qsizetype bucket = 0; bucket < bucketCount; ++bucket) {
+        const qsizetype from = firstBlock + bucket * blocks / bucketCount;
+        const qsizetype to = firstBlock + (bucket + 1) * blocks / bucketCount;
+        Summary summary;
+        for (qsizetype i = from; i < to; ++i) {
+            summary.add(i, level.min[i], level.max[i], level.sum[i], level.count[i], level.minFirst[i]);
+        }
+        const double x0 = static_cast<double>(from << level.shift);
+        const double x1 = static_cast<double>(std::min(n, to << level.shift));
+        appendBucket(points, summary, x0, x1, mode);
+    }
+    return points;
+}
+
+QList<QPointF> LodPyramid::queryRaw(const QVector<double>& values, qsizetype begin, qsizetype end, int buckets,
+                                     Mode mode) const
+{
+    if (mode == Mode::Envelope) {
+        return Decimation::minMax(values, begin, end, buckets);
+    }
+
+    // 每桶不超过 2^BASE_SHIFT 个点，顺序扫描即可
+    const double* y = values.constData();
+    const qsizetype span = end - begin;
+    QList<QPointF> points;
+    points.reserve(buckets);
+    for (qsizetype bucket = 0; bucket < buckets; ++bucket) {
+        const qsizetype from = begin + bucket * span / buckets;
+        const qsizetype to = begin + (bucket + 1) * span / buckets;
+        Summary summary;
+        for (qsizetype i = from; i < to; ++i) {
+            if (!std::isnan(y[i])) {
+                summary.add(i, y[i], y[i], y[i], 1, true);
+            }
+        }
+        appendBucket(points, summary, static_cast<double>(from), static_cast<double>(to), mode);
+    }
+    return points;
+}
+
+QSharedPointer<const LodPyramid> LodPyramid::cached(const QString& key, const QVector<double>& values)
+{
+    return Core::ResultCache::instance().getOrCompute<LodPyramid>(
+        key,
+        [&]() { return LodPyramid(values); },
+        [](const LodPyramid& pyramid) { return pyramid.memoryCost(); });
+}
+
+} // namespace Charts
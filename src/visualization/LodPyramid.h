@@ -0,0 +1,115 @@
+#ifndef LODPYRAMID_H
+#define LODPYRAMID_H
+
+#include <QList>
+#include <QPointF>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+namespace Charts {
+
+/**
+ * @brief 时间序列的多分辨率金字塔（用于可缩放的折线图）
+ *
+ * 第 k 层把序列按 2^k 个点一块汇总为最小值、最大值、和与有效值个数
+ * （并记录块内最小值是否先于最大值出现，以便按原顺序连线）。最细一层
+ * 的块为 32 个点，逐层两两合并直到只剩一块，总内存约为原始数据的 1/4。
+ *
+ * 查询可见的横坐标范围时，选取块大小不超过一个像素桶的最粗一层，每个
+ * 像素桶只合并一两个块，耗时只与绘图宽度有关、与序列长度无关；可见点
+ * 不多于 32 倍像素数时直接扫描原始数据。桶边界对齐到块边界，误差不超过
+ * 一个像素。
+ */
+class LodPyramid
+{
+public:
+    /**
+     * @brief 每个像素桶输出的点
+     */
+    enum class Mode
+    {
+        Envelope,   // 最小值与最大值两个点（保留尖峰）
+        Mean        // 均值一个点（适合平滑曲线）
+    };
+
+    LodPyramid() = default;
+
+    /**
+     * @brief 由原始序列构建（横坐标为下标，NaN 视为缺失值）
+     *
+     * 只保存各层汇总，不保留原始数据：查询时由调用方传入同一序列，
+     * 缓存中的金字塔不持有原始数据的引用，数据的所有者可以原地修改。
+     * 各层按块并行构建。
+     */
+    explicit LodPyramid(const QVector<double>& values);
+
+    qsizetype size() const { return m_size; }
+    int levelCount() const { return m_levels.size(); }
+
+    /**
+     * @brief 数据修改后的金字塔
+     * @param values 修改后的序列（行数不少于原序列）
+     * @param firstRow、lastRow 被修改的行 [firstRow, lastRow)；新增的行总会汇总
+     *
+     * 只重新汇总受影响的块及其各层上层块。每层都有块被改写，各层汇总
+     * 数组在写入时复制一次（约为原始数据的四分之一）。
+     * 原金字塔保持不变；行数减少时整体重建。
+     */
+    LodPyramid updated(const QVector<double>& values, qsizetype firstRow, qsizetype lastRow) const;
+
+    /**
+     * @brief 估算占用的内存（字节，即各层汇总）
+     */
+    qint64 memoryCost() const;
+
+    /**
+     * @brief 查询横坐标 [xBegin, xEnd] 内的绘制点
+     * @param values 构建（或 updated）金字塔时的序列，长度与 size() 不符时返回空
+     * @param pixelWidth 绘图区宽度（像素）
+     * @return 按横坐标升序的点，点数不超过 2 × pixelWidth（Mean 时为 pixelWidth）
+     */
+    QList<QPointF> query(const QVector<double>& values, double xBegin, double xEnd, int pixelWidth,
+                         Mode mode = Mode::Envelope) const;
+
+    /**
+     * @brief 查找缓存的金字塔，未命中时构建并放入 Core::ResultCache
+     * @param key 缓存键（由调用方按表格、列与版本生成）
+     */
+    static QSharedPointer<const LodPyramid> cached(const QString& key, const QVector<double>& values);
+
+private:
+    /**
+     * @brief 一层的各块汇总（结构数组）
+     */
+    struct Level
+    {
+        int shift = 0;                  // 块大小为 2^shift
+        QVector<double> min;
+        QVector<double> max;
+        QVector<double> sum;
+        QVector<qint64> count;
+        QVector<quint8> minFirst;       // 块内最小值是否先于最大值出现
+
+        qsizetype blocks() const { return min.size(); }
+        void resize(qsizetype blocks);
+    };
+
+    /**
+     * @brief 重新汇总原始数据 [firstRow, lastRow) 所在的块并向上合并
+     */
+    void refresh(const QVector<double>& values, qsizetype firstRow, qsizetype lastRow);
+    void summariseBlocks(const QVector<double>& values, Level& level, qsizetype firstBlock,
+                         qsizetype lastBlock) const;
+    static void mergeBlocks(const Level& lower, Level& upper, qsizetype firstBlock, qsizetype lastBlock);
+
+    QList<QPointF> queryRaw(const QVector<double>& values, qsizetype begin, qsizetype end, int buckets,
+                            Mode mode) const;
+
+    qsizetype m_size = 0;
+    QVector<Level> m_levels;
+};
+
+} // namespace Charts
+
+#endif // LODPYRAMID_H
@@ -0,0 +1,111 @@
+#include "TableColumnAdapter.h"
+#include "core/ResultCache.h"
+#include "statistics/CachedStatistics.h"
+#include <limits>
+
+namespace Charts {
+
+TableColumnAdapter::TableColumnAdapter(const Core::TableData* table, int column)
+    : m_table(table)
+    , m_column(column)
+{
+    if (isValid()) {
+        reload();
+    }
+}
+
+bool TableColumnAdapter::isValid() const
+{
+    return m_table && m_column >= 0 && m_column < m_table->columnCount();
+}
+
+QString TableColumnAdapter::name() const
+{
+    return isValid() ? m_table->header(m_column) : QString();
+}
+
+QString TableColumnAdapter::category(int row) const
+{
+    if (!m_table || m_table->columnCount() == 0 || row < 0 || row >= m_table->rowCount()) {
+        return QString();
+    }
+
+    // 直接读取原始字符串，不做任何转换
+    const QVariant value = m_table->at(row, 0);
+    return value.typeId() == QMetaType::QString ? value.toString() : QString::number(value.toDouble());
+}
+
+TableColumnAdapter::Change TableColumnAdapter::updateRows(int firstRow, int lastRow)
+{
+    if (!isValid()) {
+        return Change();
+    }
+    if (m_table->rowCount() != m_values.size() || firstRow < 0 || lastRow > m_values.size() || firstRow >= lastRow) {
+        return sync();
+    }
+
+    release();
+    for (int row = firstRow; row < lastRow; ++row) {
+        m_values[row] = readCell(row);
+    }
+    remember(true);
+    return Change{Change::Rows, firstRow, lastRow};
+}
+
+TableColumnAdapter::Change TableColumnAdapter::sync()
+{
+    if (!isValid()) {
+        return Change();
+    }
+    if (m_table->columnVersion(m_column) == m_columnVersion) {
+        return Change();
+    }
+
+    // 已有的行未变（只追加了行）：只读取新行
+    const int rows = m_table->rowCount();
+    const int oldRows = static_cast<int>(m_values.size());
+    if (m_table->prefixVersion(m_column) == m_prefixVersion && rows >= oldRows) {
+        release();
+        m_values.resize(rows);
+        for (int row = oldRows; row < rows; ++row) {
+            m_values[row] = readCell(row);
+        }
+        remember(true);
+        return Change{Change::Rows, oldRows, rows};
+    }
+
+    reload();
+    return Change{Change::Reset, 0, rows};
+}
+
+double TableColumnAdapter::readCell(int row) const
+{
+    // 与 TableData::toDoubleVector 的转换规则一致
+    const QVariant cell = m_table->at(row, m_column);
+    return cell.canConvert<double>() ? cell.toDouble() : std::numeric_limits<double>::quiet_NaN();
+}
+
+void TableColumnAdapter::reload()
+{
+    m_values = *Statistics::CachedStatistics::values(*m_table, m_column);
+    remember(false);
+}
+
+void TableColumnAdapter::release()
+{
+    // 旧版本的缓存项不会再命中，移除后若没有其他持有者，修补不再复制整列
+    Core::ResultCache::instance().remove(m_cacheKey);
+    m_cacheKey.clear();
+}
+
+void TableColumnAdapter::remember(bool store)
+{
+    m_columnVersion = m_table->columnVersion(m_column);
+    m_prefixVersion = m_table->prefixVersion(m_column);
+    m_cacheKey = Core::ResultCache::makeKey(*m_table, m_column, "values");
+    if (store) {
+        Statistics::CachedStatistics::storeValues(*m_table, m_column, m_values);
+    }
+}
+
+} // namespace Charts
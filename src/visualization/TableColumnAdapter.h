@@ -0,0 +1,90 @@
+#ifndef TABLECOLUMNADAPTER_H
+#define TABLECOLUMNADAPTER_H
+
+#include "core/TableData.h"
+#include <QString>
+#include <QVector>
+
+namespace Charts {
+
+/**
+ * @brief 图表读取表格列的适配器
+ *
+ * 数值直接使用 CachedStatistics::values 缓存的向量（隐式共享，不复制），
+ * 类别标签按需从第一列读取。记录读取时的列版本号，表格修改后据此判断
+ * 变化范围：已知被修改的行只重新读取这些行，只追加了行时只读取新行，
+ * 其余修改才整列重新读取；修补后的数值放回缓存供统计模块复用。
+ *
+ * 修补前先移除旧版本的缓存项；持有者也须先放开自己对 values() 的引用
+ * （LodPyramid 不保留原始数据），这样修补在独占的数据上原地进行。
+ * 仍有其他引用时（如统计对话框正在使用该列）写入会整列复制一次。
+ *
+ * 只保存表格指针而不持有表格：表格被删除前持有者须把适配器重置为
+ * 默认构造的无效状态，此后 updateRows()/sync() 不再访问表格。
+ */
+class TableColumnAdapter
+{
+public:
+    /**
+     * @brief 一次同步得到的变化
+     */
+    struct Change
+    {
+        enum Kind
+        {
+            None,       // 没有变化
+            Rows,       // [firstRow, lastRow) 被修改或追加
+            Reset       // 整列重新读取
+        };
+
+        Kind kind = None;
+        int firstRow = 0;
+        int lastRow = 0;
+    };
+
+    TableColumnAdapter() = default;
+    TableColumnAdapter(const Core::TableData* table, int column);
+
+    bool isValid() const;
+    const Core::TableData* table() const { return m_table; }
+    int column() const { return m_column; }
+
+    QString name() const;
+    qsizetype size() const { return m_values.size(); }
+    const QVector<double>& values() const { return m_values; }
+    double value(qsizetype row) const { return m_values[row]; }
+
+    /**
+     * @brief 第 row 行的类别标签（第一列的文本）
+     */
+    QString category(int row) const;
+
+    /**
+     * @brief [firstRow, lastRow) 的单元格已被修改，只重新读取这些行
+     *
+     * 行数与读取时不符时退化为 sync()。
+     */
+    Change updateRows(int firstRow, int lastRow);
+
+    /**
+     * @brief 与表格同步（修改范围未知时使用）
+     */
+    Change sync();
+
+private:
+    double readCell(int row) const;
+    void reload();
+    void release();
+    void remember(bool store);
+
+    const Core::TableData* m_table = nullptr;
+    int m_column = -1;
+    QVector<double> m_values;
+    quint64 m_columnVersion = 0;
+    quint64 m_prefixVersion = 0;
+    QString m_cacheKey;             // 读取或修补时数值所在的缓存键
+};
+
+} // namespace Charts
+
+#endif // TABLECOLUMNADAPTER_H